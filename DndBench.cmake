@@ -0,0 +1,27 @@
+# Benchmarks
+add_executable(${DND_BENCH})
+set_target_properties(${DND_BENCH} PROPERTIES EXPORT_COMPILE_COMMANDS ON)
+
+target_include_directories(${DND_BENCH}
+    PRIVATE
+    ${CMAKE_SOURCE_DIR}/src
+    ${DND_BENCH_DIRECTORY}
+    SYSTEM PRIVATE
+    ${PROJECT_BINARY_DIR}/src
+)
+target_link_libraries(${DND_BENCH}
+    PUBLIC
+    ${DND_CORE}
+    PRIVATE
+    Catch2::Catch2WithMain
+)
+
+set_compiler_flags(${DND_BENCH})
+
+# runs all benchmarks and writes the results to a JSON file, which can be compared between releases
+add_custom_target(run_bench
+    COMMAND ${DND_BENCH} --reporter console --reporter JSON::out=${PROJECT_BINARY_DIR}/bench_results.json
+    DEPENDS ${DND_BENCH}
+    WORKING_DIRECTORY ${PROJECT_BINARY_DIR}
+    COMMENT "Running benchmarks, the results are written to ${PROJECT_BINARY_DIR}/bench_results.json"
+)
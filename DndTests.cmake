@@ -6,6 +6,7 @@ target_include_directories(${DND_TESTS}
     PRIVATE
     ${CMAKE_SOURCE_DIR}/src
     ${CMAKE_SOURCE_DIR}/tests
+    ${DND_BENCH_DIRECTORY}
     SYSTEM PRIVATE
     ${PROJECT_BINARY_DIR}/src
 )
@@ -16,6 +17,12 @@ target_link_libraries(${DND_TESTS}
     Catch2::Catch2WithMain
 )
 
+# the content generator of the benchmarks is used for tests with larger amounts of content
+target_sources(${DND_TESTS}
+    PRIVATE
+    ${DND_BENCH_DIRECTORY}/corpus/content_generator.cpp
+)
+
 set_compiler_flags(${DND_TESTS})
 
 include(CTest)
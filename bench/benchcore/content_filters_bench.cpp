@@ -0,0 +1,46 @@
+#include <dnd_config.hpp>
+
+#include <core/searching/content_filters/spell/spell_filter.hpp>
+#include <core/searching/content_filters/string_filter.hpp>
+
+#include <filesystem>
+#include <string>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <core/parsing/content_parsing.hpp>
+#include <core/searching/content_filters/number_filter.hpp>
+#include <corpus/content_generator.hpp>
+
+namespace dnd::bench {
+
+static constexpr const char* tags = "[core][searching][content_filters]";
+
+TEST_CASE("StringFilter::matches", tags) {
+    const std::string str = "Concentration, up to 1 minute";
+    StringFilter contains_filter;
+    contains_filter.set(StringFilterType::CONTAINS, "minute");
+    StringFilter ends_with_filter;
+    ends_with_filter.set(StringFilterType::ENDS_WITH, "hour");
+
+    BENCHMARK("contains") { return contains_filter.matches(str); };
+    BENCHMARK("ends with") { return ends_with_filter.matches(str); };
+}
+
+TEST_CASE("SpellFilter::all_matches", tags) {
+    const std::filesystem::path content_directory = std::filesystem::temp_directory_path() / "dnd_bench_spell_filter";
+    ContentGeneratorOptions options{.seed = 1, .spell_count = 10000, .spell_file_count = 8};
+    generate_content(content_directory, options);
+    ParsingResult parsing_result = parse_content({content_directory}, ParsingMode::PARALLEL);
+
+    SpellFilter filter(parsing_result.content);
+    filter.level_filter.set(NumberFilterType::LESS_THAN, 3);
+    filter.casting_time_filter.set(StringFilterType::CONTAINS, "action");
+
+    BENCHMARK("10000 generated spells") { return filter.all_matches(); };
+
+    std::filesystem::remove_all(content_directory);
+}
+
+} // namespace dnd::bench
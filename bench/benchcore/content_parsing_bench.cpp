@@ -0,0 +1,147 @@
+#include <dnd_config.hpp>
+
+#include <core/parsing/content_parsing.hpp>
+
+#include <array>
+#include <filesystem>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/benchmark/catch_constructor.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <fmt/format.h>
+
+#include <core/content.hpp>
+#include <core/parsing/content_snapshot.hpp>
+#include <core/searching/advanced_search/advanced_content_search.hpp>
+#include <core/searching/content_filters/spell/spell_filter.hpp>
+#include <core/searching/content_filters/string_filter.hpp>
+#include <core/types.hpp>
+#include <core/utils/worker_pool.hpp>
+#include <corpus/content_generator.hpp>
+
+namespace dnd::bench {
+
+static constexpr const char* tags = "[core][parsing]";
+
+TEST_CASE("parse_content // generated content", tags) {
+    const std::filesystem::path content_directory = std::filesystem::temp_directory_path() / "dnd_bench_parsing";
+    ContentGeneratorOptions options{.seed = 1, .spell_count = 5000, .spell_file_count = 8};
+    generate_content(content_directory, options);
+
+    BENCHMARK("5000 spells, sequential") { return parse_content({content_directory}, ParsingMode::SEQUENTIAL); };
+    BENCHMARK("5000 spells, parallel") { return parse_content({content_directory}, ParsingMode::PARALLEL); };
+
+    std::filesystem::remove_all(content_directory);
+}
+
+TEST_CASE("Content // tearing down generated content", tags) {
+    const std::filesystem::path content_directory = std::filesystem::temp_directory_path() / "dnd_bench_teardown";
+    ContentGeneratorOptions options{.seed = 1, .spell_count = 5000, .spell_file_count = 8};
+    generate_content(content_directory, options);
+
+    // the buffers of the content pieces are freed together with the arenas of the content
+    BENCHMARK_ADVANCED("5000 spells")(Catch::Benchmark::Chronometer meter) {
+        std::vector<Catch::Benchmark::destructable_object<Content>> contents(static_cast<size_t>(meter.runs()));
+        for (Catch::Benchmark::destructable_object<Content>& content : contents) {
+            content.construct(parse_content({content_directory}, ParsingMode::PARALLEL).content);
+        }
+        meter.measure([&](int i) { contents[static_cast<size_t>(i)].destruct(); });
+    };
+
+    std::filesystem::remove_all(content_directory);
+}
+
+TEST_CASE("parse_content // generated content at 10x and 100x scale", tags) {
+    const std::filesystem::path content_directory = std::filesystem::temp_directory_path() / "dnd_bench_scaled";
+    for (size_t factor : std::array<size_t, 2>{10, 100}) {
+        ContentGeneratorOptions options = ContentGeneratorOptions{.seed = 1, .spell_file_count = 8}.scaled(factor);
+        generate_content(content_directory, options);
+
+        BENCHMARK(fmt::format("{}x content, parallel", factor)) {
+            return parse_content({content_directory}, ParsingMode::PARALLEL);
+        };
+    }
+
+    std::filesystem::remove_all(content_directory);
+}
+
+TEST_CASE("reparse_changed_files // one changed spell file of generated content", tags) {
+    const std::filesystem::path content_directory = std::filesystem::temp_directory_path() / "dnd_bench_reparse";
+    ContentGeneratorOptions options = ContentGeneratorOptions{.seed = 1, .spell_file_count = 80}.scaled(10);
+    generate_content(content_directory, options);
+    const std::filesystem::path spells_filepath = content_directory / "spells" / "spells-0.json";
+    WorkerPool worker_pool;
+    ParsingResult parsing_result = parse_content({content_directory}, ParsingMode::PARALLEL);
+
+    BENCHMARK("10x content, whole content parsed again") {
+        return parse_content(
+            {content_directory}, ParsingMode::PARALLEL, nullptr, DescriptionParsing::LAZY, &worker_pool
+        );
+    };
+    // the file is unchanged, so the content pieces are replaced with equal ones every time
+    BENCHMARK("10x content, only the changed spell file parsed again") {
+        return reparse_changed_files(
+            parsing_result.content, parsing_result.errors, {content_directory}, {spells_filepath}, nullptr,
+            DescriptionParsing::LAZY, worker_pool
+        );
+    };
+
+    std::filesystem::remove_all(content_directory);
+}
+
+TEST_CASE("parse_content // unchanged generated content restored from a snapshot", tags) {
+    const std::filesystem::path content_directory = std::filesystem::temp_directory_path() / "dnd_bench_snapshot";
+    ContentGeneratorOptions options = ContentGeneratorOptions{.seed = 1, .spell_file_count = 8}.scaled(10);
+    generate_content(content_directory, options);
+    WorkerPool worker_pool;
+    ContentSnapshot snapshot;
+    parse_content({content_directory}, ParsingMode::PARALLEL, &snapshot, DescriptionParsing::LAZY, &worker_pool);
+    ContentSnapshot file_snapshot = snapshot;
+    file_snapshot.clear_built_content();
+
+    // each run replaces the snapshot it restores from, so every run gets its own copy
+    auto restore = [&](Catch::Benchmark::Chronometer& meter, const ContentSnapshot& original) {
+        std::vector<ContentSnapshot> snapshots(static_cast<size_t>(meter.runs()), original);
+        meter.measure([&](int i) {
+            return parse_content(
+                {content_directory}, ParsingMode::PARALLEL, &snapshots[static_cast<size_t>(i)],
+                DescriptionParsing::LAZY, &worker_pool
+            );
+        });
+    };
+    BENCHMARK_ADVANCED("10x content, files restored and saved into the content")(Catch::Benchmark::Chronometer meter) {
+        restore(meter, file_snapshot);
+    };
+    BENCHMARK_ADVANCED("10x content, built content restored")(Catch::Benchmark::Chronometer meter) {
+        restore(meter, snapshot);
+    };
+
+    std::filesystem::remove_all(content_directory);
+}
+
+TEST_CASE("AdvancedContentSearch // generated content", "[core][searching][advanced_search]") {
+    const std::filesystem::path content_directory = std::filesystem::temp_directory_path() / "dnd_bench_search";
+    ContentGeneratorOptions options{.seed = 1, .spell_count = 10000, .spell_file_count = 8};
+    generate_content(content_directory, options);
+    ParsingResult parsing_result = parse_content({content_directory}, ParsingMode::PARALLEL);
+
+    AdvancedContentSearch search(parsing_result.content);
+    SpellFilter filter(parsing_result.content);
+    filter.duration_filter.set(StringFilterType::CONTAINS, "instant");
+    search.set_filter(std::move(filter));
+
+    BENCHMARK("spell filter, 10000 spells") {
+        search.start_searching();
+        while (!search.search_results_available()) {
+            std::this_thread::yield();
+        }
+        return search.get_search_results().size();
+    };
+
+    std::filesystem::remove_all(content_directory);
+}
+
+} // namespace dnd::bench
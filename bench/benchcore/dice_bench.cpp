@@ -0,0 +1,22 @@
+#include <dnd_config.hpp>
+
+#include <core/basic_mechanics/dice.hpp>
+
+#include <string>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+namespace dnd::bench {
+
+static constexpr const char* tags = "[core][basic_mechanics][dice]";
+
+TEST_CASE("Dice::from_string", tags) {
+    const std::string single = "1d20";
+    const std::string multiple = "2d6 + 1d8 + 3d4 + 5";
+
+    BENCHMARK("single dice") { return Dice::from_string(single); };
+    BENCHMARK("multiple dice with modifier") { return Dice::from_string(multiple); };
+}
+
+} // namespace dnd::bench
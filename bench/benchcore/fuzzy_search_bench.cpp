@@ -0,0 +1,50 @@
+#include <dnd_config.hpp>
+
+#include <core/searching/fuzzy_search/fuzzy_string_search.hpp>
+
+#include <filesystem>
+#include <string>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <core/parsing/content_parsing.hpp>
+#include <core/searching/fuzzy_search/fuzzy_content_search.hpp>
+#include <core/searching/fuzzy_search/fuzzy_search_index.hpp>
+#include <core/utils/worker_pool.hpp>
+#include <corpus/content_generator.hpp>
+
+namespace dnd::bench {
+
+static constexpr const char* tags = "[core][searching][fuzzy_search]";
+
+TEST_CASE("fuzzy_match_string", tags) {
+    const std::string short_name = "Fireball";
+    const std::string long_name = "Tasha's Otherworldly Guise (Variant: Dancing Lights of the Feywild)";
+
+    BENCHMARK("short query, short name") { return fuzzy_match_string("fb", short_name); };
+    BENCHMARK("long query, short name") { return fuzzy_match_string("fireball", short_name); };
+    BENCHMARK("short query, long name") { return fuzzy_match_string("tog", long_name); };
+    BENCHMARK("long query, long name") { return fuzzy_match_string("otherworldly feywild", long_name); };
+    BENCHMARK("no match") { return fuzzy_match_string("xyz", long_name); };
+}
+
+TEST_CASE("fuzzy_search_content_top_k // generated content", tags) {
+    const std::filesystem::path content_directory = std::filesystem::temp_directory_path() / "dnd_bench_fuzzy_search";
+    ContentGeneratorOptions options{.seed = 1, .spell_count = 10000, .spell_file_count = 8};
+    generate_content(content_directory, options);
+    ParsingResult parsing_result = parse_content({content_directory}, ParsingMode::PARALLEL);
+    FuzzySearchIndex index(parsing_result.content);
+    FuzzySearchOptions search_options;
+    search_options.set_all(true);
+    // the pool is started once like the one of the session, so a search does not start threads
+    WorkerPool worker_pool;
+
+    BENCHMARK("one keystroke, 10000 spells") {
+        return fuzzy_search_content_top_k(index, "fi", search_options, 100, worker_pool).match_count;
+    };
+
+    std::filesystem::remove_all(content_directory);
+}
+
+} // namespace dnd::bench
@@ -0,0 +1,76 @@
+#include <dnd_config.hpp>
+
+#include <core/models/character/stats.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <core/basic_mechanics/abilities.hpp>
+#include <core/basic_mechanics/dice.hpp>
+#include <core/models/character/ability_scores.hpp>
+#include <core/models/character/stat_program.hpp>
+#include <core/models/effects/stat_change/stat_change.hpp>
+#include <core/models/effects/stat_change/stat_change_factory.hpp>
+#include <core/utils/arena.hpp>
+
+namespace dnd::bench {
+
+static constexpr const char* tags = "[core][models][stats]";
+
+TEST_CASE("Stats::create", tags) {
+    AbilityScores ability_scores = AbilityScores::create(AbilityScores::Data{
+        .strength = 10, .dexterity = 14, .constitution = 13, .intelligence = 16, .wisdom = 12, .charisma = 8
+    }).value();
+    Dice hit_dice = Dice::single_from_int(8).value();
+    std::vector<int> hit_dice_rolls = {8, 5, 6, 3, 7, 4, 8, 2, 5, 6};
+
+    std::vector<ArenaPtr<StatChange>> owned_stat_changes;
+    for (const char* stat_change_str : {
+             "MY_VALUE_1 earliest set STR_MOD", "STR normal add 1", "DEX early sub -2", "SPEED late mult 1.5",
+             "MY_VALUE_2 early add MY_VALUE_1", "AC normal add 2", "STR latest max 24", "INT normal add 2",
+         }) {
+        owned_stat_changes.push_back(create_stat_change(StatChange::Data{.stat_change_str = stat_change_str}).value());
+    }
+    std::vector<StatChangeInstruction> program;
+    for (const ArenaPtr<StatChange>& stat_change : owned_stat_changes) {
+        program.push_back(stat_change->get_instruction());
+    }
+
+    BENCHMARK("without stat changes") {
+        return Stats::create(ability_scores, 3, {}, hit_dice, hit_dice_rolls);
+    };
+    BENCHMARK("with stat changes") {
+        return Stats::create(ability_scores, 3, program, hit_dice, hit_dice_rolls);
+    };
+
+    std::vector<StatChangeInstruction> program_copy = program;
+    StatProgram stat_program(std::move(program_copy));
+    StatInputs inputs{
+        .ability_scores = {10, 14, 13, 16, 12, 8},
+        .proficiency_bonus = 3,
+        .hit_dice_maximum = 8,
+        .hit_dice_rolls = hit_dice_rolls,
+    };
+    StatInputs changed_wisdom = inputs;
+    changed_wisdom.ability_scores[static_cast<size_t>(Ability::WISDOM)] = 14;
+    StatInputs changed_rolls = inputs;
+    changed_rolls.hit_dice_rolls.push_back(7);
+    Stats stats = stat_program.evaluate(inputs).value();
+
+    BENCHMARK("program evaluation") { return stat_program.evaluate(inputs); };
+    BENCHMARK("program update of an ability score") {
+        Stats updated_stats = stats;
+        return stat_program.update(updated_stats, inputs, changed_wisdom);
+    };
+    BENCHMARK("program update of the hit dice rolls") {
+        Stats updated_stats = stats;
+        return stat_program.update(updated_stats, inputs, changed_rolls);
+    };
+}
+
+} // namespace dnd::bench
@@ -0,0 +1,63 @@
+#include <dnd_config.hpp>
+
+#include <core/validation/string_matchers.hpp>
+
+#include <regex>
+#include <string>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+namespace dnd::bench {
+
+static constexpr const char* tags = "[core][validation]";
+
+// the regular expressions that were used before the matchers, to compare against
+
+TEST_CASE("is_dice_string", tags) {
+    const std::regex dice_regex(
+        "(([1-9]\\d*)?[dD](4|6|8|10|12|20|100)\\+)*(([1-9]\\d*)?[dD](4|6|8|10|12|20|100))([\\+\\-]\\d+)?"
+    );
+    const std::string dice = "2d6+1d8+3d4+5";
+
+    BENCHMARK("std::regex") { return std::regex_match(dice, dice_regex); };
+    BENCHMARK("matcher") { return is_dice_string(dice); };
+}
+
+TEST_CASE("is_condition_string", tags) {
+    const std::regex condition_regex(
+        "[A-Z][_A-Z0-9]+ ((==|!=|>=|<=|>|<) ([A-Z][_A-Z0-9]+|-?\\d+(\\.\\d\\d?)?|)|== true|== false)"
+    );
+    const std::string condition = "CLASS_LEVEL >= 3";
+
+    BENCHMARK("std::regex") { return std::regex_match(condition, condition_regex); };
+    BENCHMARK("matcher") { return is_condition_string(condition); };
+}
+
+TEST_CASE("is_stat_change_string", tags) {
+    const std::regex stat_change_regex(
+        "[A-Z][_A-Z0-9]+ (earliest|early|normal|late|latest) ((add|sub|mult|div|set|max|min) "
+        "([A-Z][_A-Z0-9]+|-?[1-9]\\d*(\\.[1-9]|\\.\\d[1-9])?)|(set (false|true)))"
+    );
+    const std::string stat_change = "ARMOR_CLASS normal add DEX_MOD";
+
+    BENCHMARK("std::regex") { return std::regex_match(stat_change, stat_change_regex); };
+    BENCHMARK("matcher") { return is_stat_change_string(stat_change); };
+}
+
+TEST_CASE("match_spell_group_name", tags) {
+    const std::regex spell_filter_regex(
+        "((1st|2nd|3rd|[4-9]th)-level )?(([aA]bjuration|[cC]onjuration|[dD]ivination|[eE]nchantment|"
+        "[eE]vocation|[iI]llusion|[nN]ecromancy|[tT]ransmutation) )?(([a-zA-Z][a-z]*) )?[sS]pells"
+    );
+    const std::string group_name = "3rd-level evocation Wizard spells";
+
+    BENCHMARK("std::regex") {
+        std::smatch match;
+        std::regex_match(group_name, match, spell_filter_regex);
+        return match[6].str();
+    };
+    BENCHMARK("matcher") { return match_spell_group_name(group_name); };
+}
+
+} // namespace dnd::bench
@@ -0,0 +1,131 @@
+#include <dnd_config.hpp>
+
+#include <core/parsing/parser.hpp>
+#include <core/text/check_text.hpp>
+#include <core/text/formatted_text.hpp>
+#include <core/text/formatted_text_writer.hpp>
+#include <core/text/rich_text.hpp>
+#include <core/utils/arena.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/benchmark/catch_constructor.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <fmt/format.h>
+
+namespace dnd::bench {
+
+static constexpr const char* tags = "[core][text]";
+
+TEST_CASE("parse_rich_text", tags) {
+    const std::string simple = "{@spell Disguise Self}";
+    const std::string with_attributes = "{@creature Goblin Boss|MM|goblin boss} attacks";
+
+    BENCHMARK("simple rich text") { return parse_rich_text(simple); };
+    BENCHMARK("rich text with attributes") { return parse_rich_text(with_attributes); };
+}
+
+TEST_CASE("parse_paragraph", tags) {
+    const std::string paragraph = "When you cast {@spell fireball|PHB}, each creature in a {@b 20-foot-radius {@i sphere}} "
+                                  "must make a {@skill Dexterity} saving throw, taking {@damage 8d6} fire damage on a "
+                                  "failed save. The fire spreads around corners and ignites flammable objects.";
+
+    BENCHMARK("paragraph with links and formatting") {
+        FormattedText parsed;
+        FormattedTextWriter writer(parsed);
+        uint32_t paragraph_index = writer.begin_node(FormattedTextNodeType::PARAGRAPH);
+        parse_paragraph(paragraph, writer, "bench.json");
+        writer.end_node(paragraph_index);
+        return parsed;
+    };
+}
+
+TEST_CASE("checked_string", tags) {
+    const std::string ascii = "You hurl a mote of fire at a creature or object within range. Make a ranged spell "
+                              "attack against the target. On a hit, the target takes 1d10 fire damage.";
+    const std::string unicode = "The caster’s “arcane” focus — a crystal, orb, rod, staff, or wand — glows ✨.";
+
+    // a typical description: long ASCII runs with only a few code points that are substituted
+    const std::string description = []() {
+        std::string text;
+        for (int i = 0; i < 8; ++i) {
+            text += "As an action, you can expend one use of this feature to deal an extra 2d6 damage — the damage "
+                    "type is the same as the weapon's — to one creature you hit within 5 feet of you. The bonus "
+                    "increases to 3d6 at 11th level and to 4d6 at 17th level. ";
+        }
+        return text;
+    }();
+
+    BENCHMARK("ASCII text") { return checked_string(std::string(ascii)); };
+    BENCHMARK("text with unicode characters") { return checked_string(std::string(unicode)); };
+    BENCHMARK("description text") { return checked_string(std::string(description)); };
+}
+
+namespace {
+
+/**
+ * @brief The descriptions of many content pieces, optionally allocated from an arena like those of a parsed content
+ */
+struct Descriptions {
+    Descriptions(bool use_arena, const std::string& paragraph, size_t count)
+        : arena(use_arena ? std::make_unique<Arena>() : nullptr) {
+        std::optional<ArenaScope> arena_scope;
+        if (arena != nullptr) {
+            arena_scope.emplace(*arena);
+        }
+        texts.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            FormattedText& text = texts.emplace_back();
+            FormattedTextWriter writer(text);
+            for (int j = 0; j < 3; ++j) {
+                uint32_t paragraph_index = writer.begin_node(FormattedTextNodeType::PARAGRAPH);
+                parse_paragraph(paragraph, writer, "bench.json");
+                writer.end_node(paragraph_index);
+            }
+        }
+    }
+
+    // declared first so that the texts are destroyed before it
+    std::unique_ptr<Arena> arena;
+    std::vector<FormattedText> texts;
+};
+
+} // namespace
+
+TEST_CASE("FormattedText // descriptions on the heap and in an arena", tags) {
+    const std::string paragraph = "When you cast {@spell fireball|PHB}, each creature in a {@b 20-foot-radius "
+                                  "{@i sphere}} must make a {@skill Dexterity} saving throw, taking {@damage 8d6} fire "
+                                  "damage on a failed save. The fire spreads around corners and ignites flammable "
+                                  "objects.";
+    constexpr size_t count = 1000;
+
+    for (bool use_arena : {false, true}) {
+        const char* resource_name = use_arena ? "arena" : "heap";
+        BENCHMARK_ADVANCED(fmt::format("build {} descriptions, {}", count, resource_name))
+        (Catch::Benchmark::Chronometer meter) {
+            std::vector<Catch::Benchmark::storage_for<Descriptions>> storage(static_cast<size_t>(meter.runs()));
+            meter.measure([&](int i) { storage[static_cast<size_t>(i)].construct(use_arena, paragraph, count); });
+            for (Catch::Benchmark::storage_for<Descriptions>& descriptions : storage) {
+                descriptions.destruct();
+            }
+        };
+        BENCHMARK_ADVANCED(fmt::format("tear down {} descriptions, {}", count, resource_name))
+        (Catch::Benchmark::Chronometer meter) {
+            std::vector<Catch::Benchmark::destructable_object<Descriptions>> storage(
+                static_cast<size_t>(meter.runs())
+            );
+            for (Catch::Benchmark::destructable_object<Descriptions>& descriptions : storage) {
+                descriptions.construct(use_arena, paragraph, count);
+            }
+            meter.measure([&](int i) { storage[static_cast<size_t>(i)].destruct(); });
+        };
+    }
+}
+
+} // namespace dnd::bench
@@ -0,0 +1,433 @@
+#include <dnd_config.hpp>
+
+#include "content_generator.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+
+namespace dnd::bench {
+
+static constexpr std::array<const char*, 16> words = {
+    "Arcane", "Blade",  "Chill", "Dancing", "Eldritch", "Flame",   "Guardian", "Healing",
+    "Ice",    "Lights", "Mage",  "Shield",  "Storm",    "Thunder", "Ward",     "Wounds",
+};
+static constexpr std::array<const char*, 4> sources = {"PHB", "XGE", "TCE", "DMG"};
+static constexpr std::array<char, 8> magic_schools = {'A', 'C', 'D', 'E', 'I', 'N', 'T', 'V'};
+static constexpr std::array<int, 4> hit_dice_faces = {6, 8, 10, 12};
+static constexpr std::array<const char*, 6> abilities = {"str", "dex", "con", "int", "wis", "cha"};
+static constexpr std::array<const char*, 5> conditions = {"blinded", "charmed", "frightened", "poisoned", "prone"};
+static constexpr std::array<const char*, 6> subjects = {
+    "The caster", "A creature", "Each ally", "The target", "Your familiar", "An enemy",
+};
+static constexpr std::array<const char*, 6> predicates = {
+    "gains resistance against", "is shielded from", "takes damage from", "is healed by", "can sense", "is bound to",
+};
+
+/**
+ * @brief A small deterministic random number generator, std::mt19937 is used directly because the standard
+ * distributions produce different values with different standard libraries
+ */
+class Random {
+public:
+    explicit Random(uint32_t seed) : engine(seed) {}
+    size_t below(size_t bound) { return engine() % bound; }
+    bool chance(double probability) { return static_cast<double>(engine()) < probability * 4294967296.0; }
+    template <typename T, size_t N>
+    const T& pick(const std::array<T, N>& values) {
+        return values[below(N)];
+    }
+    template <typename T>
+    const T& pick(const std::vector<T>& values) {
+        return values[below(values.size())];
+    }
+private:
+    std::mt19937 engine;
+};
+
+// the name and source identifying a generated content piece
+struct Reference {
+    std::string name;
+    std::string source;
+};
+
+struct GeneratedClass {
+    Reference reference;
+    int hit_dice_faces;
+    std::vector<std::string> subclass_short_names;
+};
+
+struct GeneratedSpecies {
+    Reference reference;
+    std::vector<Reference> subspecies;
+};
+
+// the already generated content pieces that later content pieces can refer to
+struct GeneratedContent {
+    std::set<std::string> used_names;
+    std::vector<std::string> spell_names;
+    std::vector<GeneratedClass> classes;
+    std::vector<GeneratedSpecies> species;
+    std::vector<Reference> feats;
+};
+
+ContentGeneratorOptions ContentGeneratorOptions::scaled(size_t factor) const {
+    ContentGeneratorOptions options = *this;
+    options.spell_count *= factor;
+    options.class_count *= factor;
+    options.species_count *= factor;
+    options.feat_count *= factor;
+    options.character_count *= factor;
+    return options;
+}
+
+static std::string unique_name(Random& random, std::set<std::string>& used_names) {
+    std::string name = fmt::format("{} {}", random.pick(words), random.pick(words));
+    while (used_names.contains(name)) {
+        name = fmt::format("{} {}", name, random.pick(words));
+    }
+    used_names.insert(name);
+    return name;
+}
+
+static std::string generate_rich_text_tag(Random& random, const GeneratedContent& generated) {
+    switch (random.below(5)) {
+        case 0:
+            if (!generated.spell_names.empty()) {
+                return fmt::format("{{@spell {}}}", random.pick(generated.spell_names));
+            }
+            [[fallthrough]];
+        case 1:
+            return fmt::format("{{@dice {}d{}}}", 1 + random.below(4), random.pick(hit_dice_faces));
+        case 2:
+            return fmt::format("{{@condition {}}}", random.pick(conditions));
+        case 3:
+            return fmt::format("{{@b {}}}", random.pick(words));
+        default:
+            return fmt::format("{{@i {}}}", random.pick(words));
+    }
+}
+
+static nlohmann::ordered_json generate_description(
+    Random& random, const GeneratedContent& generated, const ContentGeneratorOptions& options
+) {
+    nlohmann::ordered_json description = nlohmann::ordered_json::array();
+    for (size_t i = 0; i < options.paragraph_count; ++i) {
+        std::string paragraph;
+        for (size_t j = 0; j < options.sentence_count; ++j) {
+            std::string object = random.chance(options.rich_text_density)
+                                     ? generate_rich_text_tag(random, generated)
+                                     : fmt::format("the {} {}", random.pick(words), random.pick(words));
+            if (!paragraph.empty()) {
+                paragraph += ' ';
+            }
+            paragraph += fmt::format("{} {} {}.", random.pick(subjects), random.pick(predicates), object);
+        }
+        description.push_back(std::move(paragraph));
+    }
+    return description;
+}
+
+/**
+ * @brief Removes a required attribute from a content piece with the probability given by the error rate
+ * @param random the random number generator
+ * @param element the content piece
+ * @param attribute the required attribute to remove
+ * @param options the options specifying the error rate
+ */
+static void inject_error(
+    Random& random, nlohmann::ordered_json& element, const char* attribute, const ContentGeneratorOptions& options
+) {
+    if (random.chance(options.error_rate)) {
+        element.erase(attribute);
+    }
+}
+
+static void write_json(const std::filesystem::path& filepath, const nlohmann::ordered_json& json) {
+    std::ofstream file(filepath, std::ios::trunc);
+    file << json.dump(4);
+}
+
+static nlohmann::ordered_json generate_spell(
+    Random& random, const std::string& name, const std::string& source, const GeneratedContent& generated,
+    const ContentGeneratorOptions& options
+) {
+    nlohmann::ordered_json spell;
+    spell["name"] = name;
+    spell["source"] = source;
+    spell["level"] = random.below(10);
+    spell["school"] = std::string(1, random.pick(magic_schools));
+    spell["time"] = {{{"number", 1}, {"unit", "action"}}};
+    spell["range"] = {{"type", "point"}, {"distance", {{"type", "feet"}, {"amount", 30 * (1 + random.below(4))}}}};
+    spell["components"] = {{"v", true}, {"s", random.below(2) == 0}};
+    spell["duration"] = {{{"type", "instant"}}};
+    spell["entries"] = generate_description(random, generated, options);
+    inject_error(random, spell, "school", options);
+    return spell;
+}
+
+static void generate_spells(
+    Random& random, const std::filesystem::path& spells_directory, GeneratedContent& generated,
+    const ContentGeneratorOptions& options
+) {
+    std::filesystem::create_directories(spells_directory);
+    nlohmann::ordered_json spell_sources = nlohmann::ordered_json::object();
+    std::vector<nlohmann::ordered_json> spell_files(
+        std::max(options.spell_file_count, static_cast<size_t>(1)), nlohmann::ordered_json::object()
+    );
+    for (size_t i = 0; i < options.spell_count; ++i) {
+        std::string name = unique_name(random, generated.used_names);
+        std::string source = random.pick(sources);
+        nlohmann::ordered_json spell = generate_spell(random, name, source, generated, options);
+        spell_files[i % spell_files.size()]["spell"].push_back(std::move(spell));
+        nlohmann::ordered_json& spell_classes = spell_sources[source][name]["class"];
+        spell_classes = nlohmann::ordered_json::array();
+        if (!generated.classes.empty()) {
+            const Reference& cls = random.pick(generated.classes).reference;
+            spell_classes.push_back({{"name", cls.name}, {"source", cls.source}});
+        }
+        generated.spell_names.push_back(std::move(name));
+    }
+    write_json(spells_directory / "sources.json", spell_sources);
+    for (size_t i = 0; i < spell_files.size(); ++i) {
+        write_json(spells_directory / fmt::format("spells-{}.json", i), spell_files[i]);
+    }
+}
+
+/**
+ * @brief Writes a class with its subclasses and all their features to one file
+ * @param random the random number generator
+ * @param filepath the file to write the class to
+ * @param cls the class, its name and subclasses are already decided
+ * @param generated the already generated content pieces
+ * @param options the options specifying the generated content
+ */
+static void generate_class_file(
+    Random& random, const std::filesystem::path& filepath, const GeneratedClass& cls, GeneratedContent& generated,
+    const ContentGeneratorOptions& options
+) {
+    const std::string& class_name = cls.reference.name;
+    const std::string& class_source = cls.reference.source;
+    nlohmann::ordered_json class_file = nlohmann::ordered_json::object();
+
+    nlohmann::ordered_json class_json;
+    class_json["name"] = class_name;
+    class_json["source"] = class_source;
+    class_json["hd"] = {{"number", 1}, {"faces", cls.hit_dice_faces}};
+    class_file["class"].push_back(std::move(class_json));
+
+    // the first feature is the feature choosing the subclass, it is available from level 1 on
+    for (size_t i = 0; i < std::max(options.feature_count, static_cast<size_t>(1)); ++i) {
+        nlohmann::ordered_json feature;
+        feature["name"] = unique_name(random, generated.used_names);
+        feature["source"] = class_source;
+        feature["className"] = class_name;
+        feature["classSource"] = class_source;
+        feature["level"] = i == 0 ? 1 : 1 + random.below(20);
+        feature["entries"] = generate_description(random, generated, options);
+        if (i != 0) {
+            inject_error(random, feature, "level", options);
+        }
+        class_file["classFeature"].push_back(std::move(feature));
+    }
+
+    for (const std::string& short_name : cls.subclass_short_names) {
+        nlohmann::ordered_json subclass;
+        subclass["name"] = fmt::format("{} of the {}", class_name, short_name);
+        subclass["shortName"] = short_name;
+        subclass["source"] = class_source;
+        subclass["className"] = class_name;
+        subclass["classSource"] = class_source;
+        class_file["subclass"].push_back(std::move(subclass));
+
+        for (size_t i = 0; i < options.feature_count; ++i) {
+            nlohmann::ordered_json feature;
+            feature["name"] = unique_name(random, generated.used_names);
+            feature["source"] = class_source;
+            feature["className"] = class_name;
+            feature["classSource"] = class_source;
+            feature["subclassShortName"] = short_name;
+            feature["subclassSource"] = class_source;
+            feature["level"] = 1 + random.below(20);
+            feature["entries"] = generate_description(random, generated, options);
+            inject_error(random, feature, "level", options);
+            class_file["subclassFeature"].push_back(std::move(feature));
+        }
+    }
+
+    write_json(filepath, class_file);
+}
+
+static void generate_classes(
+    Random& random, const std::filesystem::path& class_directory, GeneratedContent& generated,
+    const ContentGeneratorOptions& options
+) {
+    std::filesystem::create_directories(class_directory);
+    for (size_t i = 0; i < generated.classes.size(); ++i) {
+        generate_class_file(
+            random, class_directory / fmt::format("class-{}.json", i), generated.classes[i], generated, options
+        );
+    }
+}
+
+/**
+ * @brief Decides the names of the classes and subclasses, they are needed before the spells are generated
+ * @param random the random number generator
+ * @param generated the already generated content pieces
+ * @param options the options specifying the generated content
+ */
+static void reserve_classes(Random& random, GeneratedContent& generated, const ContentGeneratorOptions& options) {
+    for (size_t i = 0; i < options.class_count; ++i) {
+        GeneratedClass& cls = generated.classes.emplace_back();
+        cls.reference = Reference{.name = unique_name(random, generated.used_names), .source = random.pick(sources)};
+        cls.hit_dice_faces = random.pick(hit_dice_faces);
+        std::set<std::string> used_short_names;
+        for (size_t j = 0; j < options.subclass_count; ++j) {
+            cls.subclass_short_names.push_back(unique_name(random, used_short_names));
+        }
+    }
+}
+
+static void generate_species(
+    Random& random, const std::filesystem::path& filepath, GeneratedContent& generated,
+    const ContentGeneratorOptions& options
+) {
+    nlohmann::ordered_json species_file = nlohmann::ordered_json::object();
+    species_file["race"] = nlohmann::ordered_json::array();
+    species_file["subrace"] = nlohmann::ordered_json::array();
+    for (size_t i = 0; i < options.species_count; ++i) {
+        GeneratedSpecies& species = generated.species.emplace_back();
+        species.reference = Reference{
+            .name = unique_name(random, generated.used_names),
+            .source = random.pick(sources),
+        };
+
+        nlohmann::ordered_json race;
+        race["name"] = species.reference.name;
+        race["source"] = species.reference.source;
+        race["entries"] = generate_description(random, generated, options);
+        inject_error(random, race, "source", options);
+        species_file["race"].push_back(std::move(race));
+
+        for (size_t j = 0; j < options.subspecies_count; ++j) {
+            Reference& subspecies = species.subspecies.emplace_back(
+                Reference{.name = unique_name(random, generated.used_names), .source = species.reference.source}
+            );
+            nlohmann::ordered_json subrace;
+            subrace["name"] = subspecies.name;
+            subrace["source"] = subspecies.source;
+            subrace["raceName"] = species.reference.name;
+            subrace["raceSource"] = species.reference.source;
+            subrace["entries"] = generate_description(random, generated, options);
+            species_file["subrace"].push_back(std::move(subrace));
+        }
+    }
+    write_json(filepath, species_file);
+}
+
+static void generate_feats(
+    Random& random, const std::filesystem::path& filepath, GeneratedContent& generated,
+    const ContentGeneratorOptions& options
+) {
+    nlohmann::ordered_json feats_file = nlohmann::ordered_json::object();
+    feats_file["feat"] = nlohmann::ordered_json::array();
+    for (size_t i = 0; i < options.feat_count; ++i) {
+        Reference& reference = generated.feats.emplace_back(
+            Reference{.name = unique_name(random, generated.used_names), .source = random.pick(sources)}
+        );
+        nlohmann::ordered_json feat;
+        feat["name"] = reference.name;
+        feat["source"] = reference.source;
+        feat["ability"] = {{{random.pick(abilities), 1}}};
+        feat["entries"] = {"You gain the following benefits:"};
+        for (nlohmann::ordered_json& paragraph : generate_description(random, generated, options)) {
+            feat["entries"].push_back(std::move(paragraph));
+        }
+        inject_error(random, feat, "source", options);
+        feats_file["feat"].push_back(std::move(feat));
+    }
+    write_json(filepath, feats_file);
+}
+
+static nlohmann::ordered_json generate_character(
+    Random& random, const std::string& name, const GeneratedContent& generated, const ContentGeneratorOptions& options
+) {
+    const GeneratedClass& cls = random.pick(generated.classes);
+    const GeneratedSpecies& species = random.pick(generated.species);
+    size_t level = 1 + random.below(20);
+
+    nlohmann::ordered_json character;
+    character["name"] = name;
+    character["source"] = "CHAR";
+    character["entries"] = generate_description(random, generated, options);
+    character["progression"]["level"] = level;
+    character["progression"]["hdRolls"] = nlohmann::ordered_json::array();
+    for (size_t i = 0; i < level; ++i) {
+        character["progression"]["hdRolls"].push_back(1 + random.below(cls.hit_dice_faces));
+    }
+    character["class"] = {{"name", cls.reference.name}, {"source", cls.reference.source}};
+    // the subclass feature of a generated class is available from level 1 on, so every character needs a subclass
+    if (!cls.subclass_short_names.empty()) {
+        const std::string& subclass_short_name = random.pick(cls.subclass_short_names);
+        character["subclass"] = {{"shortName", subclass_short_name}, {"source", cls.reference.source}};
+    }
+    character["species"] = {{"name", species.reference.name}, {"source", species.reference.source}};
+    if (!species.subspecies.empty()) {
+        const Reference& subspecies = random.pick(species.subspecies);
+        character["subspecies"] = {{"name", subspecies.name}, {"source", subspecies.source}};
+    }
+    for (const char* ability : abilities) {
+        character["baseScores"][ability] = 8 + random.below(8);
+    }
+    character["feats"] = nlohmann::ordered_json::array();
+    if (!generated.feats.empty()) {
+        for (size_t i = random.below(3); i > 0; --i) {
+            const Reference& feat = random.pick(generated.feats);
+            character["feats"].push_back({{"name", feat.name}, {"source", feat.source}});
+        }
+    }
+    inject_error(random, character, "baseScores", options);
+    return character;
+}
+
+static void generate_characters(
+    Random& random, const std::filesystem::path& characters_directory, GeneratedContent& generated,
+    const ContentGeneratorOptions& options
+) {
+    if (generated.classes.empty() || generated.species.empty()) {
+        return;
+    }
+    std::filesystem::create_directories(characters_directory);
+    std::set<std::string> used_names;
+    for (size_t i = 0; i < options.character_count; ++i) {
+        nlohmann::ordered_json character_file = nlohmann::ordered_json::object();
+        std::string name = unique_name(random, used_names);
+        character_file["character"].push_back(generate_character(random, name, generated, options));
+        write_json(characters_directory / fmt::format("character-{}.json", i), character_file);
+    }
+}
+
+void generate_content(const std::filesystem::path& content_directory, const ContentGeneratorOptions& options) {
+    std::filesystem::remove_all(content_directory);
+    std::filesystem::create_directories(content_directory);
+    Random random(options.seed);
+    GeneratedContent generated;
+    reserve_classes(random, generated, options);
+    generate_spells(random, content_directory / "spells", generated, options);
+    generate_classes(random, content_directory / "class", generated, options);
+    generate_species(random, content_directory / "species.json", generated, options);
+    generate_feats(random, content_directory / "feats.json", generated, options);
+    generate_characters(random, content_directory / "characters", generated, options);
+}
+
+} // namespace dnd::bench
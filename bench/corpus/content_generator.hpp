@@ -0,0 +1,55 @@
+#ifndef CONTENT_GENERATOR_HPP_
+#define CONTENT_GENERATOR_HPP_
+
+#include <dnd_config.hpp>
+
+#include <cstdint>
+#include <filesystem>
+
+namespace dnd::bench {
+
+struct ContentGeneratorOptions {
+    // the seed of the random number generator, the same options always generate the same content
+    uint32_t seed = 1;
+    size_t spell_count = 100;
+    // the number of files the spells are distributed over
+    size_t spell_file_count = 4;
+    // the number of classes, each class is written to its own file
+    size_t class_count = 4;
+    // the number of subclasses of each class
+    size_t subclass_count = 2;
+    // the number of features of each class and each subclass, at least 1
+    size_t feature_count = 4;
+    size_t species_count = 4;
+    // the number of subspecies of each species
+    size_t subspecies_count = 2;
+    size_t feat_count = 20;
+    // the number of characters, each character is written to its own file
+    size_t character_count = 10;
+    // the number of paragraphs of each description
+    size_t paragraph_count = 2;
+    // the number of sentences of each paragraph
+    size_t sentence_count = 3;
+    // the probability of a sentence containing a rich text tag such as {@spell ...} or {@dice ...}
+    double rich_text_density = 0.25;
+    // the probability of a content piece missing a required attribute, which results in an error
+    double error_rate = 0.0;
+
+    /**
+     * @brief Creates options generating a multiple of the content pieces, e.g. for testing at 10x or 100x scale
+     * @param factor the factor the counts of all top-level content pieces are multiplied with
+     * @return the scaled options
+     */
+    ContentGeneratorOptions scaled(size_t factor) const;
+};
+
+/**
+ * @brief Writes a content directory in the layout parse_content expects, an existing directory is replaced
+ * @param content_directory the directory to write the content to
+ * @param options the options specifying the generated content
+ */
+void generate_content(const std::filesystem::path& content_directory, const ContentGeneratorOptions& options);
+
+} // namespace dnd::bench
+
+#endif // CONTENT_GENERATOR_HPP_
@@ -3,11 +3,16 @@
 #include "content.hpp"
 
 #include <cassert>
+#include <filesystem>
+#include <memory>
+#include <optional>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <fmt/format.h>
 
+#include <core/errors/errors.hpp>
 #include <core/groups.hpp>
 #include <core/models/character/character.hpp>
 #include <core/models/class/class.hpp>
@@ -23,9 +28,58 @@
 #include <core/referencing_content_library.hpp>
 #include <core/storage_content_library.hpp>
 #include <core/types.hpp>
+#include <core/utils/arena.hpp>
+#include <core/utils/worker_pool.hpp>
 
 namespace dnd {
 
+Content::Content() : arena(std::make_unique<Arena>()), file_arenas(), groups(arena->get_resource()) {}
+
+/**
+ * @brief Replaces a detached content piece that owns features, the references of the feature library are moved to the
+ * features of the new content piece, which need to have the same keys in the same order
+ * @param library the library of the content piece
+ * @param feature_library the library referencing the features of the content piece
+ * @param index the index of the detached content piece
+ * @param content_piece the content piece replacing it
+ * @return the new content piece, or std::nullopt if the features differ, which leaves the previous one detached
+ */
+template <typename T, typename F>
+static Opt<CRef<T>> replace_feature_owner(
+    StorageContentLibrary<T>& library, ReferencingContentLibrary<F>& feature_library, size_t index, T&& content_piece
+) {
+    const std::vector<F>& previous_features = library.get(index).value().get().get_features();
+    const std::vector<F>& features = content_piece.get_features();
+    if (previous_features.size() != features.size()) {
+        return std::nullopt;
+    }
+    std::vector<size_t> reference_indices;
+    reference_indices.reserve(features.size());
+    for (size_t i = 0; i < features.size(); ++i) {
+        std::optional<size_t> reference_index = feature_library.find_reference(previous_features[i]);
+        if (!reference_index.has_value() || previous_features[i].get_key() != features[i].get_key()) {
+            return std::nullopt;
+        }
+        reference_indices.push_back(reference_index.value());
+    }
+    library.add(std::move(content_piece));
+    const T& replaced_content_piece = library.get(index).value();
+    for (size_t i = 0; i < reference_indices.size(); ++i) {
+        feature_library.rebind(reference_indices[i], replaced_content_piece.get_features()[i]);
+    }
+    return replaced_content_piece;
+}
+
+Content& Content::operator=(Content&& other) noexcept {
+    if (this != &other) {
+        // the previous models are destroyed before the arenas they were allocated from, and the models of the other
+        // content are moved together with their arenas instead of being assigned to the resources of this content
+        std::destroy_at(this);
+        std::construct_at(this, std::move(other));
+    }
+    return *this;
+}
+
 bool Content::empty() const {
 #define X(C, U, j, a, p, P) j##_library.empty() &&
     return X_CONTENT_PIECES true;
@@ -137,6 +191,37 @@ std::optional<EffectsProviderVariant> Content::get_effects_provider(const std::s
     return std::nullopt;
 }
 
+Arena& Content::get_arena() { return *arena; }
+
+void Content::adopt_arena(std::unique_ptr<Arena>&& file_arena) { file_arenas.push_back(std::move(file_arena)); }
+
+void Content::detach(Id id) {
+    switch (id.type) {
+#define X(C, U, j, a, p, P)                                                                                            \
+    case Type::C: {                                                                                                    \
+        j##_library.detach(id.index);                                                                                  \
+        break;                                                                                                         \
+    }
+        X_OWNED_CONTENT_PIECES
+#undef X
+        default:
+            // features are replaced together with the content piece owning them
+            break;
+    }
+}
+
+bool Content::has_detached() const {
+#define X(C, U, j, a, p, P) j##_library.has_detached() ||
+    return X_OWNED_CONTENT_PIECES false;
+#undef X
+}
+
+void Content::remove_drafts(const std::filesystem::path& source_path) {
+#define X(C, U, j, a, p, P) j##_library.remove_drafts(source_path);
+    X_OWNED_CONTENT_PIECES
+#undef X
+}
+
 void Content::set_subgroup(const std::string& group_name, const std::string& subgroup_name) {
     groups.set_subgroup(group_name, subgroup_name);
 }
@@ -154,6 +239,10 @@ void Content::add_group_members(const std::string& group_name, std::set<std::str
 }
 
 Opt<CRef<Character>> Content::add_character(Character&& character) {
+    std::optional<size_t> detached_index = character_library.find_detached(character.get_key());
+    if (detached_index.has_value()) {
+        return replace_feature_owner(character_library, feature_library, detached_index.value(), std::move(character));
+    }
     std::optional<size_t> character_index = character_library.add(std::move(character));
     if (!character_index.has_value()) {
         return std::nullopt;
@@ -168,6 +257,10 @@ Opt<CRef<Character>> Content::add_character(Character&& character) {
 }
 
 Opt<CRef<Class>> Content::add_class(Class&& cls) {
+    std::optional<size_t> detached_index = class_library.find_detached(cls.get_key());
+    if (detached_index.has_value()) {
+        return replace_feature_owner(class_library, class_feature_library, detached_index.value(), std::move(cls));
+    }
     std::optional<size_t> class_index = class_library.add(std::move(cls));
     if (!class_index.has_value()) {
         return std::nullopt;
@@ -182,6 +275,12 @@ Opt<CRef<Class>> Content::add_class(Class&& cls) {
 }
 
 Opt<CRef<Subclass>> Content::add_subclass(Subclass&& subclass) {
+    std::optional<size_t> detached_index = subclass_library.find_detached(subclass.get_key());
+    if (detached_index.has_value()) {
+        return replace_feature_owner(
+            subclass_library, subclass_feature_library, detached_index.value(), std::move(subclass)
+        );
+    }
     std::optional<size_t> subclass_index = subclass_library.add(std::move(subclass));
     if (!subclass_index.has_value()) {
         return std::nullopt;
@@ -196,6 +295,10 @@ Opt<CRef<Subclass>> Content::add_subclass(Subclass&& subclass) {
 }
 
 Opt<CRef<Species>> Content::add_species(Species&& species) {
+    std::optional<size_t> detached_index = species_library.find_detached(species.get_key());
+    if (detached_index.has_value()) {
+        return replace_feature_owner(species_library, feature_library, detached_index.value(), std::move(species));
+    }
     std::optional<size_t> species_index = species_library.add(std::move(species));
     if (!species_index.has_value()) {
         return std::nullopt;
@@ -210,6 +313,12 @@ Opt<CRef<Species>> Content::add_species(Species&& species) {
 }
 
 Opt<CRef<Subspecies>> Content::add_subspecies(Subspecies&& subspecies) {
+    std::optional<size_t> detached_index = subspecies_library.find_detached(subspecies.get_key());
+    if (detached_index.has_value()) {
+        return replace_feature_owner(
+            subspecies_library, feature_library, detached_index.value(), std::move(subspecies)
+        );
+    }
     std::optional<size_t> subspecies_index = subspecies_library.add(std::move(subspecies));
     if (!subspecies_index.has_value()) {
         return std::nullopt;
@@ -240,6 +349,12 @@ Opt<CRef<Spell>> Content::add_spell(Spell&& spell) {
 }
 
 Opt<CRef<Choosable>> Content::add_choosable(Choosable&& choosable) {
+    std::optional<size_t> detached_index = choosable_library.find_detached(choosable.get_key());
+    if (detached_index.has_value()
+        && choosable_library.get(detached_index.value()).value().get().get_type() != choosable.get_type()) {
+        // the choosable is a member of the group of its type, which cannot change in place
+        return std::nullopt;
+    }
     std::optional<size_t> choosable_index = choosable_library.add(std::move(choosable));
     if (!choosable_index.has_value()) {
         return std::nullopt;
@@ -254,9 +369,24 @@ Opt<CRef<Choosable>> Content::add_choosable(Choosable&& choosable) {
     return inserted_choosable;
 }
 
+Errors Content::recalculate_all_characters(WorkerPool& worker_pool) {
+    DND_MEASURE_FUNCTION();
+    // the characters only read the other content, so each of them can be recalculated by a different worker
+    std::vector<Errors> character_errors(character_library.size());
+    worker_pool.run(character_library.size(), [this, &character_errors](size_t i) {
+        character_errors[i] = character_library.get_mut(i).value().get().recalculate_stats(*this);
+    });
+    Errors errors;
+    for (Errors& error : character_errors) {
+        errors += std::move(error);
+    }
+    return errors;
+}
+
 #define X(C, U, j, a, p, P)                                                                                            \
     Opt<CRef<C>> Content::add_##j##_result(CreateResult<C>&& a) {                                                      \
         if (a.is_valid()) {                                                                                            \
+            DND_MEASURE_COUNTER(#P " created", 1);                                                                     \
             return add_##j(std::move(a.value()));                                                                      \
         } else {                                                                                                       \
             j##_library.add_draft(std::move(a.data_and_errors()));                                                     \
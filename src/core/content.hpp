@@ -3,9 +3,13 @@
 
 #include <dnd_config.hpp>
 
+#include <filesystem>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include <core/data_result.hpp>
+#include <core/errors/errors.hpp>
 #include <core/groups.hpp>
 #include <core/models/character/character.hpp>
 #include <core/models/class/class.hpp>
@@ -21,10 +25,13 @@
 #include <core/referencing_content_library.hpp>
 #include <core/storage_content_library.hpp>
 #include <core/types.hpp>
+#include <core/utils/arena.hpp>
 #include <x/content_pieces.hpp>
 
 namespace dnd {
 
+class WorkerPool;
+
 using EffectsProviderVariant = VarOfCRef<Feature, ClassFeature, Choosable>;
 
 using ContentPieceVariant = VarOfCRef<
@@ -35,6 +42,12 @@ using ContentPieceVariant = VarOfCRef<
  */
 class Content {
 public:
+    Content();
+    Content(const Content&) = delete;
+    Content& operator=(const Content&) = delete;
+    Content(Content&&) noexcept = default;
+    Content& operator=(Content&& other) noexcept;
+
     bool empty() const;
 
     const Groups& get_groups() const;
@@ -68,6 +81,17 @@ public:
 #undef X
 
     std::optional<EffectsProviderVariant> get_effects_provider(const std::string& key) const;
+    /**
+     * @brief Returns the arena that the ArenaPtr objects and the buffers of the models created for this content
+     * allocate from while an ArenaScope for it exists
+     * @return the arena of the content
+     */
+    Arena& get_arena();
+    /**
+     * @brief Keeps another arena alive as long as the content, e.g. the arena a file was parsed into by a worker
+     * @param file_arena the arena that content pieces of this content were allocated from
+     */
+    void adopt_arena(std::unique_ptr<Arena>&& file_arena);
 
     void set_subgroup(const std::string& group_name, const std::string& subgroup_name);
     void set_subgroups(const std::string& group_name, std::set<std::string>&& subgroups);
@@ -80,7 +104,37 @@ public:
 #define X(C, U, j, a, p, P) Opt<CRef<C>> add_##j##_result(CreateResult<C>&& a);
     X_OWNED_CONTENT_PIECES
 #undef X
+
+    /**
+     * @brief Detaches a content piece from its key, so that it is replaced in place by the next content piece with
+     * that key added to the content, which keeps its ID and the references to it valid. The features of a detached
+     * content piece are replaced together with it, so the new content piece needs features with the same keys.
+     * @param id the ID of the content piece, which must not be a feature
+     */
+    void detach(Id id);
+    /**
+     * @brief Returns whether there are detached content pieces that were not replaced
+     * @return true if a content piece is still detached, false otherwise
+     */
+    bool has_detached() const;
+    /**
+     * @brief Removes the drafts of the content pieces from a certain file, e.g. before the file is parsed again
+     * @param source_path the file the drafts were parsed from
+     */
+    void remove_drafts(const std::filesystem::path& source_path);
+
+    /**
+     * @brief Recalculates the stats of all characters in parallel, e.g. after content they depend on changed
+     * @param worker_pool the workers recalculating the characters
+     * @return the errors that occurred while recalculating, in the order of the characters
+     */
+    Errors recalculate_all_characters(WorkerPool& worker_pool);
 private:
+    friend class ContentSerializer;
+
+    // the arenas are declared first so that they are destroyed after all the models holding objects allocated from them
+    std::unique_ptr<Arena> arena;
+    std::vector<std::unique_ptr<Arena>> file_arenas;
     Groups groups;
 
 #define X(C, U, j, a, p, P) StorageContentLibrary<C> j##_library;
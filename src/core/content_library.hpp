@@ -3,7 +3,7 @@
 
 #include <dnd_config.hpp>
 
-#include <string>
+#include <string_view>
 
 #include <core/models/content_piece.hpp>
 #include <core/types.hpp>
@@ -18,11 +18,11 @@ template <typename T>
 requires isContentPieceType<T>
 class ContentLibrary {
 public:
-    virtual bool contains(const std::string& name) const = 0;
+    virtual bool contains(std::string_view key) const = 0;
     virtual bool empty() const = 0;
     virtual size_t size() const = 0;
     virtual Opt<CRef<T>> get(size_t index) const = 0;
-    virtual Opt<CRef<T>> get(const std::string& name) const = 0;
+    virtual Opt<CRef<T>> get(std::string_view key) const = 0;
 };
 
 } // namespace dnd
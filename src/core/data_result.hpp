@@ -7,6 +7,7 @@
 #include <memory>
 
 #include <core/errors/errors.hpp>
+#include <core/utils/arena.hpp>
 
 namespace dnd {
 
@@ -46,11 +47,12 @@ CreateResult<T> InvalidCreate(typename T::Data&& data, Errors&& errors);
 
 // holds a result of an attempt to construct an object from data where the constructed object is polymorphic
 // it either holds the constructed object or the invalid data and the errors that caused it to be invalid
+// the object is allocated in the memory resource of the calling thread, see get_model_resource
 template <typename T>
-using FactoryResult = DataResult<std::unique_ptr<T>, typename T::Data>;
+using FactoryResult = DataResult<ArenaPtr<T>, typename T::Data>;
 
 template <typename T>
-FactoryResult<T> ValidFactory(std::unique_ptr<T>&& output);
+FactoryResult<T> ValidFactory(ArenaPtr<T>&& output);
 
 template <typename T>
 FactoryResult<T> InvalidFactory(typename T::Data&& data, Errors&& errors);
@@ -109,7 +111,7 @@ CreateResult<T> InvalidCreate(typename T::Data&& data, Errors&& errors) {
 }
 
 template <typename T>
-FactoryResult<T> ValidFactory(std::unique_ptr<T>&& output) {
+FactoryResult<T> ValidFactory(ArenaPtr<T>&& output) {
     return FactoryResult<T>::valid(std::move(output));
 }
 
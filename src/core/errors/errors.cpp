@@ -14,7 +14,7 @@
 
 namespace dnd {
 
-Errors::Errors(Error&& error) : errors({std::move(error)}) {}
+Errors::Errors(Error&& error) : errors({std::move(error)}) { DND_MEASURE_COUNTER("Errors", 1); }
 
 bool Errors::ok() const { return errors.empty(); }
 
@@ -23,24 +23,27 @@ const std::vector<Error>& Errors::get_errors() const { return errors; }
 void Errors::add_parsing_error(
     ParsingError::Code error_code, const std::filesystem::path& filepath, std::string&& message
 ) {
-    errors.push_back(ParsingError(error_code, std::move(filepath), std::move(message)));
+    add_error(ParsingError(error_code, std::move(filepath), std::move(message)));
 }
 
-void Errors::add_parsing_error(ParsingError&& error) { errors.push_back(std::move(error)); }
+void Errors::add_parsing_error(ParsingError&& error) { add_error(std::move(error)); }
 
 void Errors::add_validation_error(ValidationError::Code error_code, std::string&& message) {
-    errors.push_back(ValidationError(error_code, std::move(message)));
+    add_error(ValidationError(error_code, std::move(message)));
 }
 
-void Errors::add_validation_error(ValidationError&& error) { errors.push_back(std::move(error)); }
+void Errors::add_validation_error(ValidationError&& error) { add_error(std::move(error)); }
 
 void Errors::add_runtime_error(RuntimeError::Code error_code, std::string&& message) {
-    errors.push_back(RuntimeError(error_code, std::move(message)));
+    add_error(RuntimeError(error_code, std::move(message)));
 }
 
-void Errors::add_runtime_error(RuntimeError&& error) { errors.push_back(std::move(error)); }
+void Errors::add_runtime_error(RuntimeError&& error) { add_error(std::move(error)); }
 
-void Errors::add_error(Error&& error) { errors.push_back(std::move(error)); }
+void Errors::add_error(Error&& error) {
+    DND_MEASURE_COUNTER("Errors", 1);
+    errors.push_back(std::move(error));
+}
 
 Errors& Errors::operator+=(Error&& error) {
     add_error(std::move(error));
@@ -2,7 +2,8 @@
 
 #include "groups.hpp"
 
-#include <iterator>
+#include <memory_resource>
+#include <optional>
 #include <set>
 #include <string>
 #include <unordered_map>
@@ -12,68 +13,101 @@
 
 #include <core/basic_mechanics/abilities.hpp>
 #include <core/basic_mechanics/skills.hpp>
+#include <core/utils/string_interner.hpp>
 #include <core/utils/string_manipulation.hpp>
 
 namespace dnd {
 
+Groups::Groups(std::pmr::memory_resource* resource) : members(resource), subgroups(resource) {}
+
 std::set<std::string> Groups::get_group(const std::string& group_name) const {
-    if (!is_group(group_name)) {
-        return {};
+    std::set<std::string> group_members;
+    std::optional<InternedString> interned_group_name = StringInterner::get().find(group_name);
+    if (interned_group_name.has_value()) {
+        collect_group(interned_group_name.value(), group_members);
     }
-    std::set<std::string> group_members = members.at(group_name);
-    if (!subgroups.contains(group_name)) {
-        return group_members;
+    return group_members;
+}
+
+void Groups::collect_group(InternedString group_name, std::set<std::string>& group_members) const {
+    auto members_it = members.find(group_name);
+    if (members_it == members.end()) {
+        return;
     }
-    for (const std::string& subgroup_name : subgroups.at(group_name)) {
-        std::set<std::string> subgroup_members = get_group(subgroup_name);
-        group_members.insert(
-            std::make_move_iterator(subgroup_members.begin()), std::make_move_iterator(subgroup_members.end())
-        );
+    for (InternedString member : members_it->second) {
+        group_members.insert(member.str());
+    }
+    auto subgroups_it = subgroups.find(group_name);
+    if (subgroups_it == subgroups.end()) {
+        return;
+    }
+    for (InternedString subgroup_name : subgroups_it->second) {
+        collect_group(subgroup_name, group_members);
     }
-    return group_members;
 }
 
 std::vector<std::string> Groups::get_all_group_names() const {
     std::vector<std::string> group_names;
     group_names.reserve(members.size());
     for (const auto& [group_name, _] : members) {
-        group_names.push_back(group_name);
+        group_names.push_back(group_name.str());
     }
     return group_names;
 }
 
-void Groups::add(const std::string& group_name, const std::string& value) { members[group_name].insert(value); }
+void Groups::add(const std::string& group_name, const std::string& value) {
+    members[InternedString(group_name)].emplace(value);
+}
 
 void Groups::add(const std::string& group_name, std::set<std::string>&& values) {
-    members[group_name].insert(std::make_move_iterator(values.begin()), std::make_move_iterator(values.end()));
+    std::pmr::set<InternedString>& group_members = members[InternedString(group_name)];
+    for (const std::string& value : values) {
+        group_members.emplace(value);
+    }
 }
 
 void Groups::set_subgroup(const std::string& group_name, const std::string& subgroup_name) {
-    subgroups[group_name].insert(subgroup_name);
-    members[group_name];
-    members[subgroup_name];
+    InternedString interned_group_name(group_name);
+    InternedString interned_subgroup_name(subgroup_name);
+    subgroups[interned_group_name].insert(interned_subgroup_name);
+    members[interned_group_name];
+    members[interned_subgroup_name];
 }
 
 void Groups::set_subgroups(const std::string& group_name, std::set<std::string>&& subgroup_names) {
-    subgroups[group_name].insert(
-        std::make_move_iterator(subgroup_names.begin()), std::make_move_iterator(subgroup_names.end())
-    );
-    members[group_name];
+    InternedString interned_group_name(group_name);
+    std::pmr::set<InternedString>& group_subgroups = subgroups[interned_group_name];
+    members[interned_group_name];
     for (const std::string& subgroup_name : subgroup_names) {
-        members[subgroup_name];
+        InternedString interned_subgroup_name(subgroup_name);
+        group_subgroups.insert(interned_subgroup_name);
+        members[interned_subgroup_name];
     }
 }
 
-bool Groups::is_group(const std::string& group_name) const { return members.contains(group_name); }
+bool Groups::is_group(const std::string& group_name) const {
+    std::optional<InternedString> interned_group_name = StringInterner::get().find(group_name);
+    return interned_group_name.has_value() && members.contains(interned_group_name.value());
+}
 
 bool Groups::is_subgroup(const std::string& subgroup_name, const std::string& group_name) const {
-    if (!subgroups.contains(group_name)) {
+    std::optional<InternedString> interned_subgroup_name = StringInterner::get().find(subgroup_name);
+    std::optional<InternedString> interned_group_name = StringInterner::get().find(group_name);
+    if (!interned_subgroup_name.has_value() || !interned_group_name.has_value()) {
+        return false;
+    }
+    return is_subgroup(interned_subgroup_name.value(), interned_group_name.value());
+}
+
+bool Groups::is_subgroup(InternedString subgroup_name, InternedString group_name) const {
+    auto it = subgroups.find(group_name);
+    if (it == subgroups.end()) {
         return false;
     }
-    if (subgroups.at(group_name).contains(subgroup_name)) {
+    if (it->second.contains(subgroup_name)) {
         return true;
     }
-    for (const std::string& subgroup : subgroups.at(group_name)) {
+    for (InternedString subgroup : it->second) {
         if (is_subgroup(subgroup_name, subgroup)) {
             return true;
         }
@@ -82,16 +116,27 @@ bool Groups::is_subgroup(const std::string& subgroup_name, const std::string& gr
 }
 
 bool Groups::is_member_of_group(const std::string& name, const std::string& group_name) const {
-    if (!is_group(group_name)) {
+    std::optional<InternedString> interned_name = StringInterner::get().find(name);
+    std::optional<InternedString> interned_group_name = StringInterner::get().find(group_name);
+    if (!interned_name.has_value() || !interned_group_name.has_value()) {
+        return false;
+    }
+    return is_member_of_group(interned_name.value(), interned_group_name.value());
+}
+
+bool Groups::is_member_of_group(InternedString name, InternedString group_name) const {
+    auto members_it = members.find(group_name);
+    if (members_it == members.end()) {
         return false;
     }
-    if (members.at(group_name).contains(name)) {
+    if (members_it->second.contains(name)) {
         return true;
     }
-    if (!subgroups.contains(group_name)) {
+    auto subgroups_it = subgroups.find(group_name);
+    if (subgroups_it == subgroups.end()) {
         return false;
     }
-    for (const std::string& subgroup_name : subgroups.at(group_name)) {
+    for (InternedString subgroup_name : subgroups_it->second) {
         if (is_member_of_group(name, subgroup_name)) {
             return true;
         }
@@ -3,20 +3,28 @@
 
 #include <dnd_config.hpp>
 
+#include <memory_resource>
 #include <set>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+#include <core/utils/string_interner.hpp>
+
 namespace dnd {
 
 class Groups {
 public:
-    Groups() = default;
+    /**
+     * @brief Creates empty groups whose maps and sets allocate from the given resource
+     * @param resource the memory resource, e.g. the arena of the content, which needs to outlive the groups
+     */
+    explicit Groups(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
     Groups(const Groups&) = delete;
     Groups& operator=(const Groups&) = delete;
     Groups(Groups&&) noexcept = default;
-    Groups& operator=(Groups&&) noexcept = default;
+    // assigning groups with another resource would copy them into the resource of the assigned groups
+    Groups& operator=(Groups&&) = delete;
 
     std::set<std::string> get_group(const std::string& group_name) const;
     std::vector<std::string> get_all_group_names() const;
@@ -32,10 +40,17 @@ public:
     // returns a string describing the amounts of groups parsed
     std::string status() const;
 private:
+    friend class ContentSerializer;
+
+    void collect_group(InternedString group_name, std::set<std::string>& group_members) const;
+    bool is_subgroup(InternedString subgroup_name, InternedString group_name) const;
+    bool is_member_of_group(InternedString name, InternedString group_name) const;
+
+    // the group names and members are interned, so that the lookups only hash and compare pointers
     // a map containing all the direct members of a group
-    std::unordered_map<std::string, std::set<std::string>> members;
+    std::pmr::unordered_map<InternedString, std::pmr::set<InternedString>> members;
     // a map containing all the subgroups of a group
-    std::unordered_map<std::string, std::set<std::string>> subgroups;
+    std::pmr::unordered_map<InternedString, std::pmr::set<InternedString>> subgroups;
 };
 
 } // namespace dnd
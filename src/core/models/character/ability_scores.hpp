@@ -32,6 +32,8 @@ public:
     int get_wisdom_modifier() const;
     int get_charisma_modifier() const;
 private:
+    friend class ContentSerializer;
+
     AbilityScores(int strength, int dexterity, int constitution, int intelligence, int wisdom, int charisma);
 
     int strength;
@@ -2,15 +2,19 @@
 
 #include "character.hpp"
 
+#include <algorithm>
 #include <cassert>
+#include <cstddef>
 #include <expected>
 #include <filesystem>
+#include <optional>
 #include <string>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
 #include <core/attribute_names.hpp>
+#include <core/basic_mechanics/abilities.hpp>
 #include <core/basic_mechanics/character_progression.hpp>
 #include <core/basic_mechanics/skills.hpp>
 #include <core/content.hpp>
@@ -21,9 +25,12 @@
 #include <core/models/character/ability_scores.hpp>
 #include <core/models/character/feature_providers.hpp>
 #include <core/models/character/progression.hpp>
+#include <core/models/character/stat_attribute.hpp>
+#include <core/models/character/stat_program.hpp>
+#include <core/models/character/stat_table.hpp>
 #include <core/models/character/stats.hpp>
 #include <core/models/class/class.hpp>
-#include <core/models/effects/stat_change/identifier_stat_change.hpp>
+#include <core/models/effects/effects.hpp>
 #include <core/models/effects/stat_change/stat_change.hpp>
 #include <core/models/effects_provider/choosable.hpp>
 #include <core/models/effects_provider/feature.hpp>
@@ -31,8 +38,9 @@
 #include <core/models/species/species.hpp>
 #include <core/models/subclass/subclass.hpp>
 #include <core/models/subspecies/subspecies.hpp>
-#include <core/text/text.hpp>
+#include <core/text/formatted_text.hpp>
 #include <core/types.hpp>
+#include <core/utils/arena.hpp>
 #include <core/validation/character/character_validation.hpp>
 #include <core/visitors/content/content_visitor.hpp>
 
@@ -117,7 +125,7 @@ CreateResult<Character> Character::create_for(Data&& data, const Content& conten
 
 const std::string& Character::get_name() const { return name; }
 
-const Text& Character::get_description() const { return description; }
+const FormattedText& Character::get_description() const { return description; }
 
 const SourceInfo& Character::get_source_info() const { return source_info; }
 
@@ -135,102 +143,234 @@ const Progression& Character::get_progression() const { return progression; }
 
 const Stats& Character::get_stats() const { return stats; }
 
-void Character::for_all_effects_do(const Content& content, std::function<void(const Effects&)> func) const {
+const std::vector<const Effects*>& Character::get_active_effects() const { return active_effects; }
+
+/**
+ * @brief Compiles the stat changes of the given effects and the stat changes implied by their proficiencies
+ * @param effects_list the effects in the order in which their stat changes are applied
+ * @return the stat program
+ */
+static StatProgram compile_stat_program(const std::vector<const Effects*>& effects_list) {
+    std::vector<StatChangeInstruction> program;
+
+    std::unordered_set<std::string> proficient_skills;
+    std::unordered_set<std::string> proficient_saves;
+
+    for (const Effects* effects : effects_list) {
+        for (const ArenaPtr<StatChange>& change : effects->get_stat_changes()) {
+            program.push_back(change->get_instruction());
+        }
+        const std::vector<std::string>& saves = effects->get_proficiencies().get_saving_throw_proficiencies();
+        proficient_saves.insert(saves.begin(), saves.end());
+        const std::vector<std::string>& skills = effects->get_proficiencies().get_skill_proficiencies();
+        proficient_skills.insert(skills.begin(), skills.end());
+    }
+
+    // being proficient adds the proficiency bonus to the saving throw or skill modifier
+    const StatAttribute proficiency_bonus(StatSlot::PROFICIENCY_BONUS);
+    program.reserve(program.size() + proficient_saves.size() + proficient_skills.size());
+    for (const std::string& save_ability : proficient_saves) {
+        program.push_back(StatChangeInstruction{
+            .affected_attribute = StatAttribute(attributes::ability_saving_throw(save_ability)),
+            .operation = StatChangeOperation::ADD,
+            .value_attribute = proficiency_bonus,
+            .literal_value = 0,
+        });
+    }
+    for (const std::string& skill_name : proficient_skills) {
+        std::optional<Skill> skill_opt = skill_from_config_name(skill_name);
+        if (!skill_opt.has_value()) {
+            continue;
+        }
+        program.push_back(StatChangeInstruction{
+            .affected_attribute = StatAttribute(skill_slot(skill_opt.value())),
+            .operation = StatChangeOperation::ADD,
+            .value_attribute = proficiency_bonus,
+            .literal_value = 0,
+        });
+    }
+
+    return StatProgram(std::move(program));
+}
+
+Errors Character::recalculate_stats(const Content& content) {
+    collect_effects(content);
+    return recalculate_active_stats(content);
+}
+
+std::expected<StatTable, Errors> Character::calculate_stat_table(const Content& content) const {
+    // the effects of higher levels are added to the program when reaching them
+    const Class& cls = content.get_class(feature_providers.get_class_id());
+    std::vector<Stats> level_stats;
+    level_stats.reserve(StatTable::level_count);
+    StatProgram level_program;
+    StatInputs level_inputs;
+    for (int level = StatTable::min_level; level <= StatTable::max_level; ++level) {
+        StatInputs new_level_inputs = create_stat_inputs(cls, level);
+        const bool has_new_effects = level == StatTable::min_level
+                                     || std::any_of(
+                                         leveled_effects.begin(), leveled_effects.end(),
+                                         [level](const LeveledEffects& leveled) { return leveled.level == level; }
+                                     );
+        if (has_new_effects) {
+            std::vector<const Effects*> level_effects;
+            for (const LeveledEffects& leveled : leveled_effects) {
+                if (leveled.level <= level) {
+                    level_effects.push_back(leveled.effects);
+                }
+            }
+            level_program = compile_stat_program(level_effects);
+            std::expected<Stats, Errors> result = level_program.evaluate(new_level_inputs);
+            if (!result.has_value()) {
+                return std::unexpected(std::move(result.error()));
+            }
+            level_stats.push_back(std::move(result.value()));
+        } else {
+            // without new effects only the proficiency bonus and the hit dice change
+            Stats stats_for_level = level_stats.back();
+            Errors errors = level_program.update(stats_for_level, level_inputs, new_level_inputs);
+            if (!errors.ok()) {
+                return std::unexpected(std::move(errors));
+            }
+            level_stats.push_back(std::move(stats_for_level));
+        }
+        level_inputs = std::move(new_level_inputs);
+    }
+    return StatTable::create(level_stats);
+}
+
+Errors Character::set_base_ability_scores(AbilityScores&& new_base_ability_scores) {
+    StatInputs new_stat_inputs = stat_inputs;
+    for (Ability ability : abilities_inorder) {
+        new_stat_inputs.ability_scores[static_cast<size_t>(ability)] = new_base_ability_scores.get(ability);
+    }
+    Errors errors = update_stats(std::move(new_stat_inputs));
+    if (errors.ok()) {
+        base_ability_scores = std::move(new_base_ability_scores);
+    }
+    return errors;
+}
+
+Errors Character::set_progression(Progression&& new_progression, const Content& content) {
+    if (new_progression.get_level() == progression.get_level()) {
+        // the same features apply, so only the values depending on the hit dice rolls change
+        StatInputs new_stat_inputs = stat_inputs;
+        new_stat_inputs.hit_dice_rolls = new_progression.get_hit_dice_rolls();
+        Errors errors = update_stats(std::move(new_stat_inputs));
+        if (errors.ok()) {
+            progression = std::move(new_progression);
+        }
+        return errors;
+    }
+
+    // the effects of the other level are already collected and only have to be selected
+    Progression old_progression = std::exchange(progression, std::move(new_progression));
+    Errors errors = recalculate_active_stats(content);
+    if (!errors.ok()) {
+        progression = std::move(old_progression);
+        select_active_effects();
+    }
+    return errors;
+}
+
+void Character::collect_effects(const Content& content) {
+    leveled_effects.clear();
+    // effects that do not belong to a higher level apply from the first level on
     const Species& species = content.get_species(feature_providers.get_species_id());
     for (const Feature& feature : species.get_features()) {
-        func(feature.get_main_effects());
+        leveled_effects.push_back({.level = 1, .effects = &feature.get_main_effects()});
     }
     if (feature_providers.has_subspecies()) {
         const Subspecies& subspecies = content.get_subspecies(feature_providers.get_subspecies_id().value());
         for (const Feature& feature : subspecies.get_features()) {
-            func(feature.get_main_effects());
+            leveled_effects.push_back({.level = 1, .effects = &feature.get_main_effects()});
         }
     }
     const Class& cls = content.get_class(feature_providers.get_class_id());
     for (const ClassFeature& feature : cls.get_features()) {
-        func(feature.get_main_effects());
+        leveled_effects.push_back({.level = 1, .effects = &feature.get_main_effects()});
         for (const auto& [level, effects] : feature.get_higher_level_effects()) {
-            if (level > progression.get_level()) {
-                break;
-            }
-            func(effects);
+            leveled_effects.push_back({.level = level, .effects = &effects});
         }
     }
     if (feature_providers.has_subclass()) {
         const Subclass& subclass = content.get_subclass(feature_providers.get_subclass_id().value());
         for (const SubclassFeature& feature : subclass.get_features()) {
-            func(feature.get_main_effects());
+            leveled_effects.push_back({.level = 1, .effects = &feature.get_main_effects()});
             for (const auto& [level, effects] : feature.get_higher_level_effects()) {
-                if (level > progression.get_level()) {
-                    break;
-                }
-                func(effects);
+                leveled_effects.push_back({.level = level, .effects = &effects});
             }
         }
     }
     for (const Feature& feature : features) {
-        func(feature.get_main_effects());
+        leveled_effects.push_back({.level = 1, .effects = &feature.get_main_effects()});
     }
     for (const Choosable& choosable : choosables) {
-        func(choosable.get_main_effects());
+        leveled_effects.push_back({.level = 1, .effects = &choosable.get_main_effects()});
     }
+    select_active_effects();
 }
 
-Errors Character::recalculate_stats(const Content& content) {
-    std::vector<CRef<StatChange>> stat_changes;
-
-    std::unordered_set<std::string> proficient_skills;
-    std::unordered_set<std::string> proficient_saves;
-
-    for_all_effects_do(content, [&stat_changes, &proficient_saves, &proficient_skills](const Effects& effects) {
-        for (const std::unique_ptr<StatChange>& change : effects.get_stat_changes()) {
-            stat_changes.push_back(*change);
+void Character::select_active_effects() {
+    const int level = progression.get_level();
+    active_effects.clear();
+    for (const LeveledEffects& leveled : leveled_effects) {
+        if (leveled.level <= level) {
+            active_effects.push_back(leveled.effects);
         }
-        const std::vector<std::string>& saves = effects.get_proficiencies().get_saving_throw_proficiencies();
-        proficient_saves.insert(saves.begin(), saves.end());
-        const std::vector<std::string>& skills = effects.get_proficiencies().get_skill_proficiencies();
-        proficient_skills.insert(skills.begin(), skills.end());
-    });
-
-    std::vector<IdentifierStatChange> implicit_stat_changes;
-    implicit_stat_changes.reserve(proficient_saves.size() + proficient_skills.size());
-    for (const std::string& save_ability : proficient_saves) {
-        implicit_stat_changes.emplace_back(
-            attributes::ability_saving_throw(save_ability), StatChangeTime::NORMAL, StatChangeOperation::ADD,
-            attributes::PROFICIENCY_BONUS
-        );
     }
-    for (const std::string& skill_name : proficient_skills) {
-        std::optional<Skill> skill_opt = skill_from_config_name(skill_name);
-        if (!skill_opt.has_value()) {
-            continue;
-        }
-        Skill skill = skill_opt.value();
-        std::optional<SkillInfo> skill_info_opt = get_skill_info(skill);
-        if (!skill_info_opt.has_value()) {
-            continue;
-        }
-        const SkillInfo& skill_info = skill_info_opt.value();
-        implicit_stat_changes.emplace_back(
-            std::string_view(skill_info.stat_name), StatChangeTime::NORMAL, StatChangeOperation::ADD,
-            attributes::PROFICIENCY_BONUS
-        );
-    }
-    stat_changes.insert(stat_changes.end(), implicit_stat_changes.begin(), implicit_stat_changes.end());
-
-    const Class& cls = content.get_class(feature_providers.get_class_id());
+}
 
-    std::expected<Stats, Errors> result = Stats::create(
-        base_ability_scores, get_proficiency_bonus(), stat_changes, cls.get_hit_dice(), progression.get_hit_dice_rolls()
+Errors Character::recalculate_active_stats(const Content& content) {
+    select_active_effects();
+    StatProgram new_stat_program = compile_stat_program(active_effects);
+    StatInputs new_stat_inputs = create_stat_inputs(
+        content.get_class(feature_providers.get_class_id()), progression.get_level()
     );
+    std::expected<Stats, Errors> result = new_stat_program.evaluate(new_stat_inputs);
     if (!result.has_value()) {
         return result.error();
     }
-    stats = result.value();
+    stats = std::move(result.value());
+    stat_program = std::move(new_stat_program);
+    stat_inputs = std::move(new_stat_inputs);
 
     return Errors();
 }
 
+StatInputs Character::create_stat_inputs(const Class& cls, int level) const {
+    std::expected<int, RuntimeError> proficiency_bonus_result = proficiency_bonus_for_level(level);
+    assert(proficiency_bonus_result.has_value());
+    const Dice& hit_dice = cls.get_hit_dice();
+    StatInputs inputs{
+        .ability_scores = {},
+        .proficiency_bonus = proficiency_bonus_result.value(),
+        .hit_dice_maximum = hit_dice.max_value(),
+        .hit_dice_rolls = progression.get_hit_dice_rolls(),
+    };
+    for (Ability ability : abilities_inorder) {
+        inputs.ability_scores[static_cast<size_t>(ability)] = base_ability_scores.get(ability);
+    }
+    // there is a roll for every level, levels that were not rolled yet use the average rounded up
+    const size_t roll_count = static_cast<size_t>(level);
+    if (inputs.hit_dice_rolls.size() > roll_count) {
+        inputs.hit_dice_rolls.resize(roll_count);
+    }
+    const int fixed_hit_dice_value = (hit_dice.min_value() + hit_dice.max_value() + 1) / 2;
+    inputs.hit_dice_rolls.resize(roll_count, fixed_hit_dice_value);
+    return inputs;
+}
+
+Errors Character::update_stats(StatInputs&& new_stat_inputs) {
+    Stats updated_stats = stats;
+    Errors errors = stat_program.update(updated_stats, stat_inputs, new_stat_inputs);
+    if (errors.ok()) {
+        stats = std::move(updated_stats);
+        stat_inputs = std::move(new_stat_inputs);
+    }
+    return errors;
+}
+
 int Character::get_proficiency_bonus() const {
     std::expected<int, RuntimeError> proficiency_bonus_result = proficiency_bonus_for_level(progression.get_level());
     assert(proficiency_bonus_result.has_value());
@@ -238,15 +378,16 @@ int Character::get_proficiency_bonus() const {
 }
 
 Character::Character(
-    std::string&& name, Text&& description, std::filesystem::path&& source_path, std::string&& source_name,
+    std::string&& name, FormattedText&& description, std::filesystem::path&& source_path, std::string&& source_name,
     std::string&& key, std::vector<Feature>&& features, std::vector<CRef<Choosable>>&& choosables,
     AbilityScores&& base_ability_scores, FeatureProviders&& feature_providers, Progression&& progression,
     std::vector<Decision>&& decisions
 )
     : name(std::move(name)), description(std::move(description)),
-      source_info({.path = std::move(source_path), .name = std::move(source_name)}), key(std::move(key)),
+      source_info({.path = std::move(source_path), .name = InternedString(source_name)}), key(std::move(key)),
       features(std::move(features)), choosables(std::move(choosables)),
       base_ability_scores(std::move(base_ability_scores)), feature_providers(std::move(feature_providers)),
-      progression(std::move(progression)), stats(Stats::create_default()), decisions(std::move(decisions)) {}
+      progression(std::move(progression)), stats(Stats::create_default()), leveled_effects(), active_effects(),
+      stat_program(), stat_inputs(), decisions(std::move(decisions)) {}
 
 } // namespace dnd
@@ -4,6 +4,7 @@
 #include <dnd_config.hpp>
 
 #include <compare>
+#include <expected>
 #include <filesystem>
 #include <string>
 #include <vector>
@@ -12,15 +13,20 @@
 #include <core/models/character/decision.hpp>
 #include <core/models/character/feature_providers.hpp>
 #include <core/models/character/progression.hpp>
+#include <core/models/character/stat_program.hpp>
+#include <core/models/character/stat_table.hpp>
+#include <core/models/character/stats.hpp>
 #include <core/models/class/class.hpp>
 #include <core/models/content_piece.hpp>
+#include <core/models/effects/effects.hpp>
 #include <core/models/effects_provider/choosable.hpp>
 #include <core/models/effects_provider/feature.hpp>
 #include <core/models/source_info.hpp>
 #include <core/models/species/species.hpp>
 #include <core/models/subclass/subclass.hpp>
 #include <core/models/subspecies/subspecies.hpp>
-#include <core/text/text.hpp>
+#include <core/text/formatted_text.hpp>
+#include <core/utils/string_interner.hpp>
 #include <core/validation/validation_data.hpp>
 
 namespace dnd {
@@ -41,7 +47,7 @@ public:
     Character& operator=(Character&&) noexcept = default;
 
     const std::string& get_name() const override;
-    const Text& get_description() const override;
+    const FormattedText& get_description() const override;
     const SourceInfo& get_source_info() const override;
     const std::string& get_key() const override;
     const std::vector<Feature>& get_features() const;
@@ -53,18 +59,61 @@ public:
 
     int get_proficiency_bonus() const;
 
-    void for_all_effects_do(const Content& content, std::function<void(const Effects&)> func) const;
+    /**
+     * @brief Returns the effects that apply at the current level, in the order in which their stat changes are applied
+     * @return the effects of the species, class, their features, and the character's own features and choosables
+     */
+    const std::vector<const Effects*>& get_active_effects() const;
+    /**
+     * @brief Collects the effects again and recalculates the stats, e.g. after the content they come from changed
+     * @param content the content the character belongs to
+     * @return the errors that occurred while recalculating, the stats are unchanged if there are any
+     */
     Errors recalculate_stats(const Content& content);
+    /**
+     * @brief Changes the base ability scores, only the stats that depend on them are recalculated
+     * @param new_base_ability_scores the new base ability scores
+     * @return the errors that occurred while recalculating, the character is unchanged if there are any
+     */
+    Errors set_base_ability_scores(AbilityScores&& new_base_ability_scores);
+    /**
+     * @brief Changes the progression, the stats are only recalculated completely if the level changes
+     * @param new_progression the new progression
+     * @param content the content the character belongs to
+     * @return the errors that occurred while recalculating, the character is unchanged if there are any
+     */
+    Errors set_progression(Progression&& new_progression, const Content& content);
+    /**
+     * @brief Calculates the stats the character would have at every level from 1 to 20, the levels above the current
+     * one use the fixed value of the hit dice instead of rolls
+     * @param content the content the character belongs to
+     * @return the stats of every level, or the errors that occurred while calculating them
+     */
+    std::expected<StatTable, Errors> calculate_stat_table(const Content& content) const;
 private:
+    friend class ContentSerializer;
+
     Character(
-        std::string&& name, Text&& description, std::filesystem::path&& source_path, std::string&& source_name,
+        std::string&& name, FormattedText&& description, std::filesystem::path&& source_path, std::string&& source_name,
         std::string&& key, std::vector<Feature>&& features, std::vector<CRef<Choosable>>&& choosables,
         AbilityScores&& base_ability_scores, FeatureProviders&& feature_providers, Progression&& progression,
         std::vector<Decision>&& decisions
     );
 
-    std::string name;
-    Text description;
+    struct LeveledEffects {
+        // the class level from which on the effects apply
+        int level;
+        const Effects* effects;
+    };
+
+    void collect_effects(const Content& content);
+    void select_active_effects();
+    Errors recalculate_active_stats(const Content& content);
+    StatInputs create_stat_inputs(const Class& cls, int level) const;
+    Errors update_stats(StatInputs&& new_stat_inputs);
+
+    InternedString name;
+    FormattedText description;
     SourceInfo source_info;
     std::string key;
     std::vector<Feature> features;
@@ -73,6 +122,13 @@ private:
     FeatureProviders feature_providers;
     Progression progression;
     Stats stats;
+    // the effects of all levels and the ones of the current level, collected whenever the feature providers or the
+    // content change, so that the level can change without looking the effects up again
+    std::vector<LeveledEffects> leveled_effects;
+    std::vector<const Effects*> active_effects;
+    // the compiled stat changes and the inputs the current stats were calculated from
+    StatProgram stat_program;
+    StatInputs stat_inputs;
     std::vector<Decision> decisions;
 };
 
@@ -0,0 +1,97 @@
+#include <dnd_config.hpp>
+
+#include "character_batch.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <core/content.hpp>
+#include <core/data_result.hpp>
+#include <core/models/character/character.hpp>
+#include <core/models/character/decision.hpp>
+#include <core/models/effects_provider/feature.hpp>
+#include <core/utils/arena.hpp>
+#include <core/utils/worker_pool.hpp>
+
+namespace dnd {
+
+void CharacterBatch::add(Character::Data&& character_data) { characters_data.push_back(std::move(character_data)); }
+
+/**
+ * @brief Finds the characters whose validation depends on other characters of the batch, because another character
+ * has the same key or a feature with the same key, or has a feature that one of their decisions refers to
+ * @param characters_data the characters of the batch
+ * @return for every character, whether it depends on the others
+ */
+static std::vector<bool> find_dependent_characters(const std::vector<Character::Data>& characters_data) {
+    static constexpr size_t several_characters = static_cast<size_t>(-1);
+    // the character using each key, or several_characters if more than one does
+    std::unordered_map<std::string, size_t> key_users;
+    auto use_key = [&key_users](std::string&& key, size_t character_index) {
+        auto [it, inserted] = key_users.try_emplace(std::move(key), character_index);
+        if (!inserted && it->second != character_index) {
+            it->second = several_characters;
+        }
+    };
+    for (size_t i = 0; i < characters_data.size(); ++i) {
+        use_key(characters_data[i].get_key(), i);
+        for (const Feature::Data& feature_data : characters_data[i].features_data) {
+            use_key(feature_data.get_key(), i);
+        }
+    }
+
+    std::vector<bool> dependent(characters_data.size(), false);
+    for (size_t i = 0; i < characters_data.size(); ++i) {
+        const Character::Data& character_data = characters_data[i];
+        dependent[i] = key_users[character_data.get_key()] != i;
+        for (const Feature::Data& feature_data : character_data.features_data) {
+            dependent[i] = dependent[i] || key_users[feature_data.get_key()] != i;
+        }
+        for (const Decision::Data& decision_data : character_data.decisions_data) {
+            auto it = key_users.find(decision_data.feature_name);
+            dependent[i] = dependent[i] || (it != key_users.end() && it->second != i);
+        }
+    }
+    return dependent;
+}
+
+void CharacterBatch::create_all_for(Content& content, WorkerPool& worker_pool) {
+    DND_MEASURE_FUNCTION();
+    std::stable_sort(
+        characters_data.begin(), characters_data.end(),
+        [](const Character::Data& a, const Character::Data& b) { return a.get_key() < b.get_key(); }
+    );
+
+    // Only characters that do not depend on the rest of the batch are created in parallel, the objects of their models
+    // are allocated from the heap because the arena of the content is not thread-safe. The others are created when it
+    // is their turn.
+    const std::vector<bool> dependent = find_dependent_characters(characters_data);
+    std::vector<size_t> independent_indices;
+    for (size_t i = 0; i < characters_data.size(); ++i) {
+        if (!dependent[i]) {
+            independent_indices.push_back(i);
+        }
+    }
+    std::vector<std::optional<CreateResult<Character>>> results(characters_data.size());
+    const Content& const_content = content;
+    worker_pool.run(independent_indices.size(), [this, &results, &independent_indices, &const_content](size_t i) {
+        const size_t index = independent_indices[i];
+        results[index].emplace(Character::create_for(std::move(characters_data[index]), const_content));
+    });
+
+    ArenaScope arena_scope(content.get_arena());
+    for (size_t i = 0; i < characters_data.size(); ++i) {
+        if (!results[i].has_value()) {
+            results[i].emplace(Character::create_for(std::move(characters_data[i]), content));
+        }
+        content.add_character_result(std::move(results[i].value()));
+    }
+    characters_data.clear();
+}
+
+} // namespace dnd
@@ -0,0 +1,41 @@
+#ifndef CHARACTER_BATCH_HPP_
+#define CHARACTER_BATCH_HPP_
+
+#include <dnd_config.hpp>
+
+#include <vector>
+
+#include <core/models/character/character.hpp>
+
+namespace dnd {
+
+class Content;
+class WorkerPool;
+
+/**
+ * @brief Characters whose creation is deferred until the content they depend on is complete, so that they can be
+ * created in parallel and added to the content in the order of their keys
+ */
+class CharacterBatch {
+public:
+    void add(Character::Data&& character_data);
+    bool empty() const noexcept;
+    /**
+     * @brief Creates all characters of the batch and adds them to the content in the order of their keys, the result
+     * is the same as creating and adding them one by one in that order
+     * @param content the content to add the characters to
+     * @param worker_pool the workers creating the characters
+     */
+    void create_all_for(Content& content, WorkerPool& worker_pool);
+private:
+    std::vector<Character::Data> characters_data;
+};
+
+
+// === IMPLEMENTATION ===
+
+inline bool CharacterBatch::empty() const noexcept { return characters_data.empty(); }
+
+} // namespace dnd
+
+#endif // CHARACTER_BATCH_HPP_
@@ -2,7 +2,6 @@
 
 #include "decision.hpp"
 
-#include <cassert>
 #include <set>
 #include <string>
 #include <utility>
@@ -62,14 +61,11 @@ CreateResult<Decision> Decision::create_for(Data&& data, const Content& content)
         return InvalidCreate<Decision>(std::move(data), std::move(sub_errors));
     }
 
-    assert(data.get_target() != nullptr);
-    return ValidCreate(Decision(*data.get_target(), std::move(effects_result.value())));
+    return ValidCreate(Decision(std::move(effects_result.value())));
 }
 
-CRef<Effects> Decision::get_target() const { return target; }
-
 const Effects& Decision::get_effects() const { return effects; }
 
-Decision::Decision(CRef<Effects> target, Effects&& effects) : target(target), effects(std::move(effects)) {}
+Decision::Decision(Effects&& effects) : effects(std::move(effects)) {}
 
 } // namespace dnd
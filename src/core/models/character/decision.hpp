@@ -25,16 +25,14 @@ public:
     Decision(Decision&&) noexcept = default;
     Decision& operator=(Decision&&) noexcept = default;
 
-    /**
-     * @brief Returns the target of the decision i.e. the effects with the choice that the decision is for
-     * @return the target of the decision
-     */
-    CRef<Effects> get_target() const;
     const Effects& get_effects() const;
 private:
-    Decision(CRef<Effects> target, Effects&& effects);
+    friend class ContentSerializer;
 
-    CRef<Effects> target;
+    explicit Decision(Effects&& effects);
+
+    // the target of the decision is only needed to validate it, the content piece holding the target might be replaced
+    // in place later, which keeps the IDs of the content valid but not references into the content piece
     Effects effects;
 };
 
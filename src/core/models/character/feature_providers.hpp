@@ -31,6 +31,8 @@ public:
     bool has_subspecies() const;
     bool has_subclass() const;
 private:
+    friend class ContentSerializer;
+
     FeatureProviders(Id species_id, Opt<Id> subspecies_id, Id class_id, Opt<Id> subclass_id);
 
     Id species_id;
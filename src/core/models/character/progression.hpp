@@ -22,6 +22,8 @@ public:
     int get_xp() const;
     const std::vector<int>& get_hit_dice_rolls() const;
 private:
+    friend class ContentSerializer;
+
     Progression(int level, int xp, std::vector<int>&& hit_dice_rolls);
 
     int level;
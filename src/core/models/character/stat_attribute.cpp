@@ -0,0 +1,72 @@
+#include <dnd_config.hpp>
+
+#include "stat_attribute.hpp"
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+
+#include <core/attribute_names.hpp>
+#include <core/basic_mechanics/abilities.hpp>
+#include <core/basic_mechanics/skills.hpp>
+#include <core/utils/string_interner.hpp>
+
+namespace dnd {
+
+static const std::array<InternedString, stat_slot_count>& get_slot_names() {
+    static const std::array<InternedString, stat_slot_count> slot_names = []() {
+        std::array<InternedString, stat_slot_count> names;
+        names[static_cast<size_t>(StatSlot::PROFICIENCY_BONUS)] = InternedString(attributes::PROFICIENCY_BONUS);
+        names[static_cast<size_t>(StatSlot::MAXIMUM_HP)] = InternedString(attributes::MAXIMUM_HP);
+        names[static_cast<size_t>(StatSlot::ARMOR_CLASS)] = InternedString(attributes::ARMOR_CLASS);
+        names[static_cast<size_t>(StatSlot::SPEED)] = InternedString(attributes::SPEED);
+        names[static_cast<size_t>(StatSlot::INITIATIVE)] = InternedString(attributes::INITIATIVE);
+        for (Ability ability : abilities_inorder) {
+            const char* ability_name = ability_cstr_name(ability);
+            names[static_cast<size_t>(ability_slot(ability))] = InternedString(ability_name);
+            names[static_cast<size_t>(ability_maximum_slot(ability))] = InternedString(
+                attributes::ability_maximum(ability_name)
+            );
+            names[static_cast<size_t>(ability_modifier_slot(ability))] = InternedString(
+                attributes::ability_modifier(ability_name)
+            );
+            names[static_cast<size_t>(ability_save_slot(ability))] = InternedString(
+                attributes::ability_saving_throw(ability_name)
+            );
+        }
+        for (const SkillInfo& skill_info : get_all_skill_infos()) {
+            names[static_cast<size_t>(skill_slot(skill_info.skill))] = InternedString(skill_info.stat_name);
+        }
+        return names;
+    }();
+    return slot_names;
+}
+
+std::optional<StatSlot> stat_slot_from_name(std::string_view name) {
+    static const std::unordered_map<std::string_view, StatSlot> slots_by_name = []() {
+        std::unordered_map<std::string_view, StatSlot> slots;
+        const std::array<InternedString, stat_slot_count>& slot_names = get_slot_names();
+        for (size_t i = 0; i < stat_slot_count; ++i) {
+            slots.emplace(slot_names[i].str(), static_cast<StatSlot>(i));
+        }
+        return slots;
+    }();
+    auto it = slots_by_name.find(name);
+    if (it == slots_by_name.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+const InternedString& stat_slot_name(StatSlot slot) { return get_slot_names()[static_cast<size_t>(slot)]; }
+
+StatAttribute::StatAttribute(std::string_view name) : name(), slot(stat_slot_from_name(name)) {
+    // built-in attributes share the names of their slots, so only the names of custom attributes are interned
+    this->name = slot.has_value() ? stat_slot_name(slot.value()) : InternedString(name);
+}
+
+StatAttribute::StatAttribute(StatSlot slot) : name(stat_slot_name(slot)), slot(slot) {}
+
+} // namespace dnd
@@ -0,0 +1,113 @@
+#ifndef STAT_ATTRIBUTE_HPP_
+#define STAT_ATTRIBUTE_HPP_
+
+#include <dnd_config.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <core/basic_mechanics/abilities.hpp>
+#include <core/basic_mechanics/skills.hpp>
+#include <core/utils/string_interner.hpp>
+
+namespace dnd {
+
+/**
+ * @brief The index of a built-in attribute in the flat value array of the Stats
+ */
+enum class StatSlot : uint8_t {
+    PROFICIENCY_BONUS,
+    MAXIMUM_HP,
+    ARMOR_CLASS,
+    SPEED,
+    INITIATIVE,
+    // the ability scores, maxima, modifiers, and saving throws in the order of the Ability enum
+    FIRST_ABILITY,
+    FIRST_ABILITY_MAXIMUM = FIRST_ABILITY + 6,
+    FIRST_ABILITY_MODIFIER = FIRST_ABILITY_MAXIMUM + 6,
+    FIRST_ABILITY_SAVE = FIRST_ABILITY_MODIFIER + 6,
+    // the skill modifiers in the order of the Skill enum
+    FIRST_SKILL = FIRST_ABILITY_SAVE + 6,
+};
+
+inline constexpr size_t stat_slot_count = static_cast<size_t>(StatSlot::FIRST_SKILL) + 18;
+
+/**
+ * @brief Returns the slot of a built-in attribute
+ * @param name the attribute name e.g. "AC" or "dex_MOD"
+ * @return the slot, or std::nullopt if the attribute is not a built-in one
+ */
+std::optional<StatSlot> stat_slot_from_name(std::string_view name);
+const InternedString& stat_slot_name(StatSlot slot);
+
+constexpr StatSlot ability_slot(Ability ability);
+constexpr StatSlot ability_maximum_slot(Ability ability);
+constexpr StatSlot ability_modifier_slot(Ability ability);
+constexpr StatSlot ability_save_slot(Ability ability);
+constexpr StatSlot skill_slot(Skill skill);
+constexpr bool is_ability_slot(StatSlot slot);
+
+/**
+ * @brief An attribute name that is resolved to its slot once, so that the stats can be accessed without hashing it.
+ *
+ * Attributes that are not built-in e.g. custom values of features keep their interned name as the key instead.
+ */
+class StatAttribute {
+public:
+    explicit StatAttribute(std::string_view name);
+    explicit StatAttribute(StatSlot slot);
+
+    const InternedString& get_name() const noexcept;
+    bool is_custom() const noexcept;
+    /**
+     * @brief Returns the slot of a built-in attribute, only valid if the attribute is not custom
+     */
+    StatSlot get_slot() const noexcept;
+
+    bool operator==(const StatAttribute& other) const noexcept;
+private:
+    InternedString name;
+    std::optional<StatSlot> slot;
+};
+
+
+// === IMPLEMENTATION ===
+
+constexpr StatSlot ability_slot(Ability ability) {
+    return static_cast<StatSlot>(static_cast<size_t>(StatSlot::FIRST_ABILITY) + static_cast<size_t>(ability));
+}
+
+constexpr StatSlot ability_maximum_slot(Ability ability) {
+    return static_cast<StatSlot>(static_cast<size_t>(StatSlot::FIRST_ABILITY_MAXIMUM) + static_cast<size_t>(ability));
+}
+
+constexpr StatSlot ability_modifier_slot(Ability ability) {
+    return static_cast<StatSlot>(static_cast<size_t>(StatSlot::FIRST_ABILITY_MODIFIER) + static_cast<size_t>(ability));
+}
+
+constexpr StatSlot ability_save_slot(Ability ability) {
+    return static_cast<StatSlot>(static_cast<size_t>(StatSlot::FIRST_ABILITY_SAVE) + static_cast<size_t>(ability));
+}
+
+constexpr StatSlot skill_slot(Skill skill) {
+    return static_cast<StatSlot>(static_cast<size_t>(StatSlot::FIRST_SKILL) + static_cast<size_t>(skill));
+}
+
+constexpr bool is_ability_slot(StatSlot slot) {
+    return slot >= StatSlot::FIRST_ABILITY && slot < StatSlot::FIRST_ABILITY_MAXIMUM;
+}
+
+inline const InternedString& StatAttribute::get_name() const noexcept { return name; }
+
+inline bool StatAttribute::is_custom() const noexcept { return !slot.has_value(); }
+
+inline StatSlot StatAttribute::get_slot() const noexcept { return *slot; }
+
+inline bool StatAttribute::operator==(const StatAttribute& other) const noexcept { return name == other.name; }
+
+} // namespace dnd
+
+#endif // STAT_ATTRIBUTE_HPP_
@@ -0,0 +1,367 @@
+#include <dnd_config.hpp>
+
+#include "stat_program.hpp"
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <initializer_list>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <core/basic_mechanics/abilities.hpp>
+#include <core/basic_mechanics/skills.hpp>
+#include <core/errors/errors.hpp>
+#include <core/models/character/stat_attribute.hpp>
+#include <core/models/character/stats.hpp>
+#include <core/models/effects/stat_change/stat_change.hpp>
+
+namespace dnd {
+
+static int calculate_modifier(int score) { return score / 2 - 5; }
+
+/* static int to_raw(bool value) { return value ? 1 : 0; } */ // TODO: uncomment when needed
+
+static int to_raw(int value) { return value * 100; }
+
+/* static int to_raw(float value) { return value * 100; } */ // TODO: uncomment when needed
+
+static bool is_ability_score_change(const StatChangeInstruction& instruction) {
+    return !instruction.affected_attribute.is_custom() && is_ability_slot(instruction.affected_attribute.get_slot());
+}
+
+StatProgram::StatProgram() : StatProgram(std::vector<StatChangeInstruction>()) {}
+
+StatProgram::StatProgram(std::vector<StatChangeInstruction>&& instructions)
+    : instructions(std::move(instructions)), ability_phase_end(0) {
+    nodes.reserve(stat_slot_count);
+    for (size_t i = 0; i < stat_slot_count; ++i) {
+        nodes.emplace_back(static_cast<StatSlot>(i));
+    }
+
+    // the steps are in the order in which the stats have always been calculated
+    add_step(StepType::PROFICIENCY_BONUS, 0, StatSlot::PROFICIENCY_BONUS, {});
+    for (Ability ability : abilities_inorder) {
+        add_step(StepType::BASE_ABILITY_SCORE, static_cast<uint32_t>(ability), ability_slot(ability), {});
+    }
+    for (Ability ability : abilities_inorder) {
+        add_step(StepType::ABILITY_MAXIMUM, static_cast<uint32_t>(ability), ability_maximum_slot(ability), {});
+    }
+    for (uint32_t i = 0; i < this->instructions.size(); ++i) {
+        if (is_ability_score_change(this->instructions[i])) {
+            add_instruction_step(i);
+        }
+    }
+    ability_phase_end = steps.size();
+
+    for (Ability ability : abilities_inorder) {
+        add_step(
+            StepType::ABILITY_SCORE_LIMIT, static_cast<uint32_t>(ability), ability_slot(ability),
+            {ability_maximum_slot(ability)}
+        );
+    }
+    for (Ability ability : abilities_inorder) {
+        add_step(
+            StepType::ABILITY_MODIFIER, static_cast<uint32_t>(ability), ability_modifier_slot(ability),
+            {ability_slot(ability)}
+        );
+    }
+    add_step(StepType::INITIATIVE, 0, StatSlot::INITIATIVE, {ability_modifier_slot(Ability::DEXTERITY)});
+    add_step(StepType::ARMOR_CLASS, 0, StatSlot::ARMOR_CLASS, {ability_modifier_slot(Ability::DEXTERITY)});
+    add_step(StepType::MAXIMUM_HP, 0, StatSlot::MAXIMUM_HP, {ability_modifier_slot(Ability::CONSTITUTION)});
+    for (Ability ability : abilities_inorder) {
+        add_step(
+            StepType::ABILITY_SAVE, static_cast<uint32_t>(ability), ability_save_slot(ability),
+            {ability_modifier_slot(ability)}
+        );
+    }
+    for (const SkillInfo& skill_info : get_all_skill_infos()) {
+        add_step(
+            StepType::SKILL_MODIFIER, static_cast<uint32_t>(skill_info.skill), skill_slot(skill_info.skill),
+            {ability_modifier_slot(skill_info.ability)}
+        );
+    }
+    for (uint32_t i = 0; i < this->instructions.size(); ++i) {
+        if (!is_ability_score_change(this->instructions[i])) {
+            add_instruction_step(i);
+        }
+    }
+}
+
+std::expected<Stats, Errors> StatProgram::evaluate(const StatInputs& inputs) const {
+    Stats stats = Stats::create_default();
+    Errors errors;
+    for (size_t i = 0; i < steps.size(); ++i) {
+        // the ability scores are the base of everything else, so there is no point in continuing without them
+        if (i == ability_phase_end && !errors.ok()) {
+            return std::unexpected(std::move(errors));
+        }
+        run_step(steps[i], stats, inputs, errors);
+    }
+    if (!errors.ok()) {
+        return std::unexpected(std::move(errors));
+    }
+    return stats;
+}
+
+Errors StatProgram::update(Stats& stats, const StatInputs& old_inputs, const StatInputs& new_inputs) const {
+    const std::bitset<input_count> changed_inputs = find_changed_inputs(old_inputs, new_inputs);
+    if (changed_inputs.none()) {
+        return Errors();
+    }
+    if (changed_inputs.count() == 1) {
+        // the common case of a single changed input does not need to merge anything
+        size_t input = 0;
+        while (!changed_inputs[input]) {
+            ++input;
+        }
+        return run_dependents(get_input_dependents(input), stats, new_inputs);
+    }
+    return run_dependents(merge_dependents(changed_inputs), stats, new_inputs);
+}
+
+size_t StatProgram::count_update_steps(const StatInputs& old_inputs, const StatInputs& new_inputs) const {
+    return merge_dependents(find_changed_inputs(old_inputs, new_inputs)).steps.size();
+}
+
+uint32_t StatProgram::node_of(const StatAttribute& attribute) {
+    if (!attribute.is_custom()) {
+        return static_cast<uint32_t>(attribute.get_slot());
+    }
+    // programs only have a handful of custom attributes
+    for (uint32_t node = static_cast<uint32_t>(stat_slot_count); node < nodes.size(); ++node) {
+        if (nodes[node] == attribute) {
+            return node;
+        }
+    }
+    nodes.push_back(attribute);
+    return static_cast<uint32_t>(nodes.size() - 1);
+}
+
+void StatProgram::add_step(StepType type, uint32_t index, StatSlot target, std::initializer_list<StatSlot> read_slots) {
+    steps.push_back(Step{
+        .type = type,
+        .index = index,
+        .target_node = static_cast<uint32_t>(target),
+        .first_read = static_cast<uint32_t>(step_reads.size()),
+        .read_count = static_cast<uint32_t>(read_slots.size()),
+    });
+    for (StatSlot read_slot : read_slots) {
+        step_reads.push_back(static_cast<uint32_t>(read_slot));
+    }
+}
+
+void StatProgram::add_instruction_step(uint32_t instruction_index) {
+    const StatChangeInstruction& instruction = instructions[instruction_index];
+    steps.push_back(Step{
+        .type = StepType::INSTRUCTION,
+        .index = instruction_index,
+        .target_node = node_of(instruction.affected_attribute),
+        .first_read = static_cast<uint32_t>(step_reads.size()),
+        .read_count = 0,
+    });
+    if (instruction.value_attribute.has_value()) {
+        step_reads.push_back(node_of(instruction.value_attribute.value()));
+        steps.back().read_count = 1;
+    }
+}
+
+void StatProgram::run_step(const Step& step, Stats& stats, const StatInputs& inputs, Errors& errors) const {
+    const StatSlot target = static_cast<StatSlot>(step.target_node);
+    // the derived values read at most one built-in attribute
+    auto read_int = [&stats, this, &step]() {
+        return stats.get_raw(static_cast<StatSlot>(step_reads[step.first_read])).value_or(0) / 100;
+    };
+    switch (step.type) {
+        case StepType::PROFICIENCY_BONUS:
+            stats.set_raw(target, to_raw(inputs.proficiency_bonus));
+            return;
+        case StepType::BASE_ABILITY_SCORE:
+            stats.set_raw(target, to_raw(inputs.ability_scores[step.index]));
+            return;
+        case StepType::ABILITY_MAXIMUM:
+            stats.set_raw(target, to_raw(20));
+            return;
+        case StepType::INSTRUCTION: {
+            Errors instruction_errors = instructions[step.index].apply(stats);
+            if (!instruction_errors.ok()) {
+                errors += std::move(instruction_errors);
+            }
+            return;
+        }
+        case StepType::ABILITY_SCORE_LIMIT: {
+            const int score = stats.get_raw(target).value_or(0);
+            const int maximum = stats.get_raw(static_cast<StatSlot>(step_reads[step.first_read])).value_or(0);
+            if (score > maximum) {
+                stats.set_raw(target, maximum);
+            }
+            return;
+        }
+        case StepType::ABILITY_MODIFIER:
+            stats.set_raw(target, to_raw(calculate_modifier(read_int())));
+            return;
+        case StepType::INITIATIVE:
+        case StepType::ABILITY_SAVE:
+        case StepType::SKILL_MODIFIER:
+            stats.set_raw(target, to_raw(read_int()));
+            return;
+        case StepType::ARMOR_CLASS:
+            stats.set_raw(target, to_raw(10 + read_int()));
+            return;
+        case StepType::MAXIMUM_HP: {
+            const int con_mod = read_int();
+            int max_hp = inputs.hit_dice_maximum;
+            for (const int hit_dice_roll : inputs.hit_dice_rolls) {
+                max_hp += hit_dice_roll + con_mod;
+            }
+            stats.set_raw(target, to_raw(max_hp));
+            return;
+        }
+    }
+    std::unreachable();
+}
+
+std::bitset<StatProgram::input_count> StatProgram::find_changed_inputs(
+    const StatInputs& old_inputs, const StatInputs& new_inputs
+) {
+    std::bitset<input_count> changed_inputs;
+    for (Ability ability : abilities_inorder) {
+        const size_t ability_index = static_cast<size_t>(ability);
+        changed_inputs[ability_index] = old_inputs.ability_scores[ability_index]
+                                        != new_inputs.ability_scores[ability_index];
+    }
+    changed_inputs[proficiency_bonus_input] = old_inputs.proficiency_bonus != new_inputs.proficiency_bonus;
+    changed_inputs[hit_dice_input] = old_inputs.hit_dice_maximum != new_inputs.hit_dice_maximum
+                                     || old_inputs.hit_dice_rolls != new_inputs.hit_dice_rolls;
+    return changed_inputs;
+}
+
+uint32_t StatProgram::input_node(size_t input) {
+    switch (input) {
+        case proficiency_bonus_input:
+            return static_cast<uint32_t>(StatSlot::PROFICIENCY_BONUS);
+        case hit_dice_input:
+            return static_cast<uint32_t>(StatSlot::MAXIMUM_HP);
+        default:
+            return static_cast<uint32_t>(ability_slot(static_cast<Ability>(input)));
+    }
+}
+
+StatProgram::DependencyGraph StatProgram::build_graph() const {
+    DependencyGraph new_graph{
+        .readers = std::vector<std::vector<uint32_t>>(nodes.size()),
+        .last_writer = std::vector<uint32_t>(nodes.size(), 0),
+    };
+    for (uint32_t step_index = 0; step_index < steps.size(); ++step_index) {
+        const Step& step = steps[step_index];
+        for (uint32_t i = step.first_read; i < step.first_read + step.read_count; ++i) {
+            new_graph.readers[step_reads[i]].push_back(step_index);
+        }
+        new_graph.last_writer[step.target_node] = step_index;
+    }
+    return new_graph;
+}
+
+const StatProgram::Dependents& StatProgram::get_input_dependents(size_t input) const {
+    std::optional<Dependents>& dependents = input_dependents[input];
+    if (!dependents.has_value()) {
+        if (!graph.has_value()) {
+            graph = build_graph();
+        }
+        dependents = find_dependents(graph.value(), input_node(input));
+    }
+    return dependents.value();
+}
+
+StatProgram::Dependents StatProgram::find_dependents(
+    const DependencyGraph& dependency_graph, uint32_t start_node
+) const {
+    std::vector<bool> update_nodes(nodes.size(), false);
+    std::vector<uint32_t> changed_nodes = {start_node};
+    update_nodes[start_node] = true;
+
+    // everything that is calculated from a changed value has to be calculated again
+    while (!changed_nodes.empty()) {
+        const uint32_t node = changed_nodes.back();
+        changed_nodes.pop_back();
+        for (uint32_t reader : dependency_graph.readers[node]) {
+            const uint32_t target_node = steps[reader].target_node;
+            if (!update_nodes[target_node]) {
+                update_nodes[target_node] = true;
+                changed_nodes.push_back(target_node);
+            }
+        }
+    }
+
+    // A step that is run again has to read the same values it read in the first run. That is the case for the values
+    // of unchanged nodes only if they are not written after the step, otherwise those nodes are calculated again too.
+    bool added_nodes = true;
+    while (added_nodes) {
+        added_nodes = false;
+        for (uint32_t step_index = 0; step_index < steps.size(); ++step_index) {
+            const Step& step = steps[step_index];
+            if (!update_nodes[step.target_node]) {
+                continue;
+            }
+            for (uint32_t i = step.first_read; i < step.first_read + step.read_count; ++i) {
+                const uint32_t read_node = step_reads[i];
+                if (!update_nodes[read_node] && dependency_graph.last_writer[read_node] > step_index) {
+                    update_nodes[read_node] = true;
+                    added_nodes = true;
+                }
+            }
+        }
+    }
+
+    Dependents dependents;
+    for (uint32_t node = 0; node < nodes.size(); ++node) {
+        if (update_nodes[node]) {
+            dependents.nodes.push_back(node);
+        }
+    }
+    for (uint32_t step_index = 0; step_index < steps.size(); ++step_index) {
+        if (update_nodes[steps[step_index].target_node]) {
+            dependents.steps.push_back(step_index);
+        }
+    }
+    return dependents;
+}
+
+StatProgram::Dependents StatProgram::merge_dependents(std::bitset<input_count> changed_inputs) const {
+    // the dependents of each input are closed under both rules above, so their union is as well
+    std::vector<bool> update_nodes(nodes.size(), false);
+    for (size_t input = 0; input < input_count; ++input) {
+        if (changed_inputs[input]) {
+            for (uint32_t node : get_input_dependents(input).nodes) {
+                update_nodes[node] = true;
+            }
+        }
+    }
+    Dependents dependents;
+    for (uint32_t node = 0; node < nodes.size(); ++node) {
+        if (update_nodes[node]) {
+            dependents.nodes.push_back(node);
+        }
+    }
+    for (uint32_t step_index = 0; step_index < steps.size(); ++step_index) {
+        if (update_nodes[steps[step_index].target_node]) {
+            dependents.steps.push_back(step_index);
+        }
+    }
+    return dependents;
+}
+
+Errors StatProgram::run_dependents(const Dependents& dependents, Stats& stats, const StatInputs& inputs) const {
+    for (uint32_t node : dependents.nodes) {
+        stats.remove(nodes[node]);
+    }
+    Errors errors;
+    for (uint32_t step_index : dependents.steps) {
+        run_step(steps[step_index], stats, inputs, errors);
+    }
+    return errors;
+}
+
+} // namespace dnd
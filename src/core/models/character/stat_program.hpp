@@ -0,0 +1,143 @@
+#ifndef STAT_PROGRAM_HPP_
+#define STAT_PROGRAM_HPP_
+
+#include <dnd_config.hpp>
+
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <initializer_list>
+#include <optional>
+#include <vector>
+
+#include <core/errors/errors.hpp>
+#include <core/models/character/stat_attribute.hpp>
+#include <core/models/character/stats.hpp>
+#include <core/models/effects/stat_change/stat_change.hpp>
+
+namespace dnd {
+
+/**
+ * @brief The values the stats of a character are calculated from, apart from the stat changes
+ */
+struct StatInputs {
+    bool operator==(const StatInputs&) const = default;
+
+    // the base ability scores in the order of the Ability enum
+    std::array<int, 6> ability_scores;
+    int proficiency_bonus;
+    int hit_dice_maximum;
+    std::vector<int> hit_dice_rolls;
+};
+
+/**
+ * @brief The calculation of the stats from the inputs and the stat changes of a character, split into steps that
+ * each write one attribute.
+ *
+ * The program knows which attributes every step reads, so that after a change of the inputs only the steps that
+ * depend on the changed inputs have to be run again. Those steps are only found on the first update that needs them,
+ * which is why a program must not be updated from several threads at once.
+ */
+class StatProgram {
+public:
+    StatProgram();
+    explicit StatProgram(std::vector<StatChangeInstruction>&& instructions);
+
+    /**
+     * @brief Calculates the stats for the given inputs from scratch
+     * @param inputs the inputs to calculate the stats from
+     * @return the stats, or the errors that occurred while applying the stat changes
+     */
+    std::expected<Stats, Errors> evaluate(const StatInputs& inputs) const;
+    /**
+     * @brief Updates stats that were calculated by this program to new inputs, only the attributes that depend on
+     * the changed inputs are calculated again
+     * @param stats the stats calculated for the old inputs, only valid if no errors are returned
+     * @param old_inputs the inputs the stats were calculated for
+     * @param new_inputs the inputs to update the stats to
+     * @return the errors that occurred while applying the stat changes
+     */
+    Errors update(Stats& stats, const StatInputs& old_inputs, const StatInputs& new_inputs) const;
+    /**
+     * @brief Returns the number of steps that an update between the given inputs runs, e.g. for testing
+     */
+    size_t count_update_steps(const StatInputs& old_inputs, const StatInputs& new_inputs) const;
+    size_t step_count() const noexcept;
+private:
+    enum class StepType : uint8_t {
+        PROFICIENCY_BONUS,
+        BASE_ABILITY_SCORE,
+        ABILITY_MAXIMUM,
+        INSTRUCTION,
+        ABILITY_SCORE_LIMIT,
+        ABILITY_MODIFIER,
+        INITIATIVE,
+        ARMOR_CLASS,
+        MAXIMUM_HP,
+        ABILITY_SAVE,
+        SKILL_MODIFIER,
+    };
+
+    struct Step {
+        StepType type;
+        // the ability, skill, or instruction the step is about, depending on the type
+        uint32_t index;
+        uint32_t target_node;
+        uint32_t first_read;
+        uint32_t read_count;
+    };
+
+    // the nodes and steps that have to be calculated again when an input changes, both in ascending order
+    struct Dependents {
+        std::vector<uint32_t> nodes;
+        std::vector<uint32_t> steps;
+    };
+
+    struct DependencyGraph {
+        // for every node, the steps that read it
+        std::vector<std::vector<uint32_t>> readers;
+        // for every node, the index of the last step that writes it
+        std::vector<uint32_t> last_writer;
+    };
+
+    // the inputs are the six ability scores in the order of the Ability enum, the proficiency bonus, and the hit dice
+    static constexpr size_t proficiency_bonus_input = 6;
+    static constexpr size_t hit_dice_input = 7;
+    static constexpr size_t input_count = 8;
+
+    static std::bitset<input_count> find_changed_inputs(const StatInputs& old_inputs, const StatInputs& new_inputs);
+    static uint32_t input_node(size_t input);
+
+    uint32_t node_of(const StatAttribute& attribute);
+    void add_step(StepType type, uint32_t index, StatSlot target, std::initializer_list<StatSlot> read_slots);
+    void add_instruction_step(uint32_t instruction_index);
+    void run_step(const Step& step, Stats& stats, const StatInputs& inputs, Errors& errors) const;
+    DependencyGraph build_graph() const;
+    const Dependents& get_input_dependents(size_t input) const;
+    Dependents find_dependents(const DependencyGraph& dependency_graph, uint32_t start_node) const;
+    Dependents merge_dependents(std::bitset<input_count> changed_inputs) const;
+    Errors run_dependents(const Dependents& dependents, Stats& stats, const StatInputs& inputs) const;
+
+    std::vector<StatChangeInstruction> instructions;
+    // the attribute of every node of the dependency graph, the built-in attributes come first in slot order
+    std::vector<StatAttribute> nodes;
+    std::vector<Step> steps;
+    // the nodes read by the steps, every step refers to its range
+    std::vector<uint32_t> step_reads;
+    // the steps before this index are the base values and the stat changes of the ability scores
+    size_t ability_phase_end;
+    // most programs are only evaluated, so the graph and the dependents of an input are built when first updating
+    mutable std::optional<DependencyGraph> graph;
+    mutable std::array<std::optional<Dependents>, input_count> input_dependents;
+};
+
+
+// === IMPLEMENTATION ===
+
+inline size_t StatProgram::step_count() const noexcept { return steps.size(); }
+
+} // namespace dnd
+
+#endif // STAT_PROGRAM_HPP_
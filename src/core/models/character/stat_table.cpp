@@ -0,0 +1,86 @@
+#include <dnd_config.hpp>
+
+#include "stat_table.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <core/models/character/stat_attribute.hpp>
+#include <core/models/character/stats.hpp>
+
+namespace dnd {
+
+StatTable StatTable::create(const std::vector<Stats>& level_stats) {
+    assert(level_stats.size() == level_count);
+
+    std::vector<StatAttribute> attributes;
+    for (size_t i = 0; i < stat_slot_count; ++i) {
+        attributes.emplace_back(static_cast<StatSlot>(i));
+    }
+    std::vector<StatAttribute> custom_attributes;
+    for (const Stats& stats : level_stats) {
+        for (const auto& [name, _] : stats.custom_values) {
+            StatAttribute attribute(name.str());
+            if (std::find(custom_attributes.begin(), custom_attributes.end(), attribute) == custom_attributes.end()) {
+                custom_attributes.push_back(std::move(attribute));
+            }
+        }
+    }
+    std::sort(
+        custom_attributes.begin(), custom_attributes.end(),
+        [](const StatAttribute& a, const StatAttribute& b) { return a.get_name().str() < b.get_name().str(); }
+    );
+    attributes.insert(attributes.end(), custom_attributes.begin(), custom_attributes.end());
+
+    StatTable table(std::move(attributes));
+    const size_t column_count = table.attributes.size();
+    for (size_t row = 0; row < level_count; ++row) {
+        for (size_t column = 0; column < column_count; ++column) {
+            std::optional<int> value = level_stats[row].get_raw(table.attributes[column]);
+            if (value.has_value()) {
+                table.values[row * column_count + column] = value.value();
+                table.has_value[row * column_count + column] = true;
+            }
+        }
+    }
+    return table;
+}
+
+std::optional<int> StatTable::get_raw(int level, const StatAttribute& attribute) const {
+    if (!attribute.is_custom()) {
+        return get_raw(level, attribute.get_slot());
+    }
+    // tables only have a handful of custom attributes
+    for (size_t column = stat_slot_count; column < attributes.size(); ++column) {
+        if (attributes[column] == attribute) {
+            return get_raw(level, column);
+        }
+    }
+    return std::nullopt;
+}
+
+std::optional<int> StatTable::get_int(int level, StatSlot slot) const {
+    std::optional<int> raw_value = get_raw(level, slot);
+    if (!raw_value.has_value()) {
+        return std::nullopt;
+    }
+    return raw_value.value() / 100;
+}
+
+std::optional<int> StatTable::get_int(int level, const StatAttribute& attribute) const {
+    std::optional<int> raw_value = get_raw(level, attribute);
+    if (!raw_value.has_value()) {
+        return std::nullopt;
+    }
+    return raw_value.value() / 100;
+}
+
+StatTable::StatTable(std::vector<StatAttribute>&& attributes)
+    : attributes(std::move(attributes)), values(level_count * this->attributes.size(), 0),
+      has_value(level_count * this->attributes.size(), false) {}
+
+} // namespace dnd
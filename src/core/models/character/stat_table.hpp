@@ -0,0 +1,75 @@
+#ifndef STAT_TABLE_HPP_
+#define STAT_TABLE_HPP_
+
+#include <dnd_config.hpp>
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+#include <core/models/character/stat_attribute.hpp>
+#include <core/models/character/stats.hpp>
+
+namespace dnd {
+
+/**
+ * @brief The stats of a character for every level from 1 to 20, stored as one row of raw values per level.
+ *
+ * The columns are the built-in attributes in slot order followed by the custom attributes of all levels sorted by
+ * name, so that a row can be displayed without any further lookups.
+ */
+class StatTable {
+public:
+    static constexpr int min_level = 1;
+    static constexpr int max_level = 20;
+    static constexpr size_t level_count = max_level - min_level + 1;
+
+    /**
+     * @brief Creates the table from the stats of every level
+     * @param level_stats the stats for every level from 1 to 20 in order
+     * @return the table
+     */
+    static StatTable create(const std::vector<Stats>& level_stats);
+
+    /**
+     * @brief Returns the attributes of the columns of the table
+     */
+    const std::vector<StatAttribute>& get_attributes() const noexcept;
+
+    std::optional<int> get_raw(int level, size_t column) const;
+    std::optional<int> get_raw(int level, StatSlot slot) const;
+    std::optional<int> get_raw(int level, const StatAttribute& attribute) const;
+    std::optional<int> get_int(int level, StatSlot slot) const;
+    std::optional<int> get_int(int level, const StatAttribute& attribute) const;
+private:
+    explicit StatTable(std::vector<StatAttribute>&& attributes);
+
+    std::vector<StatAttribute> attributes;
+    // the raw values of all levels, row by row
+    std::vector<int> values;
+    std::vector<bool> has_value;
+};
+
+
+// === IMPLEMENTATION ===
+
+inline const std::vector<StatAttribute>& StatTable::get_attributes() const noexcept { return attributes; }
+
+inline std::optional<int> StatTable::get_raw(int level, size_t column) const {
+    if (level < min_level || level > max_level || column >= attributes.size()) {
+        return std::nullopt;
+    }
+    const size_t index = static_cast<size_t>(level - min_level) * attributes.size() + column;
+    if (!has_value[index]) {
+        return std::nullopt;
+    }
+    return values[index];
+}
+
+inline std::optional<int> StatTable::get_raw(int level, StatSlot slot) const {
+    return get_raw(level, static_cast<size_t>(slot));
+}
+
+} // namespace dnd
+
+#endif // STAT_TABLE_HPP_
@@ -3,6 +3,9 @@
 
 #include <dnd_config.hpp>
 
+#include <array>
+#include <bitset>
+#include <cstddef>
 #include <expected>
 #include <optional>
 #include <string>
@@ -13,17 +16,34 @@
 #include <core/basic_mechanics/dice.hpp>
 #include <core/basic_mechanics/skills.hpp>
 #include <core/models/character/ability_scores.hpp>
+#include <core/models/character/stat_attribute.hpp>
 #include <core/models/effects/stat_change/stat_change.hpp>
 #include <core/types.hpp>
+#include <core/utils/string_interner.hpp>
 
 namespace dnd {
 
+/**
+ * @brief The values of the attributes of a character.
+ *
+ * The built-in attributes are stored in a flat array indexed by their StatSlot, only custom attributes are stored in
+ * a map keyed by their interned name.
+ */
 class Stats {
 public:
     static Stats create_default();
+    /**
+     * @brief Calculates the stats of a character
+     * @param base_ability_scores the ability scores before any stat changes
+     * @param proficiency_bonus the proficiency bonus for the level of the character
+     * @param program the compiled stat changes, the ones changing ability scores are applied first
+     * @param class_hit_dice the hit dice of the class of the character
+     * @param hit_dice_rolls the hit dice rolls for each level after the first
+     * @return the stats, or the errors that occurred while applying the stat changes
+     */
     static std::expected<Stats, Errors> create(
-        const AbilityScores& base_ability_scores, int proficiency_bonus, std::vector<CRef<StatChange>> stat_changes,
-        Dice class_hit_dice, const std::vector<int>& hit_dice_rolls
+        const AbilityScores& base_ability_scores, int proficiency_bonus,
+        const std::vector<StatChangeInstruction>& program, Dice class_hit_dice, const std::vector<int>& hit_dice_rolls
     );
 
     bool is_complete() const;
@@ -33,8 +53,11 @@ public:
     std::optional<float> get_float(const std::string& name) const;
 
     std::optional<int> get_raw(const std::string& name) const;
+    std::optional<int> get_raw(const StatAttribute& attribute) const;
+    std::optional<int> get_raw(StatSlot slot) const;
     std::optional<Ref<int>> get_raw_mut(const std::string& name);
     Ref<int> get_raw_mut_or_insert(const std::string& name);
+    int& get_raw_mut_or_insert(const StatAttribute& attribute);
 
     int get_current_hp() const;
     int get_maximum_hp() const;
@@ -48,17 +71,67 @@ public:
     int get_ability_save_modifier(Ability ability) const;
     int get_skill_modifier(Skill skill) const;
 private:
+    friend class StatProgram;
+    friend class StatTable;
+
     Stats();
 
-    void check_maximum_ability_scores();
-    void calculate_ability_modifiers();
-    void calculate_ability_save_modifiers();
-    void calculate_skill_modifiers();
+    void set_raw(StatSlot slot, int value);
+    void remove(const StatAttribute& attribute);
 
-    /* std::unordered_map<std::string, const int> constant_values; */
-    std::unordered_map<std::string, int> mutable_values;
+    std::array<int, stat_slot_count> values;
+    std::bitset<stat_slot_count> has_value;
+    std::unordered_map<InternedString, int> custom_values;
 };
 
+
+// === IMPLEMENTATION ===
+
+inline std::optional<int> Stats::get_raw(StatSlot slot) const {
+    const size_t index = static_cast<size_t>(slot);
+    if (!has_value[index]) {
+        return std::nullopt;
+    }
+    return values[index];
+}
+
+inline std::optional<int> Stats::get_raw(const StatAttribute& attribute) const {
+    if (!attribute.is_custom()) {
+        return get_raw(attribute.get_slot());
+    }
+    auto it = custom_values.find(attribute.get_name());
+    if (it == custom_values.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+inline int& Stats::get_raw_mut_or_insert(const StatAttribute& attribute) {
+    if (attribute.is_custom()) {
+        return custom_values[attribute.get_name()];
+    }
+    const size_t index = static_cast<size_t>(attribute.get_slot());
+    if (!has_value[index]) {
+        has_value[index] = true;
+        values[index] = 0;
+    }
+    return values[index];
+}
+
+inline void Stats::set_raw(StatSlot slot, int value) {
+    const size_t index = static_cast<size_t>(slot);
+    has_value[index] = true;
+    values[index] = value;
+}
+
+inline void Stats::remove(const StatAttribute& attribute) {
+    if (attribute.is_custom()) {
+        custom_values.erase(attribute.get_name());
+    } else {
+        has_value[static_cast<size_t>(attribute.get_slot())] = false;
+    }
+}
+
 } // namespace dnd
 
 #endif // STATS_HPP_
@@ -5,7 +5,7 @@
 #include <cassert>
 #include <filesystem>
 #include <memory>
-#include <regex>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -20,24 +20,24 @@
 #include <core/models/effects_provider/class_feature.hpp>
 #include <core/models/source_info.hpp>
 #include <core/models/spellcasting/spellcasting_factory.hpp>
-#include <core/text/text.hpp>
+#include <core/text/formatted_text.hpp>
+#include <core/utils/arena.hpp>
 #include <core/validation/class/class_validation.hpp>
 #include <core/validation/effects/condition/condition_validation.hpp>
 #include <core/validation/effects/effects_validation.hpp>
 #include <core/validation/effects_provider/feature_validation.hpp>
+#include <core/validation/string_matchers.hpp>
 #include <core/visitors/content/content_visitor.hpp>
 
 namespace dnd {
 
-static constexpr const char* level_activation_regex_cstr = "CLASS_LEVEL >= [123456789]\\d?";
-
 static int determine_subclass_level(const Feature::Data& subclass_feature_data) {
-    static const std::regex level_activation_regex(level_activation_regex_cstr);
     const std::vector<Condition::Data>& activation_conditions = subclass_feature_data.main_effects_data
                                                                     .activation_conditions_data;
     for (const Condition::Data& condition_data : activation_conditions) {
-        if (std::regex_match(condition_data.condition_str, level_activation_regex)) {
-            return std::stoi(condition_data.condition_str.substr(15));
+        std::optional<int> level = match_class_level_condition(condition_data.condition_str);
+        if (level.has_value()) {
+            return level.value();
         }
     }
     return 1;
@@ -97,7 +97,7 @@ CreateResult<Class> Class::create_for(Data&& data, const Content& content) {
         auto [_, sub_errors] = spellcasting_result.data_and_errors();
         return InvalidCreate<Class>(std::move(data), std::move(sub_errors));
     }
-    std::unique_ptr<Spellcasting> spellcasting = spellcasting_result.value();
+    ArenaPtr<Spellcasting> spellcasting = spellcasting_result.value();
 
     return ValidCreate(Class(
         std::move(data.name), std::move(data.description), std::move(data.source_path), std::move(data.source_name),
@@ -108,7 +108,7 @@ CreateResult<Class> Class::create_for(Data&& data, const Content& content) {
 
 const std::string& Class::get_name() const { return name; }
 
-const Text& Class::get_description() const { return description; }
+const FormattedText& Class::get_description() const { return description; }
 
 const SourceInfo& Class::get_source_info() const { return source_info; }
 
@@ -127,12 +127,12 @@ const Dice& Class::get_hit_dice() const { return hit_dice; }
 const ImportantLevels& Class::get_important_levels() const { return important_levels; }
 
 Class::Class(
-    std::string&& name, Text&& description, std::filesystem::path&& source_path, std::string&& source_name,
+    std::string&& name, FormattedText&& description, std::filesystem::path&& source_path, std::string&& source_name,
     std::string&& key, std::vector<ClassFeature>&& features, Opt<CRef<ClassFeature>> subclass_feature, Dice hit_dice,
-    ImportantLevels&& important_levels, std::unique_ptr<Spellcasting>&& spellcasting
+    ImportantLevels&& important_levels, ArenaPtr<Spellcasting>&& spellcasting
 )
     : name(std::move(name)), description(std::move(description)),
-      source_info({.path = std::move(source_path), .name = std::move(source_name)}), key(std::move(key)),
+      source_info({.path = std::move(source_path), .name = InternedString(source_name)}), key(std::move(key)),
       features(std::move(features)), spellcasting(std::move(spellcasting)), subclass_feature(subclass_feature),
       hit_dice(std::move(hit_dice)), important_levels(std::move(important_levels)) {}
 
@@ -15,8 +15,10 @@
 #include <core/models/effects_provider/class_feature.hpp>
 #include <core/models/source_info.hpp>
 #include <core/models/spellcasting/spellcasting.hpp>
-#include <core/text/text.hpp>
+#include <core/text/formatted_text.hpp>
 #include <core/types.hpp>
+#include <core/utils/arena.hpp>
+#include <core/utils/string_interner.hpp>
 
 namespace dnd {
 
@@ -35,7 +37,7 @@ public:
     Class& operator=(Class&&) noexcept = default;
 
     const std::string& get_name() const override;
-    const Text& get_description() const override;
+    const FormattedText& get_description() const override;
     const SourceInfo& get_source_info() const override;
     const std::string& get_key() const override;
     const std::vector<ClassFeature>& get_features() const;
@@ -45,18 +47,20 @@ public:
     const Dice& get_hit_dice() const;
     const ImportantLevels& get_important_levels() const;
 private:
+    friend class ContentSerializer;
+
     Class(
-        std::string&& name, Text&& description, std::filesystem::path&& source_path, std::string&& source_name,
+        std::string&& name, FormattedText&& description, std::filesystem::path&& source_path, std::string&& source_name,
         std::string&& key, std::vector<ClassFeature>&& features, Opt<CRef<ClassFeature>> subclass_feature,
-        Dice hit_dice, ImportantLevels&& important_levels, std::unique_ptr<Spellcasting>&& spellcasting = nullptr
+        Dice hit_dice, ImportantLevels&& important_levels, ArenaPtr<Spellcasting>&& spellcasting = nullptr
     );
 
-    std::string name;
-    Text description;
+    InternedString name;
+    FormattedText description;
     SourceInfo source_info;
     std::string key;
     std::vector<ClassFeature> features;
-    std::unique_ptr<Spellcasting> spellcasting;
+    ArenaPtr<Spellcasting> spellcasting;
     Opt<CRef<ClassFeature>> subclass_feature;
     Dice hit_dice;
     ImportantLevels important_levels;
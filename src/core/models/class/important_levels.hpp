@@ -18,6 +18,8 @@ public:
     const std::set<int>& get_feat_levels() const;
     int get_subclass_level() const;
 private:
+    friend class ContentSerializer;
+
     ImportantLevels(std::set<int>&& feat_levels, int subclass_level);
 
     std::set<int> feat_levels;
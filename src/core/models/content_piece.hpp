@@ -8,7 +8,7 @@
 #include <fmt/format.h>
 
 #include <core/models/source_info.hpp>
-#include <core/text/text.hpp>
+#include <core/text/formatted_text.hpp>
 
 namespace dnd {
 
@@ -21,7 +21,7 @@ class ContentPiece {
 public:
     virtual ~ContentPiece() = default;
     virtual const std::string& get_name() const = 0;
-    virtual const Text& get_description() const = 0;
+    virtual const FormattedText& get_description() const = 0;
     virtual const SourceInfo& get_source_info() const = 0;
     virtual const std::string& get_key() const = 0;
 };
@@ -5,9 +5,10 @@
 #include <cassert>
 #include <expected>
 #include <memory>
-#include <regex>
+#include <optional>
 #include <set>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -28,22 +29,18 @@
 #include <core/searching/content_filters/selection_filter.hpp>
 #include <core/searching/content_filters/spell/spell_filter.hpp>
 #include <core/validation/effects/choice/choice_validation.hpp>
+#include <core/validation/string_matchers.hpp>
 
 namespace dnd {
 
-static constexpr const char* cantrip_filter_regex_cstr = "(([aA]bjuration|[cC]onjuration|[dD]ivination|[eE]nchantment|"
-                                                         "[eE]vocation|[iI]llusion|[nN]ecromancy|[tT]ransmutation) )?"
-                                                         "(([a-zA-Z][a-z]*) )?[cC]antrips";
-
 static std::unique_ptr<ContentFilter> create_cantrip_filter(const Content& content, const std::string& group_name) {
     SpellFilter cantrip_filter(content);
     cantrip_filter.level_filter.set(NumberFilterType::EQUAL, 0);
-    static const std::regex cantrip_filter_regex(cantrip_filter_regex_cstr);
-    std::smatch match;
-    if (!std::regex_match(group_name, match, cantrip_filter_regex)) {
+    std::optional<SpellGroupName> group = match_cantrip_group_name(group_name);
+    if (!group.has_value()) {
         throw invalid_data("Cannot create choice filter from invalid group name.");
     }
-    const std::string spell_magic_school_name = match[2].str();
+    const std::string spell_magic_school_name(group->magic_school);
     if (!spell_magic_school_name.empty()) {
         std::expected<MagicSchool, RuntimeError> magic_school_result = magic_school_from_string(
             spell_magic_school_name
@@ -52,26 +49,20 @@ static std::unique_ptr<ContentFilter> create_cantrip_filter(const Content& conte
         MagicSchool magic_school = magic_school_result.value();
         cantrip_filter.magic_school_filter.set(SelectionFilterType::IS_IN, {magic_school});
     }
-    const std::string spell_class_name = match[4].str();
+    const std::string spell_class_name(group->class_name);
     if (!spell_class_name.empty()) {
         cantrip_filter.classes_filter.set(SelectionFilterType::IS_IN, {spell_class_name});
     }
     return std::make_unique<SpellFilter>(std::move(cantrip_filter));
 }
 
-static constexpr const char* spell_filter_regex_cstr = "((1st|2nd|3rd|[4-9]th)-level )?"
-                                                       "(([aA]bjuration|[cC]onjuration|[dD]ivination|[eE]nchantment|"
-                                                       "[eE]vocation|[iI]llusion|[nN]ecromancy|[tT]ransmutation) )?"
-                                                       "(([a-zA-Z][a-z]*) )?[sS]pells";
-
 static std::unique_ptr<ContentFilter> create_spell_filter(const Content& content, const std::string& group_name) {
     SpellFilter spell_filter(content);
-    static const std::regex spell_filter_regex(spell_filter_regex_cstr);
-    std::smatch match;
-    if (!std::regex_match(group_name, match, spell_filter_regex)) {
+    std::optional<SpellGroupName> group = match_spell_group_name(group_name);
+    if (!group.has_value()) {
         throw invalid_data("Cannot create choice filter from invalid group name.");
     }
-    const std::string spell_level = match[2].str();
+    const std::string_view spell_level = group->level;
     if (spell_level.empty()) {
         spell_filter.level_filter.set(NumberFilterType::GREATER_THAN, 0);
     } else if (spell_level == "1st") {
@@ -83,7 +74,7 @@ static std::unique_ptr<ContentFilter> create_spell_filter(const Content& content
     } else {
         spell_filter.level_filter.set(NumberFilterType::EQUAL, spell_level[0] - '0');
     }
-    const std::string spell_magic_school_name = match[4].str();
+    const std::string spell_magic_school_name(group->magic_school);
     if (!spell_magic_school_name.empty()) {
         std::expected<MagicSchool, RuntimeError> magic_school_result = magic_school_from_string(
             spell_magic_school_name
@@ -92,7 +83,7 @@ static std::unique_ptr<ContentFilter> create_spell_filter(const Content& content
         MagicSchool magic_school = magic_school_result.value();
         spell_filter.magic_school_filter.set(SelectionFilterType::IS_IN, {magic_school});
     }
-    const std::string spell_class_name = match[6].str();
+    const std::string spell_class_name(group->class_name);
     if (!spell_class_name.empty()) {
         spell_filter.classes_filter.set(SelectionFilterType::IS_IN, {spell_class_name});
     }
@@ -138,7 +129,16 @@ CreateResult<Choice> Choice::create_for(Data&& data, const Content& content) {
         return InvalidCreate<Choice>(std::move(data), std::move(errors));
     }
     ChoiceType type = type_optional.value();
-    std::vector<std::unique_ptr<ContentFilter>> filters;
+    std::vector<std::unique_ptr<ContentFilter>> filters = create_filters(type, data, content);
+    return ValidCreate(Choice(
+        type, std::move(filters), std::move(data.attribute_name), data.amount, std::move(group_names),
+        std::move(data.explicit_choices)
+    ));
+}
+
+std::vector<std::unique_ptr<ContentFilter>> Choice::create_filters(
+    ChoiceType type, Data& data, const Content& content
+) {
     switch (type) { // TODO: complete this switch
         case ChoiceType::ABILITY:
             break;
@@ -151,15 +151,11 @@ CreateResult<Choice> Choice::create_for(Data&& data, const Content& content) {
         case ChoiceType::ITEM:
             break;
         case ChoiceType::SPELL:
-            filters = spell_filters(content, data);
-            break;
+            return spell_filters(content, data);
         case ChoiceType::CHOOSABLE:
             break;
     }
-    return ValidCreate(Choice(
-        type, std::move(filters), std::move(data.attribute_name), data.amount, std::move(group_names),
-        std::move(data.explicit_choices)
-    ));
+    return {};
 }
 
 const std::string& Choice::get_attribute_name() const { return attribute_name; }
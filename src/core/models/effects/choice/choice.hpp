@@ -28,10 +28,15 @@ public:
 
     std::set<std::string> possible_values(const Content& content) const;
 private:
+    friend class ContentSerializer;
+
     Choice(
         ChoiceType type, std::vector<std::unique_ptr<ContentFilter>>&& filters, std::string&& attribute_name,
         int amount, std::vector<std::string>&& group_names, std::vector<std::string>&& explicit_choices
     );
+    static std::vector<std::unique_ptr<ContentFilter>> create_filters(
+        ChoiceType type, Data& data, const Content& content
+    );
 
     ChoiceType type;
     std::string attribute_name;
@@ -27,7 +27,7 @@ std::expected<bool, RuntimeError> Condition::evaluate_with_right_side(const Stat
     if (!left_side_optional.has_value()) {
         return std::unexpected(RuntimeError(
             RuntimeError::Code::INVALID_ARGUMENT,
-            fmt::format("Condition left side identifier '{}' not found in stats", left_side_identifier)
+            fmt::format("Condition left side identifier '{}' not found in stats", left_side_identifier.get_name())
         ));
     }
     int left_side_value = left_side_optional.value();
@@ -8,6 +8,7 @@
 #include <string_view>
 
 #include <core/errors/runtime_error.hpp>
+#include <core/models/character/stat_attribute.hpp>
 #include <core/models/character/stats.hpp>
 
 namespace dnd {
@@ -28,12 +29,14 @@ public:
     virtual ~Condition() = default;
     virtual std::expected<bool, RuntimeError> evaluate(const Stats& stats) const = 0;
 protected:
+    friend class ContentSerializer;
+
     Condition(const std::string& left_side_identifier, ComparisonOperator comparison_operator);
     Condition(std::string_view left_side_identifier, ComparisonOperator comparison_operator);
 
     std::expected<bool, RuntimeError> evaluate_with_right_side(const Stats& stats, int right_side_value) const;
 
-    std::string left_side_identifier;
+    StatAttribute left_side_identifier;
     ComparisonOperator comparison_operator;
 };
 
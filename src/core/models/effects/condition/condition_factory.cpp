@@ -17,6 +17,7 @@
 #include <core/models/effects/condition/condition.hpp>
 #include <core/models/effects/condition/identifier_condition.hpp>
 #include <core/models/effects/condition/literal_condition.hpp>
+#include <core/utils/arena.hpp>
 #include <core/utils/string_manipulation.hpp>
 #include <core/validation/effects/condition/condition_validation.hpp>
 
@@ -62,21 +63,21 @@ FactoryResult<Condition> create_condition(Condition::Data&& data) {
     }
     ComparisonOperator comparison_operator = comparison_operator_optional.value();
 
-    std::unique_ptr<Condition> condition;
+    ArenaPtr<Condition> condition;
     if (right_side_identifier[0] >= 'A' && right_side_identifier[0] <= 'Z') {
-        condition = std::make_unique<IdentifierCondition>(
+        condition = make_arena_ptr<IdentifierCondition>(
             left_side_identifier, comparison_operator, right_side_identifier
         );
     } else if (right_side_identifier == "true" || right_side_identifier == "false") {
-        condition = std::make_unique<LiteralCondition>(
+        condition = make_arena_ptr<LiteralCondition>(
             left_side_identifier, comparison_operator, right_side_identifier == "true"
         );
     } else if (right_side_identifier.find('.') != std::string::npos) {
-        condition = std::make_unique<LiteralCondition>(
+        condition = make_arena_ptr<LiteralCondition>(
             left_side_identifier, comparison_operator, std::stof(std::string(right_side_identifier))
         );
     } else {
-        condition = std::make_unique<LiteralCondition>(
+        condition = make_arena_ptr<LiteralCondition>(
             left_side_identifier, comparison_operator, std::stoi(std::string(right_side_identifier))
         );
     }
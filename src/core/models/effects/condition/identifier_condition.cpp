@@ -32,7 +32,7 @@ std::expected<bool, RuntimeError> IdentifierCondition::evaluate(const Stats& sta
     if (!right_side_optional.has_value()) {
         return std::unexpected(RuntimeError(
             RuntimeError::Code::INVALID_ARGUMENT,
-            fmt::format("Condition right side identifier '{}' not found in stats", right_side_identifier)
+            fmt::format("Condition right side identifier '{}' not found in stats", right_side_identifier.get_name())
         ));
     }
     int right_side_value = right_side_optional.value();
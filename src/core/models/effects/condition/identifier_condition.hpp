@@ -8,6 +8,7 @@
 #include <string_view>
 
 #include <core/errors/runtime_error.hpp>
+#include <core/models/character/stat_attribute.hpp>
 #include <core/models/character/stats.hpp>
 #include <core/models/effects/condition/condition.hpp>
 
@@ -26,7 +27,9 @@ public:
 
     std::expected<bool, RuntimeError> evaluate(const Stats& stats) const override final;
 private:
-    std::string right_side_identifier;
+    friend class ContentSerializer;
+
+    StatAttribute right_side_identifier;
 };
 
 } // namespace dnd
@@ -27,6 +27,8 @@ public:
 
     std::expected<bool, RuntimeError> evaluate(const Stats& stats) const override final;
 private:
+    friend class ContentSerializer;
+
     int right_side;
 };
 
@@ -20,6 +20,7 @@
 #include <core/models/effects/subholders/extra_spells_holder.hpp>
 #include <core/models/effects/subholders/proficiency_holder.hpp>
 #include <core/models/effects/subholders/riv_holder.hpp>
+#include <core/utils/arena.hpp>
 #include <core/validation/effects/effects_validation.hpp>
 #include <core/validation/effects/subholders/action_holder_validation.hpp>
 #include <core/validation/effects/subholders/extra_spells_holder_validation.hpp>
@@ -31,7 +32,7 @@ namespace dnd {
 CreateResult<Effects> Effects::create_for(Data&& data, const Content& content) {
     // there is no nonrecursive Effects::Data validation
 
-    std::vector<std::unique_ptr<Condition>> activation_conditions;
+    std::vector<ArenaPtr<Condition>> activation_conditions;
     activation_conditions.reserve(data.activation_conditions_data.size());
     for (Condition::Data& condition_data : data.activation_conditions_data) {
         FactoryResult<Condition> condition_result = create_condition(std::move(condition_data));
@@ -53,7 +54,7 @@ CreateResult<Effects> Effects::create_for(Data&& data, const Content& content) {
         choices.push_back(choice_result.value());
     }
 
-    std::vector<std::unique_ptr<StatChange>> stat_changes;
+    std::vector<ArenaPtr<StatChange>> stat_changes;
     stat_changes.reserve(data.stat_changes_data.size());
     for (StatChange::Data& stat_change_data : data.stat_changes_data) {
         FactoryResult<StatChange> stat_change_result = create_stat_change(std::move(stat_change_data));
@@ -103,8 +104,8 @@ CreateResult<Effects> Effects::create_for(Data&& data, const Content& content) {
 }
 
 Effects::Effects(
-    std::vector<std::unique_ptr<Condition>>&& activation_conditions, std::vector<Choice>&& choices,
-    std::vector<std::unique_ptr<StatChange>>&& stat_changes, ActionHolder&& action_holder,
+    std::vector<ArenaPtr<Condition>>&& activation_conditions, std::vector<Choice>&& choices,
+    std::vector<ArenaPtr<StatChange>>&& stat_changes, ActionHolder&& action_holder,
     ExtraSpellsHolder&& extra_spells_holder, ProficiencyHolder&& proficiency_holder, RIVHolder&& riv_holder
 )
     : activation_conditions(std::move(activation_conditions)), choices(std::move(choices)),
@@ -112,13 +113,13 @@ Effects::Effects(
       extra_spells(std::move(extra_spells_holder)), proficiencies(std::move(proficiency_holder)),
       rivs(std::move(riv_holder)) {}
 
-const std::vector<std::unique_ptr<Condition>>& Effects::get_activation_conditions() const {
+const std::vector<ArenaPtr<Condition>>& Effects::get_activation_conditions() const {
     return activation_conditions;
 }
 
 const std::vector<Choice>& Effects::get_choices() const { return choices; }
 
-const std::vector<std::unique_ptr<StatChange>>& Effects::get_stat_changes() const { return stat_changes; }
+const std::vector<ArenaPtr<StatChange>>& Effects::get_stat_changes() const { return stat_changes; }
 
 const ActionHolder& Effects::get_actions() const { return actions; }
 
@@ -135,7 +136,7 @@ bool Effects::empty() const {
 
 std::expected<bool, Errors> Effects::is_active(const Stats& stats) const {
     Errors errors;
-    for (const std::unique_ptr<Condition>& condition : activation_conditions) {
+    for (const ArenaPtr<Condition>& condition : activation_conditions) {
         std::expected<bool, RuntimeError> condition_result = condition->evaluate(stats);
         if (!condition_result.has_value()) {
             errors.add_runtime_error(std::move(condition_result.error()));
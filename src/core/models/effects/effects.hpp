@@ -16,6 +16,7 @@
 #include <core/models/effects/subholders/extra_spells_holder.hpp>
 #include <core/models/effects/subholders/proficiency_holder.hpp>
 #include <core/models/effects/subholders/riv_holder.hpp>
+#include <core/utils/arena.hpp>
 
 namespace dnd {
 
@@ -29,8 +30,8 @@ public:
     static CreateResult<Effects> create_for(Data&& data, const Content& content);
 
     Effects(
-        std::vector<std::unique_ptr<Condition>>&& activation_conditions, std::vector<Choice>&& choices,
-        std::vector<std::unique_ptr<StatChange>>&& stat_changes, ActionHolder&& action_holder,
+        std::vector<ArenaPtr<Condition>>&& activation_conditions, std::vector<Choice>&& choices,
+        std::vector<ArenaPtr<StatChange>>&& stat_changes, ActionHolder&& action_holder,
         ExtraSpellsHolder&& extra_spells_holder, ProficiencyHolder&& proficiency_holder, RIVHolder&& riv_holder
     );
     virtual ~Effects() = default;
@@ -41,9 +42,9 @@ public:
     Effects& operator=(Effects&&) noexcept = default;
 
     bool empty() const;
-    const std::vector<std::unique_ptr<Condition>>& get_activation_conditions() const;
+    const std::vector<ArenaPtr<Condition>>& get_activation_conditions() const;
     const std::vector<Choice>& get_choices() const;
-    const std::vector<std::unique_ptr<StatChange>>& get_stat_changes() const;
+    const std::vector<ArenaPtr<StatChange>>& get_stat_changes() const;
     const ActionHolder& get_actions() const;
     const ExtraSpellsHolder& get_extra_spells() const;
     const ProficiencyHolder& get_proficiencies() const;
@@ -53,9 +54,9 @@ public:
 
     void merge(Effects&& other);
 private:
-    std::vector<std::unique_ptr<Condition>> activation_conditions;
+    std::vector<ArenaPtr<Condition>> activation_conditions;
     std::vector<Choice> choices;
-    std::vector<std::unique_ptr<StatChange>> stat_changes;
+    std::vector<ArenaPtr<StatChange>> stat_changes;
     ActionHolder actions;
     ExtraSpellsHolder extra_spells;
     ProficiencyHolder proficiencies;
@@ -6,7 +6,6 @@
 #include <string>
 #include <string_view>
 
-#include <core/errors/errors.hpp>
 #include <core/models/effects/stat_change/stat_change.hpp>
 
 namespace dnd {
@@ -24,9 +23,6 @@ public:
         std::string_view affected_attribute, StatChangeTime time, StatChangeOperation operation,
         std::string_view value_identifier
     );
-    Errors apply(Stats& stats) const override final;
-private:
-    std::string value_identifier;
 };
 
 } // namespace dnd
@@ -2,44 +2,54 @@
 
 #include "literal_stat_change.hpp"
 
+#include <optional>
 #include <string>
 #include <string_view>
 
-#include <core/errors/errors.hpp>
+#include <core/models/character/stat_attribute.hpp>
 #include <core/models/effects/stat_change/stat_change.hpp>
 
 namespace dnd {
 
+static StatChangeInstruction literal_instruction(
+    std::string_view affected_attribute, StatChangeOperation operation, int raw_value
+) {
+    return StatChangeInstruction{
+        .affected_attribute = StatAttribute(affected_attribute),
+        .operation = operation,
+        .value_attribute = std::nullopt,
+        .literal_value = raw_value,
+    };
+}
+
 LiteralStatChange::LiteralStatChange(
     const std::string& affected_attribute, StatChangeTime time, StatChangeOperation operation, bool value
 )
-    : StatChange(affected_attribute, time, operation), value(static_cast<int>(value)) {}
+    : StatChange(literal_instruction(affected_attribute, operation, static_cast<int>(value)), time) {}
 
 LiteralStatChange::LiteralStatChange(
     std::string_view affected_attribute, StatChangeTime time, StatChangeOperation operation, bool value
 )
-    : StatChange(affected_attribute, time, operation), value(static_cast<int>(value)) {}
+    : StatChange(literal_instruction(affected_attribute, operation, static_cast<int>(value)), time) {}
 
 LiteralStatChange::LiteralStatChange(
     const std::string& affected_attribute, StatChangeTime time, StatChangeOperation operation, int value
 )
-    : StatChange(affected_attribute, time, operation), value(value * 100) {}
+    : StatChange(literal_instruction(affected_attribute, operation, value * 100), time) {}
 
 LiteralStatChange::LiteralStatChange(
     std::string_view affected_attribute, StatChangeTime time, StatChangeOperation operation, int value
 )
-    : StatChange(affected_attribute, time, operation), value(value * 100) {}
+    : StatChange(literal_instruction(affected_attribute, operation, value * 100), time) {}
 
 LiteralStatChange::LiteralStatChange(
     const std::string& affected_attribute, StatChangeTime time, StatChangeOperation operation, float value
 )
-    : StatChange(affected_attribute, time, operation), value(static_cast<int>(value * 100)) {}
+    : StatChange(literal_instruction(affected_attribute, operation, static_cast<int>(value * 100)), time) {}
 
 LiteralStatChange::LiteralStatChange(
     std::string_view affected_attribute, StatChangeTime time, StatChangeOperation operation, float value
 )
-    : StatChange(affected_attribute, time, operation), value(static_cast<int>(value * 100)) {}
-
-Errors LiteralStatChange::apply(Stats& stats) const { return apply_with_value(stats, value); }
+    : StatChange(literal_instruction(affected_attribute, operation, static_cast<int>(value * 100)), time) {}
 
 } // namespace dnd
@@ -6,7 +6,6 @@
 #include <string>
 #include <string_view>
 
-#include <core/errors/errors.hpp>
 #include <core/models/effects/stat_change/stat_change.hpp>
 
 namespace dnd {
@@ -34,10 +33,6 @@ public:
     LiteralStatChange(
         std::string_view affected_attribute, StatChangeTime time, StatChangeOperation operation, float value
     );
-
-    Errors apply(Stats& stats) const override final;
-private:
-    int value;
 };
 
 } // namespace dnd
@@ -2,29 +2,35 @@
 
 #include "stat_change.hpp"
 
+#include <algorithm>
 #include <cassert>
+#include <optional>
 #include <string>
-#include <string_view>
 #include <utility>
 
+#include <fmt/format.h>
+
 #include <core/errors/errors.hpp>
 #include <core/errors/runtime_error.hpp>
 #include <core/models/character/stats.hpp>
 
 namespace dnd {
 
-StatChangeTime StatChange::get_time() const { return time; }
-
-const std::string& StatChange::get_affected_attribute() const { return affected_attribute; }
-
-StatChange::StatChange(const std::string& affected_attribute, StatChangeTime time, StatChangeOperation operation)
-    : affected_attribute(affected_attribute), operation(operation), time(time) {}
-
-StatChange::StatChange(std::string_view affected_attribute, StatChangeTime time, StatChangeOperation operation)
-    : affected_attribute(affected_attribute), operation(operation), time(time) {}
-
-Errors StatChange::apply_with_value(Stats& stats, int value) const {
+Errors StatChangeInstruction::apply(Stats& stats) const {
     Errors errors;
+    int value = literal_value;
+    if (value_attribute.has_value()) {
+        std::optional<int> value_optional = stats.get_raw(value_attribute.value());
+        if (!value_optional.has_value()) {
+            errors.add_runtime_error(
+                RuntimeError::Code::INVALID_ARGUMENT,
+                fmt::format("Identifier for stat change value '{}' not found in stats", value_attribute->get_name())
+            );
+            return errors;
+        }
+        value = value_optional.value();
+    }
+
     int& affected_stat = stats.get_raw_mut_or_insert(affected_attribute);
     switch (operation) {
         case StatChangeOperation::ADD:
@@ -58,4 +64,15 @@ Errors StatChange::apply_with_value(Stats& stats, int value) const {
     std::unreachable();
 }
 
+StatChangeTime StatChange::get_time() const { return time; }
+
+const std::string& StatChange::get_affected_attribute() const { return instruction.affected_attribute.get_name(); }
+
+const StatChangeInstruction& StatChange::get_instruction() const { return instruction; }
+
+Errors StatChange::apply(Stats& stats) const { return instruction.apply(stats); }
+
+StatChange::StatChange(StatChangeInstruction&& instruction, StatChangeTime time)
+    : instruction(std::move(instruction)), time(time) {}
+
 } // namespace dnd
@@ -3,10 +3,12 @@
 
 #include <dnd_config.hpp>
 
+#include <optional>
 #include <string>
 #include <string_view>
 
 #include <core/errors/errors.hpp>
+#include <core/models/character/stat_attribute.hpp>
 
 namespace dnd {
 
@@ -35,6 +37,19 @@ enum class StatChangeOperation {
 
 class Stats;
 
+/**
+ * @brief A stat change compiled down to an operation on the slot of the affected attribute and its operand
+ */
+struct StatChangeInstruction {
+    Errors apply(Stats& stats) const;
+
+    StatAttribute affected_attribute;
+    StatChangeOperation operation;
+    // the attribute the operand is read from, or std::nullopt if the operand is the literal value
+    std::optional<StatAttribute> value_attribute;
+    int literal_value;
+};
+
 class StatChange {
 public:
     struct Data;
@@ -43,16 +58,15 @@ public:
 
     StatChangeTime get_time() const;
     const std::string& get_affected_attribute() const;
+    const StatChangeInstruction& get_instruction() const;
 
-    virtual Errors apply(Stats& stats) const = 0;
+    Errors apply(Stats& stats) const;
 protected:
-    StatChange(const std::string& affected_attribute, StatChangeTime time, StatChangeOperation operation);
-    StatChange(std::string_view affected_attribute, StatChangeTime time, StatChangeOperation operation);
+    friend class ContentSerializer;
 
-    Errors apply_with_value(Stats& stats, int value) const;
+    StatChange(StatChangeInstruction&& instruction, StatChangeTime time);
 private:
-    std::string affected_attribute;
-    StatChangeOperation operation;
+    StatChangeInstruction instruction;
     StatChangeTime time;
 };
 
@@ -16,6 +16,7 @@
 #include <core/errors/validation_error.hpp>
 #include <core/models/effects/stat_change/identifier_stat_change.hpp>
 #include <core/models/effects/stat_change/literal_stat_change.hpp>
+#include <core/utils/arena.hpp>
 #include <core/utils/string_manipulation.hpp>
 #include <core/validation/effects/stat_change/stat_change_validation.hpp>
 
@@ -92,9 +93,9 @@ FactoryResult<StatChange> create_stat_change(StatChange::Data&& data) {
 
     const std::string_view value = str_view(++it, data.stat_change_str.cend());
 
-    std::unique_ptr<StatChange> stat_change;
+    ArenaPtr<StatChange> stat_change;
     if (value[0] >= 'A' && value[0] <= 'Z') {
-        stat_change = std::make_unique<IdentifierStatChange>(affected_attribute, stat_change_time, operation, value);
+        stat_change = make_arena_ptr<IdentifierStatChange>(affected_attribute, stat_change_time, operation, value);
     } else if (value == "true" || value == "false") {
         if (operation != StatChangeOperation::SET) {
             Errors sub_errors = Errors(ValidationError(
@@ -103,15 +104,15 @@ FactoryResult<StatChange> create_stat_change(StatChange::Data&& data) {
             ));
             return InvalidFactory<StatChange>(std::move(data), std::move(sub_errors));
         }
-        stat_change = std::make_unique<LiteralStatChange>(
+        stat_change = make_arena_ptr<LiteralStatChange>(
             affected_attribute, stat_change_time, operation, value == "true"
         );
     } else if (value.find('.') != std::string::npos) {
-        stat_change = std::make_unique<LiteralStatChange>(
+        stat_change = make_arena_ptr<LiteralStatChange>(
             affected_attribute, stat_change_time, operation, std::stof(std::string(value))
         );
     } else {
-        stat_change = std::make_unique<LiteralStatChange>(
+        stat_change = make_arena_ptr<LiteralStatChange>(
             affected_attribute, stat_change_time, operation, std::stoi(std::string(value))
         );
     }
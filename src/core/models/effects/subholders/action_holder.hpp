@@ -26,6 +26,8 @@ public:
     bool empty() const;
     void merge(ActionHolder&& other);
 private:
+    friend class ContentSerializer;
+
     ActionHolder(
         std::map<std::string, std::string>&& actions, std::map<std::string, std::string>&& bonus_actions,
         std::map<std::string, std::string>&& reactions
@@ -67,6 +67,8 @@ public:
     bool empty() const;
     void merge(ExtraSpellsHolder&& other);
 private:
+    friend class ContentSerializer;
+
     ExtraSpellsHolder(
         std::vector<const Spell*>&& free_cantrips, std::vector<const Spell*>&& at_will,
         std::vector<const Spell*>&& innate, std::vector<const Spell*>&& free_once_a_day,
@@ -35,6 +35,8 @@ public:
     bool empty() const;
     void merge(ProficiencyHolder&& other);
 private:
+    friend class ContentSerializer;
+
     ProficiencyHolder(
         std::vector<std::string>&& armor, std::vector<std::string>&& weapons, std::vector<std::string>&& tools,
         std::vector<std::string>&& skills, std::vector<std::string>&& saving_throws,
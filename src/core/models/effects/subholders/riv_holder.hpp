@@ -31,6 +31,8 @@ public:
     bool empty() const;
     void merge(RIVHolder&& other);
 private:
+    friend class ContentSerializer;
+
     RIVHolder(
         std::vector<std::string>&& damage_resistances, std::vector<std::string>&& damage_immunities,
         std::vector<std::string>&& damage_vulnerabilities, std::vector<std::string>&& condition_immunities
@@ -12,7 +12,8 @@
 #include <core/models/effects/condition/condition_factory.hpp>
 #include <core/models/effects_provider/choosable.hpp>
 #include <core/models/effects_provider/feature.hpp>
-#include <core/text/text.hpp>
+#include <core/text/formatted_text.hpp>
+#include <core/utils/arena.hpp>
 #include <core/validation/effects_provider/choosable_validation.hpp>
 #include <core/visitors/content/content_visitor.hpp>
 
@@ -23,7 +24,7 @@ CreateResult<Choosable> Choosable::create_for(Data&& data, const Content& conten
     if (!errors.ok()) {
         return InvalidCreate<Choosable>(std::move(data), std::move(errors));
     }
-    std::vector<std::unique_ptr<Condition>> prerequisites;
+    std::vector<ArenaPtr<Condition>> prerequisites;
     prerequisites.reserve(data.prerequisites_data.size());
     for (Condition::Data& prerequisite_data : data.prerequisites_data) {
         FactoryResult<Condition> prerequisite_result = create_condition(std::move(prerequisite_data));
@@ -49,7 +50,7 @@ CreateResult<Choosable> Choosable::create_for(Data&& data, const Content& conten
 
 const std::string& Choosable::get_name() const { return name; }
 
-const Text& Choosable::get_description() const { return description; }
+const FormattedText& Choosable::get_description() const { return description; }
 
 const SourceInfo& Choosable::get_source_info() const { return source_info; }
 
@@ -59,15 +60,15 @@ const Effects& Choosable::get_main_effects() const { return main_effects; }
 
 const std::string& Choosable::get_type() const { return type; }
 
-const std::vector<std::unique_ptr<Condition>>& Choosable::get_prerequisites() const { return prerequisites; }
+const std::vector<ArenaPtr<Condition>>& Choosable::get_prerequisites() const { return prerequisites; }
 
 Choosable::Choosable(
-    std::string&& name, Text&& description, std::filesystem::path&& source_path, std::string&& source_name,
-    std::string&& key, std::string&& type, std::vector<std::unique_ptr<Condition>>&& prerequisites,
+    std::string&& name, FormattedText&& description, std::filesystem::path&& source_path, std::string&& source_name,
+    std::string&& key, std::string&& type, std::vector<ArenaPtr<Condition>>&& prerequisites,
     Effects&& main_effects
 )
     : name(std::move(name)), description(std::move(description)),
-      source_info({.path = std::move(source_path), .name = std::move(source_name)}), key(std::move(key)),
+      source_info({.path = std::move(source_path), .name = InternedString(source_name)}), key(std::move(key)),
       main_effects(std::move(main_effects)), type(type), prerequisites(std::move(prerequisites)) {}
 
 } // namespace dnd
@@ -12,7 +12,9 @@
 #include <core/models/effects/condition/condition.hpp>
 #include <core/models/effects_provider/effects_provider.hpp>
 #include <core/models/effects_provider/feature.hpp>
-#include <core/text/text.hpp>
+#include <core/text/formatted_text.hpp>
+#include <core/utils/arena.hpp>
+#include <core/utils/string_interner.hpp>
 
 namespace dnd {
 
@@ -35,26 +37,28 @@ public:
     Choosable& operator=(Choosable&&) noexcept = default;
 
     const std::string& get_name() const override;
-    const Text& get_description() const override;
+    const FormattedText& get_description() const override;
     const SourceInfo& get_source_info() const override;
     const std::string& get_key() const override;
     const Effects& get_main_effects() const override;
     const std::string& get_type() const;
-    const std::vector<std::unique_ptr<Condition>>& get_prerequisites() const;
+    const std::vector<ArenaPtr<Condition>>& get_prerequisites() const;
 private:
+    friend class ContentSerializer;
+
     Choosable(
-        std::string&& name, Text&& description, std::filesystem::path&& source_path, std::string&& source_name,
-        std::string&& key, std::string&& type, std::vector<std::unique_ptr<Condition>>&& prerequisites,
+        std::string&& name, FormattedText&& description, std::filesystem::path&& source_path, std::string&& source_name,
+        std::string&& key, std::string&& type, std::vector<ArenaPtr<Condition>>&& prerequisites,
         Effects&& main_effects
     );
 
-    std::string name;
-    Text description;
+    InternedString name;
+    FormattedText description;
     SourceInfo source_info;
     std::string key;
     Effects main_effects;
     std::string type;
-    std::vector<std::unique_ptr<Condition>> prerequisites;
+    std::vector<ArenaPtr<Condition>> prerequisites;
 };
 
 struct Choosable::Data : public Feature::Data {
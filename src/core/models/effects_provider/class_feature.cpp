@@ -12,6 +12,7 @@
 #include <core/models/content_piece.hpp>
 #include <core/models/effects/effects.hpp>
 #include <core/models/source_info.hpp>
+#include <core/text/lazy_formatted_text.hpp>
 #include <core/validation/effects_provider/class_feature_validation.hpp>
 #include <core/visitors/content/content_visitor.hpp>
 
@@ -40,8 +41,11 @@ CreateResult<ClassFeature> ClassFeature::create_for(Data&& data, const Content&
         higher_level_effects.emplace(level, effects_result.value());
     }
 
+    LazyFormattedText description = LazyFormattedText::create(
+        std::move(data.description), data.description_source, data.source_path
+    );
     return ValidCreate(ClassFeature(
-        std::move(data.name), std::move(data.description), std::move(data.source_path), std::move(data.source_name),
+        std::move(data.name), std::move(description), std::move(data.source_path), std::move(data.source_name),
         data.get_key(), data.level, std::move(main_effects), std::move(higher_level_effects),
         std::move(data.class_name), std::move(data.class_source_name)
     ));
@@ -56,7 +60,7 @@ const std::string& ClassFeature::get_class_name() const { return class_name; }
 const std::string& ClassFeature::get_class_source_name() const { return class_source_name; }
 
 ClassFeature::ClassFeature(
-    std::string&& name, Text&& description, std::filesystem::path&& source_path, std::string&& source_name,
+    std::string&& name, LazyFormattedText&& description, std::filesystem::path&& source_path, std::string&& source_name,
     std::string&& key, int level, Effects&& main_effects, std::map<int, Effects>&& higher_level_effects,
     std::string&& class_name, std::string&& class_source_name
 )
@@ -11,7 +11,7 @@
 #include <core/models/effects/effects.hpp>
 #include <core/models/effects_provider/feature.hpp>
 #include <core/models/source_info.hpp>
-#include <core/text/text.hpp>
+#include <core/text/formatted_text.hpp>
 #include <core/validation/effects_provider/feature_validation.hpp>
 
 namespace dnd {
@@ -39,10 +39,12 @@ public:
     const std::string& get_class_name() const;
     const std::string& get_class_source_name() const;
 private:
+    friend class ContentSerializer;
+
     ClassFeature(
-        std::string&& name, Text&& description, std::filesystem::path&& source_path, std::string&& source_name,
-        std::string&& key, int level, Effects&& main_effects, std::map<int, Effects>&& higher_level_parts,
-        std::string&& class_name, std::string&& class_source_name
+        std::string&& name, LazyFormattedText&& description, std::filesystem::path&& source_path,
+        std::string&& source_name, std::string&& key, int level, Effects&& main_effects, std::map<int,
+        Effects>&& higher_level_parts, std::string&& class_name, std::string&& class_source_name
     );
 
     int level;
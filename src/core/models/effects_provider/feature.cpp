@@ -11,7 +11,8 @@
 #include <core/models/content_piece.hpp>
 #include <core/models/effects/effects.hpp>
 #include <core/models/source_info.hpp>
-#include <core/text/text.hpp>
+#include <core/text/lazy_formatted_text.hpp>
+#include <core/text/formatted_text.hpp>
 #include <core/validation/effects_provider/feature_validation.hpp>
 #include <core/visitors/content/content_visitor.hpp>
 
@@ -30,15 +31,18 @@ CreateResult<Feature> Feature::create_for(Data&& data, const Content& content) {
     }
     Effects main_part = main_effects_result.value();
 
+    LazyFormattedText description = LazyFormattedText::create(
+        std::move(data.description), data.description_source, data.source_path
+    );
     return ValidCreate(Feature(
-        std::move(data.name), std::move(data.description), std::move(data.source_path), std::move(data.source_name),
+        std::move(data.name), std::move(description), std::move(data.source_path), std::move(data.source_name),
         data.get_key(), std::move(main_part)
     ));
 }
 
 const std::string& Feature::get_name() const { return name; }
 
-const Text& Feature::get_description() const { return description; }
+const FormattedText& Feature::get_description() const { return description.get(); }
 
 const SourceInfo& Feature::get_source_info() const { return source_info; }
 
@@ -47,11 +51,11 @@ const std::string& Feature::get_key() const { return key; }
 const Effects& Feature::get_main_effects() const { return main_effects; }
 
 Feature::Feature(
-    std::string&& name, Text&& description, std::filesystem::path&& source_path, std::string&& source_name,
+    std::string&& name, LazyFormattedText&& description, std::filesystem::path&& source_path, std::string&& source_name,
     std::string&& key, Effects&& main_effects
 )
     : name(std::move(name)), description(std::move(description)),
-      source_info({.path = std::move(source_path), .name = std::move(source_name)}), key(std::move(key)),
+      source_info({.path = std::move(source_path), .name = InternedString(source_name)}), key(std::move(key)),
       main_effects(std::move(main_effects)) {}
 
 } // namespace dnd
@@ -11,7 +11,9 @@
 #include <core/models/effects/effects.hpp>
 #include <core/models/effects_provider/effects_provider.hpp>
 #include <core/models/source_info.hpp>
-#include <core/text/text.hpp>
+#include <core/text/formatted_text.hpp>
+#include <core/text/lazy_formatted_text.hpp>
+#include <core/utils/string_interner.hpp>
 #include <core/validation/effects/effects_validation.hpp>
 #include <core/validation/validation_data.hpp>
 
@@ -32,18 +34,20 @@ public:
     Feature& operator=(Feature&&) noexcept = default;
 
     const std::string& get_name() const override;
-    const Text& get_description() const override;
+    const FormattedText& get_description() const override;
     const SourceInfo& get_source_info() const override;
     const std::string& get_key() const override;
     const Effects& get_main_effects() const override;
 protected:
+    friend class ContentSerializer;
+
     Feature(
-        std::string&& name, Text&& description, std::filesystem::path&& source_path, std::string&& source_name,
-        std::string&& key, Effects&& main_effects
+        std::string&& name, LazyFormattedText&& description, std::filesystem::path&& source_path,
+        std::string&& source_name, std::string&& key, Effects&& main_effects
     );
 private:
-    std::string name;
-    Text description;
+    InternedString name;
+    LazyFormattedText description;
     SourceInfo source_info;
     std::string key;
     Effects main_effects;
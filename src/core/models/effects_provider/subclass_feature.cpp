@@ -12,6 +12,7 @@
 #include <core/models/content_piece.hpp>
 #include <core/models/effects/effects.hpp>
 #include <core/models/source_info.hpp>
+#include <core/text/lazy_formatted_text.hpp>
 #include <core/validation/effects_provider/subclass_feature_validation.hpp>
 #include <core/visitors/content/content_visitor.hpp>
 
@@ -39,8 +40,11 @@ CreateResult<SubclassFeature> SubclassFeature::create_for(Data&& data, const Con
         }
         higher_level_effects.emplace(level, effects_result.value());
     }
+    LazyFormattedText description = LazyFormattedText::create(
+        std::move(data.description), data.description_source, data.source_path
+    );
     return ValidCreate(SubclassFeature(
-        std::move(data.name), std::move(data.description), std::move(data.source_path), std::move(data.source_name),
+        std::move(data.name), std::move(description), std::move(data.source_path), std::move(data.source_name),
         data.get_key(), data.level, std::move(main_effects), std::move(higher_level_effects),
         std::move(data.subclass_short_name), std::move(data.subclass_source_name)
     ));
@@ -55,7 +59,7 @@ const std::string& SubclassFeature::get_subclass_short_name() const { return sub
 const std::string& SubclassFeature::get_subclass_source_name() const { return subclass_source_name; }
 
 SubclassFeature::SubclassFeature(
-    std::string&& name, Text&& description, std::filesystem::path&& source_path, std::string&& source_name,
+    std::string&& name, LazyFormattedText&& description, std::filesystem::path&& source_path, std::string&& source_name,
     std::string&& key, int level, Effects&& main_effects, std::map<int, Effects>&& higher_level_effects,
     std::string&& subclass_short_name, std::string&& subclass_source_name
 )
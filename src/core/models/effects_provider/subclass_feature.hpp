@@ -38,10 +38,12 @@ public:
     const std::string& get_subclass_short_name() const;
     const std::string& get_subclass_source_name() const;
 private:
+    friend class ContentSerializer;
+
     SubclassFeature(
-        std::string&& name, Text&& description, std::filesystem::path&& source_path, std::string&& source_name,
-        std::string&& key, int level, Effects&& main_effects, std::map<int, Effects>&& higher_level_parts,
-        std::string&& subclass_short_name, std::string&& subclass_source_name
+        std::string&& name, LazyFormattedText&& description, std::filesystem::path&& source_path,
+        std::string&& source_name, std::string&& key, int level, Effects&& main_effects, std::map<int,
+        Effects>&& higher_level_parts, std::string&& subclass_short_name, std::string&& subclass_source_name
     );
 
     std::string key;
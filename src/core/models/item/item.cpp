@@ -29,22 +29,22 @@ CreateResult<Item> Item::create(Data&& data) {
 
 const std::string& Item::get_name() const { return name; }
 
-const Text& Item::get_description() const { return description; }
+const FormattedText& Item::get_description() const { return description; }
 
 const SourceInfo& Item::get_source_info() const { return source_info; }
 
 const std::string& Item::get_key() const { return key; }
 
-const Text& Item::get_cosmetic_description() const { return cosmetic_description; }
+const FormattedText& Item::get_cosmetic_description() const { return cosmetic_description; }
 
 bool Item::requires_attunement() const { return attunement; }
 
 Item::Item(
-    std::string&& name, Text&& description, std::filesystem::path&& source_path, std::string&& source_name,
-    std::string&& key, Text&& cosmetic_description, bool requires_attunement
+    std::string&& name, FormattedText&& description, std::filesystem::path&& source_path, std::string&& source_name,
+    std::string&& key, FormattedText&& cosmetic_description, bool requires_attunement
 )
     : name(std::move(name)), description(std::move(description)),
-      source_info({.path = std::move(source_path), .name = std::move(source_name)}), key(std::move(key)),
+      source_info({.path = std::move(source_path), .name = InternedString(source_name)}), key(std::move(key)),
       cosmetic_description(std::move(cosmetic_description)), attunement(requires_attunement) {}
 
 } // namespace dnd
@@ -10,7 +10,8 @@
 #include <core/data_result.hpp>
 #include <core/models/content_piece.hpp>
 #include <core/models/source_info.hpp>
-#include <core/text/text.hpp>
+#include <core/text/formatted_text.hpp>
+#include <core/utils/string_interner.hpp>
 
 namespace dnd {
 
@@ -23,29 +24,31 @@ public:
     static CreateResult<Item> create(Data&& item_data);
 
     const std::string& get_name() const override;
-    const Text& get_description() const override;
+    const FormattedText& get_description() const override;
     const SourceInfo& get_source_info() const override;
     const std::string& get_key() const override;
-    const Text& get_cosmetic_description() const;
+    const FormattedText& get_cosmetic_description() const;
     bool requires_attunement() const;
 private:
+    friend class ContentSerializer;
+
     Item(
-        std::string&& name, Text&& description, std::filesystem::path&& source_path, std::string&& source_name,
-        std::string&& key, Text&& cosmetic_description, bool requires_attunement
+        std::string&& name, FormattedText&& description, std::filesystem::path&& source_path, std::string&& source_name,
+        std::string&& key, FormattedText&& cosmetic_description, bool requires_attunement
     );
 
-    std::string name;
-    Text description;
+    InternedString name;
+    FormattedText description;
     SourceInfo source_info;
     std::string key;
-    Text cosmetic_description;
+    FormattedText cosmetic_description;
     bool attunement;
 };
 
 struct Item::Data : public ValidationData {
     std::strong_ordering operator<=>(const Data&) const = default;
 
-    Text cosmetic_description;
+    FormattedText cosmetic_description;
     bool requires_attunement;
 };
 
@@ -6,11 +6,13 @@
 #include <filesystem>
 #include <string>
 
+#include <core/utils/string_interner.hpp>
+
 namespace dnd {
 
 struct SourceInfo {
     std::filesystem::path path;
-    std::string name;
+    InternedString name;
 };
 
 } // namespace dnd
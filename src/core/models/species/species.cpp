@@ -11,7 +11,7 @@
 #include <core/errors/errors.hpp>
 #include <core/exceptions/validation_exceptions.hpp>
 #include <core/models/source_info.hpp>
-#include <core/text/text.hpp>
+#include <core/text/formatted_text.hpp>
 #include <core/validation/species/species_validation.hpp>
 #include <core/visitors/content/content_visitor.hpp>
 
@@ -40,7 +40,7 @@ CreateResult<Species> Species::create_for(Data&& data, const Content& content) {
 
 const std::string& Species::get_name() const { return name; }
 
-const Text& Species::get_description() const { return description; }
+const FormattedText& Species::get_description() const { return description; }
 
 const SourceInfo& Species::get_source_info() const { return source_info; }
 
@@ -49,11 +49,11 @@ const std::string& Species::get_key() const { return key; }
 const std::vector<Feature>& Species::get_features() const { return features; }
 
 Species::Species(
-    std::string&& name, Text&& description, std::filesystem::path&& source_path, std::string&& source_name,
+    std::string&& name, FormattedText&& description, std::filesystem::path&& source_path, std::string&& source_name,
     std::string&& key, std::vector<Feature>&& features
 )
     : name(std::move(name)), description(std::move(description)),
-      source_info({.path = std::move(source_path), .name = std::move(source_name)}), key(std::move(key)),
+      source_info({.path = std::move(source_path), .name = InternedString(source_name)}), key(std::move(key)),
       features(std::move(features)) {}
 
 } // namespace dnd
@@ -12,7 +12,8 @@
 #include <core/models/content_piece.hpp>
 #include <core/models/effects_provider/feature.hpp>
 #include <core/models/source_info.hpp>
-#include <core/text/text.hpp>
+#include <core/text/formatted_text.hpp>
+#include <core/utils/string_interner.hpp>
 
 namespace dnd {
 
@@ -31,18 +32,20 @@ public:
     Species& operator=(Species&&) noexcept = default;
 
     const std::string& get_name() const override;
-    const Text& get_description() const override;
+    const FormattedText& get_description() const override;
     const SourceInfo& get_source_info() const override;
     const std::string& get_key() const override;
     const std::vector<Feature>& get_features() const;
 private:
+    friend class ContentSerializer;
+
     Species(
-        std::string&& name, Text&& description, std::filesystem::path&& source_path, std::string&& source_name,
+        std::string&& name, FormattedText&& description, std::filesystem::path&& source_path, std::string&& source_name,
         std::string&& key, std::vector<Feature>&& features
     );
 
-    std::string name;
-    Text description;
+    InternedString name;
+    FormattedText description;
     SourceInfo source_info;
     std::string key;
     std::vector<Feature> features;
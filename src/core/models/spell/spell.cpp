@@ -4,6 +4,7 @@
 #include "spell.hpp"
 
 #include <filesystem>
+#include <memory_resource>
 #include <set>
 #include <string>
 #include <utility>
@@ -12,6 +13,8 @@
 #include <core/models/content_piece.hpp>
 #include <core/models/spell/spell_components.hpp>
 #include <core/models/spell/spell_type.hpp>
+#include <core/utils/arena.hpp>
+#include <core/utils/string_interner.hpp>
 #include <core/validation/spell/spell_validation.hpp>
 #include <core/visitors/content/content_visitor.hpp>
 
@@ -37,8 +40,11 @@ CreateResult<Spell> Spell::create(Data&& data) {
     }
     SpellType type = type_result.value();
 
+    LazyFormattedText description = LazyFormattedText::create(
+        std::move(data.description), data.description_source, data.source_path
+    );
     return ValidCreate(Spell(
-        std::move(data.name), std::move(data.description), std::move(data.source_path), std::move(data.source_name),
+        std::move(data.name), std::move(description), std::move(data.source_path), std::move(data.source_name),
         data.get_key(), std::move(components), std::move(type), data.concentration, std::move(data.casting_time),
         std::move(data.range), std::move(data.duration), std::move(data.classes)
     ));
@@ -46,7 +52,7 @@ CreateResult<Spell> Spell::create(Data&& data) {
 
 const std::string& Spell::get_name() const { return name; }
 
-const Text& Spell::get_description() const { return description; }
+const FormattedText& Spell::get_description() const { return description.get(); }
 
 const SourceInfo& Spell::get_source_info() const { return source_info; }
 
@@ -64,17 +70,21 @@ const std::string& Spell::get_range() const { return range; }
 
 const std::string& Spell::get_duration() const { return duration; }
 
-const std::set<std::string>& Spell::get_classes() const { return classes; }
+const std::pmr::set<InternedString>& Spell::get_classes() const { return classes; }
 
 Spell::Spell(
-    std::string&& name, Text&& description, std::filesystem::path&& source_path, std::string&& source_name,
+    std::string&& name, LazyFormattedText&& description, std::filesystem::path&& source_path, std::string&& source_name,
     std::string&& key, SpellComponents&& components, SpellType&& type, bool concentration, std::string&& casting_time,
     std::string&& range, std::string&& duration, std::set<std::string>&& classes
 )
     : name(std::move(name)), description(std::move(description)),
-      source_info({.path = std::move(source_path), .name = std::move(source_name)}), key(std::move(key)),
+      source_info({.path = std::move(source_path), .name = InternedString(source_name)}), key(std::move(key)),
       components(std::move(components)), type(std::move(type)), concentration(concentration),
       casting_time(std::move(casting_time)), range(std::move(range)), duration(std::move(duration)),
-      classes(std::move(classes)) {}
+      classes(get_model_resource()) {
+    for (const std::string& class_name : classes) {
+        this->classes.emplace_hint(this->classes.end(), class_name);
+    }
+}
 
 } // namespace dnd
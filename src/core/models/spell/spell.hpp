@@ -5,6 +5,7 @@
 
 #include <compare>
 #include <filesystem>
+#include <memory_resource>
 #include <set>
 #include <string>
 
@@ -12,7 +13,9 @@
 #include <core/models/source_info.hpp>
 #include <core/models/spell/spell_components.hpp>
 #include <core/models/spell/spell_type.hpp>
-#include <core/text/text.hpp>
+#include <core/text/formatted_text.hpp>
+#include <core/text/lazy_formatted_text.hpp>
+#include <core/utils/string_interner.hpp>
 
 namespace dnd {
 
@@ -25,7 +28,7 @@ public:
     static CreateResult<Spell> create(Data&& spell_data);
 
     const std::string& get_name() const override;
-    const Text& get_description() const override;
+    const FormattedText& get_description() const override;
     const SourceInfo& get_source_info() const override;
     const std::string& get_key() const override;
     const SpellComponents& get_components() const;
@@ -34,16 +37,19 @@ public:
     const std::string& get_casting_time() const;
     const std::string& get_range() const;
     const std::string& get_duration() const;
-    const std::set<std::string>& get_classes() const;
+    const std::pmr::set<InternedString>& get_classes() const;
 private:
+    friend class ContentSerializer;
+
     Spell(
-        std::string&& name, Text&& description, std::filesystem::path&& source_path, std::string&& source_name,
-        std::string&& key, SpellComponents&& components, SpellType&& type, bool concentration,
-        std::string&& casting_time, std::string&& range, std::string&& duration, std::set<std::string>&& classes
+        std::string&& name, LazyFormattedText&& description, std::filesystem::path&& source_path,
+        std::string&& source_name, std::string&& key, SpellComponents&& components, SpellType&& type,
+        bool concentration, std::string&& casting_time, std::string&& range, std::string&& duration,
+        std::set<std::string>&& classes
     );
 
-    std::string name;
-    Text description;
+    InternedString name;
+    LazyFormattedText description;
     SourceInfo source_info;
     std::string key;
     SpellComponents components;
@@ -52,7 +58,8 @@ private:
     std::string casting_time;
     std::string range;
     std::string duration;
-    std::set<std::string> classes;
+    // allocated from the model resource like the description, there is one set for each of the many spells
+    std::pmr::set<InternedString> classes;
 };
 
 struct Spell::Data : public ValidationData {
@@ -22,6 +22,8 @@ public:
     int get_cantrips_known(int class_level) const;
     int get_spell_slots(int spell_slot_level, int class_level) const;
 protected:
+    friend class ContentSerializer;
+
     Spellcasting(
         Ability spellcasting_ability, bool ritual_casting, std::array<int, 20>&& cantrips_known,
         std::array<std::array<int, 20>, 9>&& spell_slots
@@ -16,6 +16,7 @@
 #include <core/models/spellcasting/preparation_spellcasting.hpp>
 #include <core/models/spellcasting/spellcasting.hpp>
 #include <core/models/spellcasting/spells_known_spellcasting.hpp>
+#include <core/utils/arena.hpp>
 #include <core/validation/spellcasting/spellcasting_validation.hpp>
 
 namespace dnd {
@@ -40,20 +41,20 @@ FactoryResult<Spellcasting> create_spellcasting(Spellcasting::Data&& data) {
     }
     Ability ability = ability_optional.value();
 
-    std::unique_ptr<Spellcasting> spellcasting;
+    ArenaPtr<Spellcasting> spellcasting;
     if (data.is_spells_known_type) {
-        spellcasting = std::make_unique<SpellsKnownSpellcasting>(
+        spellcasting = make_arena_ptr<SpellsKnownSpellcasting>(
             ability, data.ritual_casting, std::move(data.cantrips_known), std::move(data.spell_slots),
             std::move(data.spells_known)
         );
     } else if (data.preparation_spellcasting_type == "half" || data.preparation_spellcasting_type == "subclass") {
         // HACK: for now, put all subclass spellcaster into "half" bucket - needs to be implemented separetely
-        spellcasting = std::make_unique<PreparationSpellcasting>(
+        spellcasting = make_arena_ptr<PreparationSpellcasting>(
             ability, data.ritual_casting, std::move(data.cantrips_known), std::move(data.spell_slots),
             PreparationSpellcastingType::HALF
         );
     } else if (data.preparation_spellcasting_type == "full") {
-        spellcasting = std::make_unique<PreparationSpellcasting>(
+        spellcasting = make_arena_ptr<PreparationSpellcasting>(
             ability, data.ritual_casting, std::move(data.cantrips_known), std::move(data.spell_slots),
             PreparationSpellcastingType::FULL
         );
@@ -19,6 +19,8 @@ public:
 
     int get_spells_known(int level) const;
 private:
+    friend class ContentSerializer;
+
     std::array<int, 20> spells_known;
 };
 
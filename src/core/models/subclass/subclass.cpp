@@ -15,6 +15,7 @@
 #include <core/models/source_info.hpp>
 #include <core/models/species/species.hpp>
 #include <core/models/spellcasting/spellcasting_factory.hpp>
+#include <core/utils/arena.hpp>
 #include <core/validation/subclass/subclass_validation.hpp>
 #include <core/visitors/content/content_visitor.hpp>
 
@@ -42,7 +43,7 @@ CreateResult<Subclass> Subclass::create_for(Data&& data, const Content& content)
         auto [_, sub_errors] = spellcasting_result.data_and_errors();
         return InvalidCreate<Subclass>(std::move(data), std::move(sub_errors));
     }
-    std::unique_ptr<Spellcasting> spellcasting = spellcasting_result.value();
+    ArenaPtr<Spellcasting> spellcasting = spellcasting_result.value();
 
     return ValidCreate(Subclass(
         std::move(data.name), std::move(data.description), std::move(data.source_path), std::move(data.source_name),
@@ -52,7 +53,7 @@ CreateResult<Subclass> Subclass::create_for(Data&& data, const Content& content)
 
 const std::string& Subclass::get_name() const { return name; }
 
-const Text& Subclass::get_description() const { return description; }
+const FormattedText& Subclass::get_description() const { return description; }
 
 const SourceInfo& Subclass::get_source_info() const { return source_info; }
 
@@ -75,12 +76,12 @@ std::string Subclass::Data::key(
 }
 
 Subclass::Subclass(
-    std::string&& name, Text&& description, std::filesystem::path&& source_path, std::string&& source_name,
+    std::string&& name, FormattedText&& description, std::filesystem::path&& source_path, std::string&& source_name,
     std::string&& key, std::string&& short_name, std::vector<SubclassFeature>&& features, Id class_id,
-    std::unique_ptr<Spellcasting>&& spellcasting
+    ArenaPtr<Spellcasting>&& spellcasting
 )
     : name(std::move(name)), description(std::move(description)),
-      source_info({.path = std::move(source_path), .name = std::move(source_name)}), key(std::move(key)),
+      source_info({.path = std::move(source_path), .name = InternedString(source_name)}), key(std::move(key)),
       short_name(std::move(short_name)), features(std::move(features)), class_id(class_id),
       spellcasting(std::move(spellcasting)) {}
 
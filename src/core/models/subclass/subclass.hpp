@@ -14,8 +14,10 @@
 #include <core/models/effects_provider/subclass_feature.hpp>
 #include <core/models/source_info.hpp>
 #include <core/models/spellcasting/spellcasting.hpp>
-#include <core/text/text.hpp>
+#include <core/text/formatted_text.hpp>
 #include <core/types.hpp>
+#include <core/utils/arena.hpp>
+#include <core/utils/string_interner.hpp>
 
 namespace dnd {
 
@@ -34,7 +36,7 @@ public:
 
     const std::string& get_name() const override;
     const std::string& get_short_name() const;
-    const Text& get_description() const override;
+    const FormattedText& get_description() const override;
     const SourceInfo& get_source_info() const override;
     const std::string& get_key() const override;
     const std::vector<SubclassFeature>& get_features() const;
@@ -42,20 +44,22 @@ public:
     const Spellcasting* get_spellcasting() const;
     Id get_class_id() const;
 private:
+    friend class ContentSerializer;
+
     Subclass(
-        std::string&& name, Text&& description, std::filesystem::path&& source_path, std::string&& source_name,
+        std::string&& name, FormattedText&& description, std::filesystem::path&& source_path, std::string&& source_name,
         std::string&& key, std::string&& short_name, std::vector<SubclassFeature>&& features, Id class_id,
-        std::unique_ptr<Spellcasting>&& spellcasting = nullptr
+        ArenaPtr<Spellcasting>&& spellcasting = nullptr
     );
 
-    std::string name;
-    Text description;
+    InternedString name;
+    FormattedText description;
     SourceInfo source_info;
     std::string key;
     std::string short_name;
     std::vector<SubclassFeature> features;
     Id class_id;
-    std::unique_ptr<Spellcasting> spellcasting;
+    ArenaPtr<Spellcasting> spellcasting;
 };
 
 struct Subclass::Data : public ValidationData {
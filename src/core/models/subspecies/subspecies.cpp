@@ -44,7 +44,7 @@ CreateResult<Subspecies> Subspecies::create_for(Data&& data, const Content& cont
 
 const std::string& Subspecies::get_name() const { return name; }
 
-const Text& Subspecies::get_description() const { return description; }
+const FormattedText& Subspecies::get_description() const { return description; }
 
 const SourceInfo& Subspecies::get_source_info() const { return source_info; }
 
@@ -55,11 +55,11 @@ const std::vector<Feature>& Subspecies::get_features() const { return features;
 CRef<Species> Subspecies::get_species() const { return species; }
 
 Subspecies::Subspecies(
-    std::string&& name, Text&& description, std::filesystem::path&& source_path, std::string&& source_name,
+    std::string&& name, FormattedText&& description, std::filesystem::path&& source_path, std::string&& source_name,
     std::string&& key, std::vector<Feature>&& features, CRef<Species> species
 )
     : name(std::move(name)), description(std::move(description)),
-      source_info({.path = std::move(source_path), .name = std::move(source_name)}), key(std::move(key)),
+      source_info({.path = std::move(source_path), .name = InternedString(source_name)}), key(std::move(key)),
       features(std::move(features)), species(species) {}
 
 } // namespace dnd
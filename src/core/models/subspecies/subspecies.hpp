@@ -13,8 +13,9 @@
 #include <core/models/effects_provider/feature.hpp>
 #include <core/models/source_info.hpp>
 #include <core/models/species/species.hpp>
-#include <core/text/text.hpp>
+#include <core/text/formatted_text.hpp>
 #include <core/types.hpp>
+#include <core/utils/string_interner.hpp>
 
 namespace dnd {
 
@@ -33,19 +34,21 @@ public:
     Subspecies& operator=(Subspecies&&) noexcept = default;
 
     const std::string& get_name() const override;
-    const Text& get_description() const override;
+    const FormattedText& get_description() const override;
     const SourceInfo& get_source_info() const override;
     const std::string& get_key() const override;
     const std::vector<Feature>& get_features() const;
     CRef<Species> get_species() const;
 private:
+    friend class ContentSerializer;
+
     Subspecies(
-        std::string&& name, Text&& description, std::filesystem::path&& source_path, std::string&& source_name,
+        std::string&& name, FormattedText&& description, std::filesystem::path&& source_path, std::string&& source_name,
         std::string&& key, std::vector<Feature>&& features, CRef<Species> species
     );
 
-    std::string name;
-    Text description;
+    InternedString name;
+    FormattedText description;
     SourceInfo source_info;
     std::string key;
     std::vector<Feature> features;
@@ -4,11 +4,11 @@
 #include <dnd_config.hpp>
 
 #include <core/output/latex_builder/latex_scope.hpp>
-#include <core/text/text.hpp>
+#include <core/text/formatted_text.hpp>
 
 namespace dnd {
 
-std::vector<LatexScope> text_to_latex(const Text& text);
+std::vector<LatexScope> text_to_latex(const FormattedText& text);
 
 } // namespace dnd
 
@@ -2,6 +2,7 @@
 
 #include "character_parsing.hpp"
 
+#include <cstdint>
 #include <filesystem>
 #include <optional>
 #include <string>
@@ -15,6 +16,8 @@
 #include <core/errors/errors.hpp>
 #include <core/models/character/character.hpp>
 #include <core/parsing/parser.hpp>
+#include <core/text/formatted_text.hpp>
+#include <core/text/formatted_text_writer.hpp>
 
 namespace dnd {
 
@@ -178,7 +181,10 @@ WithErrors<Character::Data> parse_character(const nlohmann::json& obj, const std
 
     if (obj.contains("_meta")) {
         // HACK: add meta JSON as description as that (for now) mostly includes unsupported features and decisions
-        character_data.description.parts.emplace_back(Paragraph::simple(obj["_meta"].dump(8)));
+        FormattedTextWriter writer(character_data.description);
+        uint32_t meta_paragraph_index = writer.begin_node(FormattedTextNodeType::PARAGRAPH);
+        writer.end_node(writer.begin_node(FormattedTextNodeType::SIMPLE_TEXT, obj["_meta"].dump(8)));
+        writer.end_node(meta_paragraph_index);
     }
 
     // character_data.features_data; // TODO: do I want character features?
@@ -2,8 +2,11 @@
 
 #include "choosable_parsing.hpp"
 
+#include <cstdint>
 #include <expected>
 #include <filesystem>
+#include <string>
+#include <string_view>
 
 #include <nlohmann/json.hpp>
 
@@ -11,9 +14,18 @@
 #include <core/models/effects_provider/choosable.hpp>
 #include <core/parsing/choice_parsing.hpp>
 #include <core/parsing/parser.hpp>
+#include <core/text/formatted_text.hpp>
+#include <core/text/formatted_text_writer.hpp>
 
 namespace dnd {
 
+static void add_ability_score_increase(FormattedTextWriter& writer, std::string_view increase) {
+    uint32_t paragraph_index = writer.begin_node(FormattedTextNodeType::PARAGRAPH);
+    writer.end_node(writer.begin_node(FormattedTextNodeType::SIMPLE_TEXT, "Ability Score Increase. ", true, false));
+    writer.end_node(writer.begin_node(FormattedTextNodeType::SIMPLE_TEXT, increase));
+    writer.end_node(paragraph_index);
+}
+
 static WithErrors<Choosable::Data> parse_choosable(const nlohmann::json& obj, const std::filesystem::path& filepath) {
     WithErrors<Choosable::Data> result;
     Choosable::Data& choosable_data = result.value;
@@ -27,7 +39,8 @@ static WithErrors<Choosable::Data> parse_choosable(const nlohmann::json& obj, co
     // choosable_data.main_effects_data;
     // choosable_data.prerequisites_data;
 
-    choosable_data.description = Text{};
+    choosable_data.description = FormattedText{};
+    FormattedTextWriter writer(choosable_data.description);
 
     std::optional<Error> error;
 
@@ -36,10 +49,13 @@ static WithErrors<Choosable::Data> parse_choosable(const nlohmann::json& obj, co
         && obj["entries"][0].is_string()) {
         std::string first_string = obj["entries"][0].get<std::string>();
         if (first_string.find("following") != std::string::npos || first_string.ends_with("benefits:")) {
-            Paragraph first_paragaph{};
-            error = parse_paragraph(std::move(first_string), first_paragaph, filepath);
-            if (!error.has_value()) {
-                choosable_data.description.parts.push_back(first_paragaph);
+            FormattedTextWriter::Mark mark = writer.mark();
+            uint32_t first_paragraph_index = writer.begin_node(FormattedTextNodeType::PARAGRAPH);
+            error = parse_paragraph(first_string, writer, filepath);
+            writer.end_node(first_paragraph_index);
+            if (error.has_value()) {
+                writer.reset_to(mark);
+            } else {
                 skip_first_description_entry = true;
             }
         }
@@ -93,44 +109,17 @@ static WithErrors<Choosable::Data> parse_choosable(const nlohmann::json& obj, co
             }
 
             if (!direct.empty()) {
-                Paragraph direct_paragraph{};
-                direct_paragraph.parts.push_back(
-                    SimpleText{
-                        .str = "Ability Score Increase. ",
-                        .bold = true,
-                        .italic = false,
-                    }
-                );
-                direct_paragraph.parts.push_back(
-                    SimpleText{
-                        .str = fmt::format("Increase your {} by 1, to a maximum of 20.", and_of_strings(direct)),
-                        .bold = false,
-                        .italic = false,
-                    }
+                add_ability_score_increase(
+                    writer, fmt::format("Increase your {} by 1, to a maximum of 20.", and_of_strings(direct))
                 );
-                choosable_data.description.parts.push_back(direct_paragraph);
             }
 
             for (auto& [choice, max_score] : choices) {
-                Paragraph choice_paragraph{};
-                choice_paragraph.parts.push_back(
-                    SimpleText{
-                        .str = "Ability Score Increase. ",
-                        .bold = true,
-                        .italic = false,
-                    }
-                );
-                choice_paragraph.parts.push_back(
-                    SimpleText{
-                        .str = fmt::format(
-                            "Increase your {} by {}, to a maximum of {}.", or_of_strings(choice.options), choice.amount,
-                            max_score
-                        ),
-                        .bold = false,
-                        .italic = false,
-                    }
+                std::string increase = fmt::format(
+                    "Increase your {} by {}, to a maximum of {}.", or_of_strings(choice.options), choice.amount,
+                    max_score
                 );
-                choosable_data.description.parts.push_back(choice_paragraph);
+                add_ability_score_increase(writer, increase);
             }
         }
     }
@@ -13,9 +13,11 @@
 #include <core/errors/errors.hpp>
 #include <core/models/class/class.hpp>
 #include <core/models/effects_provider/class_feature.hpp>
+#include <core/parsing/lazy_text_parsing.hpp>
 #include <core/parsing/parser.hpp>
+#include <core/text/formatted_text.hpp>
 #include <core/text/rich_text.hpp>
-#include <core/text/text.hpp>
+#include <core/text/text_source.hpp>
 
 namespace dnd {
 
@@ -312,7 +314,7 @@ WithErrors<Class::Data> parse_class(const nlohmann::ordered_json& obj, const std
 
 Errors parse_class_feature(
     const nlohmann::ordered_json& obj, const std::filesystem::path& filepath,
-    std::map<std::string, Class::Data>& parsed_classes
+    std::map<std::string, Class::Data>& parsed_classes, const std::optional<TextSource>& description_source
 ) {
     Errors errors;
 
@@ -337,7 +339,11 @@ Errors parse_class_feature(
     errors += parse_required_attribute_into(obj, "name", feature_data.name, filepath);
     errors += parse_required_attribute_into(obj, "source", feature_data.source_name, filepath);
     errors += parse_required_attribute_into(obj, "level", feature_data.level, filepath);
-    errors += write_formatted_text_into(obj, feature_data.description, filepath);
+    if (description_source.has_value()) {
+        errors += defer_description_parsing(obj, filepath, description_source.value(), feature_data);
+    } else {
+        errors += write_formatted_text_into(obj, feature_data.description, filepath);
+    }
 
     return errors;
 }
@@ -364,7 +370,7 @@ WithErrors<Subclass::Data> parse_subclass(const nlohmann::ordered_json& obj, con
 
 Errors parse_subclass_feature(
     const nlohmann::ordered_json& obj, const std::filesystem::path& filepath,
-    std::map<std::string, Subclass::Data>& parsed_subclasses
+    std::map<std::string, Subclass::Data>& parsed_subclasses, const std::optional<TextSource>& description_source
 ) {
     Errors errors;
 
@@ -400,12 +406,14 @@ Errors parse_subclass_feature(
         errors += parse_required_attribute_into(obj, "classSource", copy_class_source, filepath);
         errors += parse_required_attribute_into(obj, "subclassShortName", copy_subclass_short_name, filepath);
         errors += parse_required_attribute_into(obj, "subclassSource", copy_subclass_source, filepath);
-        feature_data.description = Text::simple(
+        feature_data.description = FormattedText::simple(
             fmt::format(
                 "Copy of {}-{} of {}-{} ({}-{})", copy_name, copy_source, copy_subclass_short_name,
                 copy_subclass_source, copy_class_name, copy_class_source
             )
         );
+    } else if (description_source.has_value()) {
+        errors += defer_description_parsing(obj, filepath, description_source.value(), feature_data);
     } else {
         errors += write_formatted_text_into(obj, feature_data.description, filepath);
     }
@@ -4,24 +4,30 @@
 #include <dnd_config.hpp>
 
 #include <filesystem>
+#include <map>
+#include <optional>
+#include <string>
 
 #include <nlohmann/json.hpp>
 
 #include <core/errors/errors.hpp>
 #include <core/models/class/class.hpp>
 #include <core/models/subclass/subclass.hpp>
+#include <core/text/text_source.hpp>
 
 namespace dnd {
 
 WithErrors<Class::Data> parse_class(const nlohmann::ordered_json& obj, const std::filesystem::path& filepath);
 Errors parse_class_feature(
     const nlohmann::ordered_json& obj, const std::filesystem::path& filepath,
-    std::map<std::string, Class::Data>& parsed_classes
+    std::map<std::string, Class::Data>& parsed_classes,
+    const std::optional<TextSource>& description_source = std::nullopt
 );
 WithErrors<Subclass::Data> parse_subclass(const nlohmann::ordered_json& obj, const std::filesystem::path& filepath);
 Errors parse_subclass_feature(
     const nlohmann::ordered_json& obj, const std::filesystem::path& filepath,
-    std::map<std::string, Subclass::Data>& parsed_subclasses
+    std::map<std::string, Subclass::Data>& parsed_subclasses,
+    const std::optional<TextSource>& description_source = std::nullopt
 );
 
 } // namespace dnd
@@ -0,0 +1,160 @@
+#include <dnd_config.hpp>
+
+#include "content_file_index.hpp"
+
+#include <deque>
+#include <filesystem>
+#include <initializer_list>
+#include <set>
+#include <vector>
+
+#include <core/content.hpp>
+#include <core/models/character/character.hpp>
+#include <core/models/class/class.hpp>
+#include <core/models/effects/effects.hpp>
+#include <core/models/effects/subholders/extra_spells_holder.hpp>
+#include <core/models/effects_provider/choosable.hpp>
+#include <core/models/species/species.hpp>
+#include <core/models/spell/spell.hpp>
+#include <core/models/subclass/subclass.hpp>
+#include <core/models/subspecies/subspecies.hpp>
+#include <core/types.hpp>
+
+namespace dnd {
+
+ContentFileIndex::ContentFileIndex(const Content& content) {
+    DND_MEASURE_FUNCTION();
+    // the content pieces of a file are next to each other, so the file of the previous content piece is tried first
+    const std::filesystem::path* previous_filepath = nullptr;
+    std::vector<Id>* previous_file_content_pieces = nullptr;
+    auto add_content_piece = [&](const std::filesystem::path& filepath, Id id) {
+        if (previous_filepath == nullptr || previous_filepath->native() != filepath.native()) {
+            previous_filepath = &filepath;
+            previous_file_content_pieces = &content_pieces[filepath];
+        }
+        previous_file_content_pieces->push_back(id);
+    };
+#define X(C, U, j, a, p, P)                                                                                            \
+    for (size_t i = 0; i < content.get_##j##_library().size(); ++i) {                                                  \
+        add_content_piece(content.get_##j(i).get_source_info().path, Id{.index = i, .type = Type::C});                 \
+    }
+    X_OWNED_CONTENT_PIECES
+#undef X
+
+    for (const Class& cls : content.get_all_classes()) {
+        for (const ClassFeature& feature : cls.get_features()) {
+            add_spell_dependencies(feature.get_main_effects(), cls.get_source_info().path);
+            for (const auto& [level, effects] : feature.get_higher_level_effects()) {
+                add_spell_dependencies(effects, cls.get_source_info().path);
+            }
+        }
+    }
+    for (const Subclass& subclass : content.get_all_subclasses()) {
+        const Class& cls = content.get_class(subclass.get_class_id());
+        add_dependency(cls.get_source_info().path, subclass.get_source_info().path);
+        for (const SubclassFeature& feature : subclass.get_features()) {
+            add_spell_dependencies(feature.get_main_effects(), subclass.get_source_info().path);
+            for (const auto& [level, effects] : feature.get_higher_level_effects()) {
+                add_spell_dependencies(effects, subclass.get_source_info().path);
+            }
+        }
+    }
+    for (const Species& species : content.get_all_species()) {
+        for (const Feature& feature : species.get_features()) {
+            add_spell_dependencies(feature.get_main_effects(), species.get_source_info().path);
+        }
+    }
+    for (const Subspecies& subspecies : content.get_all_subspecies()) {
+        add_dependency(subspecies.get_species().get().get_source_info().path, subspecies.get_source_info().path);
+        for (const Feature& feature : subspecies.get_features()) {
+            add_spell_dependencies(feature.get_main_effects(), subspecies.get_source_info().path);
+        }
+    }
+    for (const Choosable& choosable : content.get_all_choosables()) {
+        add_spell_dependencies(choosable.get_main_effects(), choosable.get_source_info().path);
+    }
+    for (const Character& character : content.get_all_characters()) {
+        for (const Feature& feature : character.get_features()) {
+            add_spell_dependencies(feature.get_main_effects(), character.get_source_info().path);
+        }
+        const FeatureProviders& feature_providers = character.get_feature_providers();
+        character_dependencies.insert(content.get_species(feature_providers.get_species_id()).get_source_info().path);
+        if (feature_providers.has_subspecies()) {
+            const Subspecies& subspecies = content.get_subspecies(feature_providers.get_subspecies_id().value());
+            character_dependencies.insert(subspecies.get_source_info().path);
+        }
+        character_dependencies.insert(content.get_class(feature_providers.get_class_id()).get_source_info().path);
+        if (feature_providers.has_subclass()) {
+            const Subclass& subclass = content.get_subclass(feature_providers.get_subclass_id().value());
+            character_dependencies.insert(subclass.get_source_info().path);
+        }
+        for (const Choosable& choosable : character.get_choosables()) {
+            character_dependencies.insert(choosable.get_source_info().path);
+        }
+    }
+}
+
+const std::vector<Id>& ContentFileIndex::get_content_pieces(const std::filesystem::path& filepath) const {
+    static const std::vector<Id> no_content_pieces;
+    auto it = content_pieces.find(filepath);
+    if (it == content_pieces.end()) {
+        return no_content_pieces;
+    }
+    return it->second;
+}
+
+std::set<std::filesystem::path> ContentFileIndex::get_affected_files(
+    const std::set<std::filesystem::path>& changed_files
+) const {
+    std::set<std::filesystem::path> affected_files = changed_files;
+    std::deque<std::filesystem::path> files_to_visit(changed_files.begin(), changed_files.end());
+    while (!files_to_visit.empty()) {
+        auto it = dependant_files.find(files_to_visit.front());
+        files_to_visit.pop_front();
+        if (it == dependant_files.end()) {
+            continue;
+        }
+        for (const std::filesystem::path& dependant_file : it->second) {
+            if (affected_files.insert(dependant_file).second) {
+                files_to_visit.push_back(dependant_file);
+            }
+        }
+    }
+    return affected_files;
+}
+
+bool ContentFileIndex::characters_depend_on(const std::set<std::filesystem::path>& files) const {
+    for (const std::filesystem::path& filepath : files) {
+        if (character_dependencies.contains(filepath)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ContentFileIndex::add_dependency(
+    const std::filesystem::path& filepath, const std::filesystem::path& dependant_filepath
+) {
+    if (filepath != dependant_filepath) {
+        dependant_files[filepath].insert(dependant_filepath);
+    }
+}
+
+void ContentFileIndex::add_spell_dependencies(const Effects& effects, const std::filesystem::path& dependant_filepath) {
+    const ExtraSpellsHolder& extra_spells = effects.get_extra_spells();
+    for (const std::vector<const Spell*>* spells : {
+             &extra_spells.get_free_cantrips(),
+             &extra_spells.get_at_will(),
+             &extra_spells.get_innate(),
+             &extra_spells.get_free_once_a_day(),
+             &extra_spells.get_spells_known(),
+             &extra_spells.get_spells_known_included(),
+             &extra_spells.get_added_to_spell_list(),
+         }) {
+        for (const Spell* spell : *spells) {
+            add_dependency(spell->get_source_info().path, dependant_filepath);
+        }
+    }
+}
+
+} // namespace dnd
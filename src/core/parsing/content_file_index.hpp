@@ -0,0 +1,57 @@
+#ifndef CONTENT_FILE_INDEX_HPP_
+#define CONTENT_FILE_INDEX_HPP_
+
+#include <dnd_config.hpp>
+
+#include <filesystem>
+#include <map>
+#include <set>
+#include <vector>
+
+#include <core/content.hpp>
+#include <core/types.hpp>
+
+namespace dnd {
+
+/**
+ * @brief Maps the content files to the content pieces parsed from them and to the files depending on them, which tells
+ * what needs to be parsed again when some of the files change
+ */
+class ContentFileIndex {
+public:
+    explicit ContentFileIndex(const Content& content);
+    /**
+     * @brief Returns the content pieces parsed from a file, without the features owned by them
+     * @param filepath the path to the file
+     * @return the IDs of the content pieces in the order they were added to the content
+     */
+    const std::vector<Id>& get_content_pieces(const std::filesystem::path& filepath) const;
+    /**
+     * @brief Returns the files that need to be parsed again when the given files changed, which are the given files and
+     * the files with content pieces that are validated against their content pieces, e.g. subclasses against their
+     * class or content pieces with extra spells against the spells
+     * @param changed_files the files that changed
+     * @return the changed files and all files depending on them, directly or through other files
+     */
+    std::set<std::filesystem::path> get_affected_files(const std::set<std::filesystem::path>& changed_files) const;
+    /**
+     * @brief Returns whether a character uses a content piece from one of the given files e.g. its class or a
+     * choosable, whose effects the character's stats are calculated from
+     * @param files the files
+     * @return true if a character depends on one of the files, false otherwise
+     */
+    bool characters_depend_on(const std::set<std::filesystem::path>& files) const;
+private:
+    void add_dependency(const std::filesystem::path& filepath, const std::filesystem::path& dependant_filepath);
+    void add_spell_dependencies(const Effects& effects, const std::filesystem::path& dependant_filepath);
+
+    std::map<std::filesystem::path, std::vector<Id>> content_pieces;
+    // maps each file to the files with content pieces referring to its content pieces
+    std::map<std::filesystem::path, std::set<std::filesystem::path>> dependant_files;
+    // the files with content pieces that characters use
+    std::set<std::filesystem::path> character_dependencies;
+};
+
+} // namespace dnd
+
+#endif // CONTENT_FILE_INDEX_HPP_
@@ -2,9 +2,19 @@
 
 #include "content_parsing.hpp"
 
+#include <algorithm>
+#include <cstdint>
+#include <deque>
 #include <exception>
 #include <filesystem>
+#include <initializer_list>
+#include <memory>
+#include <optional>
+#include <set>
 #include <string>
+#include <utility>
+#include <variant>
+#include <vector>
 
 #include <fmt/format.h>
 #include <nlohmann/json.hpp>
@@ -13,37 +23,187 @@
 #include <core/errors/errors.hpp>
 #include <core/errors/parsing_error.hpp>
 #include <core/errors/validation_error.hpp>
+#include <core/models/character/character_batch.hpp>
+#include <core/parsing/content_file_index.hpp>
+#include <core/parsing/content_serialization.hpp>
+#include <core/parsing/content_snapshot.hpp>
 #include <core/parsing/file_parser.hpp>
+#include <core/parsing/lazy_text_parsing.hpp>
+#include <core/parsing/snapshot_serialization.hpp>
 #include <core/parsing/spell_file_parser.hpp>
 #include <core/parsing/spell_sources_file_parser.hpp>
 #include <core/parsing/v2_file_parser.hpp>
+#include <core/types.hpp>
+#include <core/utils/arena.hpp>
+#include <core/utils/worker_pool.hpp>
 #include <log.hpp>
 
 namespace dnd {
 
-static Errors parse_file(Content& content, FileParser& parser) {
-    DND_MEASURE_SCOPE(parser.get_filepath().string().c_str());
+/**
+ * @brief A file that is scheduled to be parsed, split into a reading step (opening and parsing the JSON) that does
+ * not depend on the content and a saving step that has to happen in order
+ */
+struct FileParsingJob {
+    explicit FileParsingJob(const std::filesystem::path& filepath)
+        : filepath(filepath), arena(std::make_unique<Arena>(file_arena_block_size)) {}
+
+    // most files are small, the blocks of the arena grow with larger files
+    static constexpr size_t file_arena_block_size = 4 * 1024;
+
+    // the parsers only keep a reference to their filepath, so it is owned by the job
+    std::filesystem::path filepath;
+    // the buffers of the parsed data are allocated from this arena while the file is read, it is declared before the
+    // parser so that it outlives the parsed data, and it is handed to the content together with the data
+    std::unique_ptr<Arena> arena;
+    std::unique_ptr<FileParser> parser;
     Errors errors;
+    bool read = false;
+    bool ready_to_save = false;
+    // whether parsers of other jobs use the data of this parser, which then has to live until all jobs are done
+    bool parser_is_dependency = false;
+
+    // the snapshot of a previous run to restore the file from, or nullptr if no snapshots are used
+    const ContentSnapshot* previous_snapshot = nullptr;
+    // the content hash of the file this file is parsed with, or 0
+    uint64_t dependency_hash = 0;
+    std::optional<FileSnapshot> snapshot;
+};
+
+static void parse_file(FileParsingJob& job) {
+    FileParser& parser = *job.parser;
     try {
-        errors += parser.open_json();
-        if (!errors.ok()) {
-            return errors;
+        job.errors += parser.open_json();
+        if (!job.errors.ok()) {
+            return;
         }
 
-        errors += parser.parse();
-        if (!errors.ok() && !parser.continue_after_errors()) {
-            return errors;
+        job.errors += parser.parse();
+        parser.close_json();
+        if (!job.errors.ok() && !parser.continue_after_errors()) {
+            return;
         }
     } catch (const std::exception& e) {
-        errors.add_parsing_error(ParsingError::Code::UNKNOWN_ERROR, parser.get_filepath(), e.what());
-        return errors;
+        job.errors.add_parsing_error(ParsingError::Code::UNKNOWN_ERROR, parser.get_filepath(), e.what());
+        return;
+    }
+    job.ready_to_save = true;
+}
+
+static bool restore_file(FileParsingJob& job, const FileFingerprint& fingerprint) {
+    const FileSnapshot* file_snapshot = job.previous_snapshot->find(job.filepath, fingerprint, job.dependency_hash);
+    if (file_snapshot == nullptr) {
+        return false;
+    }
+    if (file_snapshot->ready_to_save) {
+        SnapshotReader reader(file_snapshot->parsed_data);
+        try {
+            if (!job.parser->read_snapshot(reader)) {
+                return false;
+            }
+        } catch (const std::exception& e) {
+            // a broken snapshot is only a cache miss, the file is parsed instead
+            LOGWARN("Could not restore {} from the content snapshot: {}", job.filepath.string(), e.what());
+            return false;
+        }
+    }
+    job.errors = file_snapshot->errors;
+    job.ready_to_save = file_snapshot->ready_to_save;
+    job.snapshot = *file_snapshot;
+    return true;
+}
+
+static void read_file(FileParsingJob& job) {
+    DND_MEASURE_DYNAMIC_SCOPE(job.filepath.string());
+    // the jobs are read on different threads, so each of them allocates from its own arena
+    ArenaScope arena_scope(*job.arena);
+    job.read = true;
+    if (job.previous_snapshot == nullptr) {
+        parse_file(job);
+        return;
+    }
+
+    std::optional<FileFingerprint> fingerprint = job.previous_snapshot->get_unchanged_fingerprint(job.filepath);
+    if (!fingerprint.has_value()) {
+        fingerprint = fingerprint_file(job.filepath, job.previous_snapshot->find_fingerprint(job.filepath));
+    }
+    if (fingerprint.has_value() && restore_file(job, fingerprint.value())) {
+        return;
+    }
+    parse_file(job);
+    if (!fingerprint.has_value()) {
+        return;
+    }
+    FileSnapshot file_snapshot{
+        .fingerprint = fingerprint.value(),
+        .dependency_hash = job.dependency_hash,
+        .ready_to_save = job.ready_to_save,
+        .errors = job.errors,
+        .parsed_data = {},
+    };
+    if (job.ready_to_save) {
+        SnapshotWriter writer;
+        job.parser->write_snapshot(writer);
+        file_snapshot.parsed_data = writer.take_buffer();
+    }
+    job.snapshot = std::move(file_snapshot);
+}
+
+static Errors save_file(Content& content, FileParsingJob& job) {
+    if (job.ready_to_save) {
+        // the content is only saved into by this thread, so the objects of the models can be allocated from its arena
+        ArenaScope arena_scope(content.get_arena());
+        job.parser->set_context(content);
+        job.parser->save_result(content);
+        // the saved content pieces and drafts keep the buffers that were allocated while reading the file
+        content.adopt_arena(std::move(job.arena));
+    }
+    // the parsed data is no longer needed once it is saved, unless other parsers depend on it e.g. spell sources
+    if (!job.parser_is_dependency) {
+        job.parser.reset();
+    }
+    return std::move(job.errors);
+}
+
+static void read_files_in_parallel(std::deque<FileParsingJob>& jobs, WorkerPool& worker_pool) {
+    DND_MEASURE_FUNCTION();
+    worker_pool.run(jobs.size(), [&jobs](size_t i) {
+        if (!jobs[i].read) {
+            read_file(jobs[i]);
+        }
+    });
+}
+
+static Errors parse_files(
+    Content& content, std::deque<FileParsingJob>& jobs, ParsingMode mode, WorkerPool& worker_pool,
+    ContentSnapshot& new_snapshot
+) {
+    if (mode == ParsingMode::PARALLEL) {
+        read_files_in_parallel(jobs, worker_pool);
+    }
+    Errors errors;
+    for (FileParsingJob& job : jobs) {
+        if (!job.read) {
+            read_file(job);
+        }
+        if (job.snapshot.has_value()) {
+            new_snapshot.add(job.filepath, std::move(job.snapshot.value()));
+        }
+        errors += save_file(content, job);
     }
-    parser.set_context(content);
-    parser.save_result(content);
     return errors;
 }
 
-static Errors parse_file(Content& content, FileParser&& parser) { return parse_file(content, parser); }
+template <typename P, typename... Args>
+static FileParsingJob& add_job(
+    std::deque<FileParsingJob>& jobs, const ContentSnapshot* previous_snapshot, const std::filesystem::path& filepath,
+    Args&&... args
+) {
+    FileParsingJob& job = jobs.emplace_back(filepath);
+    job.parser = std::make_unique<P>(job.filepath, std::forward<Args>(args)...);
+    job.previous_snapshot = previous_snapshot;
+    return job;
+}
 
 static bool skip_file(const std::filesystem::path& filepath) {
     std::string filename = filepath.filename().string();
@@ -59,80 +219,375 @@ static bool skip_file(const std::filesystem::path& filepath) {
     return false;
 }
 
-ParsingResult parse_content(const std::set<std::filesystem::path>& content_paths) {
-    DND_MEASURE_FUNCTION();
-    ParsingResult result;
-    result.content_paths = content_paths;
+enum class ContentFileType {
+    // a file with content pieces of several types e.g. classes, species, or characters
+    V2,
+    SPELL_SOURCES,
+    SPELLS,
+};
 
-    for (const std::filesystem::path& content_path : content_paths) {
-        bool valid_directory = true;
-        if (!std::filesystem::exists(content_path)) {
-            result.errors.add_parsing_error(
-                ParsingError::Code::FILE_NOT_FOUND, content_path, "The content directory does not exist."
-            );
-            valid_directory = false;
-        } else if (!std::filesystem::directory_entry(content_path).is_directory()) {
-            result.errors.add_parsing_error(
-                ParsingError::Code::FILE_NOT_FOUND, content_path, "The content directory is not a directory."
-            );
-            valid_directory = false;
+struct ContentFile {
+    std::filesystem::path filepath;
+    ContentFileType type;
+};
+
+/**
+ * @brief Lists the files of a content directory in the order in which they are saved
+ * @param content_path the content directory
+ * @return the files, including the spell sources whenever there is a spells directory, which the spells are parsed with
+ */
+static std::vector<ContentFile> list_content_files(const std::filesystem::path& content_path) {
+    std::vector<ContentFile> files;
+    for (const char* filename : {"feats.json", "races.json", "species.json"}) {
+        const std::filesystem::path filepath = content_path / filename;
+        if (std::filesystem::exists(filepath) && std::filesystem::is_regular_file(filepath)) {
+            files.push_back({.filepath = filepath, .type = ContentFileType::V2});
         }
-        if (!valid_directory) {
-            return result;
+    }
+
+    if (std::filesystem::exists(content_path / "class") && std::filesystem::is_directory(content_path / "class")) {
+        for (const auto& dir_entry : std::filesystem::directory_iterator(content_path / "class")) {
+            if (!std::filesystem::is_directory(dir_entry) && !skip_file(dir_entry.path())) {
+                files.push_back({.filepath = dir_entry.path(), .type = ContentFileType::V2});
+            }
         }
+    }
 
-        if (std::filesystem::exists(content_path / "feats.json")
-            && std::filesystem::is_regular_file(content_path / "feats.json")) {
-            result.errors += parse_file(result.content, V2FileParser(content_path / "feats.json"));
+    if (std::filesystem::exists(content_path / "spells") && std::filesystem::is_directory(content_path / "spells")) {
+        files.push_back({.filepath = content_path / "spells" / "sources.json", .type = ContentFileType::SPELL_SOURCES});
+        for (const auto& dir_entry : std::filesystem::directory_iterator(content_path / "spells")) {
+            if (!std::filesystem::is_directory(dir_entry) && !skip_file(dir_entry.path())) {
+                files.push_back({.filepath = dir_entry.path(), .type = ContentFileType::SPELLS});
+            }
         }
+    }
 
-        if (std::filesystem::exists(content_path / "races.json")
-            && std::filesystem::is_regular_file(content_path / "races.json")) {
-            result.errors += parse_file(result.content, V2FileParser(content_path / "races.json"));
+    if (std::filesystem::exists(content_path / "characters")
+        && std::filesystem::is_directory(content_path / "characters")) {
+        for (const auto& dir_entry : std::filesystem::directory_iterator(content_path / "characters")) {
+            if (!std::filesystem::is_directory(dir_entry) && !skip_file(dir_entry.path())) {
+                files.push_back({.filepath = dir_entry.path(), .type = ContentFileType::V2});
+            }
         }
-        if (std::filesystem::exists(content_path / "species.json")
-            && std::filesystem::is_regular_file(content_path / "species.json")) {
-            result.errors += parse_file(result.content, V2FileParser(content_path / "species.json"));
+    }
+    return files;
+}
+
+/**
+ * @brief Adds the jobs for the files of a content directory in the order in which they are saved
+ * @param jobs the jobs to add to
+ * @param content_path the content directory
+ * @param previous_snapshot the snapshot to restore unchanged files from, or nullptr
+ * @param description_parsing whether the descriptions are parsed right away or when they are first accessed
+ * @param character_batch the batch the characters of the directory are added to
+ * @param selected_files if given, only the jobs for these files are added, and the spell sources stand for all spells
+ */
+static void add_directory_jobs(
+    std::deque<FileParsingJob>& jobs, const std::filesystem::path& content_path,
+    const ContentSnapshot* previous_snapshot, DescriptionParsing description_parsing, CharacterBatch& character_batch,
+    const std::set<std::filesystem::path>* selected_files
+) {
+    const std::vector<ContentFile> files = list_content_files(content_path);
+    // the spells are parsed with the spell sources, so a change of the sources affects all of them
+    const bool all_spell_files = std::ranges::any_of(files, [selected_files](const ContentFile& file) {
+        return file.type == ContentFileType::SPELL_SOURCES
+               && (selected_files == nullptr || selected_files->contains(file.filepath));
+    });
+    auto is_selected = [selected_files, all_spell_files](const ContentFile& file) {
+        if (file.type == ContentFileType::SPELLS && all_spell_files) {
+            return true;
         }
+        return selected_files == nullptr || selected_files->contains(file.filepath);
+    };
+    const bool any_spell_files = std::ranges::any_of(files, [&is_selected](const ContentFile& file) {
+        return file.type == ContentFileType::SPELLS && is_selected(file);
+    });
 
-        if (std::filesystem::exists(content_path / "class") && std::filesystem::is_directory(content_path / "class")) {
-            for (const auto& dir_entry : std::filesystem::directory_iterator(content_path / "class")) {
-                if (std::filesystem::is_directory(dir_entry) || skip_file(dir_entry.path())) {
-                    continue;
+    const FileParsingJob* source_job = nullptr;
+    for (const ContentFile& file : files) {
+        switch (file.type) {
+            case ContentFileType::V2:
+                if (is_selected(file)) {
+                    add_job<V2FileParser>(
+                        jobs, previous_snapshot, file.filepath, description_parsing, &character_batch
+                    );
                 }
-                result.errors += parse_file(result.content, V2FileParser(dir_entry.path()));
+                break;
+            case ContentFileType::SPELL_SOURCES:
+                if (selected_files == nullptr || any_spell_files) {
+                    FileParsingJob& job = add_job<SpellSourcesFileParser>(jobs, previous_snapshot, file.filepath);
+                    job.parser_is_dependency = true;
+                    // the spell file parsers need the spell sources before they can parse
+                    read_file(job);
+                    source_job = &job;
+                }
+                break;
+            case ContentFileType::SPELLS:
+                if (source_job != nullptr && is_selected(file)) {
+                    const SpellSources& spell_sources =
+                        static_cast<const SpellSourcesFileParser&>(*source_job->parser).spell_classes_by_source;
+                    FileParsingJob& spell_job = add_job<SpellFileParser>(
+                        jobs, previous_snapshot, file.filepath, spell_sources, description_parsing
+                    );
+                    if (source_job->snapshot.has_value()) {
+                        spell_job.dependency_hash = source_job->snapshot->fingerprint.content_hash;
+                    }
+                }
+                break;
+        }
+    }
+}
+
+static Errors check_content_directory(const std::filesystem::path& content_path) {
+    Errors errors;
+    if (!std::filesystem::exists(content_path)) {
+        errors.add_parsing_error(
+            ParsingError::Code::FILE_NOT_FOUND, content_path, "The content directory does not exist."
+        );
+    } else if (!std::filesystem::directory_entry(content_path).is_directory()) {
+        errors.add_parsing_error(
+            ParsingError::Code::FILE_NOT_FOUND, content_path, "The content directory is not a directory."
+        );
+    }
+    return errors;
+}
+
+/**
+ * @brief Restores the content built by a previous run, which is only possible if the same content directories contain
+ * the same files as in that run and none of the files changed
+ * @param result the result to restore the content and its errors into
+ * @param previous_snapshot the snapshot of the previous run
+ * @param description_parsing whether the descriptions are parsed right away or when they are first accessed
+ * @param worker_pool the workers recalculating the characters
+ * @return true if the content was restored, false if it needs to be parsed
+ */
+static bool restore_built_content(
+    ParsingResult& result, const ContentSnapshot& previous_snapshot, DescriptionParsing description_parsing,
+    WorkerPool& worker_pool
+) {
+    DND_MEASURE_FUNCTION();
+    const BuiltContentSnapshot* built_content = previous_snapshot.get_built_content();
+    if (built_content == nullptr || built_content->content_paths != result.content_paths
+        || built_content->description_parsing != description_parsing) {
+        return false;
+    }
+    auto stored_file = built_content->files.begin();
+    for (const std::filesystem::path& content_path : result.content_paths) {
+        if (!check_content_directory(content_path).ok()) {
+            return false;
+        }
+        for (const ContentFile& file : list_content_files(content_path)) {
+            if (stored_file == built_content->files.end() || stored_file->first != file.filepath) {
+                return false;
+            }
+            std::optional<FileFingerprint> fingerprint = previous_snapshot.get_unchanged_fingerprint(file.filepath);
+            if (!fingerprint.has_value()) {
+                fingerprint = fingerprint_file(file.filepath, &stored_file->second);
             }
+            if (fingerprint != stored_file->second) {
+                return false;
+            }
+            ++stored_file;
         }
+    }
+    if (stored_file != built_content->files.end()) {
+        return false;
+    }
 
-        if (std::filesystem::exists(content_path / "spells")
-            && std::filesystem::is_directory(content_path / "spells")) {
-            std::filesystem::path sources_path = content_path / "spells" / "sources.json";
-            SpellSourcesFileParser source_parser(sources_path);
-            result.errors += parse_file(result.content, source_parser);
+    SnapshotReader reader(built_content->content_data);
+    std::optional<Content> content;
+    try {
+        content = ContentSerializer::read(reader);
+    } catch (const std::exception& e) {
+        // a broken snapshot is only a cache miss, the content is parsed instead
+        LOGWARN("Could not restore the content from the content snapshot: {}", e.what());
+        return false;
+    }
+    if (!content.has_value() || !reader.at_end()) {
+        return false;
+    }
+    result.content = std::move(content.value());
+    result.errors = built_content->errors;
+    // the stats of the characters are not part of the snapshot
+    result.errors += result.content.recalculate_all_characters(worker_pool);
+    return true;
+}
 
-            for (const auto& dir_entry : std::filesystem::directory_iterator(content_path / "spells")) {
-                if (std::filesystem::is_directory(dir_entry) || skip_file(dir_entry.path())) {
-                    continue;
-                }
-                result.errors += parse_file(
-                    result.content, SpellFileParser(dir_entry.path(), source_parser.spell_classes_by_source)
-                );
+/**
+ * @brief Creates the snapshot of the content built in this run
+ * @param result the result of parsing all content directories
+ * @param saved_files the files in the order they were saved into the content
+ * @param new_snapshot the snapshot of the files parsed in this run
+ * @param description_parsing whether the descriptions are parsed right away or when they are first accessed
+ * @return the snapshot of the content, or std::nullopt if one of the files could not be fingerprinted
+ */
+static std::optional<BuiltContentSnapshot> create_built_content_snapshot(
+    const ParsingResult& result, const std::vector<std::filesystem::path>& saved_files,
+    const ContentSnapshot& new_snapshot, DescriptionParsing description_parsing
+) {
+    DND_MEASURE_FUNCTION();
+    BuiltContentSnapshot built_content{
+        .content_paths = result.content_paths,
+        .description_parsing = description_parsing,
+        .files = {},
+        .errors = result.errors,
+        .content_data = {},
+    };
+    for (const std::filesystem::path& filepath : saved_files) {
+        const FileFingerprint* fingerprint = new_snapshot.find_fingerprint(filepath);
+        if (fingerprint == nullptr) {
+            return std::nullopt;
+        }
+        built_content.files.emplace_back(filepath, *fingerprint);
+    }
+    SnapshotWriter writer;
+    ContentSerializer::write(writer, result.content);
+    built_content.content_data = writer.take_buffer();
+    return built_content;
+}
+
+ParsingResult parse_content(
+    const std::set<std::filesystem::path>& content_paths, ParsingMode mode, ContentSnapshot* snapshot,
+    DescriptionParsing description_parsing, WorkerPool* worker_pool
+) {
+    DND_MEASURE_FUNCTION();
+    ParsingResult result;
+    result.content_paths = content_paths;
+
+    // the sequential mode does everything on this thread, which a pool with a single worker does
+    std::optional<WorkerPool> worker_pool_storage;
+    if (mode == ParsingMode::SEQUENTIAL) {
+        worker_pool_storage.emplace(1);
+        worker_pool = &worker_pool_storage.value();
+    } else if (worker_pool == nullptr) {
+        worker_pool_storage.emplace();
+        worker_pool = &worker_pool_storage.value();
+    }
+
+    // the previous snapshot is only read from, the new one only contains the files that are parsed in this run
+    std::optional<ContentSnapshot> previous_snapshot_storage;
+    const ContentSnapshot* previous_snapshot = nullptr;
+    ContentSnapshot new_snapshot;
+    if (snapshot != nullptr) {
+        previous_snapshot_storage = std::move(*snapshot);
+        previous_snapshot = &previous_snapshot_storage.value();
+        if (restore_built_content(result, *previous_snapshot, description_parsing, *worker_pool)) {
+            *snapshot = std::move(previous_snapshot_storage.value());
+            return result;
+        }
+    }
+
+    // the content is only snapshotted if all of its directories could be parsed
+    bool complete = true;
+    std::vector<std::filesystem::path> saved_files;
+    for (const std::filesystem::path& content_path : content_paths) {
+        Errors directory_errors = check_content_directory(content_path);
+        if (!directory_errors.ok()) {
+            result.errors += std::move(directory_errors);
+            complete = false;
+            break;
+        }
+
+        // the characters are created after all other files of the directory are saved, in the order of their keys
+        CharacterBatch character_batch;
+        // the jobs are saved in the order they are added, which keeps the content IDs and errors reproducible
+        std::deque<FileParsingJob> jobs;
+        add_directory_jobs(jobs, content_path, previous_snapshot, description_parsing, character_batch, nullptr);
+        for (const FileParsingJob& job : jobs) {
+            saved_files.push_back(job.filepath);
+        }
+
+        result.errors += parse_files(result.content, jobs, mode, *worker_pool, new_snapshot);
+        character_batch.create_all_for(result.content, *worker_pool);
+    }
+
+    if (snapshot != nullptr) {
+        if (complete) {
+            std::optional<BuiltContentSnapshot> built_content = create_built_content_snapshot(
+                result, saved_files, new_snapshot, description_parsing
+            );
+            if (built_content.has_value()) {
+                new_snapshot.set_built_content(std::move(built_content.value()));
             }
         }
+        *snapshot = std::move(new_snapshot);
+    }
+    return result;
+}
 
-        if (std::filesystem::exists(content_path / "characters")
-            && std::filesystem::is_directory(content_path / "characters")) {
-            for (const auto& dir_entry : std::filesystem::directory_iterator(content_path / "characters")) {
-                if (std::filesystem::is_directory(dir_entry) || skip_file(dir_entry.path())) {
-                    continue;
+/**
+ * @brief Removes the parsing errors of certain files
+ * @param errors the errors
+ * @param filepaths the files
+ * @return the remaining errors in the same order
+ */
+static Errors remove_file_errors(Errors&& errors, const std::set<std::filesystem::path>& filepaths) {
+    Errors remaining_errors;
+    for (const Error& error : errors.get_errors()) {
+        const ParsingError* parsing_error = std::get_if<ParsingError>(&error);
+        if (parsing_error == nullptr || !filepaths.contains(parsing_error->get_filepath())) {
+            remaining_errors.add_error(Error(error));
+        }
+    }
+    return remaining_errors;
+}
+
+bool reparse_changed_files(
+    Content& content, Errors& errors, const std::set<std::filesystem::path>& content_paths,
+    const std::set<std::filesystem::path>& changed_files, ContentSnapshot* snapshot,
+    DescriptionParsing description_parsing, WorkerPool& worker_pool
+) {
+    DND_MEASURE_FUNCTION();
+    const ContentFileIndex file_index(content);
+    std::set<std::filesystem::path> parsed_files = file_index.get_affected_files(changed_files);
+    // the content pieces of deleted files are detached as well, which is only undone if they are found elsewhere
+    for (const std::filesystem::path& filepath : parsed_files) {
+        for (Id id : file_index.get_content_pieces(filepath)) {
+            content.detach(id);
+        }
+        content.remove_drafts(filepath);
+    }
+
+    Errors new_errors;
+    ContentSnapshot new_snapshot;
+    const std::set<std::filesystem::path> affected_files = parsed_files;
+    for (const std::filesystem::path& content_path : content_paths) {
+        if (!check_content_directory(content_path).ok()) {
+            return false;
+        }
+        CharacterBatch character_batch;
+        std::deque<FileParsingJob> jobs;
+        add_directory_jobs(jobs, content_path, snapshot, description_parsing, character_batch, &affected_files);
+        // files can be parsed because of a file they depend on e.g. the spells if the spell sources changed
+        for (const FileParsingJob& job : jobs) {
+            if (parsed_files.insert(job.filepath).second) {
+                for (Id id : file_index.get_content_pieces(job.filepath)) {
+                    content.detach(id);
                 }
-                result.errors += parse_file(result.content, V2FileParser(dir_entry.path()));
+                content.remove_drafts(job.filepath);
             }
         }
+        new_errors += parse_files(content, jobs, ParsingMode::PARALLEL, worker_pool, new_snapshot);
+        character_batch.create_all_for(content, worker_pool);
     }
 
-    return result;
+    if (content.has_detached()) {
+        // content pieces were removed, renamed, or cannot be replaced in place, so the content is incomplete now
+        return false;
+    }
+    // the characters refer to the replaced content pieces by their IDs, which stay valid, but they need to collect
+    // the effects of the new content pieces
+    if (file_index.characters_depend_on(parsed_files)) {
+        new_errors += content.recalculate_all_characters(worker_pool);
+    }
+    errors = remove_file_errors(std::move(errors), parsed_files);
+    errors += std::move(new_errors);
+    if (snapshot != nullptr) {
+        snapshot->merge(std::move(new_snapshot));
+        // the content is no longer the one that was built from the files of the snapshot
+        snapshot->clear_built_content();
+    }
+    return true;
 }
 
-
 } // namespace dnd
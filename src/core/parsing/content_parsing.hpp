@@ -4,13 +4,18 @@
 #include <dnd_config.hpp>
 
 #include <filesystem>
+#include <set>
 #include <string>
 
 #include <core/content.hpp>
 #include <core/errors/errors.hpp>
+#include <core/parsing/content_snapshot.hpp>
+#include <core/parsing/lazy_text_parsing.hpp>
 
 namespace dnd {
 
+class WorkerPool;
+
 struct ParsingResult {
     ParsingResult() = default;
     ParsingResult(const ParsingResult&) = delete;
@@ -24,7 +29,53 @@ struct ParsingResult {
     std::string campaign_directory_name;
 };
 
-ParsingResult parse_content(const std::set<std::filesystem::path>& content_path);
+enum class ParsingMode {
+    // parse and save one file after another
+    SEQUENTIAL,
+    // read and parse all files concurrently, then save the results in the same order as the sequential mode, the
+    // characters are created concurrently as well
+    PARALLEL,
+};
+
+/**
+ * @brief Parses all the content in the given content directories
+ * @param content_paths the content directories
+ * @param mode whether the files should be parsed one after another or concurrently
+ * @param snapshot if given, the content built in a previous run is restored from it if none of the files changed, or
+ * else unchanged files are restored from it instead of being parsed, and it is replaced by a snapshot of the files and
+ * of the content built in this run
+ * @param description_parsing whether the descriptions of spells and features are parsed right away or only when they
+ * are first accessed
+ * @param worker_pool if given, the workers used by the parallel mode, otherwise a pool is started for this run
+ * @return the parsed content, the errors that occurred, and the content paths
+ */
+ParsingResult parse_content(
+    const std::set<std::filesystem::path>& content_paths, ParsingMode mode = ParsingMode::SEQUENTIAL,
+    ContentSnapshot* snapshot = nullptr, DescriptionParsing description_parsing = DescriptionParsing::EAGER,
+    WorkerPool* worker_pool = nullptr
+);
+
+/**
+ * @brief Parses changed content files again and replaces the content pieces parsed from them in place, which keeps the
+ * IDs of all content pieces and the references between them valid. The files with content pieces that are validated
+ * against the content pieces of the changed files are parsed again as well, and the characters are recalculated if
+ * they use content pieces from the parsed files.
+ * @param content the content that was parsed from the content directories
+ * @param errors the errors of parsing the content, the errors of the files that are parsed again are replaced
+ * @param content_paths the content directories
+ * @param changed_files the files that changed since the content was parsed
+ * @param snapshot if given, unchanged files are restored from it, and the files parsed again are updated in it
+ * @param description_parsing whether the descriptions of spells and features are parsed right away or only when they
+ * are first accessed
+ * @param worker_pool the workers reading the files and creating and recalculating the characters
+ * @return true if the changes were applied, false if content pieces were removed or renamed or cannot be replaced in
+ * place, which leaves the content incomplete, so that it needs to be parsed as a whole
+ */
+bool reparse_changed_files(
+    Content& content, Errors& errors, const std::set<std::filesystem::path>& content_paths,
+    const std::set<std::filesystem::path>& changed_files, ContentSnapshot* snapshot,
+    DescriptionParsing description_parsing, WorkerPool& worker_pool
+);
 
 } // namespace dnd
 
@@ -0,0 +1,1052 @@
+#include <dnd_config.hpp>
+
+#include "content_serialization.hpp"
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <memory_resource>
+#include <optional>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <core/basic_mechanics/abilities.hpp>
+#include <core/basic_mechanics/dice.hpp>
+#include <core/basic_mechanics/magic_schools.hpp>
+#include <core/content.hpp>
+#include <core/errors/errors.hpp>
+#include <core/groups.hpp>
+#include <core/models/character/ability_scores.hpp>
+#include <core/models/character/character.hpp>
+#include <core/models/character/decision.hpp>
+#include <core/models/character/feature_providers.hpp>
+#include <core/models/character/progression.hpp>
+#include <core/models/class/class.hpp>
+#include <core/models/class/important_levels.hpp>
+#include <core/models/effects/choice/choice.hpp>
+#include <core/models/effects/choice/choice_rules.hpp>
+#include <core/models/effects/condition/condition.hpp>
+#include <core/models/effects/condition/identifier_condition.hpp>
+#include <core/models/effects/condition/literal_condition.hpp>
+#include <core/models/effects/effects.hpp>
+#include <core/models/effects/stat_change/identifier_stat_change.hpp>
+#include <core/models/effects/stat_change/literal_stat_change.hpp>
+#include <core/models/effects/stat_change/stat_change.hpp>
+#include <core/models/effects/subholders/action_holder.hpp>
+#include <core/models/effects/subholders/extra_spells_holder.hpp>
+#include <core/models/effects/subholders/proficiency_holder.hpp>
+#include <core/models/effects/subholders/riv_holder.hpp>
+#include <core/models/effects_provider/choosable.hpp>
+#include <core/models/effects_provider/class_feature.hpp>
+#include <core/models/effects_provider/feature.hpp>
+#include <core/models/effects_provider/subclass_feature.hpp>
+#include <core/models/item/item.hpp>
+#include <core/models/species/species.hpp>
+#include <core/models/spell/spell.hpp>
+#include <core/models/spell/spell_components.hpp>
+#include <core/models/spell/spell_type.hpp>
+#include <core/models/spellcasting/preparation_spellcasting.hpp>
+#include <core/models/spellcasting/spellcasting.hpp>
+#include <core/models/spellcasting/spells_known_spellcasting.hpp>
+#include <core/models/subclass/subclass.hpp>
+#include <core/models/subspecies/subspecies.hpp>
+#include <core/parsing/snapshot_serialization.hpp>
+#include <core/referencing_content_library.hpp>
+#include <core/storage_content_library.hpp>
+#include <core/text/formatted_text.hpp>
+#include <core/text/lazy_formatted_text.hpp>
+#include <core/text/text_source.hpp>
+#include <core/types.hpp>
+#include <core/utils/arena.hpp>
+#include <core/utils/string_interner.hpp>
+
+namespace dnd {
+
+template <>
+struct SnapshotEnumRange<Ability> {
+    static constexpr Ability last = Ability::CHARISMA;
+};
+template <>
+struct SnapshotEnumRange<MagicSchool> {
+    static constexpr MagicSchool last = MagicSchool::TRANSMUTATION;
+};
+template <>
+struct SnapshotEnumRange<SpellLevel> {
+    static constexpr SpellLevel last = SpellLevel::LEVEL9;
+};
+template <>
+struct SnapshotEnumRange<ComparisonOperator> {
+    static constexpr ComparisonOperator last = ComparisonOperator::GREATER_THAN_OR_EQUAL;
+};
+template <>
+struct SnapshotEnumRange<StatChangeOperation> {
+    static constexpr StatChangeOperation last = StatChangeOperation::MIN;
+};
+template <>
+struct SnapshotEnumRange<StatChangeTime> {
+    static constexpr StatChangeTime last = StatChangeTime::LATEST;
+};
+template <>
+struct SnapshotEnumRange<PreparationSpellcastingType> {
+    static constexpr PreparationSpellcastingType last = PreparationSpellcastingType::FULL;
+};
+template <>
+struct SnapshotEnumRange<ChoiceType> {
+    static constexpr ChoiceType last = ChoiceType::CHOOSABLE;
+};
+
+using GroupMap = std::pmr::unordered_map<InternedString, std::pmr::set<InternedString>>;
+
+template <typename T>
+static T read_value(SnapshotReader& reader) {
+    T value{};
+    deserialize(reader, value);
+    return value;
+}
+
+/**
+ * @brief Returns the index of a content piece that a reference of another content piece points to
+ * @param content_pieces the content pieces of the library the reference points into
+ * @param content_piece the referenced content piece
+ * @return the index of the content piece in the library
+ */
+template <typename T>
+static uint64_t index_of(const std::vector<T>& content_pieces, const T& content_piece) {
+    return static_cast<uint64_t>(&content_piece - content_pieces.data());
+}
+
+/**
+ * @brief Reads the index of a referenced content piece and fails the reader if it is not in the library
+ * @param reader the reader
+ * @param library_size the size of the library the index points into
+ * @return the index, or std::nullopt if it is out of range
+ */
+static std::optional<size_t> read_index(SnapshotReader& reader, size_t library_size) {
+    const uint64_t index = read_value<uint64_t>(reader);
+    if (!reader.ok() || index >= library_size) {
+        reader.fail();
+        return std::nullopt;
+    }
+    return static_cast<size_t>(index);
+}
+
+static void write_source_info(SnapshotWriter& writer, const ContentPiece& content_piece) {
+    serialize(writer, content_piece.get_source_info().path);
+    serialize(writer, content_piece.get_source_info().name.str());
+    serialize(writer, content_piece.get_key());
+}
+
+static void write_spells(SnapshotWriter& writer, const std::vector<const Spell*>& spells, const Content& content) {
+    serialize<uint64_t>(writer, spells.size());
+    for (const Spell* spell : spells) {
+        serialize(writer, index_of(content.get_all_spells(), *spell));
+    }
+}
+
+static std::vector<const Spell*> read_spells(SnapshotReader& reader, const Content& content) {
+    const std::vector<Spell>& all_spells = content.get_all_spells();
+    const uint64_t size = read_value<uint64_t>(reader);
+    std::vector<const Spell*> spells;
+    for (uint64_t i = 0; i < size && reader.ok(); ++i) {
+        std::optional<size_t> index = read_index(reader, all_spells.size());
+        if (index.has_value()) {
+            spells.push_back(&all_spells[index.value()]);
+        }
+    }
+    return spells;
+}
+
+template <typename T, typename F>
+static void write_library(SnapshotWriter& writer, const StorageContentLibrary<T>& library, F write_content_piece) {
+    serialize<uint64_t>(writer, library.size());
+    for (const T& content_piece : library.get_all()) {
+        write_content_piece(content_piece);
+    }
+    serialize<uint64_t>(writer, library.get_drafts().size());
+    for (const auto& [draft_data, draft_errors] : library.get_drafts()) {
+        serialize(writer, draft_data);
+        serialize(writer, draft_errors);
+    }
+}
+
+template <typename T, typename F>
+static void read_library(SnapshotReader& reader, StorageContentLibrary<T>& library, F read_content_piece) {
+    const uint64_t size = read_value<uint64_t>(reader);
+    for (uint64_t i = 0; i < size && reader.ok(); ++i) {
+        std::optional<T> content_piece = read_content_piece();
+        // the content pieces are added in the order of their indices, which the references were written as
+        if (!content_piece.has_value() || library.add(std::move(content_piece.value())) != i) {
+            reader.fail();
+            return;
+        }
+    }
+    const uint64_t draft_count = read_value<uint64_t>(reader);
+    for (uint64_t i = 0; i < draft_count && reader.ok(); ++i) {
+        typename T::Data draft_data{};
+        Errors draft_errors;
+        deserialize(reader, draft_data);
+        deserialize(reader, draft_errors);
+        library.add_draft(std::move(draft_data), std::move(draft_errors));
+    }
+}
+
+/**
+ * @brief Writes the features a feature library refers to as the index of the kind of their owner within the given
+ * owner libraries, the index of their owner, and their index within the features of the owner
+ */
+template <typename F, typename... Owners>
+static void write_feature_references(
+    SnapshotWriter& writer, const ReferencingContentLibrary<F>& library, const std::vector<Owners>&... owners
+) {
+    std::unordered_map<const F*, std::array<uint64_t, 3>> locations;
+    uint64_t owner_kind = 0;
+    auto add_locations = [&locations, &owner_kind](const auto& owner_content_pieces) {
+        for (size_t i = 0; i < owner_content_pieces.size(); ++i) {
+            const std::vector<F>& features = owner_content_pieces[i].get_features();
+            for (size_t j = 0; j < features.size(); ++j) {
+                locations.emplace(&features[j], std::array<uint64_t, 3>{owner_kind, i, j});
+            }
+        }
+        ++owner_kind;
+    };
+    (add_locations(owners), ...);
+
+    serialize<uint64_t>(writer, library.size());
+    for (const F& feature : library.get_all()) {
+        serialize(writer, locations.at(&feature));
+    }
+}
+
+template <typename F, typename... Owners>
+static void read_feature_references(
+    SnapshotReader& reader, ReferencingContentLibrary<F>& library, const std::vector<Owners>&... owners
+) {
+    const uint64_t size = read_value<uint64_t>(reader);
+    for (uint64_t i = 0; i < size && reader.ok(); ++i) {
+        const std::array<uint64_t, 3> location = read_value<std::array<uint64_t, 3>>(reader);
+        const F* feature = nullptr;
+        uint64_t owner_kind = 0;
+        auto find_feature = [&location, &feature, &owner_kind](const auto& owner_content_pieces) {
+            if (owner_kind++ != location[0] || location[1] >= owner_content_pieces.size()) {
+                return;
+            }
+            const std::vector<F>& features = owner_content_pieces[location[1]].get_features();
+            if (location[2] < features.size()) {
+                feature = &features[location[2]];
+            }
+        };
+        (find_feature(owners), ...);
+        if (feature == nullptr) {
+            reader.fail();
+            return;
+        }
+        library.add(*feature);
+    }
+}
+
+static void write_group_map(SnapshotWriter& writer, const GroupMap& group_map) {
+    serialize<uint64_t>(writer, group_map.size());
+    for (const auto& [group_name, values] : group_map) {
+        serialize(writer, group_name.str());
+        serialize<uint64_t>(writer, values.size());
+        for (const InternedString& value : values) {
+            serialize(writer, value.str());
+        }
+    }
+}
+
+static void read_group_map(SnapshotReader& reader, GroupMap& group_map) {
+    const uint64_t size = read_value<uint64_t>(reader);
+    for (uint64_t i = 0; i < size && reader.ok(); ++i) {
+        std::pmr::set<InternedString>& values = group_map[InternedString(read_value<std::string>(reader))];
+        const uint64_t value_count = read_value<uint64_t>(reader);
+        for (uint64_t j = 0; j < value_count && reader.ok(); ++j) {
+            values.insert(InternedString(read_value<std::string>(reader)));
+        }
+    }
+}
+
+void ContentSerializer::write(SnapshotWriter& writer, const Content& content) {
+    DND_MEASURE_FUNCTION();
+    // the libraries are written in an order in which every content piece comes after the ones it refers to
+    write_library(writer, content.spell_library, [&writer](const Spell& spell) { write_spell(writer, spell); });
+    write_library(writer, content.item_library, [&writer](const Item& item) { write_item(writer, item); });
+    write_library(writer, content.species_library, [&writer, &content](const Species& species) {
+        write_species(writer, species, content);
+    });
+    write_library(writer, content.subspecies_library, [&writer, &content](const Subspecies& subspecies) {
+        write_subspecies(writer, subspecies, content);
+    });
+    write_library(writer, content.choosable_library, [&writer, &content](const Choosable& choosable) {
+        write_choosable(writer, choosable, content);
+    });
+    write_library(writer, content.class_library, [&writer, &content](const Class& cls) {
+        write_class(writer, cls, content);
+    });
+    write_library(writer, content.subclass_library, [&writer, &content](const Subclass& subclass) {
+        write_subclass(writer, subclass, content);
+    });
+    write_library(writer, content.character_library, [&writer, &content](const Character& character) {
+        write_character(writer, character, content);
+    });
+
+    write_feature_references(
+        writer, content.feature_library, content.get_all_species(), content.get_all_subspecies(),
+        content.get_all_characters()
+    );
+    write_feature_references(writer, content.class_feature_library, content.get_all_classes());
+    write_feature_references(writer, content.subclass_feature_library, content.get_all_subclasses());
+    write_groups(writer, content.groups);
+}
+
+std::optional<Content> ContentSerializer::read(SnapshotReader& reader) {
+    DND_MEASURE_FUNCTION();
+    Content content;
+    // the objects of the models are allocated from the arena of the content, like when the content is built
+    ArenaScope arena_scope(content.get_arena());
+    read_library(reader, content.spell_library, [&reader]() { return read_spell(reader); });
+    read_library(reader, content.item_library, [&reader]() { return read_item(reader); });
+    read_library(reader, content.species_library, [&reader, &content]() { return read_species(reader, content); });
+    read_library(reader, content.subspecies_library, [&reader, &content]() {
+        return read_subspecies(reader, content);
+    });
+    read_library(reader, content.choosable_library, [&reader, &content]() {
+        return read_choosable(reader, content);
+    });
+    read_library(reader, content.class_library, [&reader, &content]() { return read_class(reader, content); });
+    read_library(reader, content.subclass_library, [&reader, &content]() { return read_subclass(reader, content); });
+    read_library(reader, content.character_library, [&reader, &content]() {
+        return read_character(reader, content);
+    });
+
+    read_feature_references(
+        reader, content.feature_library, content.get_all_species(), content.get_all_subspecies(),
+        content.get_all_characters()
+    );
+    read_feature_references(reader, content.class_feature_library, content.get_all_classes());
+    read_feature_references(reader, content.subclass_feature_library, content.get_all_subclasses());
+    read_groups(reader, content.groups);
+    if (!reader.ok()) {
+        return std::nullopt;
+    }
+    return content;
+}
+
+void ContentSerializer::write_lazy_text(SnapshotWriter& writer, const LazyFormattedText& text) {
+    // a text that was not parsed when it was created is written as its location, even if it was accessed since
+    serialize(writer, text.source != nullptr);
+    if (text.source != nullptr) {
+        serialize(writer, text.source->filepath);
+        serialize(writer, text.source->text_source);
+    } else {
+        serialize(writer, text.text);
+    }
+}
+
+LazyFormattedText ContentSerializer::read_lazy_text(SnapshotReader& reader) {
+    if (read_value<bool>(reader)) {
+        const std::filesystem::path filepath = read_value<std::filesystem::path>(reader);
+        return LazyFormattedText(filepath, read_value<TextSource>(reader));
+    }
+    return LazyFormattedText(read_value<FormattedText>(reader));
+}
+
+void ContentSerializer::write_conditions(SnapshotWriter& writer, const std::vector<ArenaPtr<Condition>>& conditions) {
+    serialize<uint64_t>(writer, conditions.size());
+    for (const ArenaPtr<Condition>& condition : conditions) {
+        serialize(writer, condition->left_side_identifier.get_name().str());
+        serialize(writer, condition->comparison_operator);
+        const IdentifierCondition* identifier_condition = dynamic_cast<const IdentifierCondition*>(condition.get());
+        serialize(writer, identifier_condition != nullptr);
+        if (identifier_condition != nullptr) {
+            serialize(writer, identifier_condition->right_side_identifier.get_name().str());
+        } else {
+            serialize(writer, static_cast<const LiteralCondition&>(*condition).right_side);
+        }
+    }
+}
+
+std::vector<ArenaPtr<Condition>> ContentSerializer::read_conditions(SnapshotReader& reader) {
+    const uint64_t size = read_value<uint64_t>(reader);
+    std::vector<ArenaPtr<Condition>> conditions;
+    for (uint64_t i = 0; i < size && reader.ok(); ++i) {
+        const std::string left_side_identifier = read_value<std::string>(reader);
+        const ComparisonOperator comparison_operator = read_value<ComparisonOperator>(reader);
+        if (read_value<bool>(reader)) {
+            const std::string right_side_identifier = read_value<std::string>(reader);
+            conditions.push_back(
+                make_arena_ptr<IdentifierCondition>(left_side_identifier, comparison_operator, right_side_identifier)
+            );
+            continue;
+        }
+        ArenaPtr<LiteralCondition> condition = make_arena_ptr<LiteralCondition>(
+            left_side_identifier, comparison_operator, 0
+        );
+        // the right side is written as it was converted by the constructor
+        condition->right_side = read_value<int>(reader);
+        conditions.push_back(std::move(condition));
+    }
+    return conditions;
+}
+
+void ContentSerializer::write_stat_change(SnapshotWriter& writer, const StatChange& stat_change) {
+    const StatChangeInstruction& instruction = stat_change.get_instruction();
+    serialize(writer, instruction.affected_attribute.get_name().str());
+    serialize(writer, instruction.operation);
+    serialize(writer, instruction.value_attribute.has_value());
+    if (instruction.value_attribute.has_value()) {
+        serialize(writer, instruction.value_attribute->get_name().str());
+    }
+    serialize(writer, instruction.literal_value);
+    serialize(writer, stat_change.get_time());
+}
+
+ArenaPtr<StatChange> ContentSerializer::read_stat_change(SnapshotReader& reader) {
+    const std::string affected_attribute = read_value<std::string>(reader);
+    const StatChangeOperation operation = read_value<StatChangeOperation>(reader);
+    std::optional<std::string> value_attribute;
+    if (read_value<bool>(reader)) {
+        value_attribute = read_value<std::string>(reader);
+    }
+    const int literal_value = read_value<int>(reader);
+    const StatChangeTime time = read_value<StatChangeTime>(reader);
+    if (value_attribute.has_value()) {
+        return make_arena_ptr<IdentifierStatChange>(affected_attribute, time, operation, value_attribute.value());
+    }
+    ArenaPtr<LiteralStatChange> stat_change = make_arena_ptr<LiteralStatChange>(affected_attribute, time, operation, 0);
+    // the value is written as it was converted by the constructor
+    stat_change->instruction.literal_value = literal_value;
+    return stat_change;
+}
+
+void ContentSerializer::write_effects(SnapshotWriter& writer, const Effects& effects, const Content& content) {
+    write_conditions(writer, effects.get_activation_conditions());
+
+    serialize<uint64_t>(writer, effects.get_choices().size());
+    for (const Choice& choice : effects.get_choices()) {
+        serialize(writer, choice.type);
+        serialize(writer, choice.attribute_name);
+        serialize(writer, choice.amount);
+        serialize(writer, choice.group_names);
+        serialize(writer, choice.explicit_choices);
+    }
+
+    serialize<uint64_t>(writer, effects.get_stat_changes().size());
+    for (const ArenaPtr<StatChange>& stat_change : effects.get_stat_changes()) {
+        write_stat_change(writer, *stat_change);
+    }
+
+    const ActionHolder& actions = effects.get_actions();
+    serialize(writer, actions.get_actions());
+    serialize(writer, actions.get_bonus_actions());
+    serialize(writer, actions.get_reactions());
+
+    const ExtraSpellsHolder& extra_spells = effects.get_extra_spells();
+    write_spells(writer, extra_spells.get_free_cantrips(), content);
+    write_spells(writer, extra_spells.get_at_will(), content);
+    write_spells(writer, extra_spells.get_innate(), content);
+    write_spells(writer, extra_spells.get_free_once_a_day(), content);
+    write_spells(writer, extra_spells.get_spells_known(), content);
+    write_spells(writer, extra_spells.get_spells_known_included(), content);
+    write_spells(writer, extra_spells.get_added_to_spell_list(), content);
+
+    const ProficiencyHolder& proficiencies = effects.get_proficiencies();
+    serialize(writer, proficiencies.get_armor_proficiencies());
+    serialize(writer, proficiencies.get_weapon_proficiencies());
+    serialize(writer, proficiencies.get_tool_proficiencies());
+    serialize(writer, proficiencies.get_skill_proficiencies());
+    serialize(writer, proficiencies.get_saving_throw_proficiencies());
+    serialize(writer, proficiencies.get_known_languages());
+    serialize(writer, proficiencies.get_senses());
+
+    const RIVHolder& rivs = effects.get_rivs();
+    serialize(writer, rivs.get_damage_resistances());
+    serialize(writer, rivs.get_damage_immunities());
+    serialize(writer, rivs.get_damage_vulnerabilities());
+    serialize(writer, rivs.get_condition_immunities());
+}
+
+Effects ContentSerializer::read_effects(SnapshotReader& reader, const Content& content) {
+    std::vector<ArenaPtr<Condition>> activation_conditions = read_conditions(reader);
+
+    const uint64_t choice_count = read_value<uint64_t>(reader);
+    std::vector<Choice> choices;
+    for (uint64_t i = 0; i < choice_count && reader.ok(); ++i) {
+        const ChoiceType type = read_value<ChoiceType>(reader);
+        std::string attribute_name = read_value<std::string>(reader);
+        const int amount = read_value<int>(reader);
+        std::vector<std::string> group_names = read_value<std::vector<std::string>>(reader);
+        std::vector<std::string> explicit_choices = read_value<std::vector<std::string>>(reader);
+        // the filters refer to the content, so they are created again, Choice::create_for creates them after taking
+        // the group names out of the data, so they only depend on the explicit choices
+        Choice::Data filter_data{
+            .attribute_name = attribute_name,
+            .amount = amount,
+            .group_names = {},
+            .explicit_choices = explicit_choices,
+        };
+        choices.push_back(Choice(
+            type, Choice::create_filters(type, filter_data, content), std::move(attribute_name), amount,
+            std::move(group_names), std::move(explicit_choices)
+        ));
+    }
+
+    const uint64_t stat_change_count = read_value<uint64_t>(reader);
+    std::vector<ArenaPtr<StatChange>> stat_changes;
+    for (uint64_t i = 0; i < stat_change_count && reader.ok(); ++i) {
+        stat_changes.push_back(read_stat_change(reader));
+    }
+
+    using ActionMap = std::map<std::string, std::string>;
+    ActionMap actions = read_value<ActionMap>(reader);
+    ActionMap bonus_actions = read_value<ActionMap>(reader);
+    ActionMap reactions = read_value<ActionMap>(reader);
+    ActionHolder action_holder(std::move(actions), std::move(bonus_actions), std::move(reactions));
+
+    std::vector<const Spell*> free_cantrips = read_spells(reader, content);
+    std::vector<const Spell*> at_will = read_spells(reader, content);
+    std::vector<const Spell*> innate = read_spells(reader, content);
+    std::vector<const Spell*> free_once_a_day = read_spells(reader, content);
+    std::vector<const Spell*> spells_known = read_spells(reader, content);
+    std::vector<const Spell*> spells_known_included = read_spells(reader, content);
+    std::vector<const Spell*> added_to_spell_list = read_spells(reader, content);
+    ExtraSpellsHolder extra_spells_holder(
+        std::move(free_cantrips), std::move(at_will), std::move(innate), std::move(free_once_a_day),
+        std::move(spells_known), std::move(spells_known_included), std::move(added_to_spell_list)
+    );
+
+    using Strings = std::vector<std::string>;
+    Strings armor = read_value<Strings>(reader);
+    Strings weapons = read_value<Strings>(reader);
+    Strings tools = read_value<Strings>(reader);
+    Strings skills = read_value<Strings>(reader);
+    Strings saving_throws = read_value<Strings>(reader);
+    Strings languages = read_value<Strings>(reader);
+    Strings senses = read_value<Strings>(reader);
+    ProficiencyHolder proficiency_holder(
+        std::move(armor), std::move(weapons), std::move(tools), std::move(skills), std::move(saving_throws),
+        std::move(languages), std::move(senses)
+    );
+
+    Strings damage_resistances = read_value<Strings>(reader);
+    Strings damage_immunities = read_value<Strings>(reader);
+    Strings damage_vulnerabilities = read_value<Strings>(reader);
+    Strings condition_immunities = read_value<Strings>(reader);
+    RIVHolder riv_holder(
+        std::move(damage_resistances), std::move(damage_immunities), std::move(damage_vulnerabilities),
+        std::move(condition_immunities)
+    );
+
+    return Effects(
+        std::move(activation_conditions), std::move(choices), std::move(stat_changes), std::move(action_holder),
+        std::move(extra_spells_holder), std::move(proficiency_holder), std::move(riv_holder)
+    );
+}
+
+void ContentSerializer::write_higher_level_effects(
+    SnapshotWriter& writer, const std::map<int, Effects>& higher_level_effects, const Content& content
+) {
+    serialize<uint64_t>(writer, higher_level_effects.size());
+    for (const auto& [level, effects] : higher_level_effects) {
+        serialize(writer, level);
+        write_effects(writer, effects, content);
+    }
+}
+
+std::map<int, Effects> ContentSerializer::read_higher_level_effects(SnapshotReader& reader, const Content& content) {
+    const uint64_t size = read_value<uint64_t>(reader);
+    std::map<int, Effects> higher_level_effects;
+    for (uint64_t i = 0; i < size && reader.ok(); ++i) {
+        const int level = read_value<int>(reader);
+        higher_level_effects.emplace(level, read_effects(reader, content));
+    }
+    return higher_level_effects;
+}
+
+void ContentSerializer::write_spellcasting(SnapshotWriter& writer, const Spellcasting* spellcasting) {
+    serialize(writer, spellcasting != nullptr);
+    if (spellcasting == nullptr) {
+        return;
+    }
+    const SpellsKnownSpellcasting* spells_known_spellcasting = dynamic_cast<const SpellsKnownSpellcasting*>(
+        spellcasting
+    );
+    serialize(writer, spells_known_spellcasting != nullptr);
+    serialize(writer, spellcasting->ability);
+    serialize(writer, spellcasting->ritual_casting);
+    serialize(writer, spellcasting->cantrips_known);
+    serialize(writer, spellcasting->spell_slots);
+    if (spells_known_spellcasting != nullptr) {
+        serialize(writer, spells_known_spellcasting->spells_known);
+    } else {
+        serialize(writer, static_cast<const PreparationSpellcasting*>(spellcasting)->get_type());
+    }
+}
+
+ArenaPtr<Spellcasting> ContentSerializer::read_spellcasting(SnapshotReader& reader) {
+    if (!read_value<bool>(reader)) {
+        return nullptr;
+    }
+    const bool is_spells_known_type = read_value<bool>(reader);
+    const Ability ability = read_value<Ability>(reader);
+    const bool ritual_casting = read_value<bool>(reader);
+    std::array<int, 20> cantrips_known = read_value<std::array<int, 20>>(reader);
+    std::array<std::array<int, 20>, 9> spell_slots = read_value<std::array<std::array<int, 20>, 9>>(reader);
+    if (is_spells_known_type) {
+        std::array<int, 20> spells_known = read_value<std::array<int, 20>>(reader);
+        return make_arena_ptr<SpellsKnownSpellcasting>(
+            ability, ritual_casting, std::move(cantrips_known), std::move(spell_slots), std::move(spells_known)
+        );
+    }
+    const PreparationSpellcastingType type = read_value<PreparationSpellcastingType>(reader);
+    return make_arena_ptr<PreparationSpellcasting>(
+        ability, ritual_casting, std::move(cantrips_known), std::move(spell_slots), type
+    );
+}
+
+void ContentSerializer::write_feature(SnapshotWriter& writer, const Feature& feature, const Content& content) {
+    serialize(writer, feature.name.str());
+    write_lazy_text(writer, feature.description);
+    serialize(writer, feature.source_info.path);
+    serialize(writer, feature.source_info.name.str());
+    serialize(writer, feature.key);
+    write_effects(writer, feature.main_effects, content);
+}
+
+ContentSerializer::FeatureFields ContentSerializer::read_feature_fields(
+    SnapshotReader& reader, const Content& content
+) {
+    // the initializers of an aggregate are evaluated in order
+    return FeatureFields{
+        .name = read_value<std::string>(reader),
+        .description = read_lazy_text(reader),
+        .source_path = read_value<std::filesystem::path>(reader),
+        .source_name = read_value<std::string>(reader),
+        .key = read_value<std::string>(reader),
+        .main_effects = read_effects(reader, content),
+    };
+}
+
+Feature ContentSerializer::read_feature(SnapshotReader& reader, const Content& content) {
+    FeatureFields fields = read_feature_fields(reader, content);
+    return Feature(
+        std::move(fields.name), std::move(fields.description), std::move(fields.source_path),
+        std::move(fields.source_name), std::move(fields.key), std::move(fields.main_effects)
+    );
+}
+
+void ContentSerializer::write_class_feature(
+    SnapshotWriter& writer, const ClassFeature& feature, const Content& content
+) {
+    write_feature(writer, feature, content);
+    serialize(writer, feature.get_level());
+    write_higher_level_effects(writer, feature.get_higher_level_effects(), content);
+    serialize(writer, feature.get_class_name());
+    serialize(writer, feature.get_class_source_name());
+}
+
+ClassFeature ContentSerializer::read_class_feature(SnapshotReader& reader, const Content& content) {
+    FeatureFields fields = read_feature_fields(reader, content);
+    const int level = read_value<int>(reader);
+    std::map<int, Effects> higher_level_effects = read_higher_level_effects(reader, content);
+    std::string class_name = read_value<std::string>(reader);
+    std::string class_source_name = read_value<std::string>(reader);
+    return ClassFeature(
+        std::move(fields.name), std::move(fields.description), std::move(fields.source_path),
+        std::move(fields.source_name), std::move(fields.key), level, std::move(fields.main_effects),
+        std::move(higher_level_effects), std::move(class_name), std::move(class_source_name)
+    );
+}
+
+void ContentSerializer::write_subclass_feature(
+    SnapshotWriter& writer, const SubclassFeature& feature, const Content& content
+) {
+    write_feature(writer, feature, content);
+    serialize(writer, feature.get_level());
+    write_higher_level_effects(writer, feature.get_higher_level_effects(), content);
+    serialize(writer, feature.get_subclass_short_name());
+    serialize(writer, feature.get_subclass_source_name());
+}
+
+SubclassFeature ContentSerializer::read_subclass_feature(SnapshotReader& reader, const Content& content) {
+    FeatureFields fields = read_feature_fields(reader, content);
+    const int level = read_value<int>(reader);
+    std::map<int, Effects> higher_level_effects = read_higher_level_effects(reader, content);
+    std::string subclass_short_name = read_value<std::string>(reader);
+    std::string subclass_source_name = read_value<std::string>(reader);
+    return SubclassFeature(
+        std::move(fields.name), std::move(fields.description), std::move(fields.source_path),
+        std::move(fields.source_name), std::move(fields.key), level, std::move(fields.main_effects),
+        std::move(higher_level_effects), std::move(subclass_short_name), std::move(subclass_source_name)
+    );
+}
+
+void ContentSerializer::write_spell(SnapshotWriter& writer, const Spell& spell) {
+    serialize(writer, spell.get_name());
+    write_lazy_text(writer, spell.description);
+    write_source_info(writer, spell);
+    const SpellComponents& components = spell.get_components();
+    serialize(writer, components.has_verbal());
+    serialize(writer, components.has_somatic());
+    serialize(writer, components.has_material());
+    serialize(writer, components.get_material_components());
+    const SpellType& type = spell.get_type();
+    serialize(writer, type.get_spell_level());
+    serialize(writer, type.get_magic_school());
+    serialize(writer, type.is_ritual());
+    serialize(writer, spell.requires_concentration());
+    serialize(writer, spell.get_casting_time());
+    serialize(writer, spell.get_range());
+    serialize(writer, spell.get_duration());
+    serialize<uint64_t>(writer, spell.get_classes().size());
+    for (const InternedString& class_name : spell.get_classes()) {
+        serialize(writer, class_name.str());
+    }
+}
+
+std::optional<Spell> ContentSerializer::read_spell(SnapshotReader& reader) {
+    std::string name = read_value<std::string>(reader);
+    LazyFormattedText description = read_lazy_text(reader);
+    std::filesystem::path source_path = read_value<std::filesystem::path>(reader);
+    std::string source_name = read_value<std::string>(reader);
+    std::string key = read_value<std::string>(reader);
+    const bool verbal = read_value<bool>(reader);
+    const bool somatic = read_value<bool>(reader);
+    const bool material = read_value<bool>(reader);
+    std::string material_components = read_value<std::string>(reader);
+    const SpellLevel spell_level = read_value<SpellLevel>(reader);
+    const MagicSchool magic_school = read_value<MagicSchool>(reader);
+    const bool ritual = read_value<bool>(reader);
+    const bool concentration = read_value<bool>(reader);
+    std::string casting_time = read_value<std::string>(reader);
+    std::string range = read_value<std::string>(reader);
+    std::string duration = read_value<std::string>(reader);
+    std::set<std::string> classes = read_value<std::set<std::string>>(reader);
+    return Spell(
+        std::move(name), std::move(description), std::move(source_path), std::move(source_name), std::move(key),
+        SpellComponents(verbal, somatic, material, std::move(material_components)),
+        SpellType(spell_level, magic_school, ritual), concentration, std::move(casting_time), std::move(range),
+        std::move(duration), std::move(classes)
+    );
+}
+
+void ContentSerializer::write_item(SnapshotWriter& writer, const Item& item) {
+    serialize(writer, item.get_name());
+    serialize(writer, item.get_description());
+    write_source_info(writer, item);
+    serialize(writer, item.get_cosmetic_description());
+    serialize(writer, item.requires_attunement());
+}
+
+std::optional<Item> ContentSerializer::read_item(SnapshotReader& reader) {
+    std::string name = read_value<std::string>(reader);
+    FormattedText description = read_value<FormattedText>(reader);
+    std::filesystem::path source_path = read_value<std::filesystem::path>(reader);
+    std::string source_name = read_value<std::string>(reader);
+    std::string key = read_value<std::string>(reader);
+    FormattedText cosmetic_description = read_value<FormattedText>(reader);
+    const bool requires_attunement = read_value<bool>(reader);
+    return Item(
+        std::move(name), std::move(description), std::move(source_path), std::move(source_name), std::move(key),
+        std::move(cosmetic_description), requires_attunement
+    );
+}
+
+void ContentSerializer::write_species(SnapshotWriter& writer, const Species& species, const Content& content) {
+    serialize(writer, species.get_name());
+    serialize(writer, species.get_description());
+    write_source_info(writer, species);
+    serialize<uint64_t>(writer, species.get_features().size());
+    for (const Feature& feature : species.get_features()) {
+        write_feature(writer, feature, content);
+    }
+}
+
+std::optional<Species> ContentSerializer::read_species(SnapshotReader& reader, const Content& content) {
+    std::string name = read_value<std::string>(reader);
+    FormattedText description = read_value<FormattedText>(reader);
+    std::filesystem::path source_path = read_value<std::filesystem::path>(reader);
+    std::string source_name = read_value<std::string>(reader);
+    std::string key = read_value<std::string>(reader);
+    const uint64_t feature_count = read_value<uint64_t>(reader);
+    std::vector<Feature> features;
+    for (uint64_t i = 0; i < feature_count && reader.ok(); ++i) {
+        features.push_back(read_feature(reader, content));
+    }
+    return Species(
+        std::move(name), std::move(description), std::move(source_path), std::move(source_name), std::move(key),
+        std::move(features)
+    );
+}
+
+void ContentSerializer::write_subspecies(
+    SnapshotWriter& writer, const Subspecies& subspecies, const Content& content
+) {
+    serialize(writer, subspecies.get_name());
+    serialize(writer, subspecies.get_description());
+    write_source_info(writer, subspecies);
+    serialize<uint64_t>(writer, subspecies.get_features().size());
+    for (const Feature& feature : subspecies.get_features()) {
+        write_feature(writer, feature, content);
+    }
+    serialize(writer, index_of(content.get_all_species(), subspecies.get_species().get()));
+}
+
+std::optional<Subspecies> ContentSerializer::read_subspecies(SnapshotReader& reader, const Content& content) {
+    std::string name = read_value<std::string>(reader);
+    FormattedText description = read_value<FormattedText>(reader);
+    std::filesystem::path source_path = read_value<std::filesystem::path>(reader);
+    std::string source_name = read_value<std::string>(reader);
+    std::string key = read_value<std::string>(reader);
+    const uint64_t feature_count = read_value<uint64_t>(reader);
+    std::vector<Feature> features;
+    for (uint64_t i = 0; i < feature_count && reader.ok(); ++i) {
+        features.push_back(read_feature(reader, content));
+    }
+    std::optional<size_t> species_index = read_index(reader, content.get_all_species().size());
+    if (!species_index.has_value()) {
+        return std::nullopt;
+    }
+    return Subspecies(
+        std::move(name), std::move(description), std::move(source_path), std::move(source_name), std::move(key),
+        std::move(features), content.get_species(species_index.value())
+    );
+}
+
+void ContentSerializer::write_choosable(SnapshotWriter& writer, const Choosable& choosable, const Content& content) {
+    serialize(writer, choosable.get_name());
+    serialize(writer, choosable.get_description());
+    write_source_info(writer, choosable);
+    serialize(writer, choosable.get_type());
+    write_conditions(writer, choosable.get_prerequisites());
+    write_effects(writer, choosable.get_main_effects(), content);
+}
+
+std::optional<Choosable> ContentSerializer::read_choosable(SnapshotReader& reader, const Content& content) {
+    std::string name = read_value<std::string>(reader);
+    FormattedText description = read_value<FormattedText>(reader);
+    std::filesystem::path source_path = read_value<std::filesystem::path>(reader);
+    std::string source_name = read_value<std::string>(reader);
+    std::string key = read_value<std::string>(reader);
+    std::string type = read_value<std::string>(reader);
+    std::vector<ArenaPtr<Condition>> prerequisites = read_conditions(reader);
+    Effects main_effects = read_effects(reader, content);
+    return Choosable(
+        std::move(name), std::move(description), std::move(source_path), std::move(source_name), std::move(key),
+        std::move(type), std::move(prerequisites), std::move(main_effects)
+    );
+}
+
+void ContentSerializer::write_class(SnapshotWriter& writer, const Class& cls, const Content& content) {
+    serialize(writer, cls.get_name());
+    serialize(writer, cls.get_description());
+    write_source_info(writer, cls);
+    serialize<uint64_t>(writer, cls.get_features().size());
+    for (const ClassFeature& feature : cls.get_features()) {
+        write_class_feature(writer, feature, content);
+    }
+    std::optional<uint64_t> subclass_feature_index;
+    if (cls.get_subclass_feature().has_value()) {
+        subclass_feature_index = index_of(cls.get_features(), cls.get_subclass_feature().value().get());
+    }
+    serialize(writer, subclass_feature_index);
+    serialize(writer, cls.get_hit_dice().to_string());
+    serialize(writer, cls.get_important_levels().get_feat_levels());
+    serialize(writer, cls.get_important_levels().get_subclass_level());
+    write_spellcasting(writer, cls.get_spellcasting());
+}
+
+std::optional<Class> ContentSerializer::read_class(SnapshotReader& reader, const Content& content) {
+    std::string name = read_value<std::string>(reader);
+    FormattedText description = read_value<FormattedText>(reader);
+    std::filesystem::path source_path = read_value<std::filesystem::path>(reader);
+    std::string source_name = read_value<std::string>(reader);
+    std::string key = read_value<std::string>(reader);
+    const uint64_t feature_count = read_value<uint64_t>(reader);
+    std::vector<ClassFeature> features;
+    for (uint64_t i = 0; i < feature_count && reader.ok(); ++i) {
+        features.push_back(read_class_feature(reader, content));
+    }
+    // the subclass feature refers into the features, whose buffer is moved into the class
+    Opt<CRef<ClassFeature>> subclass_feature;
+    const std::optional<uint64_t> subclass_feature_index = read_value<std::optional<uint64_t>>(reader);
+    if (subclass_feature_index.has_value()) {
+        if (subclass_feature_index.value() >= features.size()) {
+            reader.fail();
+            return std::nullopt;
+        }
+        subclass_feature = features[subclass_feature_index.value()];
+    }
+    std::expected<Dice, Errors> hit_dice = Dice::from_string(read_value<std::string>(reader));
+    std::set<int> feat_levels = read_value<std::set<int>>(reader);
+    const int subclass_level = read_value<int>(reader);
+    ArenaPtr<Spellcasting> spellcasting = read_spellcasting(reader);
+    if (!hit_dice.has_value()) {
+        reader.fail();
+        return std::nullopt;
+    }
+    return Class(
+        std::move(name), std::move(description), std::move(source_path), std::move(source_name), std::move(key),
+        std::move(features), subclass_feature, std::move(hit_dice.value()),
+        ImportantLevels(std::move(feat_levels), subclass_level), std::move(spellcasting)
+    );
+}
+
+void ContentSerializer::write_subclass(SnapshotWriter& writer, const Subclass& subclass, const Content& content) {
+    serialize(writer, subclass.get_name());
+    serialize(writer, subclass.get_description());
+    write_source_info(writer, subclass);
+    serialize(writer, subclass.get_short_name());
+    serialize<uint64_t>(writer, subclass.get_features().size());
+    for (const SubclassFeature& feature : subclass.get_features()) {
+        write_subclass_feature(writer, feature, content);
+    }
+    serialize<uint64_t>(writer, subclass.get_class_id().index);
+    write_spellcasting(writer, subclass.get_spellcasting());
+}
+
+std::optional<Subclass> ContentSerializer::read_subclass(SnapshotReader& reader, const Content& content) {
+    std::string name = read_value<std::string>(reader);
+    FormattedText description = read_value<FormattedText>(reader);
+    std::filesystem::path source_path = read_value<std::filesystem::path>(reader);
+    std::string source_name = read_value<std::string>(reader);
+    std::string key = read_value<std::string>(reader);
+    std::string short_name = read_value<std::string>(reader);
+    const uint64_t feature_count = read_value<uint64_t>(reader);
+    std::vector<SubclassFeature> features;
+    for (uint64_t i = 0; i < feature_count && reader.ok(); ++i) {
+        features.push_back(read_subclass_feature(reader, content));
+    }
+    std::optional<size_t> class_index = read_index(reader, content.get_all_classes().size());
+    ArenaPtr<Spellcasting> spellcasting = read_spellcasting(reader);
+    if (!class_index.has_value()) {
+        return std::nullopt;
+    }
+    return Subclass(
+        std::move(name), std::move(description), std::move(source_path), std::move(source_name), std::move(key),
+        std::move(short_name), std::move(features), Id{.index = class_index.value(), .type = Type::Class},
+        std::move(spellcasting)
+    );
+}
+
+void ContentSerializer::write_character(SnapshotWriter& writer, const Character& character, const Content& content) {
+    serialize(writer, character.get_name());
+    serialize(writer, character.get_description());
+    write_source_info(writer, character);
+    serialize<uint64_t>(writer, character.get_features().size());
+    for (const Feature& feature : character.get_features()) {
+        write_feature(writer, feature, content);
+    }
+    serialize<uint64_t>(writer, character.get_choosables().size());
+    for (const Choosable& choosable : character.get_choosables()) {
+        serialize(writer, index_of(content.get_all_choosables(), choosable));
+    }
+
+    const AbilityScores& ability_scores = character.get_base_ability_scores();
+    serialize(writer, ability_scores.get_strength());
+    serialize(writer, ability_scores.get_dexterity());
+    serialize(writer, ability_scores.get_constitution());
+    serialize(writer, ability_scores.get_intelligence());
+    serialize(writer, ability_scores.get_wisdom());
+    serialize(writer, ability_scores.get_charisma());
+
+    const FeatureProviders& feature_providers = character.get_feature_providers();
+    serialize<uint64_t>(writer, feature_providers.get_species_id().index);
+    serialize(writer, feature_providers.get_subspecies_id().transform([](Id id) -> uint64_t { return id.index; }));
+    serialize<uint64_t>(writer, feature_providers.get_class_id().index);
+    serialize(writer, feature_providers.get_subclass_id().transform([](Id id) -> uint64_t { return id.index; }));
+
+    const Progression& progression = character.get_progression();
+    serialize(writer, progression.get_level());
+    serialize(writer, progression.get_xp());
+    serialize(writer, progression.get_hit_dice_rolls());
+
+    serialize<uint64_t>(writer, character.decisions.size());
+    for (const Decision& decision : character.decisions) {
+        write_effects(writer, decision.get_effects(), content);
+    }
+}
+
+std::optional<Character> ContentSerializer::read_character(SnapshotReader& reader, const Content& content) {
+    std::string name = read_value<std::string>(reader);
+    FormattedText description = read_value<FormattedText>(reader);
+    std::filesystem::path source_path = read_value<std::filesystem::path>(reader);
+    std::string source_name = read_value<std::string>(reader);
+    std::string key = read_value<std::string>(reader);
+    const uint64_t feature_count = read_value<uint64_t>(reader);
+    std::vector<Feature> features;
+    for (uint64_t i = 0; i < feature_count && reader.ok(); ++i) {
+        features.push_back(read_feature(reader, content));
+    }
+    const uint64_t choosable_count = read_value<uint64_t>(reader);
+    std::vector<CRef<Choosable>> choosables;
+    for (uint64_t i = 0; i < choosable_count && reader.ok(); ++i) {
+        std::optional<size_t> choosable_index = read_index(reader, content.get_all_choosables().size());
+        if (choosable_index.has_value()) {
+            choosables.push_back(content.get_choosable(choosable_index.value()));
+        }
+    }
+
+    const int strength = read_value<int>(reader);
+    const int dexterity = read_value<int>(reader);
+    const int constitution = read_value<int>(reader);
+    const int intelligence = read_value<int>(reader);
+    const int wisdom = read_value<int>(reader);
+    const int charisma = read_value<int>(reader);
+
+    std::optional<size_t> species_index = read_index(reader, content.get_all_species().size());
+    const std::optional<uint64_t> subspecies_index = read_value<std::optional<uint64_t>>(reader);
+    std::optional<size_t> class_index = read_index(reader, content.get_all_classes().size());
+    const std::optional<uint64_t> subclass_index = read_value<std::optional<uint64_t>>(reader);
+    const bool subspecies_valid = !subspecies_index.has_value()
+                                  || subspecies_index.value() < content.get_all_subspecies().size();
+    const bool subclass_valid = !subclass_index.has_value()
+                                || subclass_index.value() < content.get_all_subclasses().size();
+    if (!species_index.has_value() || !class_index.has_value() || !subspecies_valid || !subclass_valid) {
+        reader.fail();
+        return std::nullopt;
+    }
+    const Id species_id{.index = species_index.value(), .type = Type::Species};
+    const Opt<Id> subspecies_id = subspecies_index.transform([](size_t index) {
+        return Id{.index = index, .type = Type::Subspecies};
+    });
+    const Id class_id{.index = class_index.value(), .type = Type::Class};
+    const Opt<Id> subclass_id = subclass_index.transform([](size_t index) {
+        return Id{.index = index, .type = Type::Subclass};
+    });
+
+    const int level = read_value<int>(reader);
+    const int xp = read_value<int>(reader);
+    std::vector<int> hit_dice_rolls = read_value<std::vector<int>>(reader);
+
+    const uint64_t decision_count = read_value<uint64_t>(reader);
+    std::vector<Decision> decisions;
+    for (uint64_t i = 0; i < decision_count && reader.ok(); ++i) {
+        decisions.push_back(Decision(read_effects(reader, content)));
+    }
+
+    // the stats are calculated when the characters are recalculated after the whole content was read
+    return Character(
+        std::move(name), std::move(description), std::move(source_path), std::move(source_name), std::move(key),
+        std::move(features), std::move(choosables),
+        AbilityScores(strength, dexterity, constitution, intelligence, wisdom, charisma),
+        FeatureProviders(species_id, subspecies_id, class_id, subclass_id),
+        Progression(level, xp, std::move(hit_dice_rolls)), std::move(decisions)
+    );
+}
+
+void ContentSerializer::write_groups(SnapshotWriter& writer, const Groups& groups) {
+    write_group_map(writer, groups.members);
+    write_group_map(writer, groups.subgroups);
+}
+
+void ContentSerializer::read_groups(SnapshotReader& reader, Groups& groups) {
+    read_group_map(reader, groups.members);
+    read_group_map(reader, groups.subgroups);
+}
+
+} // namespace dnd
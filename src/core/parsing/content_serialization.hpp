@@ -0,0 +1,94 @@
+#ifndef CONTENT_SERIALIZATION_HPP_
+#define CONTENT_SERIALIZATION_HPP_
+
+#include <dnd_config.hpp>
+
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <core/content.hpp>
+#include <core/models/effects/condition/condition.hpp>
+#include <core/models/effects/effects.hpp>
+#include <core/models/effects/stat_change/stat_change.hpp>
+#include <core/models/spellcasting/spellcasting.hpp>
+#include <core/parsing/snapshot_serialization.hpp>
+#include <core/text/lazy_formatted_text.hpp>
+#include <core/utils/arena.hpp>
+
+namespace dnd {
+
+/**
+ * @brief Writes and reads a built content, i.e. its content pieces, drafts, feature libraries, and groups, so that a
+ * content can be restored as it was built, without saving, validating, and creating its content pieces again.
+ * References between content pieces are stored as indices into their libraries. The stats of the characters are not
+ * stored, they need to be recalculated after the content was read.
+ */
+class ContentSerializer {
+public:
+    static void write(SnapshotWriter& writer, const Content& content);
+    /**
+     * @brief Reads a content written by ContentSerializer::write
+     * @param reader the reader
+     * @return the content, or std::nullopt if the data is incomplete or inconsistent
+     */
+    static std::optional<Content> read(SnapshotReader& reader);
+private:
+    struct FeatureFields {
+        std::string name;
+        LazyFormattedText description;
+        std::filesystem::path source_path;
+        std::string source_name;
+        std::string key;
+        Effects main_effects;
+    };
+
+    static void write_lazy_text(SnapshotWriter& writer, const LazyFormattedText& text);
+    static LazyFormattedText read_lazy_text(SnapshotReader& reader);
+    static void write_conditions(SnapshotWriter& writer, const std::vector<ArenaPtr<Condition>>& conditions);
+    static std::vector<ArenaPtr<Condition>> read_conditions(SnapshotReader& reader);
+    static void write_stat_change(SnapshotWriter& writer, const StatChange& stat_change);
+    static ArenaPtr<StatChange> read_stat_change(SnapshotReader& reader);
+    static void write_effects(SnapshotWriter& writer, const Effects& effects, const Content& content);
+    static Effects read_effects(SnapshotReader& reader, const Content& content);
+    static void write_higher_level_effects(
+        SnapshotWriter& writer, const std::map<int, Effects>& higher_level_effects, const Content& content
+    );
+    static std::map<int, Effects> read_higher_level_effects(SnapshotReader& reader, const Content& content);
+    static void write_spellcasting(SnapshotWriter& writer, const Spellcasting* spellcasting);
+    static ArenaPtr<Spellcasting> read_spellcasting(SnapshotReader& reader);
+
+    static void write_feature(SnapshotWriter& writer, const Feature& feature, const Content& content);
+    static FeatureFields read_feature_fields(SnapshotReader& reader, const Content& content);
+    static Feature read_feature(SnapshotReader& reader, const Content& content);
+    static void write_class_feature(SnapshotWriter& writer, const ClassFeature& feature, const Content& content);
+    static ClassFeature read_class_feature(SnapshotReader& reader, const Content& content);
+    static void write_subclass_feature(SnapshotWriter& writer, const SubclassFeature& feature, const Content& content);
+    static SubclassFeature read_subclass_feature(SnapshotReader& reader, const Content& content);
+
+    static void write_spell(SnapshotWriter& writer, const Spell& spell);
+    static std::optional<Spell> read_spell(SnapshotReader& reader);
+    static void write_item(SnapshotWriter& writer, const Item& item);
+    static std::optional<Item> read_item(SnapshotReader& reader);
+    static void write_species(SnapshotWriter& writer, const Species& species, const Content& content);
+    static std::optional<Species> read_species(SnapshotReader& reader, const Content& content);
+    static void write_subspecies(SnapshotWriter& writer, const Subspecies& subspecies, const Content& content);
+    static std::optional<Subspecies> read_subspecies(SnapshotReader& reader, const Content& content);
+    static void write_choosable(SnapshotWriter& writer, const Choosable& choosable, const Content& content);
+    static std::optional<Choosable> read_choosable(SnapshotReader& reader, const Content& content);
+    static void write_class(SnapshotWriter& writer, const Class& cls, const Content& content);
+    static std::optional<Class> read_class(SnapshotReader& reader, const Content& content);
+    static void write_subclass(SnapshotWriter& writer, const Subclass& subclass, const Content& content);
+    static std::optional<Subclass> read_subclass(SnapshotReader& reader, const Content& content);
+    static void write_character(SnapshotWriter& writer, const Character& character, const Content& content);
+    static std::optional<Character> read_character(SnapshotReader& reader, const Content& content);
+
+    static void write_groups(SnapshotWriter& writer, const Groups& groups);
+    static void read_groups(SnapshotReader& reader, Groups& groups);
+};
+
+} // namespace dnd
+
+#endif // CONTENT_SERIALIZATION_HPP_
@@ -0,0 +1,269 @@
+#include <dnd_config.hpp>
+
+#include "content_snapshot.hpp"
+
+#include <array>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <core/errors/errors.hpp>
+#include <core/parsing/lazy_text_parsing.hpp>
+#include <core/parsing/snapshot_serialization.hpp>
+#include <core/utils/string_hash.hpp>
+
+namespace dnd {
+
+static constexpr std::array<char, 8> snapshot_magic = {'D', 'N', 'D', 'S', 'N', 'A', 'P', '\0'};
+// needs to be increased whenever the layout of the snapshot or of any parsed data changes
+static constexpr uint32_t snapshot_format_version = 5;
+
+template <>
+struct SnapshotEnumRange<DescriptionParsing> {
+    static constexpr DescriptionParsing last = DescriptionParsing::LAZY;
+};
+
+std::optional<FileFingerprint> fingerprint_file(
+    const std::filesystem::path& filepath, const FileFingerprint* previous
+) {
+    std::error_code error_code;
+    std::filesystem::file_time_type last_write_time = std::filesystem::last_write_time(filepath, error_code);
+    if (error_code) {
+        return std::nullopt;
+    }
+    if (previous != nullptr && previous->last_write_time == last_write_time.time_since_epoch().count()) {
+        uintmax_t file_size = std::filesystem::file_size(filepath, error_code);
+        if (!error_code && previous->size == file_size) {
+            // an edit that keeps both is very unlikely, so hashing every file on every start is not worth it
+            return *previous;
+        }
+    }
+    std::ifstream file(filepath, std::ios::binary);
+    if (!file.is_open()) {
+        return std::nullopt;
+    }
+
+    // FNV-1a, which is fast and good enough to detect changes of files with the same size and modification time
+    uint64_t hash = fnv1a_hash({});
+    uint64_t size = 0;
+    std::array<char, 1 << 16> chunk;
+    while (file.read(chunk.data(), chunk.size()) || file.gcount() > 0) {
+        size_t read_count = static_cast<size_t>(file.gcount());
+        hash = fnv1a_hash(std::string_view(chunk.data(), read_count), hash);
+        size += read_count;
+    }
+
+    return FileFingerprint{
+        .last_write_time = last_write_time.time_since_epoch().count(),
+        .size = size,
+        .content_hash = hash,
+    };
+}
+
+static void serialize_header(SnapshotWriter& writer) {
+    writer.write_bytes(snapshot_magic.data(), snapshot_magic.size());
+    serialize(writer, snapshot_format_version);
+    serialize(writer, static_cast<uint32_t>(DND_CAMPAIGN_MANAGER_VERSION_MAJOR));
+    serialize(writer, static_cast<uint32_t>(DND_CAMPAIGN_MANAGER_VERSION_MINOR));
+    serialize(writer, static_cast<uint32_t>(DND_CAMPAIGN_MANAGER_VERSION_PATCH));
+}
+
+static bool deserialize_header(SnapshotReader& reader) {
+    std::array<char, 8> magic;
+    uint32_t format_version = 0;
+    std::array<uint32_t, 3> version = {0, 0, 0};
+    reader.read_bytes(magic.data(), magic.size());
+    deserialize(reader, format_version);
+    deserialize(reader, version);
+    return reader.ok() && magic == snapshot_magic && format_version == snapshot_format_version
+           && version[0] == DND_CAMPAIGN_MANAGER_VERSION_MAJOR && version[1] == DND_CAMPAIGN_MANAGER_VERSION_MINOR
+           && version[2] == DND_CAMPAIGN_MANAGER_VERSION_PATCH;
+}
+
+static void serialize_fingerprint(SnapshotWriter& writer, const FileFingerprint& fingerprint) {
+    serialize(writer, fingerprint.last_write_time);
+    serialize(writer, fingerprint.size);
+    serialize(writer, fingerprint.content_hash);
+}
+
+static void deserialize_fingerprint(SnapshotReader& reader, FileFingerprint& fingerprint) {
+    deserialize(reader, fingerprint.last_write_time);
+    deserialize(reader, fingerprint.size);
+    deserialize(reader, fingerprint.content_hash);
+}
+
+static void serialize_built_content(SnapshotWriter& writer, const std::optional<BuiltContentSnapshot>& built_content) {
+    serialize(writer, built_content.has_value());
+    if (!built_content.has_value()) {
+        return;
+    }
+    serialize(writer, built_content->content_paths);
+    serialize(writer, built_content->description_parsing);
+    serialize<uint64_t>(writer, built_content->files.size());
+    for (const auto& [filepath, fingerprint] : built_content->files) {
+        serialize(writer, filepath);
+        serialize_fingerprint(writer, fingerprint);
+    }
+    serialize(writer, built_content->errors);
+    serialize(writer, built_content->content_data);
+}
+
+static void deserialize_built_content(SnapshotReader& reader, std::optional<BuiltContentSnapshot>& built_content) {
+    bool has_built_content = false;
+    deserialize(reader, has_built_content);
+    if (!has_built_content) {
+        return;
+    }
+    BuiltContentSnapshot& new_built_content = built_content.emplace();
+    deserialize(reader, new_built_content.content_paths);
+    deserialize(reader, new_built_content.description_parsing);
+    uint64_t file_count = 0;
+    deserialize(reader, file_count);
+    for (uint64_t i = 0; i < file_count && reader.ok(); ++i) {
+        std::pair<std::filesystem::path, FileFingerprint> file{};
+        deserialize(reader, file.first);
+        deserialize_fingerprint(reader, file.second);
+        new_built_content.files.push_back(std::move(file));
+    }
+    deserialize(reader, new_built_content.errors);
+    deserialize(reader, new_built_content.content_data);
+}
+
+std::optional<ContentSnapshot> ContentSnapshot::load(const std::filesystem::path& snapshot_path) {
+    DND_MEASURE_FUNCTION();
+    std::ifstream snapshot_file(snapshot_path, std::ios::binary);
+    if (!snapshot_file.is_open()) {
+        return std::nullopt;
+    }
+    std::string buffer((std::istreambuf_iterator<char>(snapshot_file)), std::istreambuf_iterator<char>());
+    snapshot_file.close();
+
+    SnapshotReader reader(buffer);
+    if (!deserialize_header(reader)) {
+        return std::nullopt;
+    }
+
+    ContentSnapshot snapshot;
+    uint64_t file_count = 0;
+    try {
+        deserialize_built_content(reader, snapshot.built_content);
+        deserialize(reader, file_count);
+        for (uint64_t i = 0; i < file_count && reader.ok(); ++i) {
+            std::filesystem::path filepath;
+            FileSnapshot file_snapshot{};
+            deserialize(reader, filepath);
+            deserialize_fingerprint(reader, file_snapshot.fingerprint);
+            deserialize(reader, file_snapshot.dependency_hash);
+            deserialize(reader, file_snapshot.ready_to_save);
+            deserialize(reader, file_snapshot.errors);
+            deserialize(reader, file_snapshot.parsed_data);
+            snapshot.files.insert_or_assign(std::move(filepath), std::move(file_snapshot));
+        }
+    } catch (const std::exception&) {
+        // a snapshot that cannot be read is treated like a missing one, so the content is parsed instead
+        return std::nullopt;
+    }
+    if (!reader.ok() || !reader.at_end()) {
+        return std::nullopt;
+    }
+    return snapshot;
+}
+
+bool ContentSnapshot::save(const std::filesystem::path& snapshot_path) const {
+    DND_MEASURE_FUNCTION();
+    SnapshotWriter writer;
+    serialize_header(writer);
+    serialize_built_content(writer, built_content);
+    serialize<uint64_t>(writer, files.size());
+    for (const auto& [filepath, file_snapshot] : files) {
+        serialize(writer, filepath);
+        serialize_fingerprint(writer, file_snapshot.fingerprint);
+        serialize(writer, file_snapshot.dependency_hash);
+        serialize(writer, file_snapshot.ready_to_save);
+        serialize(writer, file_snapshot.errors);
+        serialize(writer, file_snapshot.parsed_data);
+    }
+
+    std::ofstream snapshot_file(snapshot_path, std::ios::binary | std::ios::trunc);
+    if (!snapshot_file.is_open()) {
+        return false;
+    }
+    const std::string& buffer = writer.get_buffer();
+    snapshot_file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    return snapshot_file.good();
+}
+
+bool ContentSnapshot::empty() const { return files.empty(); }
+
+size_t ContentSnapshot::size() const { return files.size(); }
+
+const FileSnapshot* ContentSnapshot::find(
+    const std::filesystem::path& filepath, const FileFingerprint& fingerprint, uint64_t dependency_hash
+) const {
+    auto it = files.find(filepath);
+    if (it == files.end()) {
+        return nullptr;
+    }
+    const FileSnapshot& file_snapshot = it->second;
+    if (file_snapshot.fingerprint != fingerprint || file_snapshot.dependency_hash != dependency_hash) {
+        return nullptr;
+    }
+    return &file_snapshot;
+}
+
+const FileFingerprint* ContentSnapshot::find_fingerprint(const std::filesystem::path& filepath) const {
+    auto it = files.find(filepath);
+    if (it == files.end()) {
+        return nullptr;
+    }
+    return &it->second.fingerprint;
+}
+
+void ContentSnapshot::add(const std::filesystem::path& filepath, FileSnapshot&& file_snapshot) {
+    files.insert_or_assign(filepath, std::move(file_snapshot));
+}
+
+void ContentSnapshot::merge(ContentSnapshot&& other) {
+    for (auto& [filepath, file_snapshot] : other.files) {
+        files.insert_or_assign(filepath, std::move(file_snapshot));
+    }
+}
+
+void ContentSnapshot::set_unchanged_except(std::set<std::filesystem::path>&& new_changed_files) {
+    changed_files = std::move(new_changed_files);
+}
+
+std::optional<FileFingerprint> ContentSnapshot::get_unchanged_fingerprint(const std::filesystem::path& filepath) const {
+    if (!changed_files.has_value() || changed_files->contains(filepath)) {
+        return std::nullopt;
+    }
+    auto it = files.find(filepath);
+    if (it == files.end()) {
+        return std::nullopt;
+    }
+    return it->second.fingerprint;
+}
+
+const BuiltContentSnapshot* ContentSnapshot::get_built_content() const {
+    if (!built_content.has_value()) {
+        return nullptr;
+    }
+    return &built_content.value();
+}
+
+void ContentSnapshot::set_built_content(BuiltContentSnapshot&& new_built_content) {
+    built_content = std::move(new_built_content);
+}
+
+void ContentSnapshot::clear_built_content() { built_content.reset(); }
+
+} // namespace dnd
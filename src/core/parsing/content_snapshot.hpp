@@ -0,0 +1,146 @@
+#ifndef CONTENT_SNAPSHOT_HPP_
+#define CONTENT_SNAPSHOT_HPP_
+
+#include <dnd_config.hpp>
+
+#include <compare>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <core/errors/errors.hpp>
+#include <core/parsing/lazy_text_parsing.hpp>
+
+namespace dnd {
+
+/**
+ * @brief Identifies the state of a content file, used to decide whether a snapshot of it is still up-to-date
+ */
+struct FileFingerprint {
+    std::strong_ordering operator<=>(const FileFingerprint&) const = default;
+
+    int64_t last_write_time;
+    uint64_t size;
+    uint64_t content_hash;
+};
+
+/**
+ * @brief Computes the fingerprint of a file, the file is only read and hashed if its modification time or size differ
+ * from the previous fingerprint
+ * @param filepath the path to the file
+ * @param previous the fingerprint the file had before, or nullptr if it is unknown
+ * @return the fingerprint, or std::nullopt if the file cannot be read
+ */
+std::optional<FileFingerprint> fingerprint_file(
+    const std::filesystem::path& filepath, const FileFingerprint* previous = nullptr
+);
+
+/**
+ * @brief The result of reading one content file, i.e. the parsed data before it was saved into the content
+ */
+struct FileSnapshot {
+    FileFingerprint fingerprint;
+    // the content hash of the file this file was parsed with, e.g. the spell sources for spell files, or 0
+    uint64_t dependency_hash;
+    bool ready_to_save;
+    Errors errors;
+    // the parsed data in the format written by the file parser
+    std::string parsed_data;
+};
+
+/**
+ * @brief The content built by parsing all content directories, which can be restored as a whole while none of its
+ * files changed
+ */
+struct BuiltContentSnapshot {
+    std::set<std::filesystem::path> content_paths;
+    DescriptionParsing description_parsing;
+    // the content files in the order they were saved into the content, with the fingerprints they had
+    std::vector<std::pair<std::filesystem::path, FileFingerprint>> files;
+    Errors errors;
+    // the content in the format written by ContentSerializer
+    std::string content_data;
+};
+
+/**
+ * @brief A binary cache of the parsed content files, which allows skipping the JSON parsing for unchanged files.
+ * The snapshot stores the parsed data of each file, so that restoring a file goes through the same validation and
+ * produces the same content as parsing it. When none of the files changed, the content built from them is restored
+ * instead, which skips saving and validating the parsed data as well.
+ */
+class ContentSnapshot {
+public:
+    /**
+     * @brief Loads a snapshot from a file
+     * @param snapshot_path the path to the snapshot file
+     * @return the snapshot, or std::nullopt if the file does not exist, is corrupted, or was written by another version
+     */
+    static std::optional<ContentSnapshot> load(const std::filesystem::path& snapshot_path);
+    /**
+     * @brief Saves the snapshot to a file, overwriting it if it exists
+     * @param snapshot_path the path to the snapshot file
+     * @return true if the snapshot was saved successfully, false otherwise
+     */
+    bool save(const std::filesystem::path& snapshot_path) const;
+
+    bool empty() const;
+    size_t size() const;
+    /**
+     * @brief Finds the snapshot of a file if it is still up-to-date
+     * @param filepath the path to the file
+     * @param fingerprint the current fingerprint of the file
+     * @param dependency_hash the current content hash of the file the file depends on, or 0
+     * @return a pointer to the file snapshot, or nullptr if there is none or if it is outdated
+     */
+    const FileSnapshot* find(
+        const std::filesystem::path& filepath, const FileFingerprint& fingerprint, uint64_t dependency_hash
+    ) const;
+    /**
+     * @brief Returns the fingerprint a file had when its snapshot was created
+     * @param filepath the path to the file
+     * @return a pointer to the fingerprint, or nullptr if there is no snapshot of the file
+     */
+    const FileFingerprint* find_fingerprint(const std::filesystem::path& filepath) const;
+    void add(const std::filesystem::path& filepath, FileSnapshot&& file_snapshot);
+    /**
+     * @brief Adds the files of another snapshot, replacing the snapshots of files that are in both
+     * @param other the snapshot to take the files from
+     */
+    void merge(ContentSnapshot&& other);
+    /**
+     * @brief Marks all files except the given ones as unchanged, so that their fingerprints do not need to be computed,
+     * which is possible when a file watcher reports exactly which files changed
+     * @param changed_files the files that might have changed since the snapshot was created
+     */
+    void set_unchanged_except(std::set<std::filesystem::path>&& changed_files);
+    /**
+     * @brief Returns the fingerprint of a file in the snapshot if the file is known to be unchanged
+     * @param filepath the path to the file
+     * @return the fingerprint, or std::nullopt if the file might have changed
+     */
+    std::optional<FileFingerprint> get_unchanged_fingerprint(const std::filesystem::path& filepath) const;
+    /**
+     * @brief Returns the content built from the files of the snapshot
+     * @return a pointer to the built content, or nullptr if there is none
+     */
+    const BuiltContentSnapshot* get_built_content() const;
+    void set_built_content(BuiltContentSnapshot&& new_built_content);
+    /**
+     * @brief Removes the built content, e.g. because the content was changed by parsing some of its files again
+     */
+    void clear_built_content();
+private:
+    std::map<std::filesystem::path, FileSnapshot> files;
+    std::optional<BuiltContentSnapshot> built_content;
+    // if set, all files except these are known to be unchanged
+    std::optional<std::set<std::filesystem::path>> changed_files;
+};
+
+} // namespace dnd
+
+#endif // CONTENT_SNAPSHOT_HPP_
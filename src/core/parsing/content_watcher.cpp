@@ -0,0 +1,145 @@
+#include <dnd_config.hpp>
+
+#include "content_watcher.hpp"
+
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <set>
+#include <system_error>
+
+#if defined(__linux__)
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif // defined(__linux__)
+
+#include <log.hpp>
+
+namespace dnd {
+
+bool ContentChanges::empty() const { return files.empty() && !incomplete; }
+
+#if defined(__linux__)
+
+static bool is_content_file(const std::filesystem::path& filepath) { return filepath.extension() == ".json"; }
+
+static constexpr uint32_t watched_events = IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO
+                                           | IN_DELETE_SELF | IN_ONLYDIR;
+
+ContentWatcher::ContentWatcher() : inotify_fd(inotify_init1(IN_NONBLOCK | IN_CLOEXEC)), watched_directories() {
+    if (inotify_fd == -1) {
+        LOGWARN("Could not initialize inotify: {}", std::strerror(errno));
+    }
+}
+
+ContentWatcher::~ContentWatcher() {
+    if (inotify_fd != -1) {
+        close(inotify_fd);
+    }
+}
+
+bool ContentWatcher::is_supported() { return true; }
+
+void ContentWatcher::watch(const std::set<std::filesystem::path>& content_directories) {
+    stop();
+    for (const std::filesystem::path& content_directory : content_directories) {
+        watch_directory(content_directory);
+        std::error_code error_code;
+        auto it = std::filesystem::recursive_directory_iterator(content_directory, error_code);
+        for (; !error_code && it != std::filesystem::recursive_directory_iterator(); it.increment(error_code)) {
+            if (it->is_directory(error_code)) {
+                watch_directory(it->path());
+            }
+        }
+    }
+}
+
+void ContentWatcher::stop() {
+    for (const auto& [watch_descriptor, directory] : watched_directories) {
+        inotify_rm_watch(inotify_fd, watch_descriptor);
+    }
+    watched_directories.clear();
+}
+
+ContentChanges ContentWatcher::poll_changes() {
+    ContentChanges changes;
+    if (inotify_fd == -1) {
+        return changes;
+    }
+
+    alignas(inotify_event) std::array<char, 16384> buffer;
+    while (true) {
+        ssize_t length = read(inotify_fd, buffer.data(), buffer.size());
+        if (length <= 0) {
+            break; // no more events, read fails with EAGAIN
+        }
+        for (ssize_t offset = 0; offset < length;) {
+            const inotify_event* event = reinterpret_cast<const inotify_event*>(buffer.data() + offset);
+            offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+
+            if (event->mask & IN_Q_OVERFLOW) {
+                changes.incomplete = true;
+                continue;
+            }
+            auto directory_it = watched_directories.find(event->wd);
+            if (directory_it == watched_directories.end()) {
+                continue;
+            }
+            if (event->mask & (IN_DELETE_SELF | IN_IGNORED)) {
+                watched_directories.erase(directory_it);
+                continue;
+            }
+            if (event->len == 0) {
+                continue;
+            }
+
+            std::filesystem::path path = directory_it->second / event->name;
+            if (event->mask & IN_ISDIR) {
+                if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+                    watch_directory(path);
+                }
+                // the files in added or removed directories are not reported individually
+                changes.incomplete = true;
+            } else if (is_content_file(path)) {
+                changes.files.insert(std::move(path));
+            }
+        }
+    }
+    return changes;
+}
+
+void ContentWatcher::watch_directory(const std::filesystem::path& directory) {
+    if (inotify_fd == -1) {
+        return;
+    }
+    int watch_descriptor = inotify_add_watch(inotify_fd, directory.c_str(), watched_events);
+    if (watch_descriptor == -1) {
+        LOGWARN("Could not watch directory \"{}\": {}", directory.string(), std::strerror(errno));
+        return;
+    }
+    watched_directories[watch_descriptor] = directory;
+}
+
+#else // defined(__linux__)
+
+ContentWatcher::ContentWatcher() : inotify_fd(-1), watched_directories() {}
+
+ContentWatcher::~ContentWatcher() = default;
+
+bool ContentWatcher::is_supported() { return false; }
+
+void ContentWatcher::watch(const std::set<std::filesystem::path>& content_directories) {
+    DND_UNUSED(content_directories);
+}
+
+void ContentWatcher::stop() {}
+
+ContentChanges ContentWatcher::poll_changes() { return ContentChanges(); }
+
+void ContentWatcher::watch_directory(const std::filesystem::path& directory) { DND_UNUSED(directory); }
+
+#endif // defined(__linux__)
+
+} // namespace dnd
@@ -0,0 +1,57 @@
+#ifndef CONTENT_WATCHER_HPP_
+#define CONTENT_WATCHER_HPP_
+
+#include <dnd_config.hpp>
+
+#include <filesystem>
+#include <set>
+#include <unordered_map>
+
+namespace dnd {
+
+struct ContentChanges {
+    bool empty() const;
+
+    // the content files that were changed, created, moved, or deleted
+    std::set<std::filesystem::path> files;
+    // true if changes were lost e.g. because too many happened at once, which means that every file might have changed
+    bool incomplete = false;
+};
+
+/**
+ * @brief Watches content directories for changes to content files. This is implemented using inotify on Linux, on
+ * other platforms no changes are reported.
+ */
+class ContentWatcher {
+public:
+    ContentWatcher();
+    ~ContentWatcher();
+    ContentWatcher(const ContentWatcher&) = delete;
+    ContentWatcher& operator=(const ContentWatcher&) = delete;
+    ContentWatcher(ContentWatcher&&) = delete;
+    ContentWatcher& operator=(ContentWatcher&&) = delete;
+
+    static bool is_supported();
+    /**
+     * @brief Starts watching the given content directories and all their subdirectories, stops watching any other
+     * directories
+     * @param content_directories the content directories to watch
+     */
+    void watch(const std::set<std::filesystem::path>& content_directories);
+    void stop();
+    /**
+     * @brief Collects the changes since the last call without blocking
+     * @return the changes to content files
+     */
+    ContentChanges poll_changes();
+private:
+    void watch_directory(const std::filesystem::path& directory);
+
+    // the inotify instance, or -1 if there is none
+    int inotify_fd;
+    std::unordered_map<int, std::filesystem::path> watched_directories;
+};
+
+} // namespace dnd
+
+#endif // CONTENT_WATCHER_HPP_
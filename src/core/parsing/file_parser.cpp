@@ -2,8 +2,10 @@
 
 #include "file_parser.hpp"
 
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
+#include <ios>
 
 #include <fmt/format.h>
 #include <nlohmann/json.hpp>
@@ -18,18 +20,15 @@ FileParser::FileParser(const std::filesystem::path& filepath, bool multiple_piec
 
 Errors FileParser::open_json() {
     DND_MEASURE_FUNCTION();
-    Errors errors;
-    if (get_filepath().extension().string() != ".json") {
-        errors.add_parsing_error(
-            ParsingError::Code::INVALID_FILE_FORMAT, get_filepath(),
-            fmt::format("File '{}' is not a \".json\" file.", get_filepath().string())
-        );
+    Errors errors = check_file_extension();
+    if (!errors.ok()) {
         return errors;
     }
     std::ifstream json_file(get_filepath());
     try {
         DND_MEASURE_SCOPE("JSON serialization");
         json_file >> json;
+        DND_MEASURE_COUNTER("Bytes read", std::max<std::streamoff>(json_file.tellg(), 0));
     } catch (const nlohmann::json::parse_error& e) {
         errors.add_parsing_error(
             ParsingError::Code::INVALID_FILE_FORMAT, get_filepath(),
@@ -39,6 +38,19 @@ Errors FileParser::open_json() {
     return errors;
 }
 
+void FileParser::close_json() { json = nlohmann::ordered_json(); }
+
+Errors FileParser::check_file_extension() const {
+    Errors errors;
+    if (get_filepath().extension().string() != ".json") {
+        errors.add_parsing_error(
+            ParsingError::Code::INVALID_FILE_FORMAT, get_filepath(),
+            fmt::format("File '{}' is not a \".json\" file.", get_filepath().string())
+        );
+    }
+    return errors;
+}
+
 bool FileParser::continue_after_errors() const { return multiple_pieces_per_file; }
 
 void FileParser::set_context(const Content& content) { DND_UNUSED(content); }
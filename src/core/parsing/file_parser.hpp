@@ -12,16 +12,33 @@
 namespace dnd {
 
 class Content;
+class SnapshotReader;
+class SnapshotWriter;
 
 class FileParser : public Parser {
 public:
     explicit FileParser(const std::filesystem::path& filepath, bool multiple_pieces_per_file);
-    virtual Errors open_json() final;
+    virtual Errors open_json();
+    /**
+     * @brief Releases the opened JSON, which is no longer needed once the file is parsed
+     */
+    void close_json();
     virtual Errors parse() = 0;
-    bool continue_after_errors() const;
+    virtual bool continue_after_errors() const;
     virtual void set_context(const Content& content);
     virtual void save_result(Content& content) = 0;
+    /**
+     * @brief Writes the parsed data into a snapshot, so that the file does not have to be parsed again
+     */
+    virtual void write_snapshot(SnapshotWriter& writer) const = 0;
+    /**
+     * @brief Restores the parsed data from a snapshot that was written by write_snapshot
+     * @return true if the parsed data was restored, false if the snapshot is corrupted, which leaves the data unchanged
+     */
+    virtual bool read_snapshot(SnapshotReader& reader) = 0;
 protected:
+    Errors check_file_extension() const;
+
     nlohmann::ordered_json json;
     bool multiple_pieces_per_file;
 };
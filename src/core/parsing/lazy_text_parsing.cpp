@@ -0,0 +1,129 @@
+#include <dnd_config.hpp>
+
+#include "lazy_text_parsing.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <optional>
+#include <string>
+#include <utility>
+#include <variant>
+
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+
+#include <core/errors/errors.hpp>
+#include <core/errors/parsing_error.hpp>
+#include <core/parsing/parser.hpp>
+#include <core/parsing/spell_parsing.hpp>
+#include <core/text/formatted_text.hpp>
+#include <core/text/formatted_text_writer.hpp>
+#include <core/text/text_source.hpp>
+#include <core/utils/string_hash.hpp>
+#include <core/validation/validation_data.hpp>
+#include <log.hpp>
+
+namespace dnd {
+
+static FormattedText unreadable_text(const std::filesystem::path& filepath) {
+    return FormattedText::simple(fmt::format("The description could not be read from '{}'.", filepath.string()));
+}
+
+static FormattedText changed_text(const std::filesystem::path& filepath) {
+    return FormattedText::simple(
+        fmt::format("The description was changed in '{}', parse the content again to see it.", filepath.string())
+    );
+}
+
+std::optional<Error> defer_description_parsing(
+    const nlohmann::ordered_json& obj, const std::filesystem::path& filepath, const TextSource& source,
+    ValidationData& data
+) {
+    auto entries = obj.find("entries");
+    if (entries == obj.end()) {
+        return ParsingError(ParsingError::Code::MISSING_ATTRIBUTE, filepath, "The attribute 'entries' is missing");
+    }
+    if (!entries->is_array()) {
+        return ParsingError(
+            ParsingError::Code::INVALID_ATTRIBUTE_TYPE, filepath,
+            "The attribute 'entries' exists but is of wrong type - should be array"
+        );
+    }
+    // without entries the description stays empty, which the validation reports like for eagerly parsed ones
+    if (!entries->empty()) {
+        data.description_source = source;
+    }
+    return std::nullopt;
+}
+
+/**
+ * @brief Appends the errors that occurred while parsing a description, because the description is parsed when the
+ * user opens it, so that is where the errors are shown
+ */
+static void append_errors(FormattedText& text, const Errors& errors) {
+    FormattedTextWriter writer(text);
+    for (const Error& error : errors.get_errors()) {
+        std::visit(
+            [&writer](const auto& specific_error) {
+                uint32_t paragraph_index = writer.begin_node(FormattedTextNodeType::PARAGRAPH);
+                writer.end_node(writer.begin_node(
+                    FormattedTextNodeType::SIMPLE_TEXT,
+                    fmt::format("Error in the description: {}", specific_error.get_error_message()), true, false
+                ));
+                writer.end_node(paragraph_index);
+            },
+            error
+        );
+    }
+}
+
+FormattedText parse_text_source(const std::filesystem::path& filepath, const TextSource& source) {
+    DND_MEASURE_FUNCTION();
+    std::ifstream file(filepath, std::ios::binary);
+    std::string json_text(source.length, '\0');
+    file.seekg(static_cast<std::streamoff>(source.offset));
+    file.read(json_text.data(), static_cast<std::streamsize>(source.length));
+    if (!file) {
+        LOGWARN("Could not read the description at offset {} of {}", source.offset, filepath.string());
+        return unreadable_text(filepath);
+    }
+
+    if (source.content_hash != fnv1a_hash(json_text)) {
+        // the file was changed since the content was parsed, so the range might contain anything
+        LOGWARN("The description at offset {} of {} changed since it was parsed", source.offset, filepath.string());
+        return changed_text(filepath);
+    }
+
+    nlohmann::ordered_json obj = nlohmann::ordered_json::parse(json_text, nullptr, false);
+    if (obj.is_discarded() || !obj.is_object()) {
+        // the file was changed since the content was parsed
+        LOGWARN("Found no JSON object at offset {} of {}", source.offset, filepath.string());
+        return unreadable_text(filepath);
+    }
+
+    FormattedText text;
+    Errors errors;
+    switch (source.format) {
+        case TextSource::Format::ENTRIES:
+            errors += write_formatted_text_into(obj, text, filepath);
+            break;
+        case TextSource::Format::SPELL_ENTRIES:
+            errors += parse_spell_description_into(obj, text, filepath);
+            break;
+    }
+    if (!errors.ok()) {
+        LOGWARN(
+            "Found {} errors in the description at offset {} of {}", errors.get_errors().size(), source.offset,
+            filepath.string()
+        );
+        append_errors(text, errors);
+    }
+    if (text.empty()) {
+        return unreadable_text(filepath);
+    }
+    return text;
+}
+
+} // namespace dnd
@@ -0,0 +1,51 @@
+#ifndef LAZY_TEXT_PARSING_HPP_
+#define LAZY_TEXT_PARSING_HPP_
+
+#include <dnd_config.hpp>
+
+#include <filesystem>
+#include <optional>
+
+#include <nlohmann/json.hpp>
+
+#include <core/errors/errors.hpp>
+#include <core/text/formatted_text.hpp>
+#include <core/text/text_source.hpp>
+
+namespace dnd {
+
+enum class DescriptionParsing {
+    // parse the descriptions together with the rest of the content
+    EAGER,
+    // only remember where the descriptions are in their files and parse them when they are first accessed
+    LAZY,
+};
+
+class ValidationData;
+
+/**
+ * @brief Defers parsing a description until it is first accessed, after the checks that do not need to parse it,
+ * i.e. that the "entries" of the object are an array, which must not be empty for the description to be deferred
+ * @param obj the JSON object of the described content piece
+ * @param filepath the file that contains the object
+ * @param source the location of the object within the file
+ * @param data the data of the described content piece, which keeps an empty description if there are no entries
+ * @return an error if the "entries" are missing or not an array
+ */
+std::optional<Error> defer_description_parsing(
+    const nlohmann::ordered_json& obj, const std::filesystem::path& filepath, const TextSource& source,
+    ValidationData& data
+);
+
+/**
+ * @brief Parses a description that was not parsed together with the rest of the content
+ * @param filepath the file that contains the description
+ * @param source the location of the JSON object of the described content piece within the file
+ * @return the description followed by the errors that occurred while parsing it, or a paragraph saying that it could
+ * not be read if the file changed in the meantime
+ */
+FormattedText parse_text_source(const std::filesystem::path& filepath, const TextSource& source);
+
+} // namespace dnd
+
+#endif // LAZY_TEXT_PARSING_HPP_
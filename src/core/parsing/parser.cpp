@@ -3,12 +3,18 @@
 #include "parser.hpp"
 
 #include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
 #include <deque>
 #include <expected>
 #include <filesystem>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <utility>
+#include <variant>
+#include <vector>
 
 #include <fmt/format.h>
 #include <fmt/ranges.h>
@@ -16,14 +22,15 @@
 #include <core/errors/errors.hpp>
 #include <core/errors/parsing_error.hpp>
 #include <core/text/check_text.hpp>
+#include <core/text/formatted_text.hpp>
+#include <core/text/formatted_text_writer.hpp>
 #include <core/text/rich_text.hpp>
-#include <core/text/text.hpp>
 #include <core/types.hpp>
 #include <log.hpp>
 
 namespace dnd {
 
-constexpr std::array<std::string_view, 38> known_link_types = {
+constexpr std::array<std::string_view, 37> known_link_types = {
     "damage",       "condition",   "dice",      "skill",       "spell",        "creature", "action", "adventure",
     "quickref",     "item",        "sense",     "dc",          "note",         "filter",   "chance", "status",
     "classFeature", "variantrule", "hazard",    "5etools",     "book",         "feat",     "deity",  "subclassFeature",
@@ -34,31 +41,101 @@ constexpr std::array<std::string_view, 38> known_link_types = {
 
 constexpr std::array<std::string_view, 1> known_ignore_types = {"d20"};
 
+/**
+ * @brief A perfect hash set of the known link types, which are looked up for every rich text tag.
+ * The seed of the hash is searched at compile time, so that every type has a slot of its own.
+ */
+class LinkTypeSet {
+public:
+    consteval LinkTypeSet() {
+        while (!try_seed()) {
+            ++seed;
+        }
+    }
+    constexpr bool contains(std::string_view type) const {
+        return !type.empty() && slots[slot_index(type, seed)] == type;
+    }
+private:
+    static constexpr size_t slot_count = 128;
+
+    static constexpr size_t slot_index(std::string_view str, uint32_t seed) {
+        uint32_t hash = seed;
+        for (char c : str) {
+            hash = (hash ^ static_cast<uint8_t>(c)) * 16'777'619u;
+        }
+        return (hash ^ (hash >> 16)) % slot_count;
+    }
+
+    consteval bool try_seed() {
+        slots = {};
+        for (std::string_view type : known_link_types) {
+            std::string_view& slot = slots[slot_index(type, seed)];
+            if (!slot.empty()) {
+                return false;
+            }
+            slot = type;
+        }
+        return true;
+    }
+
+    std::array<std::string_view, slot_count> slots{};
+    uint32_t seed = 2'166'136'261u;
+};
+
+static constexpr LinkTypeSet link_types;
+
 const std::filesystem::path& Parser::get_filepath() const { return filepath; }
 
 Parser::Parser(const std::filesystem::path& filepath) : filepath(filepath) {}
 
-static std::optional<Error> parse_text_recursive(
-    std::string&& str, Paragraph& paragraph, bool bold, bool italic, const std::filesystem::path& filepath
+/**
+ * @brief The part of a paragraph that is parsed with the same formatting, i.e. the paragraph itself or the text of a
+ * bold or italic tag
+ */
+struct FormattingScope {
+    const char* end;
+    bool bold;
+    bool italic;
+};
+
+static void add_simple_text(
+    FormattedTextWriter& out, const char* begin, const char* end, const FormattingScope& scope
+) {
+    if (begin != end) {
+        out.add_simple_text(std::string_view(begin, end), scope.bold, scope.italic);
+    }
+}
+
+std::optional<Error> parse_paragraph(
+    std::string_view str, FormattedTextWriter& out, const std::filesystem::path& filepath
 ) {
     // TODO: add warning if '\n' is left in the string, as this is not well supported (currently)
-    std::optional<Error> error;
-    std::string::iterator start = str.begin();
-    std::string::iterator cur = str.begin();
-    std::string::iterator end = str.end();
-    while (cur != end) {
-        if (*cur != '{') {
-            ++cur;
+    FormattingScope scope{.end = str.data() + str.size(), .bold = false, .italic = false};
+    // the scopes that are continued after the current one, the formatting tags are parsed in one pass this way
+    std::vector<FormattingScope> outer_scopes;
+    std::vector<RichAttributeView> link_attributes;
+    const char* start = str.data();
+    const char* cur = str.data();
+    while (true) {
+        const char* tag_begin = static_cast<const char*>(std::memchr(cur, '{', static_cast<size_t>(scope.end - cur)));
+        if (tag_begin == nullptr) {
+            add_simple_text(out, start, scope.end, scope);
+            if (outer_scopes.empty()) {
+                break;
+            }
+            // skip the closing brace of the formatting tag
+            start = cur = scope.end + 1;
+            scope = outer_scopes.back();
+            outer_scopes.pop_back();
             continue;
         }
-        std::optional<RichText> rich_text = parse_rich_text(cur, end);
+        std::optional<RichTextView> rich_text = parse_rich_text_view(std::string_view(tag_begin, scope.end));
         if (!rich_text.has_value()) {
-            ++cur;
+            cur = tag_begin + 1;
             continue;
         }
-        if (start != cur) {
-            paragraph.parts.emplace_back(SimpleText{.str = checked_string(start, cur), .bold = bold, .italic = italic});
-        }
+        add_simple_text(out, start, tag_begin, scope);
+        start = cur = tag_begin + rich_text->length;
 
         if (rich_text->rich_type == "b" || rich_text->rich_type == "i") {
             if (!rich_text->attributes.empty()) {
@@ -68,84 +145,117 @@ static std::optional<Error> parse_text_recursive(
                     "well"
                 );
             }
-            bool inner_italic = false;
-            bool inner_bold = false;
-            if (rich_text->rich_type == "b") {
-                inner_bold = true;
-            } else {
-                assert(rich_text->rich_type == "i");
-                inner_italic = true;
-            }
-            error = parse_text_recursive(
-                std::move(rich_text->text), paragraph, bold || inner_bold, italic || inner_italic, filepath
-            );
-            if (error.has_value()) {
-                return error;
-            }
+            outer_scopes.push_back(scope);
+            scope = FormattingScope{
+                .end = rich_text->text.data() + rich_text->text.size(),
+                .bold = scope.bold || rich_text->rich_type == "b",
+                .italic = scope.italic || rich_text->rich_type == "i",
+            };
+            start = cur = rich_text->text.data();
         } else if (std::find(known_ignore_types.begin(), known_ignore_types.end(), rich_text->rich_type)
                    != known_ignore_types.end()) {
         } else {
-            if (std::find(known_link_types.begin(), known_link_types.end(), rich_text->rich_type)
-                == known_link_types.end()) {
+            if (!link_types.contains(rich_text->rich_type)) {
                 LOGWARN("Found rich text of unknown type '{}' - assuming link", rich_text->rich_type);
             }
 
+            std::string_view link_text = rich_text->text;
+            link_attributes.clear();
+            parse_rich_attributes_into(rich_text->attributes, link_attributes);
+
             // scaledamage and scaledice work very unintuitively - "<accum-increase>|<increase-range>|<single-increase>"
-            if (rich_text->rich_type == "scaledamage" || rich_text->rich_type == "scaledice") {
+            if ((rich_text->rich_type == "scaledamage" || rich_text->rich_type == "scaledice")
+                && !link_attributes.empty()) {
                 // swap accum-increase (stored in text) with single-increase (stored in the last attribute)
-                std::swap(rich_text->text, rich_text->attributes.back().value);
+                std::swap(link_text, link_attributes.back().value);
             }
-
-            paragraph.parts.emplace_back(
-                Link{
-                    .text =
-                        SimpleText{
-                            .str = std::move(rich_text->text),
-                            .bold = bold,
-                            .italic = italic,
-                        },
-                    .attributes = std::move(rich_text->attributes),
-                }
-            );
+            out.add_link(link_text, scope.bold, scope.italic, link_attributes);
         }
-        cur += rich_text->length;
-        start = cur;
-    }
-    if (start != cur) {
-        paragraph.parts.emplace_back(SimpleText{.str = checked_string(start, cur), .bold = bold, .italic = italic});
     }
     return std::nullopt;
 }
 
-std::optional<Error> parse_paragraph(std::string&& str, Paragraph& paragraph, const std::filesystem::path& filepath) {
-    return parse_text_recursive(std::move(str), paragraph, false, false, filepath);
+/**
+ * @brief Parses a paragraph and appends it, unless it is empty
+ * @param str the text of the paragraph
+ * @param out the writer to append the paragraph to
+ * @param filepath the file that contains the text
+ * @return the error that occurred while parsing, in which case nothing is appended
+ */
+static std::optional<Error> add_paragraph(
+    std::string_view str, FormattedTextWriter& out, const std::filesystem::path& filepath
+) {
+    FormattedTextWriter::Mark mark = out.mark();
+    uint32_t paragraph_index = out.begin_node(FormattedTextNodeType::PARAGRAPH);
+    std::optional<Error> error = parse_paragraph(str, out, filepath);
+    out.end_node(paragraph_index);
+    if (error.has_value() || !out.has_children(paragraph_index)) {
+        out.reset_to(mark);
+    }
+    return error;
 }
 
-std::expected<Table, Error> parse_table(const nlohmann::json& json, const std::filesystem::path& filepath) {
-    std::optional<Error> error;
-    Table new_table{};
+/**
+ * @brief Parses an "entries" entry with a name into one paragraph that starts with the name, unless the entries are
+ * not all strings, in which case they are queued to be parsed on their own after the name
+ * @param entry the entry
+ * @param todo the queue of entries that are still to be parsed
+ * @param out the writer to append the paragraph to
+ * @param filepath the file that contains the text
+ * @return the error that occurred while parsing, in which case nothing is appended
+ */
+static std::optional<Error> add_named_entries(
+    const nlohmann::json& entry, std::deque<CRef<nlohmann::json>>& todo, FormattedTextWriter& out,
+    const std::filesystem::path& filepath
+) {
+    std::string name;
+    std::optional<Error> error = parse_required_attribute_into(entry, "name", name, filepath);
+    if (error.has_value()) {
+        return error;
+    }
+    FormattedTextWriter::Mark mark = out.mark();
+    uint32_t paragraph_index = out.begin_node(FormattedTextNodeType::PARAGRAPH);
+    if (!name.empty()) {
+        out.add_simple_text(name, true, true, ". ");
+    }
 
-    std::string caption;
-    error = parse_optional_attribute_into(json, "caption", caption, filepath);
+    std::vector<std::string> entries_strings;
+    error = parse_required_attribute_into(entry, "entries", entries_strings, filepath);
     if (error.has_value()) {
-        return std::unexpected(error.value());
+        // fallback, treat all entries on their own
+        for (auto it = entry["entries"].rbegin(); it != entry["entries"].rend(); ++it) {
+            todo.push_front(*it);
+        }
+        error = std::nullopt;
+    } else {
+        error = parse_paragraph(
+            fmt::format("{}", fmt::join(entries_strings.begin(), entries_strings.end(), " ")), out, filepath
+        );
     }
-    if (!caption.empty()) {
-        new_table.caption = SimpleText{.str = checked_string(std::move(caption))};
+    out.end_node(paragraph_index);
+    if (error.has_value() || !out.has_children(paragraph_index)) {
+        out.reset_to(mark);
     }
+    return error;
+}
 
-    error = check_required_attribute(json, "colLabels", filepath, JsonType::ARRAY);
+static std::optional<Error> parse_table_into(
+    const nlohmann::json& json, uint32_t table_index, FormattedTextWriter& out, const std::filesystem::path& filepath
+) {
+    std::optional<Error> error = check_required_attribute(json, "colLabels", filepath, JsonType::ARRAY);
     if (error.has_value()) {
-        return std::unexpected(error.value());
+        return error;
     }
     const nlohmann::json& labels = json["colLabels"];
-    new_table.columns = labels.size();
+    size_t columns = labels.size();
+    out.set_column_count(table_index, columns);
 
-    for (size_t col = 0; col < new_table.columns; ++col) {
+    uint32_t first_column_index = out.node_count();
+    for (size_t col = 0; col < columns; ++col) {
         std::string header_entry;
         error = parse_required_index_into(labels, col, header_entry, filepath);
         if (error.has_value()) {
-            return std::unexpected(error.value());
+            return error;
         }
         if (header_entry.starts_with("{@")) {
             // INFO: I think there is no need and no real use case for rich text in the header; reconsider later
@@ -154,169 +264,172 @@ std::expected<Table, Error> parse_table(const nlohmann::json& json, const std::f
                 header_entry = rich_text->text;
             }
         }
-        new_table.header.push_back(SimpleText{.str = header_entry});
+        uint32_t column_index = out.begin_node(FormattedTextNodeType::TABLE_COLUMN, header_entry);
+        out.set_column_width(column_index, std::nullopt);
+        out.end_node(column_index);
     }
 
     if (json.contains("colStyles") && json["colStyles"].is_array()) {
         const nlohmann::json& styles = json["colStyles"];
-        for (size_t col = 0; col < new_table.columns; ++col) {
-            if (col >= styles.size()) {
-                new_table.column_widths->push_back(std::nullopt);
-                continue;
-            }
+        for (size_t col = 0; col < columns && col < styles.size(); ++col) {
             std::string style_entry;
             error = parse_required_index_into(styles, col, style_entry, filepath);
             if (error.has_value()) {
-                return std::unexpected(error.value());
+                return error;
             }
             if (style_entry.starts_with("col-")) {
                 size_t i = 4;
                 while (i < style_entry.size() && style_entry[i] != ' ') {
                     ++i;
                 }
-                if (!new_table.column_widths.has_value()) {
-                    new_table.column_widths = std::vector<std::optional<int>>();
-                }
-                new_table.column_widths->push_back(std::stoi(style_entry.substr(4, i)));
+                out.set_column_width(
+                    first_column_index + static_cast<uint32_t>(col), std::stoi(style_entry.substr(4, i))
+                );
             } else {
-                return std::unexpected(ParsingError(
+                return ParsingError(
                     ParsingError::Code::INVALID_ATTRIBUTE_TYPE, filepath,
                     "Table column style must start with \"col-<column width>...\""
-                ));
+                );
             }
         }
     }
 
     error = check_required_attribute(json, "rows", filepath, JsonType::ARRAY);
     if (error.has_value()) {
-        return std::unexpected(error.value());
+        return error;
     }
     const nlohmann::json& rows = json["rows"];
     for (size_t i = 0; i < rows.size(); ++i) {
         error = check_required_index(rows, i, filepath, JsonType::ARRAY);
         if (error.has_value()) {
-            return std::unexpected(error.value());
+            return error;
         }
-        std::vector<Paragraph>& row = new_table.rows.emplace_back();
+        uint32_t row_index = out.begin_node(FormattedTextNodeType::TABLE_ROW);
         for (size_t j = 0; j < rows[i].size(); ++j) {
             std::string entry;
             const nlohmann::json& entry_json = rows[i][j];
             if (entry_json.is_string()) {
                 error = parse_required_index_into(rows[i], j, entry, filepath);
                 if (error.has_value()) {
-                    return std::unexpected(error.value());
+                    return error;
                 }
             } else if (entry_json.is_number_integer()) {
                 int val;
                 error = parse_required_index_into(rows[i], j, val, filepath);
                 if (error.has_value()) {
-                    return std::unexpected(error.value());
+                    return error;
                 }
                 entry = fmt::format("{}", val);
             } else {
                 error = check_required_index(rows[i], j, filepath, JsonType::OBJECT);
                 if (error.has_value()) {
-                    return std::unexpected(error.value());
+                    return error;
                 }
                 std::string typ;
                 error = parse_required_attribute_into(entry_json, "type", typ, filepath);
                 if (error.has_value()) {
-                    return std::unexpected(error.value());
+                    return error;
                 }
                 if (typ != "cell") {
-                    return std::unexpected(ParsingError(
+                    return ParsingError(
                         ParsingError::Code::INVALID_ATTRIBUTE_TYPE, filepath,
                         "When having an object in a table entry, it must be of type \"cell\""
-                    ));
+                    );
                 }
                 error = check_required_attribute(entry_json, "roll", filepath, JsonType::OBJECT);
                 if (error.has_value()) {
-                    return std::unexpected(error.value());
+                    return error;
                 }
                 const nlohmann::json& roll = entry_json["roll"];
                 if (roll.contains("exact")) {
                     int exact_roll;
                     error = parse_required_attribute_into(roll, "exact", exact_roll, filepath);
                     if (error.has_value()) {
-                        return std::unexpected(error.value());
+                        return error;
                     }
                     entry = fmt::format("{}", exact_roll);
                 } else {
                     int min_roll;
                     error = parse_required_attribute_into(roll, "min", min_roll, filepath);
                     if (error.has_value()) {
-                        return std::unexpected(error.value());
+                        return error;
                     }
                     int max_roll;
                     error = parse_required_attribute_into(roll, "max", max_roll, filepath);
                     if (error.has_value()) {
-                        return std::unexpected(error.value());
+                        return error;
                     }
                     entry = fmt::format("{}-{}", min_roll, max_roll);
                 }
             }
-            Paragraph entry_paragraph{};
-            error = parse_paragraph(std::move(entry), entry_paragraph, filepath);
+            // every cell is kept, even an empty one, so that the cells stay in their columns
+            uint32_t cell_index = out.begin_node(FormattedTextNodeType::PARAGRAPH);
+            error = parse_paragraph(entry, out, filepath);
             if (error.has_value()) {
-                return std::unexpected(error.value());
+                return error;
             }
-            row.push_back(entry_paragraph);
+            out.end_node(cell_index);
         }
+        out.end_node(row_index);
     }
-    return new_table;
+    return std::nullopt;
 }
 
-static std::expected<ListItem, Error> parse_list_item(
-    const nlohmann::json& json, const std::filesystem::path& filepath
+std::optional<Error> parse_table(
+    const nlohmann::json& json, FormattedTextWriter& out, const std::filesystem::path& filepath
 ) {
-    ListItem out{};
+    std::string caption;
+    std::optional<Error> error = parse_optional_attribute_into(json, "caption", caption, filepath);
+    if (error.has_value()) {
+        return error;
+    }
+
+    FormattedTextWriter::Mark mark = out.mark();
+    uint32_t table_index = out.begin_node(FormattedTextNodeType::TABLE, checked_string(std::move(caption)));
+    error = parse_table_into(json, table_index, out, filepath);
+    if (error.has_value()) {
+        out.reset_to(mark);
+        return error;
+    }
+    out.end_node(table_index);
+    return std::nullopt;
+}
 
+/**
+ * @brief Parses a list item and appends its parts to the list item node that the writer has open
+ * @param json the list item
+ * @param out the writer with the open list item node
+ * @param filepath the file that contains the text
+ * @return the error that occurred while parsing, in which case the parts might have been appended partially
+ */
+static std::optional<Error> parse_list_item(
+    const nlohmann::json& json, FormattedTextWriter& out, const std::filesystem::path& filepath
+) {
     std::optional<Error> error;
     if (json.is_string()) {
-        Paragraph new_paragraph{};
-        error = parse_paragraph(json.get<std::string>(), new_paragraph, filepath);
-        if (error.has_value()) {
-            return std::unexpected(error.value());
-        }
-        if (!new_paragraph.parts.empty()) {
-            out.parts.push_back(new_paragraph);
-        }
-        return out;
+        return add_paragraph(json.get<std::string>(), out, filepath);
     }
     if (!json.is_object()) {
-        return std::unexpected(ParsingError(
+        return ParsingError(
             ParsingError::Code::INVALID_ATTRIBUTE_TYPE, filepath,
             "Json entries in the \"items\" array must either be strings or objects."
-        ));
+        );
     }
 
     std::string type;
     error = parse_required_attribute_into(json, "type", type, filepath);
     if (error.has_value()) {
-        return std::unexpected(error.value());
+        return error;
     }
     if (type != "item" && type != "itemSpell") {
-        return out;
+        return std::nullopt;
     }
 
-    std::optional<Paragraph> first_paragraph = std::nullopt;
+    std::string name;
     if (json.contains("name")) {
-        std::string name;
         error = parse_required_attribute_into(json, "name", name, filepath);
         if (error.has_value()) {
-            return std::unexpected(error.value());
-        }
-        if (!name.empty()) {
-            if (!first_paragraph.has_value()) {
-                first_paragraph = Paragraph{};
-            }
-            first_paragraph->parts.push_back(
-                SimpleText{
-                    .str = checked_string(std::move(name)) + ". ",
-                    .bold = true,
-                    .italic = false,
-                }
-            );
+            return error;
         }
     }
 
@@ -327,93 +440,62 @@ static std::expected<ListItem, Error> parse_list_item(
     } else {
         error = check_required_attribute(json, "entries", filepath, JsonType::ARRAY);
         if (error.has_value()) {
-            return std::unexpected(error.value());
+            return error;
         }
         for (const nlohmann::json& entry : json["entries"]) {
             todo.push_back(entry);
         }
     }
 
-    if (first_paragraph.has_value()) {
-        const nlohmann::json& first_entry = todo.front();
-        if (first_entry.is_string()) {
+    if (!name.empty()) {
+        // the name and the first entry, if it is a string, form the first paragraph
+        uint32_t first_paragraph_index = out.begin_node(FormattedTextNodeType::PARAGRAPH);
+        out.add_simple_text(name, true, false, ". ");
+        if (!todo.empty() && todo.front().get().is_string()) {
+            const nlohmann::json& first_entry = todo.front();
             todo.pop_front();
-            error = parse_paragraph(first_entry.get<std::string>(), first_paragraph.value(), filepath);
+            error = parse_paragraph(first_entry.get<std::string>(), out, filepath);
             if (error.has_value()) {
-                return std::unexpected(error.value());
+                return error;
             }
         }
-        if (!first_paragraph.value().parts.empty()) {
-            out.parts.push_back(first_paragraph.value());
-        }
+        out.end_node(first_paragraph_index);
     }
 
     while (!todo.empty()) {
         const nlohmann::json& entry = todo.front();
         todo.pop_front();
         if (entry.is_string()) {
-            Paragraph new_paragraph{};
-            error = parse_paragraph(entry.get<std::string>(), new_paragraph, filepath);
+            error = add_paragraph(entry.get<std::string>(), out, filepath);
             if (error.has_value()) {
-                return std::unexpected(error.value());
-            }
-            if (!new_paragraph.parts.empty()) {
-                out.parts.push_back(new_paragraph);
+                return error;
             }
             continue;
         }
 
         if (!entry.is_object()) {
-            return std::unexpected(ParsingError(
+            return ParsingError(
                 ParsingError::Code::INVALID_ATTRIBUTE_TYPE, filepath,
                 "Json entries in the \"entries\" array must either be strings or objects."
-            ));
+            );
         }
 
         std::string entry_type;
         error = parse_required_attribute_into(entry, "type", entry_type, filepath);
         if (error.has_value()) {
-            return std::unexpected(error.value());
+            return error;
         }
 
         if (entry_type == "entries") {
             error = check_required_attribute(entry, "entries", filepath, JsonType::ARRAY);
             if (error.has_value()) {
-                return std::unexpected(error.value());
+                return error;
             }
 
             if (entry.contains("name")) {
-                std::string name;
-                error = parse_required_attribute_into(entry, "name", name, filepath);
-                if (error.has_value()) {
-                    return std::unexpected(error.value());
-                }
-                Paragraph new_paragraph{};
-                if (!name.empty()) {
-                    new_paragraph.parts.push_back(
-                        SimpleText{.str = checked_string(std::move(name)) + ". ", .bold = true, .italic = true}
-                    );
-                }
-
-                std::vector<std::string> entries_strings;
-                error = parse_required_attribute_into(entry, "entries", entries_strings, filepath);
+                error = add_named_entries(entry, todo, out, filepath);
                 if (error.has_value()) {
-                    // fallback, treat all entries on their own
-                    for (auto it = entry["entries"].rbegin(); it != entry["entries"].rend(); ++it) {
-                        todo.push_front(*it);
-                    }
-                    error = std::nullopt;
-                } else {
-                    error = parse_paragraph(
-                        fmt::format("{}", fmt::join(entries_strings.begin(), entries_strings.end(), " ")),
-                        new_paragraph, filepath
-                    );
-                    if (error.has_value()) {
-                        return std::unexpected(error.value());
-                    }
-                }
-                if (!new_paragraph.parts.empty()) {
-                    out.parts.push_back(new_paragraph);
+                    return error;
                 }
             } else {
                 for (auto it = entry["entries"].rbegin(); it != entry["entries"].rend(); ++it) {
@@ -421,92 +503,92 @@ static std::expected<ListItem, Error> parse_list_item(
                 }
             }
         } else if (entry_type == "table") {
-            std::expected<Table, Error> new_table = parse_table(entry, filepath);
-            if (new_table.has_value()) {
-                out.parts.push_back(new_table.value());
-            } else {
-                return std::unexpected(new_table.error());
+            error = parse_table(entry, out, filepath);
+            if (error.has_value()) {
+                return error;
             }
         } else {
-            return std::unexpected(ParsingError(
+            return ParsingError(
                 ParsingError::Code::UNEXPECTED_ATTRIBUTE, filepath,
                 fmt::format("Entry type \"{}\" unexpected", entry_type)
-            ));
+            );
         }
     }
-    return out;
+    return std::nullopt;
 }
 
-std::optional<Error> parse_list(const nlohmann::json& list_items, Text& out, const std::filesystem::path& filepath) {
-    std::optional<Error> error;
-    List new_list{};
-
-    if (!out.parts.empty()) {
-        TextObject& last = out.parts.back();
-        if (last.index() == 0) /* Paragraph */ {
-            Paragraph& paragraph = std::get<0>(last);
-            if (!paragraph.parts.empty()) {
-                const InlineText& last_inline = paragraph.parts.back();
-                if (last_inline.index() == 0) /* SimpleText */ {
-                    const SimpleText& simple_text = std::get<0>(last_inline);
-                    if (simple_text.str.ends_with(':')) {
-                        new_list.text_above = paragraph;
-                        out.parts.pop_back();
-                    }
-                }
-            }
-        }
+/**
+ * @brief Returns the last top-level paragraph if it ends with a colon and therefore introduces a list
+ */
+static std::optional<uint32_t> find_text_above_list(const FormattedTextWriter& out) {
+    std::optional<uint32_t> last_part = out.get_last_part();
+    if (!last_part.has_value() || out.get_node(last_part.value()).get_type() != FormattedTextNodeType::PARAGRAPH) {
+        return std::nullopt;
+    }
+    std::optional<uint32_t> last_inline = out.get_last_child(last_part.value());
+    if (!last_inline.has_value()) {
+        return std::nullopt;
     }
+    FormattedTextNode last_inline_node = out.get_node(last_inline.value());
+    bool ends_with_colon = last_inline_node.get_text().ends_with(':');
+    if (last_inline_node.get_type() != FormattedTextNodeType::SIMPLE_TEXT || !ends_with_colon) {
+        return std::nullopt;
+    }
+    return last_part;
+}
 
+std::optional<Error> parse_list(
+    const nlohmann::json& list_items, FormattedTextWriter& out, const std::filesystem::path& filepath
+) {
+    std::optional<uint32_t> text_above_index = find_text_above_list(out);
+    // the text above belongs to the list, so it is removed together with it
+    FormattedTextWriter::Mark list_mark = text_above_index.has_value() ? out.mark_before(text_above_index.value())
+                                                                       : out.mark();
+    uint32_t first_item_index = out.node_count();
+
+    size_t item_count = 0;
     for (const nlohmann::json& item : list_items) {
-        std::expected<ListItem, Error> parsed_item = parse_list_item(item, filepath);
-        if (parsed_item.has_value()) {
-            if (!parsed_item.value().parts.empty()) {
-                new_list.parts.push_back(parsed_item.value());
-            }
+        FormattedTextWriter::Mark item_mark = out.mark();
+        uint32_t item_index = out.begin_node(FormattedTextNodeType::LIST_ITEM);
+        std::optional<Error> error = parse_list_item(item, out, filepath);
+        if (error.has_value()) {
+            out.reset_to(list_mark);
+            return error;
+        }
+        out.end_node(item_index);
+        if (out.has_children(item_index)) {
+            ++item_count;
         } else {
-            return parsed_item.error();
+            out.reset_to(item_mark);
         }
     }
 
-    if (new_list.parts.size() == 1) {
-        for (std::variant<Paragraph, Table>& part : new_list.parts[0].parts) {
-            switch (part.index()) {
-                case 0: /*Paragraph */ {
-                    Paragraph& paragraph = std::get<0>(part);
-                    if (!paragraph.parts.empty()) {
-                        out.parts.push_back(paragraph);
-                    }
-                    break;
-                }
-                case 1: /* Table */ {
-                    out.parts.push_back(std::get<1>(part));
-                    break;
-                }
-                default:
-                    std::unreachable();
-            }
-        }
-    } else if (!new_list.parts.empty()) {
-        out.parts.push_back(new_list);
+    if (item_count == 0) {
+        out.reset_to(list_mark);
+    } else if (item_count == 1) {
+        // a single item is not a list, its parts are kept on their own without the text above
+        out.erase_nodes(text_above_index.value_or(first_item_index), first_item_index + 1);
+    } else {
+        out.wrap_nodes_from(text_above_index.value_or(first_item_index), FormattedTextNodeType::LIST);
     }
     return std::nullopt;
 }
 
 std::optional<Error> write_formatted_text_into(
-    const nlohmann::json& json, Text& out, const std::filesystem::path& filepath
+    const nlohmann::json& json, FormattedText& out, const std::filesystem::path& filepath
 ) {
     return write_formatted_text_into(json, out, filepath, false);
 }
 
 std::optional<Error> write_formatted_text_into(
-    const nlohmann::json& json, Text& out, const std::filesystem::path& filepath, bool skip_first
+    const nlohmann::json& json, FormattedText& out, const std::filesystem::path& filepath, bool skip_first
 ) {
     std::optional<Error> error = check_required_attribute(json, "entries", filepath, JsonType::ARRAY);
     if (error.has_value()) {
         return error;
     }
 
+    FormattedTextWriter writer(out);
     std::deque<CRef<nlohmann::json>> todo;
 
     bool is_first = true;
@@ -522,14 +604,10 @@ std::optional<Error> write_formatted_text_into(
         const nlohmann::json& entry = todo.front();
         todo.pop_front();
         if (entry.is_string()) {
-            Paragraph new_paragraph{};
-            error = parse_paragraph(entry.get<std::string>(), new_paragraph, filepath);
+            error = add_paragraph(entry.get<std::string>(), writer, filepath);
             if (error.has_value()) {
                 return error;
             }
-            if (!new_paragraph.parts.empty()) {
-                out.parts.push_back(new_paragraph);
-            }
             continue;
         }
 
@@ -553,38 +631,10 @@ std::optional<Error> write_formatted_text_into(
             }
 
             if (entry.contains("name")) {
-                std::string name;
-                error = parse_required_attribute_into(entry, "name", name, filepath);
+                error = add_named_entries(entry, todo, writer, filepath);
                 if (error.has_value()) {
                     return error;
                 }
-                Paragraph new_paragraph{};
-                if (!name.empty()) {
-                    new_paragraph.parts.push_back(
-                        SimpleText{.str = checked_string(std::move(name)) + ". ", .bold = true, .italic = true}
-                    );
-                }
-
-                std::vector<std::string> entries_strings;
-                error = parse_required_attribute_into(entry, "entries", entries_strings, filepath);
-                if (error.has_value()) {
-                    // fallback, treat all entries on their own
-                    for (auto it = entry["entries"].rbegin(); it != entry["entries"].rend(); ++it) {
-                        todo.push_front(*it);
-                    }
-                    error = std::nullopt;
-                } else {
-                    error = parse_paragraph(
-                        fmt::format("{}", fmt::join(entries_strings.begin(), entries_strings.end(), " ")),
-                        new_paragraph, filepath
-                    );
-                    if (error.has_value()) {
-                        return error;
-                    }
-                }
-                if (!new_paragraph.parts.empty()) {
-                    out.parts.push_back(new_paragraph);
-                }
             } else {
                 for (auto it = entry["entries"].rbegin(); it != entry["entries"].rend(); ++it) {
                     todo.push_front(*it);
@@ -595,16 +645,14 @@ std::optional<Error> write_formatted_text_into(
             if (error.has_value()) {
                 return error;
             }
-            error = parse_list(entry["items"], out, filepath);
+            error = parse_list(entry["items"], writer, filepath);
             if (error.has_value()) {
                 return error;
             }
         } else if (type == "table") {
-            std::expected<Table, Error> new_table = parse_table(entry, filepath);
-            if (new_table.has_value()) {
-                out.parts.push_back(new_table.value());
-            } else {
-                return new_table.error();
+            error = parse_table(entry, writer, filepath);
+            if (error.has_value()) {
+                return error;
             }
         } else if (
             type == "options" || type.starts_with("ref") || type == "abilityDc" || type == "abilityAttackMod"
@@ -9,6 +9,7 @@
 #include <optional>
 #include <set>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include <fmt/format.h>
@@ -16,7 +17,8 @@
 
 #include <core/errors/errors.hpp>
 #include <core/errors/parsing_error.hpp>
-#include <core/text/text.hpp>
+#include <core/text/formatted_text.hpp>
+#include <core/text/formatted_text_writer.hpp>
 
 namespace dnd {
 
@@ -31,18 +33,31 @@ private:
     const std::filesystem::path& filepath;
 };
 
-std::optional<Error> parse_paragraph(std::string&& str, Paragraph& paragraph, const std::filesystem::path& filepath);
+/**
+ * @brief Parses the text of a paragraph and appends its simple texts and links to the open paragraph of the writer
+ * @param str the text of the paragraph
+ * @param out the writer with the open paragraph node
+ * @param filepath the file that contains the text
+ * @return the error that occurred while parsing, in which case the paragraph might have been appended to partially
+ */
+std::optional<Error> parse_paragraph(
+    std::string_view str, FormattedTextWriter& out, const std::filesystem::path& filepath
+);
 
-std::expected<Table, Error> parse_table(const nlohmann::json& json, const std::filesystem::path& filepath);
+std::optional<Error> parse_table(
+    const nlohmann::json& json, FormattedTextWriter& out, const std::filesystem::path& filepath
+);
 
-std::optional<Error> parse_list(const nlohmann::json& list_items, Text& out, const std::filesystem::path& filepath);
+std::optional<Error> parse_list(
+    const nlohmann::json& list_items, FormattedTextWriter& out, const std::filesystem::path& filepath
+);
 
 std::optional<Error> write_formatted_text_into(
-    const nlohmann::json& json, Text& out, const std::filesystem::path& filepath
+    const nlohmann::json& json, FormattedText& out, const std::filesystem::path& filepath
 );
 
 std::optional<Error> write_formatted_text_into(
-    const nlohmann::json& json, Text& out, const std::filesystem::path& filepath, bool skip_first
+    const nlohmann::json& json, FormattedText& out, const std::filesystem::path& filepath, bool skip_first
 );
 
 
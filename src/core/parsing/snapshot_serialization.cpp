@@ -0,0 +1,635 @@
+#include <dnd_config.hpp>
+
+#include "snapshot_serialization.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <core/errors/errors.hpp>
+#include <core/errors/parsing_error.hpp>
+#include <core/errors/runtime_error.hpp>
+#include <core/errors/validation_error.hpp>
+#include <core/models/character/character.hpp>
+#include <core/models/class/class.hpp>
+#include <core/models/effects_provider/choosable.hpp>
+#include <core/models/item/item.hpp>
+#include <core/models/species/species.hpp>
+#include <core/models/spell/spell.hpp>
+#include <core/models/subclass/subclass.hpp>
+#include <core/models/subspecies/subspecies.hpp>
+#include <core/text/formatted_text.hpp>
+#include <core/text/formatted_text_writer.hpp>
+#include <core/text/text_source.hpp>
+#include <core/validation/validation_data.hpp>
+
+namespace dnd {
+
+void SnapshotWriter::write_bytes(const void* data, size_t size) {
+    buffer.append(static_cast<const char*>(data), size);
+}
+
+const std::string& SnapshotWriter::get_buffer() const { return buffer; }
+
+std::string SnapshotWriter::take_buffer() { return std::move(buffer); }
+
+SnapshotReader::SnapshotReader(std::string_view buffer) : buffer(buffer), position(0), failed(false) {}
+
+bool SnapshotReader::read_bytes(void* data, size_t size) {
+    if (failed || size > buffer.size() - position) {
+        failed = true;
+        return false;
+    }
+    std::memcpy(data, buffer.data() + position, size);
+    position += size;
+    return true;
+}
+
+bool SnapshotReader::ok() const { return !failed; }
+
+bool SnapshotReader::at_end() const { return position == buffer.size(); }
+
+size_t SnapshotReader::get_remaining_size() const { return buffer.size() - position; }
+
+void SnapshotReader::fail() { failed = true; }
+
+void serialize(SnapshotWriter& writer, const std::string& str) {
+    serialize<uint64_t>(writer, str.size());
+    writer.write_bytes(str.data(), str.size());
+}
+
+void deserialize(SnapshotReader& reader, std::string& str) {
+    uint64_t size = 0;
+    deserialize(reader, size);
+    if (!reader.ok()) {
+        return;
+    }
+    // a corrupted size must not be allocated before it is known that the buffer contains that many bytes
+    if (size > reader.get_remaining_size()) {
+        reader.fail();
+        return;
+    }
+    std::string result(size, '\0');
+    if (reader.read_bytes(result.data(), size)) {
+        str = std::move(result);
+    }
+}
+
+void serialize(SnapshotWriter& writer, const std::filesystem::path& path) { serialize(writer, path.string()); }
+
+void deserialize(SnapshotReader& reader, std::filesystem::path& path) {
+    std::string path_str;
+    deserialize(reader, path_str);
+    path = std::move(path_str);
+}
+
+void serialize(SnapshotWriter& writer, const Errors& errors) {
+    serialize<uint64_t>(writer, errors.get_errors().size());
+    for (const Error& error : errors.get_errors()) {
+        serialize<uint64_t>(writer, error.index());
+        switch (error.index()) {
+            case 0: {
+                const ParsingError& parsing_error = std::get<ParsingError>(error);
+                serialize(writer, parsing_error.get_error_code());
+                serialize(writer, parsing_error.get_filepath());
+                serialize(writer, parsing_error.get_error_message());
+                break;
+            }
+            case 1: {
+                const ValidationError& validation_error = std::get<ValidationError>(error);
+                serialize(writer, validation_error.get_error_code());
+                serialize(writer, validation_error.get_error_message());
+                break;
+            }
+            case 2: {
+                const RuntimeError& runtime_error = std::get<RuntimeError>(error);
+                serialize(writer, runtime_error.get_error_code());
+                serialize(writer, runtime_error.get_error_message());
+                break;
+            }
+        }
+    }
+}
+
+void deserialize(SnapshotReader& reader, Errors& errors) {
+    uint64_t size = 0;
+    deserialize(reader, size);
+    for (uint64_t i = 0; i < size && reader.ok(); ++i) {
+        uint64_t index = 0;
+        deserialize(reader, index);
+        switch (index) {
+            case 0: {
+                ParsingError::Code code = ParsingError::Code::UNKNOWN_ERROR;
+                std::filesystem::path filepath;
+                std::string message;
+                deserialize(reader, code);
+                deserialize(reader, filepath);
+                deserialize(reader, message);
+                errors.add_parsing_error(code, filepath, std::move(message));
+                break;
+            }
+            case 1: {
+                ValidationError::Code code = ValidationError::Code::UNKNOWN_ERROR;
+                std::string message;
+                deserialize(reader, code);
+                deserialize(reader, message);
+                errors.add_validation_error(code, std::move(message));
+                break;
+            }
+            case 2: {
+                RuntimeError::Code code = RuntimeError::Code::UNKNOWN_ERROR;
+                std::string message;
+                deserialize(reader, code);
+                deserialize(reader, message);
+                errors.add_runtime_error(code, std::move(message));
+                break;
+            }
+            default:
+                reader.fail();
+                break;
+        }
+    }
+}
+
+// the nodes of a text are nested at most this deep, deeper nesting can only come from a corrupted snapshot
+static constexpr uint32_t max_text_depth = 8;
+
+static void serialize(SnapshotWriter& writer, std::string_view str) {
+    serialize<uint64_t>(writer, str.size());
+    writer.write_bytes(str.data(), str.size());
+}
+
+static void serialize(SnapshotWriter& writer, FormattedTextNode node) {
+    serialize(writer, node.get_type());
+    serialize(writer, node.get_text());
+    serialize(writer, node.is_bold());
+    serialize(writer, node.is_italic());
+    if (node.get_type() == FormattedTextNodeType::TABLE) {
+        serialize<uint64_t>(writer, node.get_column_count());
+    } else if (node.get_type() == FormattedTextNodeType::TABLE_COLUMN) {
+        serialize(writer, node.get_column_width());
+    }
+
+    uint64_t attribute_count = 0;
+    for (FormattedTextAttribute attribute : node.get_attributes()) {
+        DND_UNUSED(attribute);
+        ++attribute_count;
+    }
+    serialize(writer, attribute_count);
+    for (FormattedTextAttribute attribute : node.get_attributes()) {
+        serialize(writer, attribute.key.has_value());
+        serialize(writer, attribute.key.value_or(std::string_view()));
+        serialize(writer, attribute.value);
+    }
+
+    uint64_t child_count = 0;
+    for (FormattedTextNode child : node.get_children()) {
+        DND_UNUSED(child);
+        ++child_count;
+    }
+    serialize(writer, child_count);
+    for (FormattedTextNode child : node.get_children()) {
+        serialize(writer, child);
+    }
+}
+
+static void deserialize_node(SnapshotReader& reader, FormattedTextWriter& text_writer, uint32_t depth) {
+    FormattedTextNodeType type = FormattedTextNodeType::PARAGRAPH;
+    std::string str;
+    bool bold = false;
+    bool italic = false;
+    deserialize(reader, type);
+    deserialize(reader, str);
+    deserialize(reader, bold);
+    deserialize(reader, italic);
+    if (!reader.ok() || depth > max_text_depth) {
+        reader.fail();
+        return;
+    }
+    uint32_t node_index = text_writer.begin_node(type, str, bold, italic);
+    if (type == FormattedTextNodeType::TABLE) {
+        uint64_t column_count = 0;
+        deserialize(reader, column_count);
+        if (column_count > static_cast<uint64_t>(std::numeric_limits<int32_t>::max())) {
+            reader.fail();
+            return;
+        }
+        text_writer.set_column_count(node_index, column_count);
+    } else if (type == FormattedTextNodeType::TABLE_COLUMN) {
+        std::optional<int> column_width;
+        deserialize(reader, column_width);
+        text_writer.set_column_width(node_index, column_width);
+    }
+
+    uint64_t attribute_count = 0;
+    deserialize(reader, attribute_count);
+    for (uint64_t i = 0; i < attribute_count && reader.ok(); ++i) {
+        bool has_key = false;
+        std::string key;
+        std::string value;
+        deserialize(reader, has_key);
+        deserialize(reader, key);
+        deserialize(reader, value);
+        if (has_key) {
+            text_writer.add_attribute(key, value);
+        } else {
+            text_writer.add_attribute(std::nullopt, value);
+        }
+    }
+
+    uint64_t child_count = 0;
+    deserialize(reader, child_count);
+    for (uint64_t i = 0; i < child_count && reader.ok(); ++i) {
+        deserialize_node(reader, text_writer, depth + 1);
+    }
+    text_writer.end_node(node_index);
+}
+
+void serialize(SnapshotWriter& writer, const FormattedText& text) {
+    uint64_t part_count = 0;
+    for (FormattedTextNode part : text.get_parts()) {
+        DND_UNUSED(part);
+        ++part_count;
+    }
+    serialize(writer, part_count);
+    for (FormattedTextNode part : text.get_parts()) {
+        serialize(writer, part);
+    }
+}
+
+void deserialize(SnapshotReader& reader, FormattedText& text) {
+    text = FormattedText();
+    FormattedTextWriter text_writer(text);
+    uint64_t part_count = 0;
+    deserialize(reader, part_count);
+    for (uint64_t i = 0; i < part_count && reader.ok(); ++i) {
+        deserialize_node(reader, text_writer, 1);
+    }
+}
+
+void serialize(SnapshotWriter& writer, const TextSource& text_source) {
+    serialize(writer, text_source.offset);
+    serialize(writer, text_source.length);
+    serialize(writer, text_source.content_hash);
+    serialize(writer, text_source.format);
+}
+
+void deserialize(SnapshotReader& reader, TextSource& text_source) {
+    deserialize(reader, text_source.offset);
+    deserialize(reader, text_source.length);
+    deserialize(reader, text_source.content_hash);
+    deserialize(reader, text_source.format);
+}
+
+static void serialize_validation_data(SnapshotWriter& writer, const ValidationData& data) {
+    serialize(writer, data.name);
+    serialize(writer, data.description);
+    serialize(writer, data.description_source);
+    serialize(writer, data.source_path);
+    serialize(writer, data.source_name);
+}
+
+static void deserialize_validation_data(SnapshotReader& reader, ValidationData& data) {
+    deserialize(reader, data.name);
+    deserialize(reader, data.description);
+    deserialize(reader, data.description_source);
+    deserialize(reader, data.source_path);
+    deserialize(reader, data.source_name);
+}
+
+void serialize(SnapshotWriter& writer, const Condition::Data& data) { serialize(writer, data.condition_str); }
+
+void deserialize(SnapshotReader& reader, Condition::Data& data) { deserialize(reader, data.condition_str); }
+
+void serialize(SnapshotWriter& writer, const Choice::Data& data) {
+    serialize(writer, data.attribute_name);
+    serialize(writer, data.amount);
+    serialize(writer, data.group_names);
+    serialize(writer, data.explicit_choices);
+}
+
+void deserialize(SnapshotReader& reader, Choice::Data& data) {
+    deserialize(reader, data.attribute_name);
+    deserialize(reader, data.amount);
+    deserialize(reader, data.group_names);
+    deserialize(reader, data.explicit_choices);
+}
+
+void serialize(SnapshotWriter& writer, const StatChange::Data& data) { serialize(writer, data.stat_change_str); }
+
+void deserialize(SnapshotReader& reader, StatChange::Data& data) { deserialize(reader, data.stat_change_str); }
+
+void serialize(SnapshotWriter& writer, const Effects::Data& data) {
+    serialize(writer, data.activation_conditions_data);
+    serialize(writer, data.choices_data);
+    serialize(writer, data.stat_changes_data);
+
+    serialize(writer, data.action_holder_data.actions);
+    serialize(writer, data.action_holder_data.bonus_actions);
+    serialize(writer, data.action_holder_data.reactions);
+
+    serialize(writer, data.extra_spells_holder_data.free_cantrips);
+    serialize(writer, data.extra_spells_holder_data.at_will);
+    serialize(writer, data.extra_spells_holder_data.innate);
+    serialize(writer, data.extra_spells_holder_data.free_once_a_day);
+    serialize(writer, data.extra_spells_holder_data.spells_known);
+    serialize(writer, data.extra_spells_holder_data.spells_known_included);
+    serialize(writer, data.extra_spells_holder_data.added_to_spell_list);
+
+    serialize(writer, data.proficiency_holder_data.armor);
+    serialize(writer, data.proficiency_holder_data.weapons);
+    serialize(writer, data.proficiency_holder_data.tools);
+    serialize(writer, data.proficiency_holder_data.skills);
+    serialize(writer, data.proficiency_holder_data.saving_throws);
+    serialize(writer, data.proficiency_holder_data.languages);
+    serialize(writer, data.proficiency_holder_data.senses);
+
+    serialize(writer, data.riv_holder_data.damage_resistances);
+    serialize(writer, data.riv_holder_data.damage_immunities);
+    serialize(writer, data.riv_holder_data.damage_vulnerabilities);
+    serialize(writer, data.riv_holder_data.condition_immunities);
+}
+
+void deserialize(SnapshotReader& reader, Effects::Data& data) {
+    deserialize(reader, data.activation_conditions_data);
+    deserialize(reader, data.choices_data);
+    deserialize(reader, data.stat_changes_data);
+
+    deserialize(reader, data.action_holder_data.actions);
+    deserialize(reader, data.action_holder_data.bonus_actions);
+    deserialize(reader, data.action_holder_data.reactions);
+
+    deserialize(reader, data.extra_spells_holder_data.free_cantrips);
+    deserialize(reader, data.extra_spells_holder_data.at_will);
+    deserialize(reader, data.extra_spells_holder_data.innate);
+    deserialize(reader, data.extra_spells_holder_data.free_once_a_day);
+    deserialize(reader, data.extra_spells_holder_data.spells_known);
+    deserialize(reader, data.extra_spells_holder_data.spells_known_included);
+    deserialize(reader, data.extra_spells_holder_data.added_to_spell_list);
+
+    deserialize(reader, data.proficiency_holder_data.armor);
+    deserialize(reader, data.proficiency_holder_data.weapons);
+    deserialize(reader, data.proficiency_holder_data.tools);
+    deserialize(reader, data.proficiency_holder_data.skills);
+    deserialize(reader, data.proficiency_holder_data.saving_throws);
+    deserialize(reader, data.proficiency_holder_data.languages);
+    deserialize(reader, data.proficiency_holder_data.senses);
+
+    deserialize(reader, data.riv_holder_data.damage_resistances);
+    deserialize(reader, data.riv_holder_data.damage_immunities);
+    deserialize(reader, data.riv_holder_data.damage_vulnerabilities);
+    deserialize(reader, data.riv_holder_data.condition_immunities);
+}
+
+void serialize(SnapshotWriter& writer, const Feature::Data& data) {
+    serialize_validation_data(writer, data);
+    serialize(writer, data.main_effects_data);
+}
+
+void deserialize(SnapshotReader& reader, Feature::Data& data) {
+    deserialize_validation_data(reader, data);
+    deserialize(reader, data.main_effects_data);
+}
+
+void serialize(SnapshotWriter& writer, const ClassFeature::Data& data) {
+    serialize(writer, static_cast<const Feature::Data&>(data));
+    serialize(writer, data.level);
+    serialize(writer, data.higher_level_effects_data);
+    serialize(writer, data.class_name);
+    serialize(writer, data.class_source_name);
+}
+
+void deserialize(SnapshotReader& reader, ClassFeature::Data& data) {
+    deserialize(reader, static_cast<Feature::Data&>(data));
+    deserialize(reader, data.level);
+    deserialize(reader, data.higher_level_effects_data);
+    deserialize(reader, data.class_name);
+    deserialize(reader, data.class_source_name);
+}
+
+void serialize(SnapshotWriter& writer, const SubclassFeature::Data& data) {
+    serialize(writer, static_cast<const Feature::Data&>(data));
+    serialize(writer, data.level);
+    serialize(writer, data.higher_level_effects_data);
+    serialize(writer, data.subclass_short_name);
+    serialize(writer, data.subclass_source_name);
+}
+
+void deserialize(SnapshotReader& reader, SubclassFeature::Data& data) {
+    deserialize(reader, static_cast<Feature::Data&>(data));
+    deserialize(reader, data.level);
+    deserialize(reader, data.higher_level_effects_data);
+    deserialize(reader, data.subclass_short_name);
+    deserialize(reader, data.subclass_source_name);
+}
+
+void serialize(SnapshotWriter& writer, const Choosable::Data& data) {
+    serialize(writer, static_cast<const Feature::Data&>(data));
+    serialize(writer, data.type);
+    serialize(writer, data.prerequisites_data);
+}
+
+void deserialize(SnapshotReader& reader, Choosable::Data& data) {
+    deserialize(reader, static_cast<Feature::Data&>(data));
+    deserialize(reader, data.type);
+    deserialize(reader, data.prerequisites_data);
+}
+
+void serialize(SnapshotWriter& writer, const Spellcasting::Data& data) {
+    serialize(writer, data.is_spellcaster);
+    serialize(writer, data.ability);
+    serialize(writer, data.ritual_casting);
+    serialize(writer, data.is_spells_known_type);
+    serialize(writer, data.preparation_spellcasting_type);
+    serialize(writer, data.spells_known);
+    serialize(writer, data.cantrips_known);
+    serialize(writer, data.spell_slots);
+}
+
+void deserialize(SnapshotReader& reader, Spellcasting::Data& data) {
+    deserialize(reader, data.is_spellcaster);
+    deserialize(reader, data.ability);
+    deserialize(reader, data.ritual_casting);
+    deserialize(reader, data.is_spells_known_type);
+    deserialize(reader, data.preparation_spellcasting_type);
+    deserialize(reader, data.spells_known);
+    deserialize(reader, data.cantrips_known);
+    deserialize(reader, data.spell_slots);
+}
+
+void serialize(SnapshotWriter& writer, const Class::Data& data) {
+    serialize_validation_data(writer, data);
+    serialize(writer, data.spellcasting_data);
+    serialize(writer, data.features_data);
+    serialize(writer, data.subclass_feature_name);
+    serialize(writer, data.hit_dice_str);
+    serialize(writer, data.important_levels_data.feat_levels);
+}
+
+void deserialize(SnapshotReader& reader, Class::Data& data) {
+    deserialize_validation_data(reader, data);
+    deserialize(reader, data.spellcasting_data);
+    deserialize(reader, data.features_data);
+    deserialize(reader, data.subclass_feature_name);
+    deserialize(reader, data.hit_dice_str);
+    deserialize(reader, data.important_levels_data.feat_levels);
+}
+
+void serialize(SnapshotWriter& writer, const Subclass::Data& data) {
+    serialize_validation_data(writer, data);
+    serialize(writer, data.short_name);
+    serialize(writer, data.class_name);
+    serialize(writer, data.spellcasting_data);
+    serialize(writer, data.features_data);
+    serialize(writer, data.class_key);
+}
+
+void deserialize(SnapshotReader& reader, Subclass::Data& data) {
+    deserialize_validation_data(reader, data);
+    deserialize(reader, data.short_name);
+    deserialize(reader, data.class_name);
+    deserialize(reader, data.spellcasting_data);
+    deserialize(reader, data.features_data);
+    deserialize(reader, data.class_key);
+}
+
+void serialize(SnapshotWriter& writer, const Species::Data& data) {
+    serialize_validation_data(writer, data);
+    serialize(writer, data.features_data);
+}
+
+void deserialize(SnapshotReader& reader, Species::Data& data) {
+    deserialize_validation_data(reader, data);
+    deserialize(reader, data.features_data);
+}
+
+void serialize(SnapshotWriter& writer, const Subspecies::Data& data) {
+    serialize_validation_data(writer, data);
+    serialize(writer, data.features_data);
+    serialize(writer, data.species_key);
+}
+
+void deserialize(SnapshotReader& reader, Subspecies::Data& data) {
+    deserialize_validation_data(reader, data);
+    deserialize(reader, data.features_data);
+    deserialize(reader, data.species_key);
+}
+
+void serialize(SnapshotWriter& writer, const Decision::Data& data) {
+    serialize(writer, data.feature_name);
+    serialize(writer, data.selections);
+}
+
+void deserialize(SnapshotReader& reader, std::vector<Decision::Data>& data) {
+    uint64_t size = 0;
+    deserialize(reader, size);
+    data.clear();
+    for (uint64_t i = 0; i < size && reader.ok(); ++i) {
+        // the targets are pointers into the content and are resolved when the character is created
+        Decision::Data& decision_data = data.emplace_back(nullptr);
+        deserialize(reader, decision_data.feature_name);
+        deserialize(reader, decision_data.selections);
+    }
+}
+
+void serialize(SnapshotWriter& writer, const Character::Data& data) {
+    serialize_validation_data(writer, data);
+    serialize(writer, data.features_data);
+    serialize(writer, data.choosable_keys);
+
+    const AbilityScores::Data& ability_scores = data.base_ability_scores_data;
+    serialize(writer, ability_scores.strength);
+    serialize(writer, ability_scores.dexterity);
+    serialize(writer, ability_scores.constitution);
+    serialize(writer, ability_scores.intelligence);
+    serialize(writer, ability_scores.wisdom);
+    serialize(writer, ability_scores.charisma);
+
+    const FeatureProviders::Data& feature_providers = data.feature_providers_data;
+    serialize(writer, feature_providers.species_key);
+    serialize(writer, feature_providers.subspecies_key);
+    serialize(writer, feature_providers.class_key);
+    serialize(writer, feature_providers.subclass_key);
+
+    serialize(writer, data.progression_data.level);
+    serialize(writer, data.progression_data.xp);
+    serialize(writer, data.progression_data.hit_dice_rolls);
+
+    serialize(writer, data.decisions_data);
+}
+
+void deserialize(SnapshotReader& reader, Character::Data& data) {
+    deserialize_validation_data(reader, data);
+    deserialize(reader, data.features_data);
+    deserialize(reader, data.choosable_keys);
+
+    AbilityScores::Data& ability_scores = data.base_ability_scores_data;
+    deserialize(reader, ability_scores.strength);
+    deserialize(reader, ability_scores.dexterity);
+    deserialize(reader, ability_scores.constitution);
+    deserialize(reader, ability_scores.intelligence);
+    deserialize(reader, ability_scores.wisdom);
+    deserialize(reader, ability_scores.charisma);
+
+    FeatureProviders::Data& feature_providers = data.feature_providers_data;
+    deserialize(reader, feature_providers.species_key);
+    deserialize(reader, feature_providers.subspecies_key);
+    deserialize(reader, feature_providers.class_key);
+    deserialize(reader, feature_providers.subclass_key);
+
+    deserialize(reader, data.progression_data.level);
+    deserialize(reader, data.progression_data.xp);
+    deserialize(reader, data.progression_data.hit_dice_rolls);
+
+    deserialize(reader, data.decisions_data);
+}
+
+void serialize(SnapshotWriter& writer, const Spell::Data& data) {
+    serialize_validation_data(writer, data);
+    serialize(writer, data.components_data.verbal);
+    serialize(writer, data.components_data.somatic);
+    serialize(writer, data.components_data.material_components);
+    serialize(writer, data.type_data.level);
+    serialize(writer, data.type_data.magic_school_char);
+    serialize(writer, data.type_data.ritual);
+    serialize(writer, data.concentration);
+    serialize(writer, data.casting_time);
+    serialize(writer, data.range);
+    serialize(writer, data.duration);
+    serialize(writer, data.classes);
+}
+
+void deserialize(SnapshotReader& reader, Spell::Data& data) {
+    deserialize_validation_data(reader, data);
+    deserialize(reader, data.components_data.verbal);
+    deserialize(reader, data.components_data.somatic);
+    deserialize(reader, data.components_data.material_components);
+    deserialize(reader, data.type_data.level);
+    deserialize(reader, data.type_data.magic_school_char);
+    deserialize(reader, data.type_data.ritual);
+    deserialize(reader, data.concentration);
+    deserialize(reader, data.casting_time);
+    deserialize(reader, data.range);
+    deserialize(reader, data.duration);
+    deserialize(reader, data.classes);
+}
+
+void serialize(SnapshotWriter& writer, const Item::Data& data) {
+    serialize_validation_data(writer, data);
+    serialize(writer, data.cosmetic_description);
+    serialize(writer, data.requires_attunement);
+}
+
+void deserialize(SnapshotReader& reader, Item::Data& data) {
+    deserialize_validation_data(reader, data);
+    deserialize(reader, data.cosmetic_description);
+    deserialize(reader, data.requires_attunement);
+}
+
+} // namespace dnd
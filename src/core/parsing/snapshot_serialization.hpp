@@ -0,0 +1,387 @@
+#ifndef SNAPSHOT_SERIALIZATION_HPP_
+#define SNAPSHOT_SERIALIZATION_HPP_
+
+#include <dnd_config.hpp>
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <core/errors/errors.hpp>
+#include <core/errors/parsing_error.hpp>
+#include <core/errors/runtime_error.hpp>
+#include <core/errors/validation_error.hpp>
+#include <core/models/character/character.hpp>
+#include <core/models/class/class.hpp>
+#include <core/models/effects_provider/choosable.hpp>
+#include <core/models/item/item.hpp>
+#include <core/models/species/species.hpp>
+#include <core/models/spell/spell.hpp>
+#include <core/models/subclass/subclass.hpp>
+#include <core/models/subspecies/subspecies.hpp>
+#include <core/text/formatted_text.hpp>
+#include <core/text/text_source.hpp>
+
+namespace dnd {
+
+/**
+ * @brief Writes values into a binary buffer in the native byte order.
+ * Snapshots are caches that are only read on the machine that wrote them, so the format is not portable.
+ */
+class SnapshotWriter {
+public:
+    void write_bytes(const void* data, size_t size);
+    const std::string& get_buffer() const;
+    std::string take_buffer();
+private:
+    std::string buffer;
+};
+
+/**
+ * @brief Reads values from a binary buffer written by a SnapshotWriter
+ */
+class SnapshotReader {
+public:
+    explicit SnapshotReader(std::string_view buffer);
+    /**
+     * @brief Reads the given amount of bytes, fails if the buffer does not contain enough bytes
+     * @return true if the bytes were read, false otherwise
+     */
+    bool read_bytes(void* data, size_t size);
+    /**
+     * @brief Returns whether all reads so far were successful
+     * @return true if no read has failed, false otherwise
+     */
+    bool ok() const;
+    bool at_end() const;
+    /**
+     * @brief Returns the amount of bytes that were not read yet, which bounds every size read from the buffer
+     * @return the amount of remaining bytes
+     */
+    size_t get_remaining_size() const;
+    /**
+     * @brief Marks the reader as failed, which is used when the read data is inconsistent
+     */
+    void fail();
+private:
+    std::string_view buffer;
+    size_t position;
+    bool failed;
+};
+
+template <typename T>
+concept isTriviallySerializable = std::is_arithmetic_v<T> || std::is_enum_v<T>;
+
+/**
+ * @brief The last value of an enum that is stored in snapshots, every such enum needs a specialization,
+ * because a value read from a corrupted snapshot must be rejected before it is converted to the enum
+ */
+template <typename T>
+requires std::is_enum_v<T>
+struct SnapshotEnumRange;
+
+template <>
+struct SnapshotEnumRange<ParsingError::Code> {
+    static constexpr ParsingError::Code last = ParsingError::Code::UNKNOWN_ERROR;
+};
+template <>
+struct SnapshotEnumRange<ValidationError::Code> {
+    static constexpr ValidationError::Code last = ValidationError::Code::UNKNOWN_ERROR;
+};
+template <>
+struct SnapshotEnumRange<RuntimeError::Code> {
+    static constexpr RuntimeError::Code last = RuntimeError::Code::UNKNOWN_ERROR;
+};
+template <>
+struct SnapshotEnumRange<FormattedTextNodeType> {
+    static constexpr FormattedTextNodeType last = FormattedTextNodeType::LINK;
+};
+template <>
+struct SnapshotEnumRange<TextSource::Format> {
+    static constexpr TextSource::Format last = TextSource::Format::SPELL_ENTRIES;
+};
+
+template <typename T>
+requires isTriviallySerializable<T>
+void serialize(SnapshotWriter& writer, T value);
+/**
+ * @brief Reads a number, a bool, or an enum value, fails if a bool or an enum value is out of its range
+ */
+template <typename T>
+requires isTriviallySerializable<T>
+void deserialize(SnapshotReader& reader, T& value);
+
+void serialize(SnapshotWriter& writer, const std::string& str);
+void deserialize(SnapshotReader& reader, std::string& str);
+void serialize(SnapshotWriter& writer, const std::filesystem::path& path);
+void deserialize(SnapshotReader& reader, std::filesystem::path& path);
+
+template <typename T>
+void serialize(SnapshotWriter& writer, const std::optional<T>& opt);
+template <typename T>
+void deserialize(SnapshotReader& reader, std::optional<T>& opt);
+template <typename T, size_t N>
+void serialize(SnapshotWriter& writer, const std::array<T, N>& arr);
+template <typename T, size_t N>
+void deserialize(SnapshotReader& reader, std::array<T, N>& arr);
+template <typename T>
+void serialize(SnapshotWriter& writer, const std::vector<T>& vec);
+template <typename T>
+void deserialize(SnapshotReader& reader, std::vector<T>& vec);
+template <typename T>
+void serialize(SnapshotWriter& writer, const std::set<T>& set);
+template <typename T>
+void deserialize(SnapshotReader& reader, std::set<T>& set);
+template <typename K, typename V>
+void serialize(SnapshotWriter& writer, const std::map<K, V>& map);
+template <typename K, typename V>
+void deserialize(SnapshotReader& reader, std::map<K, V>& map);
+template <typename K, typename V>
+void serialize(SnapshotWriter& writer, const std::unordered_map<K, V>& map);
+template <typename K, typename V>
+void deserialize(SnapshotReader& reader, std::unordered_map<K, V>& map);
+template <typename... T>
+void serialize(SnapshotWriter& writer, const std::variant<T...>& var);
+template <typename... T>
+void deserialize(SnapshotReader& reader, std::variant<T...>& var);
+
+void serialize(SnapshotWriter& writer, const Errors& errors);
+void deserialize(SnapshotReader& reader, Errors& errors);
+
+void serialize(SnapshotWriter& writer, const FormattedText& text);
+void deserialize(SnapshotReader& reader, FormattedText& text);
+void serialize(SnapshotWriter& writer, const TextSource& text_source);
+void deserialize(SnapshotReader& reader, TextSource& text_source);
+
+void serialize(SnapshotWriter& writer, const Condition::Data& data);
+void deserialize(SnapshotReader& reader, Condition::Data& data);
+void serialize(SnapshotWriter& writer, const Choice::Data& data);
+void deserialize(SnapshotReader& reader, Choice::Data& data);
+void serialize(SnapshotWriter& writer, const StatChange::Data& data);
+void deserialize(SnapshotReader& reader, StatChange::Data& data);
+void serialize(SnapshotWriter& writer, const Effects::Data& data);
+void deserialize(SnapshotReader& reader, Effects::Data& data);
+void serialize(SnapshotWriter& writer, const Feature::Data& data);
+void deserialize(SnapshotReader& reader, Feature::Data& data);
+void serialize(SnapshotWriter& writer, const ClassFeature::Data& data);
+void deserialize(SnapshotReader& reader, ClassFeature::Data& data);
+void serialize(SnapshotWriter& writer, const SubclassFeature::Data& data);
+void deserialize(SnapshotReader& reader, SubclassFeature::Data& data);
+void serialize(SnapshotWriter& writer, const Choosable::Data& data);
+void deserialize(SnapshotReader& reader, Choosable::Data& data);
+void serialize(SnapshotWriter& writer, const Spellcasting::Data& data);
+void deserialize(SnapshotReader& reader, Spellcasting::Data& data);
+void serialize(SnapshotWriter& writer, const Class::Data& data);
+void deserialize(SnapshotReader& reader, Class::Data& data);
+void serialize(SnapshotWriter& writer, const Subclass::Data& data);
+void deserialize(SnapshotReader& reader, Subclass::Data& data);
+void serialize(SnapshotWriter& writer, const Species::Data& data);
+void deserialize(SnapshotReader& reader, Species::Data& data);
+void serialize(SnapshotWriter& writer, const Subspecies::Data& data);
+void deserialize(SnapshotReader& reader, Subspecies::Data& data);
+void serialize(SnapshotWriter& writer, const Decision::Data& data);
+void deserialize(SnapshotReader& reader, std::vector<Decision::Data>& data);
+void serialize(SnapshotWriter& writer, const Character::Data& data);
+void deserialize(SnapshotReader& reader, Character::Data& data);
+void serialize(SnapshotWriter& writer, const Spell::Data& data);
+void deserialize(SnapshotReader& reader, Spell::Data& data);
+void serialize(SnapshotWriter& writer, const Item::Data& data);
+void deserialize(SnapshotReader& reader, Item::Data& data);
+
+
+// === IMPLEMENTATION ===
+
+template <typename T>
+requires isTriviallySerializable<T>
+inline void serialize(SnapshotWriter& writer, T value) {
+    writer.write_bytes(&value, sizeof(T));
+}
+
+template <typename T>
+requires isTriviallySerializable<T>
+inline void deserialize(SnapshotReader& reader, T& value) {
+    if constexpr (std::is_same_v<T, bool>) {
+        // any byte other than 0 and 1 is not a valid bool, so it has to be checked before the conversion
+        uint8_t byte = 0;
+        static_assert(sizeof(bool) == sizeof(uint8_t));
+        if (reader.read_bytes(&byte, sizeof(uint8_t))) {
+            if (byte > 1) {
+                reader.fail();
+                return;
+            }
+            value = byte == 1;
+        }
+    } else if constexpr (std::is_enum_v<T>) {
+        using Underlying = std::underlying_type_t<T>;
+        Underlying underlying{};
+        if (reader.read_bytes(&underlying, sizeof(Underlying))) {
+            bool in_range = underlying <= static_cast<Underlying>(SnapshotEnumRange<T>::last);
+            if constexpr (std::is_signed_v<Underlying>) {
+                in_range = in_range && underlying >= 0;
+            }
+            if (!in_range) {
+                reader.fail();
+                return;
+            }
+            value = static_cast<T>(underlying);
+        }
+    } else {
+        reader.read_bytes(&value, sizeof(T));
+    }
+}
+
+template <typename T>
+inline void serialize(SnapshotWriter& writer, const std::optional<T>& opt) {
+    serialize(writer, opt.has_value());
+    if (opt.has_value()) {
+        serialize(writer, opt.value());
+    }
+}
+
+template <typename T>
+inline void deserialize(SnapshotReader& reader, std::optional<T>& opt) {
+    bool has_value = false;
+    deserialize(reader, has_value);
+    if (has_value) {
+        deserialize(reader, opt.emplace());
+    } else {
+        opt.reset();
+    }
+}
+
+template <typename T, size_t N>
+inline void serialize(SnapshotWriter& writer, const std::array<T, N>& arr) {
+    for (const T& value : arr) {
+        serialize(writer, value);
+    }
+}
+
+template <typename T, size_t N>
+inline void deserialize(SnapshotReader& reader, std::array<T, N>& arr) {
+    for (T& value : arr) {
+        deserialize(reader, value);
+    }
+}
+
+template <typename T>
+inline void serialize(SnapshotWriter& writer, const std::vector<T>& vec) {
+    serialize<uint64_t>(writer, vec.size());
+    for (const T& value : vec) {
+        serialize(writer, value);
+    }
+}
+
+template <typename T>
+inline void deserialize(SnapshotReader& reader, std::vector<T>& vec) {
+    uint64_t size = 0;
+    deserialize(reader, size);
+    vec.clear();
+    for (uint64_t i = 0; i < size && reader.ok(); ++i) {
+        deserialize(reader, vec.emplace_back());
+    }
+}
+
+template <typename T>
+inline void serialize(SnapshotWriter& writer, const std::set<T>& set) {
+    serialize<uint64_t>(writer, set.size());
+    for (const T& value : set) {
+        serialize(writer, value);
+    }
+}
+
+template <typename T>
+inline void deserialize(SnapshotReader& reader, std::set<T>& set) {
+    uint64_t size = 0;
+    deserialize(reader, size);
+    set.clear();
+    for (uint64_t i = 0; i < size && reader.ok(); ++i) {
+        T value{};
+        deserialize(reader, value);
+        set.insert(set.end(), std::move(value));
+    }
+}
+
+template <typename K, typename V>
+inline void serialize(SnapshotWriter& writer, const std::map<K, V>& map) {
+    serialize<uint64_t>(writer, map.size());
+    for (const auto& [key, value] : map) {
+        serialize(writer, key);
+        serialize(writer, value);
+    }
+}
+
+template <typename K, typename V>
+inline void deserialize(SnapshotReader& reader, std::map<K, V>& map) {
+    uint64_t size = 0;
+    deserialize(reader, size);
+    map.clear();
+    for (uint64_t i = 0; i < size && reader.ok(); ++i) {
+        K key{};
+        deserialize(reader, key);
+        deserialize(reader, map[std::move(key)]);
+    }
+}
+
+template <typename K, typename V>
+inline void serialize(SnapshotWriter& writer, const std::unordered_map<K, V>& map) {
+    serialize<uint64_t>(writer, map.size());
+    for (const auto& [key, value] : map) {
+        serialize(writer, key);
+        serialize(writer, value);
+    }
+}
+
+template <typename K, typename V>
+inline void deserialize(SnapshotReader& reader, std::unordered_map<K, V>& map) {
+    uint64_t size = 0;
+    deserialize(reader, size);
+    map.clear();
+    // the size is not reserved, because it is only known to be valid once all elements were read
+    for (uint64_t i = 0; i < size && reader.ok(); ++i) {
+        K key{};
+        deserialize(reader, key);
+        deserialize(reader, map[std::move(key)]);
+    }
+}
+
+template <typename... T>
+inline void serialize(SnapshotWriter& writer, const std::variant<T...>& var) {
+    serialize<uint64_t>(writer, var.index());
+    std::visit([&writer](const auto& value) { serialize(writer, value); }, var);
+}
+
+template <typename V, size_t I = 0>
+inline void deserialize_variant_alternative(SnapshotReader& reader, V& var, uint64_t index) {
+    if constexpr (I < std::variant_size_v<V>) {
+        if (index == I) {
+            deserialize(reader, var.template emplace<I>());
+        } else {
+            deserialize_variant_alternative<V, I + 1>(reader, var, index);
+        }
+    } else {
+        DND_UNUSED(var);
+        DND_UNUSED(index);
+        reader.fail(); // the index is out of range, which means that the snapshot is corrupted
+    }
+}
+
+template <typename... T>
+inline void deserialize(SnapshotReader& reader, std::variant<T...>& var) {
+    uint64_t index = 0;
+    deserialize(reader, index);
+    deserialize_variant_alternative(reader, var, index);
+}
+
+} // namespace dnd
+
+#endif // SNAPSHOT_SERIALIZATION_HPP_
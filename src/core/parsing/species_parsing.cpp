@@ -10,7 +10,7 @@
 #include <core/models/species/species.hpp>
 #include <core/models/subspecies/subspecies.hpp>
 #include <core/parsing/parser.hpp>
-#include <core/text/text.hpp>
+#include <core/text/formatted_text.hpp>
 
 namespace dnd {
 
@@ -25,7 +25,7 @@ WithErrors<Species::Data> parse_species(const nlohmann::ordered_json& obj, const
     if (obj.contains("entries")) {
         errors += write_formatted_text_into(obj, species_data.description, filepath);
     } else {
-        species_data.description = Text::simple("<empty description>");
+        species_data.description = FormattedText::simple("<empty description>");
     }
 
     return result;
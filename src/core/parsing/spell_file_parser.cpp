@@ -3,7 +3,10 @@
 #include "spell_file_parser.hpp"
 
 #include <filesystem>
-#include <unordered_map>
+#include <map>
+#include <optional>
+#include <string>
+#include <utility>
 
 #include <fmt/format.h>
 #include <fmt/ranges.h>
@@ -13,71 +16,73 @@
 #include <core/errors/errors.hpp>
 #include <core/models/spell/spell.hpp>
 #include <core/parsing/file_parser.hpp>
+#include <core/parsing/lazy_text_parsing.hpp>
+#include <core/parsing/snapshot_serialization.hpp>
 #include <core/parsing/spell_parsing.hpp>
 #include <core/parsing/spell_sources_file_parser.hpp>
+#include <core/parsing/streaming_file_parser.hpp>
 #include <core/parsing/v2_file_parser.hpp>
+#include <core/text/text_source.hpp>
 #include <log.hpp>
 
 namespace dnd {
 
-SpellFileParser::SpellFileParser(const std::filesystem::path& filepath, const SpellSources& spell_sources)
-    : FileParser(filepath, true), spell_sources(spell_sources) {}
+SpellFileParser::SpellFileParser(
+    const std::filesystem::path& filepath, const SpellSources& spell_sources, DescriptionParsing description_parsing
+)
+    : StreamingFileParser(filepath, description_parsing), spell_sources(spell_sources) {}
 
-Errors SpellFileParser::parse() {
-    Errors errors;
-    if (!json.is_object()) {
-        errors.add_parsing_error(
-            ParsingError::Code::INVALID_FILE_FORMAT, get_filepath(), "The v2 json is not an object."
-        );
+bool SpellFileParser::is_supported_category(const std::string& category) const {
+    std::optional<ParseType> parse_type = find_parse_type(category);
+    if (!parse_type.has_value()) {
+        LOGWARN("Found unknown category '{}' in {}", category, get_filepath().c_str());
+        return false;
     }
+    return parse_type.value() == ParseType::spell_type;
+}
+
+Errors SpellFileParser::parse_element(const std::string& category, const nlohmann::ordered_json& element) {
+    DND_UNUSED(category);
+    Errors errors;
+    std::string name;
+    parse_required_attribute_into(element, "name", name, get_filepath());
 
-    for (nlohmann::ordered_json::const_iterator it = json.cbegin(); it != json.cend(); ++it) {
-        const std::string& category = it.key();
-        const nlohmann::ordered_json& entry = it.value();
-        if (!entry.is_array()) {
-            continue;
-        }
-
-        size_t type_index = std::find(parse_types.begin(), parse_types.end(), category) - parse_types.begin();
-        if (type_index >= parse_types.size()) {
-            LOGWARN("Found unknown category '{}' in {}", category, get_filepath().c_str());
-            continue;
-        }
-        ParseType parse_type = static_cast<ParseType>(type_index);
-
-        if (parse_type != ParseType::spell_type) {
-            continue;
-        }
-
-        for (const nlohmann::ordered_json& element : entry) {
-            if (!element.is_object()) {
-                errors.add_parsing_error(
-                    ParsingError::Code::INVALID_FILE_FORMAT, get_filepath(),
-                    fmt::format("Element within the '{}'-entry is not an object.", category)
-                );
-                continue;
-            }
-            std::string name;
-            parse_required_attribute_into(element, "name", name, get_filepath());
-
-            Spell::Data spell_data;
-            parse_spell(element, get_filepath()).move_into(spell_data, errors);
-
-            if (spell_sources.contains(spell_data.source_name)
-                && spell_sources.at(spell_data.source_name).contains(spell_data.name)) {
-                spell_data.classes = spell_sources.at(spell_data.source_name).at(spell_data.name);
-            }
-
-            parsed_data.insert({spell_data.get_key(), spell_data});
-        }
+    Spell::Data spell_data;
+    parse_spell(element, get_filepath(), get_description_source(TextSource::Format::SPELL_ENTRIES))
+        .move_into(spell_data, errors);
+
+    if (spell_sources.contains(spell_data.source_name)
+        && spell_sources.at(spell_data.source_name).contains(spell_data.name)) {
+        spell_data.classes = spell_sources.at(spell_data.source_name).at(spell_data.name);
     }
+
+    parsed_data.insert({spell_data.get_key(), spell_data});
     return errors;
 }
 
+bool SpellFileParser::is_deferred_description(const std::string& category, const std::string& attribute) const {
+    DND_UNUSED(category);
+    return attribute == "entries" || attribute == "entriesHigherLevel";
+}
+
+void SpellFileParser::clear_parsed_data() { parsed_data.clear(); }
+
 void SpellFileParser::save_result(Content& content) {
     for (auto& [key, data] : parsed_data) {
         content.add_spell_result(Spell::create(std::move(data)));
     }
 }
 
+void SpellFileParser::write_snapshot(SnapshotWriter& writer) const { serialize(writer, parsed_data); }
+
+bool SpellFileParser::read_snapshot(SnapshotReader& reader) {
+    std::map<std::string, Spell::Data> snapshot_data;
+    deserialize(reader, snapshot_data);
+    if (!reader.ok() || !reader.at_end()) {
+        return false;
+    }
+    parsed_data = std::move(snapshot_data);
+    return true;
+}
+
 } // namespace dnd
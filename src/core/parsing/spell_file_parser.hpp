@@ -4,25 +4,40 @@
 #include <dnd_config.hpp>
 
 #include <filesystem>
-#include <unordered_map>
+#include <map>
+#include <string>
+
+#include <nlohmann/json.hpp>
 
 #include <core/errors/errors.hpp>
 #include <core/models/spell/spell.hpp>
 #include <core/parsing/file_parser.hpp>
+#include <core/parsing/lazy_text_parsing.hpp>
 #include <core/parsing/spell_sources_file_parser.hpp>
+#include <core/parsing/streaming_file_parser.hpp>
 
 namespace dnd {
 
 class Content;
 
-class SpellFileParser : public FileParser {
+class SpellFileParser : public StreamingFileParser {
 public:
-    explicit SpellFileParser(const std::filesystem::path& filepath, const SpellSources& spell_sources);
-    virtual Errors parse();
+    explicit SpellFileParser(
+        const std::filesystem::path& filepath, const SpellSources& spell_sources,
+        DescriptionParsing description_parsing = DescriptionParsing::EAGER
+    );
     virtual void save_result(Content& content);
+    virtual void write_snapshot(SnapshotWriter& writer) const;
+    virtual bool read_snapshot(SnapshotReader& reader);
+protected:
+    virtual bool is_supported_category(const std::string& category) const override;
+    virtual Errors parse_element(const std::string& category, const nlohmann::ordered_json& element) override;
+    virtual bool is_deferred_description(const std::string& category, const std::string& attribute) const override;
+    virtual void clear_parsed_data() override;
 private:
     const SpellSources& spell_sources;
-    std::unordered_map<std::string, Spell::Data> parsed_data;
+    // ordered, so that the spells are saved in the same order whether they were parsed or restored from a snapshot
+    std::map<std::string, Spell::Data> parsed_data;
 };
 
 
@@ -2,7 +2,9 @@
 
 #include "spell_parsing.hpp"
 
+#include <cstdint>
 #include <filesystem>
+#include <optional>
 #include <string>
 
 #include <fmt/format.h>
@@ -13,7 +15,11 @@
 #include <core/models/spell/spell.hpp>
 #include <core/models/spell/spell_components.hpp>
 #include <core/models/spell/spell_type.hpp>
+#include <core/parsing/lazy_text_parsing.hpp>
 #include <core/parsing/parser.hpp>
+#include <core/text/formatted_text.hpp>
+#include <core/text/formatted_text_writer.hpp>
+#include <core/text/text_source.hpp>
 #include <core/types.hpp>
 
 namespace dnd {
@@ -245,7 +251,7 @@ static WithErrors<SpellType::Data> parse_spell_type(
 }
 
 static Errors parse_higher_level_text_into(
-    const nlohmann::ordered_json& obj, Text& out, const std::filesystem::path& filepath
+    const nlohmann::ordered_json& obj, FormattedText& out, const std::filesystem::path& filepath
 ) {
     Errors errors;
 
@@ -278,17 +284,16 @@ static Errors parse_higher_level_text_into(
     if (name.empty()) {
         name = "At Higher Levels";
     }
-    Paragraph first_paragraph;
-    first_paragraph.parts.push_back(SimpleText{.str = name + ". ", .bold = true, .italic = false});
+    FormattedTextWriter writer(out);
+    uint32_t first_paragraph_index = writer.begin_node(FormattedTextNodeType::PARAGRAPH);
+    writer.add_simple_text(name, true, false, ". ");
 
     errors += check_required_attribute(higher_level_entries.get(), "entries", filepath, JsonType::ARRAY);
     const nlohmann::ordered_json& entries = higher_level_entries.get()["entries"];
     std::string entry;
     errors += parse_required_index_into(entries, 0, entry, filepath);
-    errors += parse_paragraph(std::move(entry), first_paragraph, filepath);
-
-    TextObject paragraph = std::move(first_paragraph);
-    out.parts.push_back(paragraph);
+    errors += parse_paragraph(entry, writer, filepath);
+    writer.end_node(first_paragraph_index);
 
     if (entries.size() > 1) {
         errors += write_formatted_text_into(higher_level_entries.get(), out, filepath, true);
@@ -298,7 +303,19 @@ static Errors parse_higher_level_text_into(
 }
 
 
-WithErrors<Spell::Data> parse_spell(const nlohmann::ordered_json& obj, const std::filesystem::path& filepath) {
+Errors parse_spell_description_into(
+    const nlohmann::ordered_json& obj, FormattedText& description, const std::filesystem::path& filepath
+) {
+    Errors errors;
+    errors += write_formatted_text_into(obj, description, filepath);
+    errors += parse_higher_level_text_into(obj, description, filepath);
+    return errors;
+}
+
+WithErrors<Spell::Data> parse_spell(
+    const nlohmann::ordered_json& obj, const std::filesystem::path& filepath,
+    const std::optional<TextSource>& description_source
+) {
     WithErrors<Spell::Data> result;
     Spell::Data& spell_data = result.value;
     Errors& errors = result.errors;
@@ -306,8 +323,11 @@ WithErrors<Spell::Data> parse_spell(const nlohmann::ordered_json& obj, const std
     spell_data.source_path = filepath;
     errors += parse_required_attribute_into(obj, "name", spell_data.name, filepath);
     errors += parse_required_attribute_into(obj, "source", spell_data.source_name, filepath);
-    errors += write_formatted_text_into(obj, spell_data.description, filepath);
-    errors += parse_higher_level_text_into(obj, spell_data.description, filepath);
+    if (description_source.has_value()) {
+        errors += defer_description_parsing(obj, filepath, description_source.value(), spell_data);
+    } else {
+        errors += parse_spell_description_into(obj, spell_data.description, filepath);
+    }
 
     parse_spell_components(obj, filepath).move_into(spell_data.components_data, errors);
     parse_spell_type(obj, filepath).move_into(spell_data.type_data, errors);
@@ -4,15 +4,35 @@
 #include <dnd_config.hpp>
 
 #include <filesystem>
+#include <optional>
 
 #include <nlohmann/json.hpp>
 
 #include <core/errors/errors.hpp>
 #include <core/models/spell/spell.hpp>
+#include <core/text/formatted_text.hpp>
+#include <core/text/text_source.hpp>
 
 namespace dnd {
 
-WithErrors<Spell::Data> parse_spell(const nlohmann::ordered_json& obj, const std::filesystem::path& filepath);
+/**
+ * @brief Parses the description of a spell i.e. its entries and the text for casting it at higher levels
+ */
+Errors parse_spell_description_into(
+    const nlohmann::ordered_json& obj, FormattedText& description, const std::filesystem::path& filepath
+);
+
+/**
+ * @brief Parses a spell
+ * @param obj the JSON object of the spell
+ * @param filepath the file the spell is parsed from
+ * @param description_source if given, the description is not parsed but parsed from this source when first accessed
+ * @return the data of the spell and the errors that occurred while parsing
+ */
+WithErrors<Spell::Data> parse_spell(
+    const nlohmann::ordered_json& obj, const std::filesystem::path& filepath,
+    const std::optional<TextSource>& description_source = std::nullopt
+);
 
 }
 
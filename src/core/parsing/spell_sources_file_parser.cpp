@@ -3,10 +3,12 @@
 #include "spell_sources_file_parser.hpp"
 
 #include <filesystem>
+#include <utility>
 
 #include <core/errors/errors.hpp>
 #include <core/models/class/class.hpp>
 #include <core/parsing/file_parser.hpp>
+#include <core/parsing/snapshot_serialization.hpp>
 
 namespace dnd {
 
@@ -50,5 +52,19 @@ Errors SpellSourcesFileParser::parse() {
 
 void SpellSourcesFileParser::save_result(Content& content) { DND_UNUSED(content); }
 
+void SpellSourcesFileParser::write_snapshot(SnapshotWriter& writer) const {
+    serialize(writer, spell_classes_by_source);
+}
+
+bool SpellSourcesFileParser::read_snapshot(SnapshotReader& reader) {
+    SpellSources snapshot_data;
+    deserialize(reader, snapshot_data);
+    if (!reader.ok() || !reader.at_end()) {
+        return false;
+    }
+    spell_classes_by_source = std::move(snapshot_data);
+    return true;
+}
+
 
 } // namespace dnd
@@ -18,6 +18,8 @@ public:
     explicit SpellSourcesFileParser(const std::filesystem::path& filepath);
     virtual Errors parse() override;
     virtual void save_result(Content& content) override;
+    virtual void write_snapshot(SnapshotWriter& writer) const override;
+    virtual bool read_snapshot(SnapshotReader& reader) override;
 
     SpellSources spell_classes_by_source;
 };
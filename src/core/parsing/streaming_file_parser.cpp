@@ -0,0 +1,470 @@
+#include <dnd_config.hpp>
+
+#include "streaming_file_parser.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <istream>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+
+#include <core/errors/errors.hpp>
+#include <core/errors/parsing_error.hpp>
+#include <core/parsing/file_parser.hpp>
+#include <core/parsing/lazy_text_parsing.hpp>
+#include <core/text/text_source.hpp>
+#include <core/utils/string_hash.hpp>
+
+namespace dnd {
+
+namespace {
+
+// a byte range within the file and the content hash of its bytes
+struct ByteRange {
+    uint64_t offset;
+    uint64_t length;
+    uint64_t content_hash;
+};
+
+/**
+ * @brief Reads a file in chunks, so that only one chunk of the file is in memory while it is streamed, and locates
+ * byte ranges within the file while reading it.
+ * The SAX interface does not provide the positions of the values, but the parser reads the input one character at a
+ * time, so the read position right after a bracket was reported is the position after that bracket.
+ */
+class ChunkedFileReader {
+public:
+    static constexpr size_t chunk_size = 64 * 1024;
+
+    ChunkedFileReader(std::istream& stream, bool hash_ranges)
+        : stream(stream), chunk(chunk_size), hash_ranges(hash_ranges) {}
+
+    /**
+     * @return true if the whole file was read, false otherwise
+     */
+    bool at_end() {
+        // the next chunk is only read when its first character is needed, so the last character read is always
+        // within the current chunk
+        if (index == chunk_length) {
+            read_chunk();
+        }
+        return index == chunk_length;
+    }
+    char current() const { return chunk[index]; }
+    void advance() noexcept { ++index; }
+    /**
+     * @return the number of characters read so far
+     */
+    uint64_t get_read_position() const noexcept { return chunk_offset + index; }
+    /**
+     * @brief Starts a byte range at the last character read
+     */
+    void begin_range() {
+        assert(index > 0);
+        range_offset = get_read_position() - 1;
+        range_begin = index - 1;
+        range_hash = fnv1a_hash({});
+    }
+    /**
+     * @brief Ends the byte range after the last character read
+     * @return the range from the last call to begin_range, with its content hash if ranges are hashed and 0 otherwise
+     */
+    ByteRange end_range() {
+        hash_range_in_chunk();
+        return ByteRange{
+            .offset = range_offset,
+            .length = get_read_position() - range_offset,
+            .content_hash = hash_ranges ? range_hash : 0,
+        };
+    }
+    uint64_t get_bytes_read() const noexcept { return chunk_offset + chunk_length; }
+private:
+    void read_chunk() {
+        hash_range_in_chunk();
+        range_begin = 0;
+        chunk_offset += chunk_length;
+        stream.read(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+        chunk_length = static_cast<size_t>(stream.gcount());
+        index = 0;
+    }
+    void hash_range_in_chunk() {
+        if (hash_ranges && range_begin < index) {
+            range_hash = fnv1a_hash(std::string_view(chunk.data() + range_begin, index - range_begin), range_hash);
+        }
+    }
+
+    std::istream& stream;
+    std::vector<char> chunk;
+    bool hash_ranges;
+    // the number of characters in the chunk, which is smaller than the chunk size at the end of the file
+    size_t chunk_length = 0;
+    // the position of the chunk within the file
+    uint64_t chunk_offset = 0;
+    // the position of the next character within the chunk
+    size_t index = 0;
+    uint64_t range_offset = 0;
+    // where the part of the current range within the chunk begins
+    size_t range_begin = 0;
+    uint64_t range_hash = 0;
+};
+
+/**
+ * @brief An input iterator over the characters of a ChunkedFileReader, the end iterator has no reader
+ */
+class ChunkedFileIterator {
+public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = char;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const char*;
+    using reference = char;
+
+    explicit ChunkedFileIterator(ChunkedFileReader* reader = nullptr) noexcept : reader(reader) {}
+
+    reference operator*() const { return reader->current(); }
+    ChunkedFileIterator& operator++() {
+        reader->advance();
+        return *this;
+    }
+    ChunkedFileIterator operator++(int) {
+        ChunkedFileIterator previous = *this;
+        ++*this;
+        return previous;
+    }
+    bool operator==(const ChunkedFileIterator& other) const { return at_end() == other.at_end(); }
+private:
+    bool at_end() const { return reader == nullptr || reader->at_end(); }
+
+    ChunkedFileReader* reader;
+};
+
+/**
+ * @brief Builds a JSON value from SAX events
+ */
+class JsonBuilder {
+public:
+    bool building() const { return !stack.empty(); }
+    /**
+     * @return the number of containers that are currently being built, 1 within the root container
+     */
+    size_t depth() const { return stack.size(); }
+    void start_container(nlohmann::ordered_json&& container) {
+        if (stack.empty()) {
+            root = std::move(container);
+            stack.push_back(&root);
+        } else {
+            stack.push_back(add_value(std::move(container)));
+        }
+    }
+    /**
+     * @return true if the root container was ended, false otherwise
+     */
+    bool end_container() {
+        stack.pop_back();
+        return stack.empty();
+    }
+    void set_key(const std::string& key) { object_element = &(*stack.back())[key]; }
+    nlohmann::ordered_json* add_value(nlohmann::ordered_json&& value) {
+        nlohmann::ordered_json* parent = stack.back();
+        if (parent->is_array()) {
+            parent->push_back(std::move(value));
+            return &parent->back();
+        }
+        *object_element = std::move(value);
+        return object_element;
+    }
+    nlohmann::ordered_json take_root() { return std::move(root); }
+private:
+    nlohmann::ordered_json root;
+    // the containers that are currently being built, the pointers stay valid because only the innermost is modified
+    std::vector<nlohmann::ordered_json*> stack;
+    nlohmann::ordered_json* object_element = nullptr;
+};
+
+/**
+ * @brief A SAX handler for the v2 format, which only builds the elements of supported categories, without the
+ * contents of their deferred attributes
+ */
+template <typename IsSupportedCategory, typename IsDeferredAttribute, typename ParseElement>
+class CategoryElementSax {
+public:
+    using number_integer_t = nlohmann::ordered_json::number_integer_t;
+    using number_unsigned_t = nlohmann::ordered_json::number_unsigned_t;
+    using number_float_t = nlohmann::ordered_json::number_float_t;
+    using string_t = nlohmann::ordered_json::string_t;
+    using binary_t = nlohmann::ordered_json::binary_t;
+
+    CategoryElementSax(
+        const std::filesystem::path& filepath, ChunkedFileReader& reader, IsSupportedCategory is_supported_category,
+        IsDeferredAttribute is_deferred_attribute, ParseElement parse_element
+    )
+        : filepath(filepath), reader(reader), is_supported_category(is_supported_category),
+          is_deferred_attribute(is_deferred_attribute), parse_element(parse_element) {}
+
+    Errors take_errors() { return std::move(errors); }
+    const std::optional<std::string>& get_syntax_error() const { return syntax_error; }
+
+    bool null() { return handle_value(nullptr); }
+    bool boolean(bool val) { return handle_value(val); }
+    bool number_integer(number_integer_t val) { return handle_value(val); }
+    bool number_unsigned(number_unsigned_t val) { return handle_value(val); }
+    bool number_float(number_float_t val, const string_t& str) {
+        DND_UNUSED(str);
+        return handle_value(val);
+    }
+    bool string(string_t& val) { return handle_value(std::move(val)); }
+    bool binary(binary_t& val) {
+        DND_UNUSED(val);
+        return true;
+    }
+
+    bool start_object(size_t elements) {
+        DND_UNUSED(elements);
+        if (skip_depth > 0) {
+            ++skip_depth;
+        } else if (deferred_depth > 0 || deferred_attribute_pending) {
+            start_deferred_container(nlohmann::ordered_json::object());
+        } else if (element_builder.building()) {
+            element_builder.start_container(nlohmann::ordered_json::object());
+        } else if (depth == 0) {
+            depth = 1;
+        } else if (depth == 1) {
+            skip_depth = 1; // categories that are not arrays are ignored
+        } else {
+            // the opening bracket of the element was the last character read
+            reader.begin_range();
+            element_builder.start_container(nlohmann::ordered_json::object());
+        }
+        return true;
+    }
+
+    bool end_object() {
+        if (skip_depth > 0) {
+            --skip_depth;
+        } else if (deferred_depth > 0) {
+            --deferred_depth;
+        } else if (element_builder.building()) {
+            if (element_builder.end_container()) {
+                errors += parse_element(category, element_builder.take_root(), reader.end_range());
+            }
+        } else {
+            depth = 0;
+        }
+        return true;
+    }
+
+    bool start_array(size_t elements) {
+        DND_UNUSED(elements);
+        if (skip_depth > 0) {
+            ++skip_depth;
+        } else if (deferred_depth > 0 || deferred_attribute_pending) {
+            start_deferred_container(nlohmann::ordered_json::array());
+        } else if (element_builder.building()) {
+            element_builder.start_container(nlohmann::ordered_json::array());
+        } else if (depth == 0) {
+            add_not_an_object_error();
+            return false;
+        } else if (depth == 1) {
+            if (is_supported_category(category)) {
+                depth = 2;
+            } else {
+                skip_depth = 1;
+            }
+        } else {
+            add_element_not_an_object_error();
+            skip_depth = 1;
+        }
+        return true;
+    }
+
+    bool end_array() {
+        if (skip_depth > 0) {
+            --skip_depth;
+        } else if (deferred_depth > 0) {
+            --deferred_depth;
+        } else if (element_builder.building()) {
+            element_builder.end_container();
+        } else {
+            depth = 1;
+        }
+        return true;
+    }
+
+    bool key(string_t& val) {
+        if (skip_depth > 0 || deferred_depth > 0) {
+            return true;
+        }
+        if (element_builder.building()) {
+            deferred_attribute_pending = element_builder.depth() == 1 && is_deferred_attribute(category, val);
+            element_builder.set_key(val);
+        } else {
+            category = std::move(val);
+        }
+        return true;
+    }
+
+    bool parse_error(size_t position, const std::string& last_token, const nlohmann::ordered_json::exception& ex) {
+        DND_UNUSED(position);
+        DND_UNUSED(last_token);
+        syntax_error = ex.what();
+        return false;
+    }
+private:
+    template <typename T>
+    bool handle_value(T&& value) {
+        if (skip_depth > 0) {
+            return true;
+        }
+        if (deferred_depth > 0) {
+            add_deferred_item();
+        } else if (element_builder.building()) {
+            // a deferred attribute that is not a container is kept, so that its type is still checked
+            deferred_attribute_pending = false;
+            element_builder.add_value(nlohmann::ordered_json(std::forward<T>(value)));
+        } else if (depth == 0) {
+            add_not_an_object_error();
+            return false;
+        } else if (depth == 2) {
+            add_element_not_an_object_error();
+        }
+        return true;
+    }
+
+    /**
+     * @brief Starts a container within a deferred attribute, or the empty container that replaces the attribute
+     */
+    void start_deferred_container(nlohmann::ordered_json&& container) {
+        if (deferred_depth == 0) {
+            deferred_attribute_pending = false;
+            deferred_container = element_builder.add_value(std::move(container));
+        } else {
+            add_deferred_item();
+        }
+        ++deferred_depth;
+    }
+
+    /**
+     * @brief Records an item of a deferred attribute, only whether a deferred array has items is kept
+     */
+    void add_deferred_item() {
+        if (deferred_depth == 1 && deferred_container->is_array() && deferred_container->empty()) {
+            deferred_container->push_back(nullptr);
+        }
+    }
+
+    void add_not_an_object_error() {
+        errors.add_parsing_error(ParsingError::Code::INVALID_FILE_FORMAT, filepath, "The v2 json is not an object.");
+    }
+
+    void add_element_not_an_object_error() {
+        errors.add_parsing_error(
+            ParsingError::Code::INVALID_FILE_FORMAT, filepath,
+            fmt::format("Element within the '{}'-entry is not an object.", category)
+        );
+    }
+
+    const std::filesystem::path& filepath;
+    ChunkedFileReader& reader;
+    IsSupportedCategory is_supported_category;
+    IsDeferredAttribute is_deferred_attribute;
+    ParseElement parse_element;
+    Errors errors;
+    std::optional<std::string> syntax_error;
+    // 0 outside of the file's object, 1 within the file's object, 2 within the array of a supported category
+    int depth = 0;
+    // the nesting depth within a value that is skipped, 0 if nothing is skipped
+    int skip_depth = 0;
+    std::string category;
+    JsonBuilder element_builder;
+    // whether the value that follows is a deferred attribute of the element
+    bool deferred_attribute_pending = false;
+    // the nesting depth within a deferred attribute, 0 if no deferred attribute is skipped
+    int deferred_depth = 0;
+    nlohmann::ordered_json* deferred_container = nullptr;
+};
+
+} // namespace
+
+StreamingFileParser::StreamingFileParser(
+    const std::filesystem::path& filepath, DescriptionParsing description_parsing
+)
+    : FileParser(filepath, true), description_parsing(description_parsing) {}
+
+Errors StreamingFileParser::open_json() {
+    DND_MEASURE_FUNCTION();
+    Errors errors = check_file_extension();
+    if (!errors.ok()) {
+        return errors;
+    }
+    json_file.open(get_filepath(), std::ios::binary);
+    return errors;
+}
+
+Errors StreamingFileParser::parse() {
+    DND_MEASURE_FUNCTION();
+    auto is_supported = [this](const std::string& category) { return is_supported_category(category); };
+    auto is_deferred = [this](const std::string& category, const std::string& attribute) {
+        return description_parsing == DescriptionParsing::LAZY && is_deferred_description(category, attribute);
+    };
+    auto parse = [this](const std::string& category, nlohmann::ordered_json&& element, const ByteRange& range) {
+        element_offset = range.offset;
+        element_length = range.length;
+        element_hash = range.content_hash;
+        return parse_element(category, element);
+    };
+    // the content hashes of the elements are only needed to check the lazily parsed descriptions
+    ChunkedFileReader reader(json_file, description_parsing == DescriptionParsing::LAZY);
+    CategoryElementSax<decltype(is_supported), decltype(is_deferred), decltype(parse)> sax(
+        get_filepath(), reader, is_supported, is_deferred, parse
+    );
+    nlohmann::ordered_json::sax_parse(ChunkedFileIterator(&reader), ChunkedFileIterator(), &sax);
+    DND_MEASURE_COUNTER("Bytes read", reader.get_bytes_read());
+    json_file.close();
+
+    valid_json = !sax.get_syntax_error().has_value();
+    if (!valid_json) {
+        // like when parsing the whole file at once, nothing of an invalid file is used
+        clear_parsed_data();
+        Errors errors;
+        errors.add_parsing_error(
+            ParsingError::Code::INVALID_FILE_FORMAT, get_filepath(),
+            fmt::format(
+                "Error occured while parsing '{}': {} ", get_filepath().string(), sax.get_syntax_error().value()
+            )
+        );
+        return errors;
+    }
+    return sax.take_errors();
+}
+
+bool StreamingFileParser::is_deferred_description(const std::string& category, const std::string& attribute) const {
+    DND_UNUSED(category);
+    DND_UNUSED(attribute);
+    return false;
+}
+
+std::optional<TextSource> StreamingFileParser::get_description_source(TextSource::Format format) const {
+    if (description_parsing == DescriptionParsing::EAGER) {
+        return std::nullopt;
+    }
+    return TextSource{
+        .offset = element_offset,
+        .length = element_length,
+        .content_hash = element_hash,
+        .format = format,
+    };
+}
+
+bool StreamingFileParser::continue_after_errors() const { return valid_json && FileParser::continue_after_errors(); }
+
+} // namespace dnd
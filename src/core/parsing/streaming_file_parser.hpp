@@ -0,0 +1,92 @@
+#ifndef STREAMING_FILE_PARSER_HPP_
+#define STREAMING_FILE_PARSER_HPP_
+
+#include <dnd_config.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string>
+
+#include <nlohmann/json.hpp>
+
+#include <core/errors/errors.hpp>
+#include <core/parsing/file_parser.hpp>
+#include <core/parsing/lazy_text_parsing.hpp>
+#include <core/text/text_source.hpp>
+
+namespace dnd {
+
+/**
+ * @brief A parser for files in the v2 format, i.e. an object of categories that are arrays of objects.
+ * Instead of building the JSON of the whole file, the file is streamed and only the elements of supported categories
+ * are built and parsed, one element at a time.
+ */
+class StreamingFileParser : public FileParser {
+public:
+    explicit StreamingFileParser(
+        const std::filesystem::path& filepath, DescriptionParsing description_parsing = DescriptionParsing::EAGER
+    );
+    /**
+     * @brief Opens the file without reading it, the JSON is parsed while streaming it in parse
+     * @return the errors that occurred while reading the file
+     */
+    virtual Errors open_json() override;
+    /**
+     * @brief Streams the file and parses the elements of all supported categories
+     * @return the errors that occurred while parsing
+     */
+    virtual Errors parse() override final;
+    /**
+     * @return false if the file is not valid JSON, otherwise whether the file has multiple pieces
+     */
+    virtual bool continue_after_errors() const override;
+protected:
+    /**
+     * @brief Decides whether the elements of a category are parsed, all other categories are skipped while streaming
+     * @param category the name of the category
+     * @return true if the elements of the category should be parsed, false otherwise
+     */
+    virtual bool is_supported_category(const std::string& category) const = 0;
+    /**
+     * @brief Parses one element of a supported category
+     * @param category the name of the category
+     * @param element the JSON of the element
+     * @return the errors that occurred while parsing the element
+     */
+    virtual Errors parse_element(const std::string& category, const nlohmann::ordered_json& element) = 0;
+    /**
+     * @brief Decides whether an attribute of the elements of a category is a description that is only located, not
+     * parsed, if descriptions are parsed lazily. Such an attribute is not built while streaming, the element only
+     * contains an empty container of the same type instead, which contains a null if the attribute was a non-empty
+     * array.
+     * @param category the name of the category
+     * @param attribute the key of the attribute within the element
+     * @return true if the attribute is a lazily parsed description, false otherwise
+     */
+    virtual bool is_deferred_description(const std::string& category, const std::string& attribute) const;
+    /**
+     * @brief Discards everything parsed so far, which is used when the file turns out not to be valid JSON
+     */
+    virtual void clear_parsed_data() = 0;
+    /**
+     * @brief Returns where the description of the element that is currently parsed can be found, if it should be
+     * parsed lazily
+     * @param format how the description is stored within the element
+     * @return the location of the element within the file, or std::nullopt if descriptions are parsed eagerly
+     */
+    std::optional<TextSource> get_description_source(TextSource::Format format) const;
+private:
+    std::ifstream json_file;
+    bool valid_json = true;
+    DescriptionParsing description_parsing;
+    // the byte range of the element that is currently parsed within the file
+    uint64_t element_offset = 0;
+    uint64_t element_length = 0;
+    uint64_t element_hash = 0;
+};
+
+} // namespace dnd
+
+#endif // STREAMING_FILE_PARSER_HPP_
@@ -2,7 +2,11 @@
 
 #include "v2_file_parser.hpp"
 
+#include <algorithm>
 #include <filesystem>
+#include <optional>
+#include <string>
+#include <utility>
 
 #include <fmt/format.h>
 #include <fmt/ranges.h>
@@ -12,6 +16,7 @@
 #include <core/errors/errors.hpp>
 #include <core/errors/parsing_error.hpp>
 #include <core/models/character/character.hpp>
+#include <core/models/character/character_batch.hpp>
 #include <core/models/class/class.hpp>
 #include <core/models/effects_provider/choosable.hpp>
 #include <core/models/species/species.hpp>
@@ -21,78 +26,76 @@
 #include <core/parsing/choosable_parsing.hpp>
 #include <core/parsing/class_parsing.hpp>
 #include <core/parsing/file_parser.hpp>
+#include <core/parsing/lazy_text_parsing.hpp>
+#include <core/parsing/snapshot_serialization.hpp>
 #include <core/parsing/species_parsing.hpp>
+#include <core/parsing/streaming_file_parser.hpp>
+#include <core/text/formatted_text.hpp>
+#include <core/text/text_source.hpp>
 #include <log.hpp>
 
 namespace dnd {
 
-V2FileParser::V2FileParser(const std::filesystem::path& filepath) : FileParser(filepath, true) {}
-
-Errors V2FileParser::parse() {
-    Errors errors;
-    if (!json.is_object()) {
-        errors.add_parsing_error(
-            ParsingError::Code::INVALID_FILE_FORMAT, get_filepath(), "The v2 json is not an object."
-        );
+std::optional<ParseType> find_parse_type(const std::string& category) {
+    size_t type_index = std::find(parse_types.begin(), parse_types.end(), category) - parse_types.begin();
+    if (type_index >= parse_types.size()) {
+        return std::nullopt;
     }
+    return static_cast<ParseType>(type_index);
+}
 
-    for (nlohmann::ordered_json::const_iterator it = json.cbegin(); it != json.cend(); ++it) {
-        const std::string& category = it.key();
-        const nlohmann::ordered_json& entry = it.value();
-        if (!entry.is_array()) {
-            continue;
-        }
+V2FileParser::V2FileParser(
+    const std::filesystem::path& filepath, DescriptionParsing description_parsing, CharacterBatch* character_batch
+)
+    : StreamingFileParser(filepath, description_parsing), character_batch(character_batch) {}
 
-        size_t type_index = std::find(parse_types.begin(), parse_types.end(), category) - parse_types.begin();
-        if (type_index >= parse_types.size()) {
-            LOGWARN("Found unknown category '{}' in {}", category, get_filepath().c_str());
-            continue;
-        }
-        ParseType parse_type = static_cast<ParseType>(type_index);
-
-        bool is_supported;
-        switch (parse_type) {
-            case ParseType::class_type:
-            case ParseType::classFeature_type:
-            case ParseType::subclass_type:
-            case ParseType::subclassFeature_type:
-            case ParseType::race_type:
-            case ParseType::subrace_type:
-            case ParseType::character_type:
-            case ParseType::feat_type:
-                is_supported = true;
-                break;
-            default:
-                is_supported = false;
-                break;
-        }
-        if (!is_supported) {
-            continue;
-        }
+bool V2FileParser::is_supported_category(const std::string& category) const {
+    std::optional<ParseType> parse_type = find_parse_type(category);
+    if (!parse_type.has_value()) {
+        LOGWARN("Found unknown category '{}' in {}", category, get_filepath().c_str());
+        return false;
+    }
+    switch (parse_type.value()) {
+        case ParseType::class_type:
+        case ParseType::classFeature_type:
+        case ParseType::subclass_type:
+        case ParseType::subclassFeature_type:
+        case ParseType::race_type:
+        case ParseType::subrace_type:
+        case ParseType::character_type:
+        case ParseType::feat_type:
+            return true;
+        default:
+            return false;
+    }
+}
 
-        for (const nlohmann::ordered_json& element : entry) {
-            if (!element.is_object()) {
-                errors.add_parsing_error(
-                    ParsingError::Code::INVALID_FILE_FORMAT, get_filepath(),
-                    fmt::format("Element within the '{}'-entry is not an object.", category)
-                );
-                continue;
-            }
-            errors += parse_object(element, parse_type);
-        }
+Errors V2FileParser::parse_element(const std::string& category, const nlohmann::ordered_json& element) {
+    return parse_object(element, find_parse_type(category).value());
+}
+
+bool V2FileParser::is_deferred_description(const std::string& category, const std::string& attribute) const {
+    if (attribute != "entries") {
+        return false;
     }
-    return errors;
+    // only the features get the location of their description, see parse_object
+    std::optional<ParseType> parse_type = find_parse_type(category);
+    return parse_type == ParseType::classFeature_type || parse_type == ParseType::subclassFeature_type;
 }
 
+void V2FileParser::clear_parsed_data() { parsed_data = Data(); }
+
 void V2FileParser::save_result(Content& content) {
     for (auto& [key, data] : parsed_data.class_data) {
         data.important_levels_data.feat_levels = {1};            // HACK: set random feat level to circumvent validation
         data.subclass_feature_name = data.features_data[0].name; // HACK: set subclass feature to circumvent validation
-        data.description = Text::simple("Class " + data.name);   // HACK: set description to circumvent validation
+        // HACK: set description to circumvent validation
+        data.description = FormattedText::simple("Class " + data.name);
         content.add_class_result(Class::create_for(std::move(data), content));
     }
     for (auto& [key, data] : parsed_data.subclass_data) {
-        data.description = Text::simple("Subclass " + data.name); // HACK: set description to circumvent validation
+        // HACK: set description to circumvent validation
+        data.description = FormattedText::simple("Subclass " + data.name);
         content.add_subclass_result(Subclass::create_for(std::move(data), content));
     }
     for (auto& [key, data] : parsed_data.species_data) {
@@ -102,13 +105,41 @@ void V2FileParser::save_result(Content& content) {
         content.add_subspecies_result(Subspecies::create_for(std::move(data), content));
     }
     for (auto& [key, data] : parsed_data.character_data) {
-        content.add_character_result(Character::create_for(std::move(data), content));
+        if (character_batch != nullptr) {
+            character_batch->add(std::move(data));
+        } else {
+            content.add_character_result(Character::create_for(std::move(data), content));
+        }
     }
     for (auto& [key, data] : parsed_data.choosable_data) {
         content.add_choosable_result(Choosable::create_for(std::move(data), content));
     }
 }
 
+void V2FileParser::write_snapshot(SnapshotWriter& writer) const {
+    serialize(writer, parsed_data.class_data);
+    serialize(writer, parsed_data.subclass_data);
+    serialize(writer, parsed_data.species_data);
+    serialize(writer, parsed_data.subspecies_data);
+    serialize(writer, parsed_data.character_data);
+    serialize(writer, parsed_data.choosable_data);
+}
+
+bool V2FileParser::read_snapshot(SnapshotReader& reader) {
+    Data snapshot_data;
+    deserialize(reader, snapshot_data.class_data);
+    deserialize(reader, snapshot_data.subclass_data);
+    deserialize(reader, snapshot_data.species_data);
+    deserialize(reader, snapshot_data.subspecies_data);
+    deserialize(reader, snapshot_data.character_data);
+    deserialize(reader, snapshot_data.choosable_data);
+    if (!reader.ok() || !reader.at_end()) {
+        return false;
+    }
+    parsed_data = std::move(snapshot_data);
+    return true;
+}
+
 Errors V2FileParser::parse_object(const nlohmann::ordered_json& obj, ParseType parse_type) {
     Errors errors;
     switch (parse_type) {
@@ -119,7 +150,9 @@ Errors V2FileParser::parse_object(const nlohmann::ordered_json& obj, ParseType p
             break;
         }
         case ParseType::classFeature_type: {
-            errors += parse_class_feature(obj, get_filepath(), parsed_data.class_data);
+            errors += parse_class_feature(
+                obj, get_filepath(), parsed_data.class_data, get_description_source(TextSource::Format::ENTRIES)
+            );
             break;
         }
         case ParseType::subclass_type: {
@@ -129,7 +162,9 @@ Errors V2FileParser::parse_object(const nlohmann::ordered_json& obj, ParseType p
             break;
         }
         case ParseType::subclassFeature_type: {
-            errors += parse_subclass_feature(obj, get_filepath(), parsed_data.subclass_data);
+            errors += parse_subclass_feature(
+                obj, get_filepath(), parsed_data.subclass_data, get_description_source(TextSource::Format::ENTRIES)
+            );
             break;
         }
         case ParseType::race_type: {
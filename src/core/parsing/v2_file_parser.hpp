@@ -5,6 +5,10 @@
 
 #include <filesystem>
 #include <map>
+#include <optional>
+#include <string>
+
+#include <nlohmann/json.hpp>
 
 #include <core/errors/errors.hpp>
 #include <core/models/character/character.hpp>
@@ -14,6 +18,8 @@
 #include <core/models/subclass/subclass.hpp>
 #include <core/models/subspecies/subspecies.hpp>
 #include <core/parsing/file_parser.hpp>
+#include <core/parsing/lazy_text_parsing.hpp>
+#include <core/parsing/streaming_file_parser.hpp>
 
 namespace dnd {
 
@@ -42,9 +48,17 @@ enum class ParseType {
 constexpr std::array<const char*, 90> parse_types = {X_PARSE_TYPES};
 #undef X
 
+/**
+ * @brief Finds the parse type of a category of the v2 format
+ * @param category the name of the category
+ * @return the parse type, or std::nullopt if the category is unknown
+ */
+std::optional<ParseType> find_parse_type(const std::string& category);
+
+class CharacterBatch;
 class Content;
 
-class V2FileParser : public FileParser {
+class V2FileParser : public StreamingFileParser {
 public:
     struct Data {
         std::map<std::string, Class::Data> class_data;
@@ -54,13 +68,29 @@ public:
         std::map<std::string, Character::Data> character_data;
         std::map<std::string, Choosable::Data> choosable_data;
     };
-    explicit V2FileParser(const std::filesystem::path& filepath);
-    virtual Errors parse();
+    /**
+     * @brief Constructs a parser for a file of the v2 format
+     * @param filepath the file to parse
+     * @param description_parsing whether the descriptions are parsed right away or only when they are first accessed
+     * @param character_batch if given, the characters are added to it instead of being created right away
+     */
+    explicit V2FileParser(
+        const std::filesystem::path& filepath, DescriptionParsing description_parsing = DescriptionParsing::EAGER,
+        CharacterBatch* character_batch = nullptr
+    );
     virtual void save_result(Content& content);
+    virtual void write_snapshot(SnapshotWriter& writer) const;
+    virtual bool read_snapshot(SnapshotReader& reader);
+protected:
+    virtual bool is_supported_category(const std::string& category) const override;
+    virtual Errors parse_element(const std::string& category, const nlohmann::ordered_json& element) override;
+    virtual bool is_deferred_description(const std::string& category, const std::string& attribute) const override;
+    virtual void clear_parsed_data() override;
 private:
     Errors parse_object(const nlohmann::ordered_json& obj, ParseType parse_type);
 
     Data parsed_data;
+    CharacterBatch* character_batch;
 };
 
 
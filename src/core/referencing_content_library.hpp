@@ -3,8 +3,12 @@
 
 #include <dnd_config.hpp>
 
+#include <algorithm>
+#include <cassert>
+#include <functional>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include <fmt/format.h>
@@ -12,6 +16,7 @@
 #include <core/content_library.hpp>
 #include <core/models/effects_provider/class_feature.hpp>
 #include <core/types.hpp>
+#include <core/utils/string_hash.hpp>
 #include <core/utils/string_manipulation.hpp>
 
 namespace dnd {
@@ -24,12 +29,17 @@ template <typename T>
 requires isContentPieceType<T>
 class ReferencingContentLibrary : public ContentLibrary<T> {
 public:
-    std::optional<size_t> find(const std::string& key) const;
-    bool contains(const std::string& key) const override;
+    /**
+     * @brief Find the index of the content piece with the given key
+     * @param key the key of the content piece
+     * @return the index of the content piece, or std::nullopt if no content piece with that key exists
+     */
+    std::optional<size_t> find(std::string_view key) const;
+    bool contains(std::string_view key) const override;
     bool empty() const override;
     size_t size() const override;
     Opt<CRef<T>> get(size_t index) const override;
-    Opt<CRef<T>> get(const std::string& key) const override;
+    Opt<CRef<T>> get(std::string_view key) const override;
     const std::vector<std::reference_wrapper<const T>>& get_all() const;
     /**
      * @brief Add a content piece to a content piece to the library
@@ -37,8 +47,23 @@ public:
      * @return reference to the inserted content piece, or std::nullopt if a content piece with that key already exists
      */
     std::optional<size_t> add(const T& content_piece);
+    /**
+     * @brief Find the index of the reference to a certain content piece, i.e. to the object and not to its key
+     * @param content_piece the referenced content piece
+     * @return the index of the reference, or std::nullopt if the content piece is not referenced
+     */
+    std::optional<size_t> find_reference(const T& content_piece) const;
+    /**
+     * @brief Replaces a reference with a reference to another content piece with the same key, e.g. after the content
+     * piece that owns the referenced one was replaced
+     * @param index the index of the reference
+     * @param content_piece the content piece to reference instead
+     */
+    void rebind(size_t index, const T& content_piece);
 private:
     std::vector<std::reference_wrapper<const T>> data;
+    // maps the key of each content piece to its index in data (the first one, if a key occurs more than once)
+    StringMap<size_t> key_index;
 };
 
 
@@ -46,18 +71,17 @@ private:
 
 template <typename T>
 requires isContentPieceType<T>
-inline std::optional<size_t> ReferencingContentLibrary<T>::find(const std::string& key) const {
-    for (size_t i = 0; i < data.size(); ++i) {
-        if (data[i].get().get_key() == key) {
-            return i;
-        }
+inline std::optional<size_t> ReferencingContentLibrary<T>::find(std::string_view key) const {
+    auto it = key_index.find(key);
+    if (it == key_index.end()) {
+        return std::nullopt;
     }
-    return std::nullopt;
+    return it->second;
 }
 
 template <typename T>
 requires isContentPieceType<T>
-inline bool ReferencingContentLibrary<T>::contains(const std::string& key) const {
+inline bool ReferencingContentLibrary<T>::contains(std::string_view key) const {
     return find(key).has_value();
 }
 
@@ -84,7 +108,7 @@ inline Opt<CRef<T>> ReferencingContentLibrary<T>::get(size_t index) const {
 
 template <typename T>
 requires isContentPieceType<T>
-inline Opt<CRef<T>> ReferencingContentLibrary<T>::get(const std::string& key) const {
+inline Opt<CRef<T>> ReferencingContentLibrary<T>::get(std::string_view key) const {
     std::optional<size_t> idx = find(key);
     if (!idx.has_value()) {
         return std::nullopt;
@@ -107,7 +131,34 @@ inline std::optional<size_t> ReferencingContentLibrary<T>::add(const T& content_
         DND_UNUSED(e);
         return std::nullopt;
     }
-    return data.size() - 1;
+    size_t index = data.size() - 1;
+    try {
+        key_index.try_emplace(content_piece.get_key(), index);
+    } catch (const std::exception& e) {
+        DND_UNUSED(e);
+        data.pop_back();
+        return std::nullopt;
+    }
+    return index;
+}
+
+template <typename T>
+requires isContentPieceType<T>
+inline std::optional<size_t> ReferencingContentLibrary<T>::find_reference(const T& content_piece) const {
+    auto it = std::find_if(data.begin(), data.end(), [&content_piece](std::reference_wrapper<const T> reference) {
+        return &reference.get() == &content_piece;
+    });
+    if (it == data.end()) {
+        return std::nullopt;
+    }
+    return static_cast<size_t>(it - data.begin());
+}
+
+template <typename T>
+requires isContentPieceType<T>
+inline void ReferencingContentLibrary<T>::rebind(size_t index, const T& content_piece) {
+    assert(data[index].get().get_key() == content_piece.get_key());
+    data[index] = std::cref(content_piece);
 }
 
 } // namespace dnd
@@ -13,12 +13,15 @@
 namespace dnd {
 
 AdvancedContentSearch::AdvancedContentSearch(const Content& content)
-    : content(content), filter(ContentPieceFilter(content)), searching(false), search_future() {}
+    : content(content), filter(ContentPieceFilter(content)), searching(false), search_future(), search_results(),
+      search_results_generation(0) {}
 
 ContentFilterVariant& AdvancedContentSearch::get_filter() { return filter; }
 
 const std::vector<Id>& AdvancedContentSearch::get_search_results() const { return search_results; }
 
+uint64_t AdvancedContentSearch::get_search_results_generation() const { return search_results_generation; }
+
 static std::vector<Id> search(const Content& content, ContentFilterVariant searching_filter) {
     std::vector<Id> search_results = dispatch(searching_filter, const auto& filter, filter.all_matches());
     std::sort(search_results.begin(), search_results.end(), [&content](Id lhs, Id rhs) {
@@ -40,8 +43,19 @@ bool AdvancedContentSearch::search_results_available() {
     if (searching && search_future.wait_for(std::chrono::nanoseconds(1)) == std::future_status::ready) {
         searching = false;
         search_results = search_future.get();
+        ++search_results_generation;
     }
     return !searching;
 }
 
+void AdvancedContentSearch::clear_search_results() {
+    if (searching) {
+        search_future.wait();
+        search_future = std::future<std::vector<Id>>();
+        searching = false;
+    }
+    search_results.clear();
+    ++search_results_generation;
+}
+
 } // namespace dnd
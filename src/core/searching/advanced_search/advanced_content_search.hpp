@@ -3,6 +3,7 @@
 
 #include <dnd_config.hpp>
 
+#include <cstdint>
 #include <future>
 #include <variant>
 #include <vector>
@@ -36,6 +37,10 @@ public:
     void set_filter(T&& new_filter);
     ContentFilterVariant& get_filter();
     const std::vector<Id>& get_search_results() const;
+    /**
+     * @return a number that changes whenever the search results change
+     */
+    uint64_t get_search_results_generation() const;
 
     void start_searching();
     /**
@@ -44,12 +49,17 @@ public:
      * @throws std::exception if any exception is thrown by the search thread
      */
     bool search_results_available();
+    /**
+     * @brief Waits for a running search and discards all search results, e.g. because the content is replaced
+     */
+    void clear_search_results();
 private:
     const Content& content;
     ContentFilterVariant filter;
     bool searching;
     std::future<std::vector<Id>> search_future;
     std::vector<Id> search_results;
+    uint64_t search_results_generation;
 };
 
 template <typename T>
@@ -1,55 +1,190 @@
-#include <cstdint>
 #include <dnd_config.hpp>
 
 #include "fuzzy_content_search.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <string>
 #include <vector>
 
-#include <core/content.hpp>
+#include <core/searching/fuzzy_search/fuzzy_search_index.hpp>
 #include <core/searching/fuzzy_search/fuzzy_string_search.hpp>
 #include <core/searching/search_result.hpp>
+#include <core/utils/string_manipulation.hpp>
+#include <core/utils/worker_pool.hpp>
 
 namespace dnd {
 
-std::vector<SearchResult> fuzzy_search_content(
-    const Content& content, const std::string& search_query, const FuzzySearchOptions& options
-) {
-    DND_MEASURE_FUNCTION();
-    std::vector<SearchResult> results;
+bool search_result_ranks_higher(const SearchResult& a, const SearchResult& b) {
+    if (a.significance == b.significance) {
+        return a.content_piece_id < b.content_piece_id;
+    }
+    return a.significance > b.significance;
+}
+
+// the number of content pieces a worker scores before it takes the next chunk
+static constexpr size_t SEARCH_CHUNK_SIZE = 512;
 
+/**
+ * @brief A range of content pieces of one type that is scored by one worker
+ */
+struct SearchChunk {
+    Type type;
+    size_t begin;
+    size_t end;
+};
+
+/**
+ * @brief Keeps the best results seen by one worker, the lowest-ranked of them is on top of the heap
+ */
+class TopResultsHeap {
+public:
+    explicit TopResultsHeap(size_t max_results) : max_results(max_results) { heap.reserve(max_results + 1); }
+    void add(SearchResult&& result) {
+        ++match_count;
+        if (heap.size() == max_results) {
+            if (max_results == 0 || !search_result_ranks_higher(result, heap.front())) {
+                return;
+            }
+            std::pop_heap(heap.begin(), heap.end(), search_result_ranks_higher);
+            heap.pop_back();
+        }
+        heap.push_back(std::move(result));
+        std::push_heap(heap.begin(), heap.end(), search_result_ranks_higher);
+    }
+    const std::vector<SearchResult>& get_results() const { return heap; }
+    size_t get_match_count() const { return match_count; }
+private:
+    size_t max_results;
+    size_t match_count = 0;
+    std::vector<SearchResult> heap;
+};
+
+/**
+ * @brief Everything one worker found
+ */
+struct WorkerResults {
+    explicit WorkerResults(size_t max_results) : top_results(max_results), candidates() {}
+
+    TopResultsHeap top_results;
+    std::vector<Id> candidates;
+};
+
+static void search_content_piece(
+    const FuzzySearchIndex& index, const std::string& lowercase_query, uint64_t query_char_mask, Id id,
+    WorkerResults& worker_results
+) {
     int64_t min_match_score = 0;
+    FuzzyMatchTarget target = index.get(id.type, id.index);
+    if (!fuzzy_contains_query(lowercase_query, query_char_mask, target)) {
+        return;
+    }
+    worker_results.candidates.push_back(id);
+    int64_t match_score = fuzzy_match_prepared(lowercase_query, query_char_mask, target);
+    if (match_score > min_match_score) {
+        worker_results.top_results.add(SearchResult(id, match_score));
+    }
+}
+
+/**
+ * @brief Lets the workers of the pool search the chunks and merges what they found
+ * @param chunk_count the number of chunks
+ * @param max_results the number of the best matches to keep
+ * @param worker_pool the workers searching the chunks
+ * @param search_chunk a function searching the chunk with the given index and adding to the given worker results
+ * @return the best matches, the number of all matches, and all candidates
+ */
+template <typename SearchChunkFunction>
+static TopFuzzySearchResults search_chunks_in_parallel(
+    size_t chunk_count, size_t max_results, WorkerPool& worker_pool, const SearchChunkFunction& search_chunk
+) {
+    size_t worker_count = std::max(static_cast<size_t>(1), std::min(worker_pool.get_worker_count(), chunk_count));
+    std::vector<WorkerResults> worker_results(worker_count, WorkerResults(max_results));
+    std::atomic<size_t> next_chunk = 0;
+    // each job keeps its own results and takes chunks until none are left, which balances chunks of different cost
+    worker_pool.run(worker_count, [&](size_t worker_index) {
+        for (size_t i = next_chunk++; i < chunk_count; i = next_chunk++) {
+            search_chunk(i, worker_results[worker_index]);
+        }
+    });
+
+    TopFuzzySearchResults top_results;
+    for (WorkerResults& results : worker_results) {
+        const std::vector<SearchResult>& heap = results.top_results.get_results();
+        top_results.match_count += results.top_results.get_match_count();
+        top_results.results.insert(top_results.results.end(), heap.begin(), heap.end());
+        top_results.candidates.insert(
+            top_results.candidates.end(), results.candidates.begin(), results.candidates.end()
+        );
+    }
+    // only the best results of all workers are sorted, all others are dropped
+    size_t result_count = std::min(max_results, top_results.results.size());
+    std::partial_sort(
+        top_results.results.begin(), top_results.results.begin() + static_cast<std::ptrdiff_t>(result_count),
+        top_results.results.end(), search_result_ranks_higher
+    );
+    top_results.results.resize(result_count);
+    return top_results;
+}
+
+static std::vector<SearchChunk> split_into_chunks(const FuzzySearchIndex& index, const FuzzySearchOptions& options) {
+    std::vector<SearchChunk> chunks;
+    auto add_chunks = [&chunks](Type type, size_t size) {
+        for (size_t begin = 0; begin < size; begin += SEARCH_CHUNK_SIZE) {
+            size_t end = std::min(size, begin + SEARCH_CHUNK_SIZE);
+            chunks.push_back(SearchChunk{.type = type, .begin = begin, .end = end});
+        }
+    };
 
 #define X(C, U, j, a, p, P)                                                                                            \
     if (options.search_##p) {                                                                                          \
-        const std::vector<C>& vec_##p = content.get_all_##p();                                                         \
-        for (size_t i = 0; i < vec_##p.size(); ++i) {                                                                  \
-            const C& a = vec_##p[i];                                                                                   \
-            int64_t match_score = fuzzy_match_string(search_query, a.get_name());                                      \
-            if (match_score > min_match_score) {                                                                       \
-                results.emplace_back(Id{.index = i, .type = Type::C}, match_score);                                    \
-            }                                                                                                          \
-        }                                                                                                              \
+        add_chunks(Type::C, index.size(Type::C));                                                                      \
     }
-
     X_OWNED_CONTENT_PIECES
 #undef X
 
     if (options.search_features) {
-#define X(C, U, j, a, p, P)                                                                                            \
-    const std::vector<CRef<C>>& vec_##p = content.get_all_##p();                                                       \
-    for (size_t i = 0; i < vec_##p.size(); ++i) {                                                                      \
-        const C& a = vec_##p[i];                                                                                       \
-        int64_t match_score = fuzzy_match_string(search_query, a.get_name());                                          \
-        if (match_score > min_match_score) {                                                                           \
-            results.emplace_back(Id{.index = i, .type = Type::C}, match_score);                                        \
-        }                                                                                                              \
-    }
-
+#define X(C, U, j, a, p, P) add_chunks(Type::C, index.size(Type::C));
         X_FEATURES
 #undef X
     }
-    return results;
+    return chunks;
+}
+
+TopFuzzySearchResults fuzzy_search_content_top_k(
+    const FuzzySearchIndex& index, const std::string& search_query, const FuzzySearchOptions& options,
+    size_t max_results, WorkerPool& worker_pool
+) {
+    DND_MEASURE_FUNCTION();
+    const std::vector<SearchChunk> chunks = split_into_chunks(index, options);
+    const std::string lowercase_query = string_lowercase_copy(search_query);
+    const uint64_t query_char_mask = fuzzy_char_mask(lowercase_query);
+    auto search_chunk = [&](size_t chunk_index, WorkerResults& worker_results) {
+        const SearchChunk& chunk = chunks[chunk_index];
+        for (size_t i = chunk.begin; i < chunk.end; ++i) {
+            Id id{.index = i, .type = chunk.type};
+            search_content_piece(index, lowercase_query, query_char_mask, id, worker_results);
+        }
+    };
+    return search_chunks_in_parallel(chunks.size(), max_results, worker_pool, search_chunk);
+}
+
+TopFuzzySearchResults refine_fuzzy_search_top_k(
+    const FuzzySearchIndex& index, const std::string& search_query, const std::vector<Id>& candidates,
+    size_t max_results, WorkerPool& worker_pool
+) {
+    DND_MEASURE_FUNCTION();
+    const std::string lowercase_query = string_lowercase_copy(search_query);
+    const uint64_t query_char_mask = fuzzy_char_mask(lowercase_query);
+    size_t chunk_count = (candidates.size() + SEARCH_CHUNK_SIZE - 1) / SEARCH_CHUNK_SIZE;
+    auto search_chunk = [&](size_t chunk_index, WorkerResults& worker_results) {
+        size_t end = std::min(candidates.size(), (chunk_index + 1) * SEARCH_CHUNK_SIZE);
+        for (size_t i = chunk_index * SEARCH_CHUNK_SIZE; i < end; ++i) {
+            search_content_piece(index, lowercase_query, query_char_mask, candidates[i], worker_results);
+        }
+    };
+    return search_chunks_in_parallel(chunk_count, max_results, worker_pool, search_chunk);
 }
 
 } // namespace dnd
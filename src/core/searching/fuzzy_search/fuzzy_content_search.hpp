@@ -4,13 +4,16 @@
 #include <dnd_config.hpp>
 
 #include <string>
+#include <vector>
 
+#include <core/searching/fuzzy_search/fuzzy_search_index.hpp>
 #include <core/searching/search_result.hpp>
+#include <core/types.hpp>
 #include <x/content_pieces.hpp>
 
 namespace dnd {
 
-class Content;
+class WorkerPool;
 
 constexpr uint32_t FUZZY_SEARCH_MINIMUM_QUERY_LENGTH = 1;
 
@@ -30,8 +33,52 @@ struct FuzzySearchOptions {
     }
 };
 
-std::vector<SearchResult> fuzzy_search_content(
-    const Content& content, const std::string& search_query, const FuzzySearchOptions& options
+/**
+ * @brief The best results of a fuzzy search
+ */
+struct TopFuzzySearchResults {
+    // the best results, sorted from the most to the least significant
+    std::vector<SearchResult> results;
+    // the number of all matches, which can be larger than the number of kept results
+    size_t match_count = 0;
+    // all content pieces containing the characters of the query in order, which are the only content pieces that
+    // can match a query extending this query
+    std::vector<Id> candidates;
+};
+
+/**
+ * @brief Compares search results by their significance, equally significant results are ordered by their ID
+ * @return true if the first result should be shown before the second, false otherwise
+ */
+bool search_result_ranks_higher(const SearchResult& a, const SearchResult& b);
+
+/**
+ * @brief Searches the content concurrently and only keeps the best matches
+ * @param index the prepared names of the content to search
+ * @param search_query the query to match the names of the content pieces against
+ * @param options the types of content pieces to search
+ * @param max_results the number of the best matches to keep
+ * @param worker_pool the workers searching the content, which are kept alive between the searches of each keystroke
+ * @return the best matches in the order they are ranked, the number of all matches, and the candidates
+ */
+TopFuzzySearchResults fuzzy_search_content_top_k(
+    const FuzzySearchIndex& index, const std::string& search_query, const FuzzySearchOptions& options,
+    size_t max_results, WorkerPool& worker_pool
+);
+
+/**
+ * @brief Searches only the candidates of a previous search, which finds the same matches as searching all content if
+ * the query extends the query of the previous search
+ * @param index the prepared names of the content to search
+ * @param search_query the query to match the names of the content pieces against
+ * @param candidates the candidates of the previous search
+ * @param max_results the number of the best matches to keep
+ * @param worker_pool the workers searching the candidates
+ * @return the best matches in the order they are ranked, the number of all matches, and the candidates
+ */
+TopFuzzySearchResults refine_fuzzy_search_top_k(
+    const FuzzySearchIndex& index, const std::string& search_query, const std::vector<Id>& candidates,
+    size_t max_results, WorkerPool& worker_pool
 );
 
 
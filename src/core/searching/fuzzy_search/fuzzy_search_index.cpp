@@ -0,0 +1,48 @@
+#include <dnd_config.hpp>
+
+#include "fuzzy_search_index.hpp"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <core/content.hpp>
+#include <core/searching/fuzzy_search/fuzzy_string_search.hpp>
+#include <core/types.hpp>
+#include <x/content_pieces.hpp>
+
+namespace dnd {
+
+FuzzySearchIndex::FuzzySearchIndex(const Content& content) {
+    DND_MEASURE_FUNCTION();
+#define X(C, U, j, a, p, P)                                                                                            \
+    entries[static_cast<size_t>(Type::C)].reserve(content.get_all_##p().size());                                       \
+    for (const C& a : content.get_all_##p()) {                                                                         \
+        add_name(Type::C, a.get_name());                                                                               \
+    }
+    X_CONTENT_PIECES
+#undef X
+}
+
+size_t FuzzySearchIndex::size(Type type) const { return entries[static_cast<size_t>(type)].size(); }
+
+FuzzyMatchTarget FuzzySearchIndex::get(Type type, size_t index) const {
+    const Entry& entry = entries[static_cast<size_t>(type)][index];
+    return FuzzyMatchTarget{
+        .lowercase = std::string_view(lowercase_chars).substr(entry.offset, entry.length),
+        .char_types = char_types.data() + entry.offset,
+        .bonus_points = bonus_points.data() + entry.offset,
+        .char_mask = entry.char_mask,
+    };
+}
+
+void FuzzySearchIndex::add_name(Type type, const std::string& name) {
+    size_t offset = lowercase_chars.size();
+    prepare_fuzzy_match_target(name, lowercase_chars, char_types, bonus_points);
+    std::string_view lowercase_name = std::string_view(lowercase_chars).substr(offset);
+    entries[static_cast<size_t>(type)].push_back(
+        Entry{.offset = offset, .length = name.size(), .char_mask = fuzzy_char_mask(lowercase_name)}
+    );
+}
+
+} // namespace dnd
@@ -0,0 +1,61 @@
+#ifndef FUZZY_SEARCH_INDEX_HPP_
+#define FUZZY_SEARCH_INDEX_HPP_
+
+#include <dnd_config.hpp>
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <core/searching/fuzzy_search/fuzzy_string_search.hpp>
+#include <core/types.hpp>
+#include <x/content_pieces.hpp>
+
+namespace dnd {
+
+class Content;
+
+/**
+ * @brief The names of all content pieces prepared for fuzzy matching, which is built once for the parsed content
+ * because the names do not change afterwards
+ */
+class FuzzySearchIndex {
+public:
+    FuzzySearchIndex() = default;
+    explicit FuzzySearchIndex(const Content& content);
+    /**
+     * @param type the type of the content pieces
+     * @return the number of content pieces of this type
+     */
+    size_t size(Type type) const;
+    /**
+     * @brief Returns the prepared name of a content piece, which stays valid as long as the index is not changed
+     * @param type the type of the content piece
+     * @param index the index of the content piece
+     * @return the prepared name
+     */
+    FuzzyMatchTarget get(Type type, size_t index) const;
+private:
+    struct Entry {
+        size_t offset;
+        size_t length;
+        uint64_t char_mask;
+    };
+
+    void add_name(Type type, const std::string& name);
+
+#define X(C, U, j, a, p, P) +1
+    static constexpr size_t type_count = 0 X_CONTENT_PIECES;
+#undef X
+
+    // the data of all names is stored contiguously, the entries refer to their part of it
+    std::string lowercase_chars;
+    std::vector<CharType> char_types;
+    std::vector<int16_t> bonus_points;
+    std::array<std::vector<Entry>, type_count> entries;
+};
+
+} // namespace dnd
+
+#endif // FUZZY_SEARCH_INDEX_HPP_
@@ -6,7 +6,9 @@
 #include <array>
 #include <cassert>
 #include <cctype>
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include <core/utils/char_manipulation.hpp>
@@ -19,15 +21,6 @@ struct LocalMaximum {
 
 namespace dnd {
 
-enum class CharType {
-    LOWER_CHAR,
-    UPPER_CHAR,
-    DIGIT,
-    WHITESPACE,
-    DELIMITER,
-    NON_WORD,
-};
-
 constexpr std::array<char, 5> delimiter_chars = {'-', '(', ')', ':', ','};
 
 constexpr int16_t SCORE_MATCH = 16;
@@ -92,33 +85,80 @@ int16_t bonus_for_types(CharType previous_type, CharType type) {
     }
 }
 
+uint64_t fuzzy_char_mask(std::string_view lowercase_string) {
+    uint64_t mask = 0;
+    for (char c : lowercase_string) {
+        unsigned char uc = static_cast<unsigned char>(c);
+        size_t bit;
+        if (uc >= 'a' && uc <= 'z') {
+            bit = static_cast<size_t>(uc - 'a');
+        } else if (uc >= '0' && uc <= '9') {
+            bit = static_cast<size_t>(26 + uc - '0');
+        } else {
+            // all other characters share the remaining bits, which can only make the mask less selective
+            bit = 36 + uc % 28;
+        }
+        mask |= static_cast<uint64_t>(1) << bit;
+    }
+    return mask;
+}
+
+void prepare_fuzzy_match_target(
+    const std::string& str, std::string& lowercase, std::vector<CharType>& char_types,
+    std::vector<int16_t>& bonus_points
+) {
+    CharType previous_type = CharType::WHITESPACE;
+    for (char c : str) {
+        c = char_to_lowercase(c);
+        CharType type = char_type(c);
+        lowercase.push_back(c);
+        char_types.push_back(type);
+        bonus_points.push_back(bonus_for_types(previous_type, type));
+        previous_type = type;
+    }
+}
+
+bool fuzzy_contains_query(
+    const std::string& lowercase_query, uint64_t query_char_mask, const FuzzyMatchTarget& target
+) {
+    if ((query_char_mask & ~target.char_mask) != 0) {
+        return false;
+    }
+    size_t query_idx = 0;
+    for (char c : target.lowercase) {
+        if (query_idx < lowercase_query.size() && c == lowercase_query[query_idx]) {
+            ++query_idx;
+        }
+    }
+    return query_idx == lowercase_query.size();
+}
+
 // fuzzy search implementation heavily inspired by fzf's algorithm
 // see https://github.com/junegunn/fzf/blob/db01e7dab65423cd1d14e15f5b15dfaabe760283/src/algo/algo.go#L432
-int64_t fuzzy_match_string(const std::string& search_query, const std::string& string_to_match) {
-    if (search_query.empty() || string_to_match.empty()) {
+int64_t fuzzy_match_prepared(
+    const std::string& lowercase_query, uint64_t query_char_mask, const FuzzyMatchTarget& target
+) {
+    const std::string_view string_to_match = target.lowercase;
+    if (lowercase_query.empty() || string_to_match.empty()) {
         return 0;
     }
-    size_t query_len = search_query.size();
+    size_t query_len = lowercase_query.size();
     size_t string_len = string_to_match.size();
     if (query_len > string_len) {
         return 0;
     }
-
-    size_t min_idx = 0;
-    for (char c : string_to_match) {
-        if (char_to_lowercase(c) == char_to_lowercase(search_query[0])) {
-            break;
-        }
-        min_idx++;
+    if ((query_char_mask & ~target.char_mask) != 0) { // a character of the query does not occur in the string
+        return 0;
     }
-    if (min_idx == string_len) {
+
+    size_t min_idx = string_to_match.find(lowercase_query[0]);
+    if (min_idx == std::string_view::npos) {
         return 0;
     }
 
     size_t max_idx = string_len;
     for (size_t i = string_len - 1; i > 0; --i) {
-        char c = string_to_match[i];
-        if (char_to_lowercase(c) == char_to_lowercase(search_query[query_len - 1])) {
+        if (string_to_match[i] == lowercase_query[query_len - 1]) {
             break;
         }
         max_idx = i;
@@ -131,41 +171,33 @@ int64_t fuzzy_match_string(const std::string& search_query, const std::string& s
 
     std::vector<int16_t> initial_scores(range_len);
     std::vector<int16_t> initial_occupation(range_len);
-    std::vector<int16_t> bonus_points(range_len);
     std::vector<size_t> first_occurences(query_len);
-    std::string search_range = string_to_match.substr(min_idx, range_len);
-    string_lowercase_inplace(search_range);
+    std::string_view search_range = string_to_match.substr(min_idx, range_len);
+    // the first character of the range is scored as if it followed a whitespace
+    std::vector<int16_t> bonus_points(target.bonus_points + min_idx, target.bonus_points + max_idx);
+    bonus_points[0] = bonus_for_types(CharType::WHITESPACE, target.char_types[min_idx]);
 
     int16_t max_score = 0;
     size_t max_score_idx = 0;
 
-    char first_query_char = char_to_lowercase(search_query[0]);
-    char query_char = char_to_lowercase(search_query[0]);
+    char first_query_char = lowercase_query[0];
+    char query_char = lowercase_query[0];
     int16_t previous_inital_bonus = 0;
-    CharType previous_type = CharType::WHITESPACE;
     bool in_gap = false;
 
     size_t query_idx = 0;
     size_t last_idx = 0;
 
-    // calculate bonus values and initial scores
+    // calculate initial scores
     for (size_t i = 0; i < range_len; ++i) {
         char c = search_range[i];
-        CharType type = char_type(c);
-        if (type == CharType::UPPER_CHAR) {
-            c = char_to_lowercase(c);
-            search_range[i] = c;
-        }
-        int16_t bonus = bonus_for_types(previous_type, type);
-        bonus_points[i] = bonus;
-        previous_type = type;
+        int16_t bonus = bonus_points[i];
 
         if (c == query_char) {
             if (query_idx < query_len) {
                 first_occurences[query_idx] = i;
                 query_idx++;
-                query_char = search_query[std::min(query_idx, query_len - 1)];
-                query_char = char_to_lowercase(query_char);
+                query_char = lowercase_query[std::min(query_idx, query_len - 1)];
             }
             last_idx = i;
         }
@@ -218,12 +250,12 @@ int64_t fuzzy_match_string(const std::string& search_query, const std::string& s
     size_t occurence_count = first_occurences.size() - 1;
     for (size_t i = 0; i < occurence_count; ++i) {
         query_idx = i + 1;
-        query_char = char_to_lowercase(search_query[query_idx]);
+        query_char = lowercase_query[query_idx];
         size_t occurence = first_occurences[query_idx];
         size_t row = query_idx * match_width;
         in_gap = false;
 
-        char* search_range_subrange = search_range.data() + occurence;
+        const char* search_range_subrange = search_range.data() + occurence;
         int16_t* bonus_points_subrange = bonus_points.data() + occurence;
         int16_t* occupation_subrange = occupation.data() + row + occurence - very_first_occurence;
         int16_t* occupation_diagonal = occupation_subrange - 1 - match_width;
@@ -275,7 +307,7 @@ int64_t fuzzy_match_string(const std::string& search_query, const std::string& s
     }
 
     for (size_t i = 0; i < query_len; ++i) {
-        if (char_to_lowercase(search_query[i]) == char_to_lowercase(string_to_match[i])) {
+        if (lowercase_query[i] == string_to_match[i]) {
             max_score += BONUS_FIRST;
         } else {
             break;
@@ -285,4 +317,19 @@ int64_t fuzzy_match_string(const std::string& search_query, const std::string& s
     return max_score;
 }
 
+int64_t fuzzy_match_string(const std::string& search_query, const std::string& string_to_match) {
+    std::string lowercase;
+    std::vector<CharType> char_types;
+    std::vector<int16_t> bonus_points;
+    prepare_fuzzy_match_target(string_to_match, lowercase, char_types, bonus_points);
+    FuzzyMatchTarget target{
+        .lowercase = lowercase,
+        .char_types = char_types.data(),
+        .bonus_points = bonus_points.data(),
+        .char_mask = fuzzy_char_mask(lowercase),
+    };
+    std::string lowercase_query = string_lowercase_copy(search_query);
+    return fuzzy_match_prepared(lowercase_query, fuzzy_char_mask(lowercase_query), target);
+}
+
 } // namespace dnd
@@ -3,10 +3,77 @@
 
 #include <dnd_config.hpp>
 
+#include <cstdint>
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace dnd {
 
+enum class CharType : uint8_t {
+    LOWER_CHAR,
+    UPPER_CHAR,
+    DIGIT,
+    WHITESPACE,
+    DELIMITER,
+    NON_WORD,
+};
+
+/**
+ * @brief A string prepared for fuzzy matching, the arrays have one element per character of the string
+ */
+struct FuzzyMatchTarget {
+    // the lowercase characters of the string
+    std::string_view lowercase;
+    // the type of each character
+    const CharType* char_types;
+    // the bonus points of each character for following the character before it
+    const int16_t* bonus_points;
+    // the characters occurring in the string, see fuzzy_char_mask
+    uint64_t char_mask;
+};
+
+/**
+ * @brief Creates a mask of the characters of a string, a string can only match a query if its mask contains all bits
+ * of the query's mask
+ * @param lowercase_string a lowercase string
+ * @return a mask with one bit set for each (class of) character occurring in the string
+ */
+uint64_t fuzzy_char_mask(std::string_view lowercase_string);
+
+/**
+ * @brief Computes everything fuzzy matching needs to know about a string, which only has to happen once per string
+ * @param str the string
+ * @param lowercase the lowercase characters of the string are appended to this
+ * @param char_types the types of the characters are appended to this
+ * @param bonus_points the bonus points of the characters are appended to this
+ */
+void prepare_fuzzy_match_target(
+    const std::string& str, std::string& lowercase, std::vector<CharType>& char_types,
+    std::vector<int16_t>& bonus_points
+);
+
+/**
+ * @brief Checks whether the characters of a query occur in a prepared string in the same order, which every string
+ * matching the query has to fulfill
+ * @param lowercase_query the lowercase query
+ * @param query_char_mask the character mask of the query
+ * @param target the prepared string
+ * @return true if the string contains the characters of the query in order, false otherwise
+ */
+bool fuzzy_contains_query(const std::string& lowercase_query, uint64_t query_char_mask, const FuzzyMatchTarget& target);
+
+/**
+ * @brief Matches a prepared string against a query
+ * @param lowercase_query the lowercase query
+ * @param query_char_mask the character mask of the query
+ * @param target the prepared string
+ * @return the score of the match, or 0 if the string does not match the query
+ */
+int64_t fuzzy_match_prepared(
+    const std::string& lowercase_query, uint64_t query_char_mask, const FuzzyMatchTarget& target
+);
+
 int64_t fuzzy_match_string(const std::string& search_query, const std::string& string_to_match);
 
 } // namespace dnd
@@ -19,24 +19,37 @@
 #include <core/models/content_piece.hpp>
 #include <core/models/source_info.hpp>
 #include <core/parsing/content_parsing.hpp>
+#include <core/parsing/content_snapshot.hpp>
+#include <core/parsing/lazy_text_parsing.hpp>
 #include <core/searching/advanced_search/advanced_content_search.hpp>
 #include <core/searching/fuzzy_search/fuzzy_content_search.hpp>
 #include <core/searching/search_result.hpp>
 #include <core/types.hpp>
 #include <core/utils/string_manipulation.hpp>
 #include <core/visitors/content/list_content_visitor.hpp>
+#include <log.hpp>
 
 static const char* OPEN_TABS = "open_tabs";
 static const char* CONTENT_DIRECTORY = "content_directory";
 
 namespace dnd {
 
-Session::Session(const char* last_session_filename)
-    : last_session_filename(last_session_filename), status(SessionStatus::CONTENT_DIR_SELECTION), content_directories(),
-      parsing_future(), errors(), content(), last_session_open_tabs(), open_content_pieces(), selected_content_piece(),
-      fuzzy_search_results(max_search_results), advanced_search(content), unknown_error_messages() {}
-
-Session::~Session() { save_session_values(); }
+Session::Session(const char* last_session_filename, const char* content_snapshot_filename)
+    : last_session_filename(last_session_filename), content_snapshot_filename(content_snapshot_filename),
+      status(SessionStatus::CONTENT_DIR_SELECTION), content_directories(), worker_pool(), parsing_future(), errors(),
+      content(), parsed_content_directories(), content_snapshot(), unsaved_content_snapshot(false), content_watcher(),
+      content_changes(), last_session_open_tabs(), open_content_pieces(), selected_content_piece(),
+      fuzzy_search_index(), fuzzy_search_results(), fuzzy_search_match_count(0),
+      fuzzy_search_candidates(), fuzzy_search_query(), fuzzy_search_options(), fuzzy_search_generation(0),
+      fuzzy_search_result_strings(), advanced_search(content), advanced_search_result_strings(),
+      unknown_error_messages() {}
+
+Session::~Session() {
+    save_session_values();
+    if (unsaved_content_snapshot) {
+        content_snapshot.save(content_snapshot_filename);
+    }
+}
 
 SessionStatus Session::get_status() const { return status; }
 
@@ -63,9 +76,9 @@ Opt<Id> Session::get_selected_content_piece() {
     return rv;
 }
 
-size_t Session::get_fuzzy_search_result_count() const { return fuzzy_search_results.size(); }
+size_t Session::get_fuzzy_search_result_count() const { return fuzzy_search_match_count; }
 
-bool Session::too_many_fuzzy_search_results() const { return fuzzy_search_results.size() > max_search_results; }
+bool Session::too_many_fuzzy_search_results() const { return fuzzy_search_match_count > max_search_results; }
 
 static std::vector<std::string> cleaned_results_list(std::vector<std::string>&& results_list) {
     // TODO: pretty this up - or replace it with another solution
@@ -79,22 +92,33 @@ static std::vector<std::string> cleaned_results_list(std::vector<std::string>&&
     return results_list;
 }
 
-std::vector<std::string> Session::get_fuzzy_search_result_strings() const {
+const std::vector<std::string>& Session::get_fuzzy_search_result_strings() {
+    if (fuzzy_search_result_strings.generation == fuzzy_search_generation) {
+        return fuzzy_search_result_strings.strings;
+    }
     DND_MEASURE_FUNCTION();
+    fuzzy_search_result_strings.generation = fuzzy_search_generation;
+    if (too_many_fuzzy_search_results()) {
+        fuzzy_search_result_strings.strings.clear();
+        return fuzzy_search_result_strings.strings;
+    }
     ListContentVisitor list_content_visitor(content);
     list_content_visitor.reserve(fuzzy_search_results.size());
-    if (fuzzy_search_results.size() > max_search_results) {
-        return {};
-    }
     for (const SearchResult& result : fuzzy_search_results) {
         ContentPieceVariant variant = content.get(result.content_piece_id);
         list_content_visitor.visit_variant(variant);
     }
-    return cleaned_results_list(list_content_visitor.get_list());
+    fuzzy_search_result_strings.strings = cleaned_results_list(list_content_visitor.get_list());
+    return fuzzy_search_result_strings.strings;
 }
 
-std::vector<std::string> Session::get_advanced_search_result_strings() const {
+const std::vector<std::string>& Session::get_advanced_search_result_strings() {
+    uint64_t generation = advanced_search.get_search_results_generation();
+    if (advanced_search_result_strings.generation == generation) {
+        return advanced_search_result_strings.strings;
+    }
     DND_MEASURE_FUNCTION();
+    advanced_search_result_strings.generation = generation;
     ListContentVisitor list_content_visitor(content);
     const std::vector<Id>& advanced_search_results = advanced_search.get_search_results();
     list_content_visitor.reserve(advanced_search_results.size());
@@ -102,7 +126,8 @@ std::vector<std::string> Session::get_advanced_search_result_strings() const {
         ContentPieceVariant variant = content.get(content_piece_id);
         list_content_visitor.visit_variant(variant);
     }
-    return cleaned_results_list(list_content_visitor.get_list());
+    advanced_search_result_strings.strings = cleaned_results_list(list_content_visitor.get_list());
+    return advanced_search_result_strings.strings;
 }
 
 void Session::retrieve_last_session_values() {
@@ -208,18 +233,37 @@ Errors Session::add_content_directory(const std::filesystem::path& new_content_d
 void Session::set_fuzzy_search(const std::string& search_query, const FuzzySearchOptions& search_options) {
     DND_MEASURE_FUNCTION();
     if (search_query.size() < FUZZY_SEARCH_MINIMUM_QUERY_LENGTH) {
-        fuzzy_search_results.clear();
+        clear_fuzzy_search();
         return;
     }
-    fuzzy_search_results = fuzzy_search_content(content, search_query, search_options);
-    std::sort(
-        fuzzy_search_results.begin(), fuzzy_search_results.end(), [](const SearchResult& a, const SearchResult& b) {
-            if (a.significance == b.significance) {
-                return a.content_piece_id < b.content_piece_id;
-            }
-            return a.significance > b.significance;
-        }
-    );
+    // a longer query can only match content pieces that were candidates for the previous query
+    bool refines_last_search = fuzzy_search_query.has_value() && fuzzy_search_options == search_options
+                               && search_query.size() > fuzzy_search_query->size()
+                               && string_lowercase_copy(search_query).starts_with(fuzzy_search_query.value());
+    TopFuzzySearchResults top_results;
+    if (refines_last_search) {
+        top_results = refine_fuzzy_search_top_k(
+            fuzzy_search_index, search_query, fuzzy_search_candidates, max_search_results, worker_pool
+        );
+    } else {
+        top_results = fuzzy_search_content_top_k(
+            fuzzy_search_index, search_query, search_options, max_search_results, worker_pool
+        );
+    }
+    fuzzy_search_results = std::move(top_results.results);
+    fuzzy_search_match_count = top_results.match_count;
+    fuzzy_search_candidates = std::move(top_results.candidates);
+    fuzzy_search_query = string_lowercase_copy(search_query);
+    fuzzy_search_options = search_options;
+    ++fuzzy_search_generation;
+}
+
+void Session::clear_fuzzy_search() {
+    fuzzy_search_results.clear();
+    fuzzy_search_match_count = 0;
+    fuzzy_search_candidates.clear();
+    fuzzy_search_query = std::nullopt;
+    ++fuzzy_search_generation;
 }
 
 void Session::open_fuzzy_search_result(size_t index) {
@@ -273,19 +317,73 @@ bool Session::parsing_result_available() {
 
 void Session::start_parsing() {
     if (status != SessionStatus::PARSING) {
-        parsing_future = std::async(std::launch::async, &Session::parse_content_and_initialize, this);
-        status = SessionStatus::PARSING;
+        content_changes = ContentChanges{.files = {}, .incomplete = true};
+        start_parsing_content();
+    }
+}
+
+void Session::reparse_changed_content() {
+    if (status != SessionStatus::READY) {
+        return;
     }
+    ContentChanges changes = content_watcher.poll_changes();
+    if (changes.empty()) {
+        return;
+    }
+    content_changes = std::move(changes);
+    start_parsing_content();
+}
+
+void Session::start_parsing_content() {
+    store_open_content_pieces();
+    parsing_future = std::async(std::launch::async, &Session::parse_content_and_initialize, this);
+    status = SessionStatus::PARSING;
 }
 
 bool Session::directories_differ() const { return content_directories != parsed_content_directories; }
 
 void Session::parse_content_and_initialize() {
-    ParsingResult parsing_result = parse_content(content_directories);
+    if (content_snapshot.empty()) {
+        content_snapshot = ContentSnapshot::load(content_snapshot_filename).value_or(ContentSnapshot());
+    }
+    // the descriptions are only needed for the content pieces that are opened, so they are parsed on demand
+    if (!content_changes.incomplete) {
+        const std::set<std::filesystem::path> changed_files = content_changes.files;
+        content_snapshot.set_unchanged_except(std::move(content_changes.files));
+        if (!directories_differ()
+            && reparse_changed_files(
+                content, errors, parsed_content_directories, changed_files, &content_snapshot,
+                DescriptionParsing::LAZY, worker_pool
+            )) {
+            // the snapshot is only saved for full parses to keep the re-parsing of single files fast, the changes
+            // are saved when the session ends
+            unsaved_content_snapshot = true;
+            fuzzy_search_index = FuzzySearchIndex(content);
+            set_error_messages();
+            return;
+        }
+    }
+    ParsingResult parsing_result = parse_content(
+        content_directories, ParsingMode::PARALLEL, &content_snapshot, DescriptionParsing::LAZY, &worker_pool
+    );
+    if (content_changes.incomplete) {
+        // the watched directories might have changed
+        content_watcher.watch(parsing_result.content_paths);
+        if (!content_snapshot.save(content_snapshot_filename)) {
+            LOGWARN("Could not save the content snapshot to \"{}\"", content_snapshot_filename);
+        }
+        unsaved_content_snapshot = false;
+    } else {
+        unsaved_content_snapshot = true;
+    }
     content = std::move(parsing_result.content);
+    fuzzy_search_index = FuzzySearchIndex(content);
     errors = std::move(parsing_result.errors);
     parsed_content_directories = std::move(parsing_result.content_paths);
+    set_error_messages();
+}
 
+void Session::set_error_messages() {
     parsing_error_messages.clear();
     validation_error_messages.clear();
 
@@ -312,6 +410,26 @@ void Session::parse_content_and_initialize() {
     }
 }
 
+void Session::store_open_content_pieces() {
+    // the content is replaced by parsing, so the open content pieces are stored by key and reopened afterwards
+    if (status == SessionStatus::READY) {
+        last_session_open_tabs.clear();
+        CollectOpenTabsVisitor collect_open_tabs_visitor;
+        for (Id open_content_piece : open_content_pieces) {
+            auto variant = content.get(open_content_piece);
+            collect_open_tabs_visitor.visit_variant(variant);
+        }
+        nlohmann::json open_tabs = collect_open_tabs_visitor.get_open_tabs();
+        for (auto& [type_name, keys] : open_tabs.items()) {
+            last_session_open_tabs[type_name] = keys.get<std::vector<std::string>>();
+        }
+    }
+    open_content_pieces.clear();
+    selected_content_piece = std::nullopt;
+    clear_fuzzy_search();
+    advanced_search.clear_search_results();
+}
+
 void Session::open_last_session() {
 #define X(C, U, j, a, p, P)                                                                                            \
     for (const std::string& piece_to_open : last_session_open_tabs[#j]) {                                              \
@@ -3,6 +3,7 @@
 
 #include <dnd_config.hpp>
 
+#include <cstdint>
 #include <deque>
 #include <filesystem>
 #include <future>
@@ -15,8 +16,12 @@
 #include <core/errors/errors.hpp>
 #include <core/models/content_piece.hpp>
 #include <core/parsing/content_parsing.hpp>
+#include <core/parsing/content_snapshot.hpp>
+#include <core/parsing/content_watcher.hpp>
 #include <core/searching/advanced_search/advanced_content_search.hpp>
 #include <core/searching/fuzzy_search/fuzzy_content_search.hpp>
+#include <core/searching/fuzzy_search/fuzzy_search_index.hpp>
+#include <core/utils/worker_pool.hpp>
 
 namespace dnd {
 
@@ -27,9 +32,21 @@ enum class SessionStatus {
     UNKNOWN_ERROR,
 };
 
+/**
+ * @brief Result descriptions that were built for a certain generation of search results
+ */
+struct ResultStrings {
+    std::vector<std::string> strings;
+    // the generation of the search results the strings were built for, no results have generation 0
+    uint64_t generation = 0;
+};
+
 class Session {
 public:
-    Session(const char* last_session_filename = "last_session.ini");
+    Session(
+        const char* last_session_filename = "last_session.ini",
+        const char* content_snapshot_filename = "content_snapshot.bin"
+    );
     ~Session();
     SessionStatus get_status() const;
     Content& get_content();
@@ -52,11 +69,17 @@ public:
 
     size_t get_fuzzy_search_result_count() const;
     bool too_many_fuzzy_search_results() const;
-    std::vector<std::string> get_fuzzy_search_result_strings() const;
+    /**
+     * @return the descriptions of the fuzzy search results, which are only rebuilt after the results changed
+     */
+    const std::vector<std::string>& get_fuzzy_search_result_strings();
     void set_fuzzy_search(const std::string& search_query, const FuzzySearchOptions& search_options);
     void open_fuzzy_search_result(size_t index);
 
-    std::vector<std::string> get_advanced_search_result_strings() const;
+    /**
+     * @return the descriptions of the advanced search results, which are only rebuilt after the results changed
+     */
+    const std::vector<std::string>& get_advanced_search_result_strings();
     void open_advanced_search_result(size_t index);
     void start_advanced_search();
     bool advanced_search_results_available();
@@ -66,33 +89,69 @@ public:
     bool parsing_result_available();
 
     void start_parsing();
+    /**
+     * @brief Starts re-parsing the content in the background if any content files changed since the last parsing.
+     *
+     * Only the changed files and the files depending on them are parsed again, and their content pieces are replaced
+     * in place. The whole content is only parsed again if the changes are incomplete or if content pieces were added
+     * to or removed from the changed files.
+     */
+    void reparse_changed_content();
     bool directories_differ() const;
 private:
+    void start_parsing_content();
     void parse_content_and_initialize();
+    void set_error_messages();
+    void store_open_content_pieces();
     void open_last_session();
     void open_content_piece(Id content_piece);
+    void clear_fuzzy_search();
 
     static constexpr int max_search_results = 1000;
 
     const char* const last_session_filename;
+    // a cache of the parsed content files, which makes re-parsing unchanged content directories faster
+    const char* const content_snapshot_filename;
 
     SessionStatus status;
 
     std::set<std::filesystem::path> content_directories;
 
+    // the workers are kept for the whole session, so re-parsing the content does not start new threads every time,
+    // and they are declared before the parsing that uses them so that they outlive it
+    WorkerPool worker_pool;
     std::future<void> parsing_future;
     Errors errors;
     // the object holding all selected DnD content
     Content content;
     std::set<std::filesystem::path> parsed_content_directories;
+    ContentSnapshot content_snapshot;
+    bool unsaved_content_snapshot;
+    ContentWatcher content_watcher;
+    // the changes to the content files the current parsing was started for
+    ContentChanges content_changes;
 
     std::unordered_map<std::string, std::vector<std::string>> last_session_open_tabs;
     std::deque<Id> open_content_pieces;
     Opt<Id> selected_content_piece;
 
+    // the names of the content prepared for the fuzzy search, rebuilt whenever the content is parsed
+    FuzzySearchIndex fuzzy_search_index;
+    // the best fuzzy search results, at most max_search_results of them
     std::vector<SearchResult> fuzzy_search_results;
+    // the number of all content pieces matching the fuzzy search
+    size_t fuzzy_search_match_count;
+    // the content pieces that can match a query extending the last query
+    std::vector<Id> fuzzy_search_candidates;
+    // the lowercase query and the options of the last fuzzy search, or std::nullopt if there is none
+    Opt<std::string> fuzzy_search_query;
+    FuzzySearchOptions fuzzy_search_options;
+    // changes whenever the fuzzy search results change
+    uint64_t fuzzy_search_generation;
+    ResultStrings fuzzy_search_result_strings;
 
     AdvancedContentSearch advanced_search;
+    ResultStrings advanced_search_result_strings;
 
     std::vector<std::string> unknown_error_messages;
     std::vector<std::string> parsing_error_messages;
@@ -4,8 +4,10 @@
 #include <dnd_config.hpp>
 
 #include <algorithm>
+#include <filesystem>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -16,6 +18,7 @@
 #include <core/errors/errors.hpp>
 #include <core/models/content_piece.hpp>
 #include <core/types.hpp>
+#include <core/utils/string_hash.hpp>
 #include <core/utils/string_manipulation.hpp>
 
 namespace dnd {
@@ -28,25 +31,63 @@ template <typename T>
 requires isContentPieceType<T>
 class StorageContentLibrary : public ContentLibrary<T> {
 public:
-    std::optional<size_t> find(const std::string& key) const;
-    bool contains(const std::string& key) const override;
+    /**
+     * @brief Find the index of the content piece with the given key
+     * @param key the key of the content piece
+     * @return the index of the content piece, or std::nullopt if no content piece with that key exists
+     */
+    std::optional<size_t> find(std::string_view key) const;
+    bool contains(std::string_view key) const override;
     bool empty() const override;
     size_t size() const override;
     Opt<CRef<T>> get(size_t index) const override;
-    Opt<CRef<T>> get(const std::string& key) const override;
+    Opt<CRef<T>> get(std::string_view key) const override;
+    /**
+     * @brief Get a content piece to modify it, which must not change its key
+     * @param index the index of the content piece
+     * @return the content piece, or std::nullopt if the index is out of range
+     */
+    Opt<Ref<T>> get_mut(size_t index);
     const std::vector<T>& get_all() const;
     const std::vector<std::pair<typename T::Data, Errors>>& get_drafts() const;
     /**
-     * @brief Add a content piece to a content piece to the library
+     * @brief Add a content piece to a content piece to the library, a content piece with the key of a detached content
+     * piece replaces it at its index
      * @param content_piece the content piece to add
      * @return reference to the inserted content piece, or std::nullopt if a content piece with that key already exists
      */
     std::optional<size_t> add(T&& content_piece);
     void add_draft(std::pair<typename T::Data, Errors>&& draft);
     void add_draft(typename T::Data&& draft_data, Errors&& draft_errors);
+    /**
+     * @brief Detaches a content piece from its key until a content piece with the same key is added, which then
+     * replaces it at the same index, so that the IDs of the content pieces and references to them stay valid
+     * @param index the index of the content piece
+     */
+    void detach(size_t index);
+    /**
+     * @brief Find the index of the detached content piece with the given key
+     * @param key the key of the detached content piece
+     * @return the index of the detached content piece, or std::nullopt if no content piece with that key is detached
+     */
+    std::optional<size_t> find_detached(std::string_view key) const;
+    /**
+     * @brief Returns whether there are detached content pieces that were not replaced
+     * @return true if a content piece is still detached, false otherwise
+     */
+    bool has_detached() const;
+    /**
+     * @brief Removes the drafts of the content pieces from a certain file
+     * @param source_path the file the drafts were parsed from
+     */
+    void remove_drafts(const std::filesystem::path& source_path);
 private:
     std::vector<T> data;
     std::vector<std::pair<typename T::Data, Errors>> drafts;
+    // maps the key of each content piece to its index in data (the first one, if a key occurs more than once)
+    StringMap<size_t> key_index;
+    // maps the keys of the detached content pieces to their index in data
+    StringMap<size_t> detached_key_index;
 };
 
 
@@ -54,19 +95,18 @@ private:
 
 template <typename T>
 requires isContentPieceType<T>
-inline std::optional<size_t> StorageContentLibrary<T>::find(const std::string& key) const {
-    for (size_t i = 0; i < data.size(); ++i) {
-        if (data[i].get_key() == key) {
-            return i;
-        }
+inline std::optional<size_t> StorageContentLibrary<T>::find(std::string_view key) const {
+    auto it = key_index.find(key);
+    if (it == key_index.end()) {
+        return std::nullopt;
     }
-    return std::nullopt;
+    return it->second;
 }
 
 
 template <typename T>
 requires isContentPieceType<T>
-bool StorageContentLibrary<T>::contains(const std::string& key) const {
+bool StorageContentLibrary<T>::contains(std::string_view key) const {
     return find(key).has_value();
 }
 
@@ -93,7 +133,7 @@ Opt<CRef<T>> StorageContentLibrary<T>::get(size_t index) const {
 
 template <typename T>
 requires isContentPieceType<T>
-Opt<CRef<T>> StorageContentLibrary<T>::get(const std::string& key) const {
+Opt<CRef<T>> StorageContentLibrary<T>::get(std::string_view key) const {
     std::optional<size_t> idx = find(key);
     if (!idx.has_value()) {
         return std::nullopt;
@@ -101,6 +141,15 @@ Opt<CRef<T>> StorageContentLibrary<T>::get(const std::string& key) const {
     return data[idx.value()];
 }
 
+template <typename T>
+requires isContentPieceType<T>
+Opt<Ref<T>> StorageContentLibrary<T>::get_mut(size_t index) {
+    if (index >= data.size()) {
+        return std::nullopt;
+    }
+    return std::ref(data[index]);
+}
+
 template <typename T>
 requires isContentPieceType<T>
 const std::vector<T>& StorageContentLibrary<T>::get_all() const {
@@ -116,13 +165,29 @@ const std::vector<std::pair<typename T::Data, Errors>>& StorageContentLibrary<T>
 template <typename T>
 requires isContentPieceType<T>
 std::optional<size_t> StorageContentLibrary<T>::add(T&& content_piece) {
+    auto detached_it = detached_key_index.find(content_piece.get_key());
+    if (detached_it != detached_key_index.end()) {
+        size_t index = detached_it->second;
+        data[index] = std::move(content_piece);
+        key_index.try_emplace(data[index].get_key(), index);
+        detached_key_index.erase(detached_it);
+        return index;
+    }
     try {
         data.emplace_back(std::move(content_piece));
     } catch (const std::exception& e) {
         DND_UNUSED(e);
         return std::nullopt;
     }
-    return data.size() - 1;
+    size_t index = data.size() - 1;
+    try {
+        key_index.try_emplace(data.back().get_key(), index);
+    } catch (const std::exception& e) {
+        DND_UNUSED(e);
+        data.pop_back();
+        return std::nullopt;
+    }
+    return index;
 }
 
 template <typename T>
@@ -137,6 +202,41 @@ void StorageContentLibrary<T>::add_draft(typename T::Data&& draft_data, Errors&&
     drafts.emplace_back(std::move(draft_data), std::move(draft_errors));
 }
 
+template <typename T>
+requires isContentPieceType<T>
+void StorageContentLibrary<T>::detach(size_t index) {
+    auto it = key_index.find(data[index].get_key());
+    if (it == key_index.end() || it->second != index) {
+        return;
+    }
+    detached_key_index.try_emplace(data[index].get_key(), index);
+    key_index.erase(it);
+}
+
+template <typename T>
+requires isContentPieceType<T>
+std::optional<size_t> StorageContentLibrary<T>::find_detached(std::string_view key) const {
+    auto it = detached_key_index.find(key);
+    if (it == detached_key_index.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+template <typename T>
+requires isContentPieceType<T>
+bool StorageContentLibrary<T>::has_detached() const {
+    return !detached_key_index.empty();
+}
+
+template <typename T>
+requires isContentPieceType<T>
+void StorageContentLibrary<T>::remove_drafts(const std::filesystem::path& source_path) {
+    std::erase_if(drafts, [&source_path](const std::pair<typename T::Data, Errors>& draft) {
+        return draft.first.source_path == source_path;
+    });
+}
+
 } // namespace dnd
 
 #endif // STORAGE_CONTENT_LIBRARY_HPP_
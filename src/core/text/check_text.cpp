@@ -1,9 +1,18 @@
 #include "check_text.hpp"
 
+#include <bit>
 #include <cassert>
+#include <cstddef>
 #include <cstdint>
 #include <optional>
+#include <memory_resource>
 #include <string>
+#include <string_view>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
 
 #include <log.hpp>
 
@@ -71,21 +80,57 @@ static constexpr uint32_t bytes_to_utf8_code(uint32_t concat_bytes) {
 }
 #endif
 
-static void push_back_bytes(std::string& str, const char* bytes, size_t byte_count) {
-    for (size_t i = 0; i < byte_count; ++i) {
-        str.push_back(bytes[i]);
+static constexpr bool is_printable_ascii(char c) { return c >= 0x20 && c < 0x7f; }
+
+/**
+ * @brief Finds the length of the run of printable ASCII characters at the start of a string, which are kept as they
+ * are and can therefore be validated and copied in blocks
+ */
+static size_t printable_ascii_run_length(const char* begin, const char* end) {
+    const char* cur = begin;
+    // the comparisons are signed, so that all bytes with the high bit set are below the lower bound
+#if defined(__SSE2__)
+    const __m128i lower_bound = _mm_set1_epi8(0x1f);
+    const __m128i upper_bound = _mm_set1_epi8(0x7f);
+    while (end - cur >= 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cur));
+        __m128i printable = _mm_and_si128(_mm_cmpgt_epi8(block, lower_bound), _mm_cmplt_epi8(block, upper_bound));
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(printable));
+        if (mask != 0xff'ff) {
+            return static_cast<size_t>(cur - begin) + static_cast<size_t>(std::countr_one(mask));
+        }
+        cur += 16;
+    }
+#endif
+    while (cur != end && is_printable_ascii(*cur)) {
+        ++cur;
     }
+    return static_cast<size_t>(cur - begin);
 }
 
-std::string checked_string(std::string&& str) {
-    std::string out;
-
+/**
+ * @brief Appends the checked characters of a string, which starts with a run of printable ASCII characters
+ * @param str the string to check
+ * @param run_length the length of that run
+ * @param out the string to append to
+ */
+template <typename String>
+static void append_checked_characters(std::string_view str, size_t run_length, String& out) {
+    const char* cur = str.data();
+    const char* end = cur + str.size();
     std::optional<char> prev = std::nullopt;
-    std::string::iterator cur = str.begin();
-    std::string::iterator end = str.end();
 
     char utf8_bytes[5];
     while (cur != end) {
+        if (run_length > 0) {
+            out.append(cur, run_length);
+            cur += run_length;
+            prev = *(cur - 1);
+            if (cur == end) {
+                break;
+            }
+        }
+
         unsigned char first_byte = utf8_bytes[0] = *cur;
         bool valid_code_point = true;
         size_t expected_byte_count;
@@ -122,9 +167,8 @@ std::string checked_string(std::string&& str) {
             concat_bytes = (concat_bytes << 8) | new_byte;
         }
 
-        if (byte_count == 1 && std::isprint(first_byte)) {
-            out.push_back(first_byte);
-        } else if (valid_code_point) {
+        // the printable ASCII characters were already copied as part of a run
+        if (valid_code_point) {
             switch (concat_bytes) {
                 case utf8_code_to_bytes(0xbd): // 1/2
                 {
@@ -156,7 +200,7 @@ std::string checked_string(std::string&& str) {
                 case utf8_code_to_bytes(0xfc): // u umlaut
                 case utf8_code_to_bytes(0xfb): // u with ^
                 {
-                    push_back_bytes(out, utf8_bytes, byte_count);
+                    out.append(utf8_bytes, byte_count);
                     break;
                 }
                 default: {
@@ -165,20 +209,42 @@ std::string checked_string(std::string&& str) {
                         "Unknown or unhandled UTF-8 code point: '{}' ({:#x})\n  in '{}'", &utf8_bytes[0],
                         bytes_to_utf8_code(concat_bytes), str
                     );
-                    push_back_bytes(out, utf8_bytes, byte_count);
+                    out.append(utf8_bytes, byte_count);
                     break;
                 }
             }
         } else {
-            push_back_bytes(out, utf8_bytes, byte_count);
+            out.append(utf8_bytes, byte_count);
         }
 
         if (cur != end) {
             prev = *cur;
             ++cur;
+            run_length = printable_ascii_run_length(cur, end);
         }
     }
+}
+
+std::string checked_string(std::string&& str) {
+    size_t run_length = printable_ascii_run_length(str.data(), str.data() + str.size());
+    if (run_length == str.size()) {
+        // most of the text is plain ASCII, which needs neither changes nor a copy
+        return std::move(str);
+    }
+
+    std::string out;
+    out.reserve(str.size());
+    append_checked_characters(str, run_length, out);
     return out;
 }
 
+void append_checked_string(std::string_view str, std::pmr::string& out) {
+    size_t run_length = printable_ascii_run_length(str.data(), str.data() + str.size());
+    if (run_length == str.size()) {
+        out.append(str);
+        return;
+    }
+    append_checked_characters(str, run_length, out);
+}
+
 } // namespace dnd
@@ -1,16 +1,27 @@
 #ifndef CHECK_TEXT_HPP_
 #define CHECK_TEXT_HPP_
 
+#include <memory_resource>
 #include <string>
+#include <string_view>
 
 namespace dnd {
 
 std::string checked_string(std::string&& str);
 
+/**
+ * @brief Appends the checked version of a string, as returned by checked_string, without an intermediate copy
+ * @param str the string to check
+ * @param out the string to append to
+ */
+void append_checked_string(std::string_view str, std::pmr::string& out);
+
 inline std::string checked_string(std::string::const_iterator start, std::string::const_iterator end) {
     return checked_string(std::string(start, end));
 }
 
+inline std::string checked_string(std::string_view str) { return checked_string(std::string(str)); }
+
 } // namespace dnd
 
 #endif // CHECK_TEXT_HPP_
@@ -0,0 +1,60 @@
+#include <dnd_config.hpp>
+
+#include "formatted_text.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
+#include <string_view>
+
+#include <core/utils/arena.hpp>
+
+namespace dnd {
+
+FormattedText::FormattedText() : FormattedText(get_model_resource()) {}
+
+FormattedText::FormattedText(std::pmr::memory_resource* resource)
+    : characters(resource), nodes(resource), attributes(resource) {}
+
+FormattedText FormattedText::simple(std::string_view str) {
+    FormattedText text;
+    uint32_t paragraph_index = text.begin_node(FormattedTextNodeType::PARAGRAPH);
+    text.end_node(text.begin_node(FormattedTextNodeType::SIMPLE_TEXT, str));
+    text.end_node(paragraph_index);
+    return text;
+}
+
+FormattedText::Span FormattedText::add_characters(std::string_view str) {
+    assert(characters.size() + str.size() < std::numeric_limits<uint32_t>::max());
+    Span span{.begin = static_cast<uint32_t>(characters.size()), .size = static_cast<uint32_t>(str.size())};
+    characters.append(str);
+    characters.push_back('\0');
+    return span;
+}
+
+uint32_t FormattedText::begin_node(FormattedTextNodeType type, std::string_view str, bool bold, bool italic) {
+    return begin_node(type, add_characters(str), bold, italic);
+}
+
+uint32_t FormattedText::begin_node(FormattedTextNodeType type, Span text_span, bool bold, bool italic) {
+    assert(nodes.size() < std::numeric_limits<uint32_t>::max());
+    uint32_t node_index = static_cast<uint32_t>(nodes.size());
+    nodes.push_back(Node{
+        .text = text_span,
+        .subtree_end = node_index + 1,
+        .first_attribute = 0,
+        .attribute_count = 0,
+        .number = 0,
+        .type = type,
+        .bold = bold,
+        .italic = italic,
+    });
+    return node_index;
+}
+
+void FormattedText::end_node(uint32_t node_index) {
+    nodes[node_index].subtree_end = static_cast<uint32_t>(nodes.size());
+}
+
+} // namespace dnd
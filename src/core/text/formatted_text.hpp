@@ -3,9 +3,360 @@
 
 #include <dnd_config.hpp>
 
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
 namespace dnd {
 
-class FormattedText {};
+class FormattedText;
+
+enum class FormattedTextNodeType : uint8_t {
+    // children: SIMPLE_TEXT and LINK
+    PARAGRAPH,
+    // children: PARAGRAPH (the text above and below the items) and LIST_ITEM
+    LIST,
+    // children: PARAGRAPH and TABLE
+    LIST_ITEM,
+    // text: the caption, children: one TABLE_COLUMN per column followed by the TABLE_ROWs
+    TABLE,
+    // text: the column header
+    TABLE_COLUMN,
+    // children: one PARAGRAPH per cell
+    TABLE_ROW,
+    SIMPLE_TEXT,
+    // text: the link text, has attributes
+    LINK,
+};
+
+struct FormattedTextAttribute {
+    std::optional<std::string_view> key;
+    std::string_view value;
+};
+
+/**
+ * @brief A lightweight view of one node of a FormattedText, only valid as long as the text is alive.
+ */
+class FormattedTextNode {
+public:
+    class Range;
+    class AttributeRange;
+
+    FormattedTextNodeType get_type() const;
+    std::string_view get_text() const;
+    /**
+     * @brief Returns the text as a null-terminated string, e.g. for C APIs
+     */
+    const char* get_c_str() const;
+    bool is_bold() const;
+    bool is_italic() const;
+    Range get_children() const;
+    AttributeRange get_attributes() const;
+    /**
+     * @brief Returns the number of columns of a TABLE node
+     */
+    size_t get_column_count() const;
+    /**
+     * @brief Returns the width of a TABLE_COLUMN node, if it has one
+     */
+    std::optional<int> get_column_width() const;
+private:
+    friend class FormattedText;
+    friend class FormattedTextNodeIterator;
+    friend class FormattedTextWriter;
+
+    FormattedTextNode(const FormattedText& text, uint32_t index) noexcept;
+
+    const FormattedText* text;
+    uint32_t index;
+};
+
+/**
+ * @brief A forward iterator over sibling nodes, or over all nodes in document order
+ */
+class FormattedTextNodeIterator {
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = FormattedTextNode;
+    using difference_type = std::ptrdiff_t;
+
+    FormattedTextNodeIterator() noexcept = default;
+    FormattedTextNodeIterator(const FormattedText& text, uint32_t index, bool skip_children) noexcept;
+
+    FormattedTextNode operator*() const;
+    FormattedTextNodeIterator& operator++();
+    FormattedTextNodeIterator operator++(int);
+    bool operator==(const FormattedTextNodeIterator& other) const noexcept;
+private:
+    const FormattedText* text = nullptr;
+    uint32_t index = 0;
+    bool skip_children = true;
+};
+
+class FormattedTextNode::Range {
+public:
+    Range(FormattedTextNodeIterator begin, FormattedTextNodeIterator end) noexcept;
+    FormattedTextNodeIterator begin() const noexcept;
+    FormattedTextNodeIterator end() const noexcept;
+    bool empty() const noexcept;
+private:
+    FormattedTextNodeIterator first;
+    FormattedTextNodeIterator last;
+};
+
+class FormattedTextNode::AttributeRange {
+public:
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = FormattedTextAttribute;
+        using difference_type = std::ptrdiff_t;
+
+        Iterator() noexcept = default;
+        Iterator(const FormattedText& text, uint32_t index) noexcept;
+
+        FormattedTextAttribute operator*() const;
+        Iterator& operator++();
+        Iterator operator++(int);
+        bool operator==(const Iterator& other) const noexcept;
+    private:
+        const FormattedText* text = nullptr;
+        uint32_t index = 0;
+    };
+
+    AttributeRange(Iterator begin, Iterator end) noexcept;
+    Iterator begin() const noexcept;
+    Iterator end() const noexcept;
+    bool empty() const noexcept;
+private:
+    Iterator first;
+    Iterator last;
+};
+
+/**
+ * @brief A flat, contiguous representation of a formatted text, which is written by a FormattedTextWriter.
+ *
+ * All strings are stored in one character buffer and the structure is stored as an array of nodes in document order,
+ * where every node knows where its subtree ends. Walking the text through the node views does not allocate.
+ * Every string in the buffer is followed by a null character, so that it can be passed on without copying it.
+ * The strings and the attributes are stored in the order of their nodes.
+ *
+ * The buffers are allocated from the model resource of the thread creating the text, see get_model_resource, and keep
+ * it when the text is moved. A copy allocates from the default resource.
+ */
+class FormattedText {
+public:
+    FormattedText();
+    /**
+     * @brief Creates an empty text whose buffers allocate from the given resource
+     * @param resource the memory resource, which needs to outlive the text
+     */
+    explicit FormattedText(std::pmr::memory_resource* resource);
+    static FormattedText simple(std::string_view str);
+
+    std::strong_ordering operator<=>(const FormattedText&) const = default;
+
+    bool empty() const noexcept;
+    /**
+     * @brief Returns the top-level nodes i.e. the paragraphs, lists, and tables
+     */
+    FormattedTextNode::Range get_parts() const;
+    /**
+     * @brief Returns all nodes in document order e.g. for searching through the whole text
+     */
+    FormattedTextNode::Range get_all_nodes() const;
+    size_t node_count() const noexcept;
+private:
+    friend class FormattedTextNode;
+    friend class FormattedTextNodeIterator;
+    friend class FormattedTextNode::AttributeRange::Iterator;
+    friend class FormattedTextWriter;
+
+    struct Span {
+        std::strong_ordering operator<=>(const Span&) const = default;
+
+        uint32_t begin = 0;
+        uint32_t size = 0;
+    };
+
+    struct Node {
+        std::strong_ordering operator<=>(const Node&) const = default;
+
+        Span text;
+        // the index one past the last node of the subtree of this node
+        uint32_t subtree_end = 0;
+        uint32_t first_attribute = 0;
+        uint32_t attribute_count = 0;
+        // TABLE: the column count, TABLE_COLUMN: the column width or no_column_width
+        int32_t number = 0;
+        FormattedTextNodeType type = FormattedTextNodeType::PARAGRAPH;
+        bool bold = false;
+        bool italic = false;
+    };
+
+    struct Attribute {
+        std::strong_ordering operator<=>(const Attribute&) const = default;
+
+        std::optional<Span> key;
+        Span value;
+    };
+
+    static constexpr int32_t no_column_width = -1;
+
+    std::string_view view(Span span) const noexcept;
+    Span add_characters(std::string_view str);
+    uint32_t begin_node(FormattedTextNodeType type, std::string_view str = {}, bool bold = false, bool italic = false);
+    uint32_t begin_node(FormattedTextNodeType type, Span text_span, bool bold, bool italic);
+    void end_node(uint32_t node_index);
+
+    std::pmr::string characters;
+    std::pmr::vector<Node> nodes;
+    std::pmr::vector<Attribute> attributes;
+};
+
+
+// === IMPLEMENTATION ===
+
+inline FormattedTextNode::FormattedTextNode(const FormattedText& text, uint32_t index) noexcept
+    : text(&text), index(index) {}
+
+inline FormattedTextNodeType FormattedTextNode::get_type() const { return text->nodes[index].type; }
+
+inline std::string_view FormattedTextNode::get_text() const { return text->view(text->nodes[index].text); }
+
+inline const char* FormattedTextNode::get_c_str() const {
+    return text->characters.c_str() + text->nodes[index].text.begin;
+}
+
+inline bool FormattedTextNode::is_bold() const { return text->nodes[index].bold; }
+
+inline bool FormattedTextNode::is_italic() const { return text->nodes[index].italic; }
+
+inline FormattedTextNode::Range FormattedTextNode::get_children() const {
+    return Range(
+        FormattedTextNodeIterator(*text, index + 1, true),
+        FormattedTextNodeIterator(*text, text->nodes[index].subtree_end, true)
+    );
+}
+
+inline FormattedTextNode::AttributeRange FormattedTextNode::get_attributes() const {
+    const FormattedText::Node& node = text->nodes[index];
+    return AttributeRange(
+        AttributeRange::Iterator(*text, node.first_attribute),
+        AttributeRange::Iterator(*text, node.first_attribute + node.attribute_count)
+    );
+}
+
+inline size_t FormattedTextNode::get_column_count() const {
+    return static_cast<size_t>(text->nodes[index].number);
+}
+
+inline std::optional<int> FormattedTextNode::get_column_width() const {
+    int32_t width = text->nodes[index].number;
+    if (width == FormattedText::no_column_width) {
+        return std::nullopt;
+    }
+    return width;
+}
+
+inline FormattedTextNodeIterator::FormattedTextNodeIterator(
+    const FormattedText& text, uint32_t index, bool skip_children
+) noexcept
+    : text(&text), index(index), skip_children(skip_children) {}
+
+inline FormattedTextNode FormattedTextNodeIterator::operator*() const { return FormattedTextNode(*text, index); }
+
+inline FormattedTextNodeIterator& FormattedTextNodeIterator::operator++() {
+    index = skip_children ? text->nodes[index].subtree_end : index + 1;
+    return *this;
+}
+
+inline FormattedTextNodeIterator FormattedTextNodeIterator::operator++(int) {
+    FormattedTextNodeIterator previous = *this;
+    ++*this;
+    return previous;
+}
+
+inline bool FormattedTextNodeIterator::operator==(const FormattedTextNodeIterator& other) const noexcept {
+    return index == other.index;
+}
+
+inline FormattedTextNode::Range::Range(FormattedTextNodeIterator begin, FormattedTextNodeIterator end) noexcept
+    : first(begin), last(end) {}
+
+inline FormattedTextNodeIterator FormattedTextNode::Range::begin() const noexcept { return first; }
+
+inline FormattedTextNodeIterator FormattedTextNode::Range::end() const noexcept { return last; }
+
+inline bool FormattedTextNode::Range::empty() const noexcept { return first == last; }
+
+inline FormattedTextNode::AttributeRange::Iterator::Iterator(const FormattedText& text, uint32_t index) noexcept
+    : text(&text), index(index) {}
+
+inline FormattedTextAttribute FormattedTextNode::AttributeRange::Iterator::operator*() const {
+    const FormattedText::Attribute& attribute = text->attributes[index];
+    FormattedTextAttribute result{.key = std::nullopt, .value = text->view(attribute.value)};
+    if (attribute.key.has_value()) {
+        result.key = text->view(attribute.key.value());
+    }
+    return result;
+}
+
+inline FormattedTextNode::AttributeRange::Iterator& FormattedTextNode::AttributeRange::Iterator::operator++() {
+    ++index;
+    return *this;
+}
+
+inline FormattedTextNode::AttributeRange::Iterator FormattedTextNode::AttributeRange::Iterator::operator++(int) {
+    Iterator previous = *this;
+    ++index;
+    return previous;
+}
+
+inline bool FormattedTextNode::AttributeRange::Iterator::operator==(const Iterator& other) const noexcept {
+    return index == other.index;
+}
+
+inline FormattedTextNode::AttributeRange::AttributeRange(Iterator begin, Iterator end) noexcept
+    : first(begin), last(end) {}
+
+inline FormattedTextNode::AttributeRange::Iterator FormattedTextNode::AttributeRange::begin() const noexcept {
+    return first;
+}
+
+inline FormattedTextNode::AttributeRange::Iterator FormattedTextNode::AttributeRange::end() const noexcept {
+    return last;
+}
+
+inline bool FormattedTextNode::AttributeRange::empty() const noexcept { return first == last; }
+
+inline bool FormattedText::empty() const noexcept { return nodes.empty(); }
+
+inline FormattedTextNode::Range FormattedText::get_parts() const {
+    return FormattedTextNode::Range(
+        FormattedTextNodeIterator(*this, 0, true),
+        FormattedTextNodeIterator(*this, static_cast<uint32_t>(nodes.size()), true)
+    );
+}
+
+inline FormattedTextNode::Range FormattedText::get_all_nodes() const {
+    return FormattedTextNode::Range(
+        FormattedTextNodeIterator(*this, 0, false),
+        FormattedTextNodeIterator(*this, static_cast<uint32_t>(nodes.size()), false)
+    );
+}
+
+inline size_t FormattedText::node_count() const noexcept { return nodes.size(); }
+
+inline std::string_view FormattedText::view(Span span) const noexcept {
+    return std::string_view(characters).substr(span.begin, span.size);
+}
 
 } // namespace dnd
 
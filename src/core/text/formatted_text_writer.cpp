@@ -0,0 +1,216 @@
+#include <dnd_config.hpp>
+
+#include "formatted_text_writer.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include <core/text/check_text.hpp>
+#include <core/text/formatted_text.hpp>
+#include <core/text/rich_text.hpp>
+
+namespace dnd {
+
+FormattedTextWriter::FormattedTextWriter(FormattedText& text) noexcept : text(text) {}
+
+FormattedTextWriter::Mark FormattedTextWriter::mark() const noexcept {
+    return Mark{
+        .node_count = static_cast<uint32_t>(text.nodes.size()),
+        .character_count = static_cast<uint32_t>(text.characters.size()),
+        .attribute_count = static_cast<uint32_t>(text.attributes.size()),
+    };
+}
+
+FormattedTextWriter::Mark FormattedTextWriter::mark_before(uint32_t node_index) const noexcept {
+    if (node_index == text.nodes.size()) {
+        return mark();
+    }
+    // the strings and attributes are stored in the order of their nodes
+    uint32_t attribute_count = static_cast<uint32_t>(text.attributes.size());
+    for (uint32_t i = node_index; i < text.nodes.size(); ++i) {
+        if (text.nodes[i].attribute_count > 0) {
+            attribute_count = text.nodes[i].first_attribute;
+            break;
+        }
+    }
+    return Mark{
+        .node_count = node_index,
+        .character_count = text.nodes[node_index].text.begin,
+        .attribute_count = attribute_count,
+    };
+}
+
+void FormattedTextWriter::reset_to(const Mark& mark) {
+    text.nodes.resize(mark.node_count);
+    text.characters.resize(mark.character_count);
+    text.attributes.resize(mark.attribute_count);
+}
+
+uint32_t FormattedTextWriter::node_count() const noexcept { return static_cast<uint32_t>(text.nodes.size()); }
+
+FormattedTextNode FormattedTextWriter::get_node(uint32_t node_index) const {
+    return FormattedTextNode(text, node_index);
+}
+
+bool FormattedTextWriter::has_children(uint32_t node_index) const {
+    return text.nodes[node_index].subtree_end > node_index + 1;
+}
+
+std::optional<uint32_t> FormattedTextWriter::get_last_part() const {
+    std::optional<uint32_t> last_part;
+    for (uint32_t i = 0; i < text.nodes.size(); i = text.nodes[i].subtree_end) {
+        last_part = i;
+    }
+    return last_part;
+}
+
+std::optional<uint32_t> FormattedTextWriter::get_last_child(uint32_t node_index) const {
+    std::optional<uint32_t> last_child;
+    for (uint32_t i = node_index + 1; i < text.nodes[node_index].subtree_end; i = text.nodes[i].subtree_end) {
+        last_child = i;
+    }
+    return last_child;
+}
+
+uint32_t FormattedTextWriter::begin_node(FormattedTextNodeType type, std::string_view str, bool bold, bool italic) {
+    return text.begin_node(type, str, bold, italic);
+}
+
+void FormattedTextWriter::end_node(uint32_t node_index) { text.end_node(node_index); }
+
+void FormattedTextWriter::add_simple_text(std::string_view str, bool bold, bool italic, std::string_view suffix) {
+    uint32_t node_index = text.begin_node(
+        FormattedTextNodeType::SIMPLE_TEXT, add_checked_characters(str, suffix), bold, italic
+    );
+    text.end_node(node_index);
+}
+
+void FormattedTextWriter::add_link(
+    std::string_view str, bool bold, bool italic, const std::vector<RichAttributeView>& attributes
+) {
+    uint32_t link_index = text.begin_node(FormattedTextNodeType::LINK, add_checked_characters(str), bold, italic);
+    for (const RichAttributeView& rich_attribute : attributes) {
+        std::optional<FormattedText::Span> key;
+        if (rich_attribute.key.has_value()) {
+            key = add_checked_characters(rich_attribute.key.value());
+        }
+        add_attribute_spans(key, add_checked_characters(rich_attribute.value));
+    }
+    text.end_node(link_index);
+}
+
+void FormattedTextWriter::add_attribute(std::optional<std::string_view> key, std::string_view value) {
+    std::optional<FormattedText::Span> key_span;
+    if (key.has_value()) {
+        key_span = text.add_characters(key.value());
+    }
+    add_attribute_spans(key_span, text.add_characters(value));
+}
+
+void FormattedTextWriter::set_column_count(uint32_t table_index, size_t column_count) {
+    text.nodes[table_index].number = static_cast<int32_t>(column_count);
+}
+
+void FormattedTextWriter::set_column_width(uint32_t column_index, std::optional<int> width) {
+    text.nodes[column_index].number = width.value_or(FormattedText::no_column_width);
+}
+
+uint32_t FormattedTextWriter::wrap_nodes_from(uint32_t node_index, FormattedTextNodeType type) {
+    assert(node_index <= text.nodes.size());
+    // the empty string of the new node is inserted in front of the strings of the nodes it contains
+    uint32_t character_index = mark_before(node_index).character_count;
+    text.characters.insert(character_index, 1, '\0');
+    for (FormattedText::Node& node : text.nodes) {
+        if (node.text.begin >= character_index) {
+            ++node.text.begin;
+        }
+        if (node.subtree_end > node_index) {
+            ++node.subtree_end;
+        }
+    }
+    for (FormattedText::Attribute& attribute : text.attributes) {
+        if (attribute.key.has_value() && attribute.key->begin >= character_index) {
+            ++attribute.key->begin;
+        }
+        if (attribute.value.begin >= character_index) {
+            ++attribute.value.begin;
+        }
+    }
+    text.nodes.insert(
+        text.nodes.begin() + node_index,
+        FormattedText::Node{
+            .text = FormattedText::Span{.begin = character_index, .size = 0},
+            .subtree_end = static_cast<uint32_t>(text.nodes.size()) + 1,
+            .first_attribute = 0,
+            .attribute_count = 0,
+            .number = 0,
+            .type = type,
+            .bold = false,
+            .italic = false,
+        }
+    );
+    return node_index;
+}
+
+void FormattedTextWriter::erase_nodes(uint32_t begin_index, uint32_t end_index) {
+    assert(begin_index <= end_index && end_index <= text.nodes.size());
+    Mark first = mark_before(begin_index);
+    Mark last = mark_before(end_index);
+    uint32_t removed_characters = last.character_count - first.character_count;
+    uint32_t removed_attributes = last.attribute_count - first.attribute_count;
+
+    text.characters.erase(first.character_count, removed_characters);
+    text.attributes.erase(
+        text.attributes.begin() + first.attribute_count, text.attributes.begin() + last.attribute_count
+    );
+    text.nodes.erase(text.nodes.begin() + begin_index, text.nodes.begin() + end_index);
+    for (FormattedText::Node& node : text.nodes) {
+        if (node.text.begin >= last.character_count) {
+            node.text.begin -= removed_characters;
+        }
+        if (node.first_attribute >= last.attribute_count) {
+            node.first_attribute -= removed_attributes;
+        }
+        // the subtrees that contained removed nodes shrink by the number of them
+        if (node.subtree_end > begin_index) {
+            node.subtree_end -= std::min(node.subtree_end, end_index) - begin_index;
+        }
+    }
+    for (FormattedText::Attribute& attribute : text.attributes) {
+        if (attribute.key.has_value() && attribute.key->begin >= last.character_count) {
+            attribute.key->begin -= removed_characters;
+        }
+        if (attribute.value.begin >= last.character_count) {
+            attribute.value.begin -= removed_characters;
+        }
+    }
+}
+
+void FormattedTextWriter::add_attribute_spans(std::optional<FormattedText::Span> key, FormattedText::Span value) {
+    assert(!text.nodes.empty());
+    // nodes without attributes keep the first attribute at 0, so that equal texts have equal nodes
+    FormattedText::Node& node = text.nodes.back();
+    if (node.attribute_count == 0) {
+        node.first_attribute = static_cast<uint32_t>(text.attributes.size());
+    }
+    ++node.attribute_count;
+    text.attributes.push_back(FormattedText::Attribute{.key = key, .value = value});
+}
+
+FormattedText::Span FormattedTextWriter::add_checked_characters(std::string_view str, std::string_view suffix) {
+    uint32_t begin = static_cast<uint32_t>(text.characters.size());
+    append_checked_string(str, text.characters);
+    text.characters.append(suffix);
+    assert(text.characters.size() < std::numeric_limits<uint32_t>::max());
+    FormattedText::Span span{.begin = begin, .size = static_cast<uint32_t>(text.characters.size()) - begin};
+    text.characters.push_back('\0');
+    return span;
+}
+
+} // namespace dnd
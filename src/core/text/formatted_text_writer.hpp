@@ -0,0 +1,113 @@
+#ifndef FORMATTED_TEXT_WRITER_HPP_
+#define FORMATTED_TEXT_WRITER_HPP_
+
+#include <dnd_config.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include <core/text/formatted_text.hpp>
+#include <core/text/rich_text.hpp>
+
+namespace dnd {
+
+/**
+ * @brief Appends nodes to a FormattedText in document order, so that a parser can write a text directly into its flat
+ * buffers.
+ *
+ * A node is begun, its children are appended, and then it is ended. Everything appended after a mark can be discarded
+ * again by resetting to the mark, e.g. if parsing a part of the text failed.
+ */
+class FormattedTextWriter {
+public:
+    struct Mark {
+        uint32_t node_count = 0;
+        uint32_t character_count = 0;
+        uint32_t attribute_count = 0;
+    };
+
+    explicit FormattedTextWriter(FormattedText& text) noexcept;
+
+    /**
+     * @brief Returns a mark at the current end of the text
+     */
+    Mark mark() const noexcept;
+    /**
+     * @brief Returns a mark right before a node, resetting to it removes the node and everything after it
+     */
+    Mark mark_before(uint32_t node_index) const noexcept;
+    void reset_to(const Mark& mark);
+
+    uint32_t node_count() const noexcept;
+    FormattedTextNode get_node(uint32_t node_index) const;
+    bool has_children(uint32_t node_index) const;
+    /**
+     * @brief Returns the index of the last top-level node, if there is one
+     */
+    std::optional<uint32_t> get_last_part() const;
+    /**
+     * @brief Returns the index of the last child of a node, if it has children
+     */
+    std::optional<uint32_t> get_last_child(uint32_t node_index) const;
+
+    /**
+     * @brief Begins a node whose children are appended until it is ended
+     * @param type the type of the node
+     * @param str the text of the node, which is stored as it is
+     * @param bold whether the text is bold
+     * @param italic whether the text is italic
+     * @return the index of the node
+     */
+    uint32_t begin_node(FormattedTextNodeType type, std::string_view str = {}, bool bold = false, bool italic = false);
+    void end_node(uint32_t node_index);
+    /**
+     * @brief Appends a SIMPLE_TEXT node whose text is checked like with checked_string
+     * @param str the text, which is checked
+     * @param bold whether the text is bold
+     * @param italic whether the text is italic
+     * @param suffix characters that are appended to the text without checking them e.g. the separator after a name
+     */
+    void add_simple_text(std::string_view str, bool bold, bool italic, std::string_view suffix = {});
+    /**
+     * @brief Appends a LINK node whose text and attributes are checked like with checked_string
+     * @param str the link text, which is checked
+     * @param bold whether the text is bold
+     * @param italic whether the text is italic
+     * @param attributes the attributes of the link, which are checked
+     */
+    void add_link(std::string_view str, bool bold, bool italic, const std::vector<RichAttributeView>& attributes);
+    /**
+     * @brief Adds an attribute to the node that was begun last, the strings are stored as they are
+     * @param key the key of the attribute, if it has one
+     * @param value the value of the attribute
+     */
+    void add_attribute(std::optional<std::string_view> key, std::string_view value);
+    void set_column_count(uint32_t table_index, size_t column_count);
+    void set_column_width(uint32_t column_index, std::optional<int> width);
+
+    /**
+     * @brief Inserts a node right before a top-level node, which contains that node and all nodes after it
+     * @param node_index the index of the first node that the new node contains
+     * @param type the type of the new node
+     * @return the index of the new node
+     */
+    uint32_t wrap_nodes_from(uint32_t node_index, FormattedTextNodeType type);
+    /**
+     * @brief Removes a range of nodes, the remaining children of the removed nodes are moved up to the parent
+     * @param begin_index the index of the first removed node
+     * @param end_index the index one past the last removed node
+     */
+    void erase_nodes(uint32_t begin_index, uint32_t end_index);
+private:
+    void add_attribute_spans(std::optional<FormattedText::Span> key, FormattedText::Span value);
+    FormattedText::Span add_checked_characters(std::string_view str, std::string_view suffix = {});
+
+    FormattedText& text;
+};
+
+} // namespace dnd
+
+#endif // FORMATTED_TEXT_WRITER_HPP_
@@ -0,0 +1,52 @@
+#include <dnd_config.hpp>
+
+#include "lazy_formatted_text.hpp"
+
+#include <atomic>
+#include <filesystem>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+#include <core/parsing/lazy_text_parsing.hpp>
+#include <core/text/formatted_text.hpp>
+#include <core/text/text_source.hpp>
+
+namespace dnd {
+
+LazyFormattedText LazyFormattedText::create(
+    FormattedText&& text, const std::optional<TextSource>& source, const std::filesystem::path& filepath
+) {
+    if (source.has_value()) {
+        return LazyFormattedText(filepath, source.value());
+    }
+    return LazyFormattedText(std::move(text));
+}
+
+LazyFormattedText::LazyFormattedText(FormattedText&& text) : text(std::move(text)) {}
+
+// the text is parsed on whichever thread first accesses it, possibly at the same time as other texts, so its buffers
+// are allocated from the heap instead of from an arena that only one thread may allocate from
+LazyFormattedText::LazyFormattedText(const std::filesystem::path& filepath, const TextSource& source)
+    : text(std::pmr::new_delete_resource()), source(std::make_unique<Source>(filepath, source)) {}
+
+const FormattedText& LazyFormattedText::get() const {
+    if (source != nullptr) {
+        std::call_once(source->parse_flag, [this]() {
+            text = parse_text_source(source->filepath, source->text_source);
+            source->parsed.store(true, std::memory_order_release);
+        });
+    }
+    return text;
+}
+
+bool LazyFormattedText::is_parsed() const {
+    return source == nullptr || source->parsed.load(std::memory_order_acquire);
+}
+
+LazyFormattedText::Source::Source(const std::filesystem::path& filepath, const TextSource& text_source)
+    : filepath(filepath), text_source(text_source), parsed(false) {}
+
+} // namespace dnd
@@ -0,0 +1,56 @@
+#ifndef LAZY_FORMATTED_TEXT_HPP_
+#define LAZY_FORMATTED_TEXT_HPP_
+
+#include <dnd_config.hpp>
+
+#include <atomic>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+#include <core/text/formatted_text.hpp>
+#include <core/text/text_source.hpp>
+
+namespace dnd {
+
+/**
+ * @brief A FormattedText that is either built right away or parsed from its source file when it is first accessed.
+ * Accessing the text is thread-safe.
+ */
+class LazyFormattedText {
+public:
+    /**
+     * @brief Creates the text from a parsed text, or from the source if the text was not parsed yet
+     * @param text the parsed text, which is ignored if a source is given
+     * @param source the location of the text within its file, if it was not parsed yet
+     * @param filepath the file that contains the text
+     */
+    static LazyFormattedText create(
+        FormattedText&& text, const std::optional<TextSource>& source, const std::filesystem::path& filepath
+    );
+
+    explicit LazyFormattedText(FormattedText&& text);
+    LazyFormattedText(const std::filesystem::path& filepath, const TextSource& source);
+
+    const FormattedText& get() const;
+    bool is_parsed() const;
+private:
+    friend class ContentSerializer;
+
+    struct Source {
+        Source(const std::filesystem::path& filepath, const TextSource& text_source);
+
+        std::filesystem::path filepath;
+        TextSource text_source;
+        std::once_flag parse_flag;
+        std::atomic<bool> parsed;
+    };
+
+    mutable FormattedText text;
+    std::unique_ptr<Source> source;
+};
+
+} // namespace dnd
+
+#endif // LAZY_FORMATTED_TEXT_HPP_
@@ -2,116 +2,127 @@
 
 #include "rich_text.hpp"
 
-#include <cassert>
 #include <optional>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 #include <core/text/check_text.hpp>
 
 namespace dnd {
 
-enum class Status {
-    SEARCHING_INNER_END,
-    SEARCHING_START,
-    SEARCHING_TYPE_START,
-    SEARCHING_TYPE,
-    SEARCHING_TEXT,
-    SEARCHING_ATTRIBUTES,
-    FINISHED,
-};
+std::optional<RichTextView> parse_rich_text_view(std::string_view str) {
+    // the first character of the type is part of it, whatever it is
+    if (str.size() < 3 || str[0] != '{' || str[1] != '@') {
+        return std::nullopt;
+    }
+    size_t type_end = str.find_first_of(" }", 3);
+    if (type_end == std::string_view::npos || str[type_end] == '}') {
+        return std::nullopt;
+    }
 
-std::optional<RichText> parse_rich_text(const std::string& str) { return parse_rich_text(str.begin(), str.end()); }
+    size_t text_begin = str.find_first_not_of(' ', type_end + 1);
+    if (text_begin == std::string_view::npos) {
+        return std::nullopt;
+    }
+    // the first character of the text is part of it, every other '{' starts an inner tag that is part of the text
+    size_t text_end = text_begin + 1;
+    int inner = 0;
+    for (; text_end < str.size(); ++text_end) {
+        char c = str[text_end];
+        if (inner > 0) {
+            if (c == '{') {
+                ++inner;
+            } else if (c == '}') {
+                --inner;
+            }
+        } else if (c == '{') {
+            ++inner;
+        } else if (c == '|' || c == '}') {
+            break;
+        }
+    }
+    if (text_end == str.size()) {
+        return std::nullopt;
+    }
 
-std::optional<RichText> parse_rich_text(std::string::const_iterator begin, std::string::const_iterator end) {
-    RichText rich_text;
-    Status status = Status::SEARCHING_START;
+    RichTextView rich_text{
+        .rich_type = str.substr(2, type_end - 2),
+        .text = str.substr(text_begin, text_end - text_begin),
+        .attributes = {},
+        .length = text_end + 1,
+    };
+    if (str[text_end] == '}') {
+        return rich_text;
+    }
 
+    size_t attributes_begin = text_end + 1;
     bool found_start = false;
-    std::string::const_iterator start = begin;
-
-    std::optional<std::string> parsed_key = std::nullopt;
+    for (size_t i = attributes_begin; i < str.size(); ++i) {
+        char c = str[i];
+        if (!found_start && c != ' ') {
+            found_start = true;
+        } else if (c == '=' || c == '|') {
+            found_start = false;
+        } else if (c == '}') {
+            rich_text.attributes = str.substr(attributes_begin, i - attributes_begin);
+            rich_text.length = i + 1;
+            return rich_text;
+        }
+    }
+    return std::nullopt;
+}
 
-    int inner = 0;
+void parse_rich_attributes_into(std::string_view attributes, std::vector<RichAttributeView>& out) {
+    std::optional<std::string_view> key = std::nullopt;
+    bool found_start = false;
+    size_t start = 0;
+    // the closing brace that ends the last attribute is not part of the attributes
+    for (size_t i = 0; i <= attributes.size(); ++i) {
+        char c = i < attributes.size() ? attributes[i] : '}';
+        if (!found_start && c != ' ') {
+            start = i;
+            found_start = true;
+        } else if (c == '=') {
+            key = attributes.substr(start, i - start);
+            found_start = false;
+        } else if (c == '|' || c == '}') {
+            out.push_back({.key = key, .value = attributes.substr(start, i - start)});
+            key = std::nullopt;
+            found_start = false;
+        }
+    }
+}
 
-    for (std::string::const_iterator str = begin; str != end; str++) {
-        switch (status) {
-            case Status::SEARCHING_START:
-                assert(*str == '{');
-                status = Status::SEARCHING_TYPE_START;
-                break;
-            case Status::SEARCHING_TYPE_START:
-                if (*str != '@') {
-                    return std::nullopt;
-                }
-                status = Status::SEARCHING_TYPE;
-                break;
-            case Status::SEARCHING_TYPE:
-                if (!found_start) {
-                    start = str;
-                    found_start = true;
-                } else if (*str == ' ' || *str == '}') {
-                    rich_text.rich_type = checked_string(start, str);
-                    found_start = false;
-                    status = Status::SEARCHING_TEXT;
-                    if (*str == '}') {
-                        return std::nullopt;
-                    }
-                }
-                break;
-            case Status::SEARCHING_TEXT:
-                if (!found_start && *str != ' ') {
-                    start = str;
-                    found_start = true;
-                } else if (*str == '{') {
-                    inner++;
-                    status = Status::SEARCHING_INNER_END;
-                } else if (*str == '|' || *str == '}') {
-                    rich_text.text = checked_string(start, str);
-                    found_start = false;
-                    status = Status::SEARCHING_ATTRIBUTES;
-                    if (*str == '}') {
-                        rich_text.length = str - begin + 1;
-                        status = Status::FINISHED;
-                    }
-                }
-                break;
-            case Status::SEARCHING_INNER_END:
-                if (*str == '{') {
-                    inner++;
-                } else if (*str == '}') {
-                    inner--;
-                    if (inner == 0) {
-                        status = Status::SEARCHING_TEXT;
-                    }
-                }
-                break;
-            case Status::SEARCHING_ATTRIBUTES:
-                if (!found_start && *str != ' ') {
-                    start = str;
-                    found_start = true;
-                } else if (*str == '=') {
-                    parsed_key = checked_string(start, str);
-                    found_start = false;
-                } else if (*str == '|' || *str == '}') {
-                    rich_text.attributes.push_back({.key = parsed_key, .value = checked_string(start, str)});
-                    found_start = false;
-                    parsed_key = std::nullopt;
-                    if (*str == '}') {
-                        rich_text.length = str - begin + 1;
-                        status = Status::FINISHED;
-                    }
-                }
-                break;
-            case Status::FINISHED:
-                return rich_text;
-                break;
+void parse_rich_attributes_into(std::string_view attributes, std::vector<RichAttribute>& out) {
+    std::vector<RichAttributeView> attribute_views;
+    parse_rich_attributes_into(attributes, attribute_views);
+    for (const RichAttributeView& attribute_view : attribute_views) {
+        RichAttribute& attribute = out.emplace_back();
+        if (attribute_view.key.has_value()) {
+            attribute.key = checked_string(attribute_view.key.value());
         }
+        attribute.value = checked_string(attribute_view.value);
     }
+}
 
-    if (status != Status::FINISHED) {
+std::optional<RichText> parse_rich_text(const std::string& str) { return parse_rich_text(str.begin(), str.end()); }
+
+std::optional<RichText> parse_rich_text(std::string::const_iterator begin, std::string::const_iterator end) {
+    std::optional<RichTextView> rich_text_view = parse_rich_text_view(std::string_view(begin, end));
+    if (!rich_text_view.has_value()) {
         return std::nullopt;
     }
+    RichText rich_text{
+        .rich_type = checked_string(rich_text_view->rich_type),
+        .text = checked_string(rich_text_view->text),
+        .attributes = {},
+        .length = rich_text_view->length,
+    };
+    if (!rich_text_view->attributes.empty()) {
+        parse_rich_attributes_into(rich_text_view->attributes, rich_text.attributes);
+    }
     return rich_text;
 }
 
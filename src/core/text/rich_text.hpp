@@ -6,6 +6,7 @@
 #include <compare>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace dnd {
@@ -17,6 +18,14 @@ struct RichAttribute {
     std::string value;
 };
 
+/**
+ * @brief An attribute of a rich text tag as views into the string it was parsed from, the strings are not checked yet
+ */
+struct RichAttributeView {
+    std::optional<std::string_view> key;
+    std::string_view value;
+};
+
 struct RichText {
     std::strong_ordering operator<=>(const RichText&) const = default;
 
@@ -26,6 +35,36 @@ struct RichText {
     size_t length;
 };
 
+/**
+ * @brief A rich text tag such as "{@filter Charms|rewards|source=IDRotF}" as views into the string it was parsed from
+ */
+struct RichTextView {
+    std::string_view rich_type;
+    std::string_view text;
+    // the attributes as written, i.e. without the separator in front of the first one and without the closing brace
+    std::string_view attributes;
+    size_t length;
+};
+
+/**
+ * @brief Parses the rich text tag at the start of a string without copying any part of it
+ * @param str the string starting with the tag
+ * @return the tag, or std::nullopt if the string does not start with a complete tag
+ */
+std::optional<RichTextView> parse_rich_text_view(std::string_view str);
+/**
+ * @brief Splits the attributes of a rich text tag and appends them
+ * @param attributes the attributes of a RichTextView
+ * @param out the attributes to append to
+ */
+void parse_rich_attributes_into(std::string_view attributes, std::vector<RichAttribute>& out);
+/**
+ * @brief Splits the attributes of a rich text tag without copying them and appends them
+ * @param attributes the attributes of a RichTextView
+ * @param out the attributes to append to
+ */
+void parse_rich_attributes_into(std::string_view attributes, std::vector<RichAttributeView>& out);
+
 std::optional<RichText> parse_rich_text(const std::string& str);
 std::optional<RichText> parse_rich_text(std::string::const_iterator begin, std::string::const_iterator end);
 
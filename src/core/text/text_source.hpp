@@ -0,0 +1,34 @@
+#ifndef TEXT_SOURCE_HPP_
+#define TEXT_SOURCE_HPP_
+
+#include <dnd_config.hpp>
+
+#include <compare>
+#include <cstdint>
+
+namespace dnd {
+
+/**
+ * @brief The location of a description that is parsed when it is first accessed, i.e. the byte range of the JSON
+ * object of the described content piece within its source file
+ */
+struct TextSource {
+    enum class Format : uint8_t {
+        // the "entries" of the object
+        ENTRIES,
+        // the "entries" and "entriesHigherLevel" of a spell
+        SPELL_ENTRIES,
+    };
+
+    std::strong_ordering operator<=>(const TextSource&) const = default;
+
+    uint64_t offset = 0;
+    uint64_t length = 0;
+    // the hash of the byte range, which tells whether the file still contains the same object at that range
+    uint64_t content_hash = 0;
+    Format format = Format::ENTRIES;
+};
+
+} // namespace dnd
+
+#endif // TEXT_SOURCE_HPP_
@@ -0,0 +1,31 @@
+#include <dnd_config.hpp>
+
+#include "arena.hpp"
+
+#include <memory_resource>
+
+namespace dnd {
+
+// the resource of the innermost arena scope of the thread, nullptr if there is none
+static thread_local std::pmr::memory_resource* current_model_resource = nullptr;
+
+Arena::Arena() : resource(default_initial_block_size) {}
+
+Arena::Arena(size_t initial_block_size) : resource(initial_block_size) {}
+
+std::pmr::memory_resource* Arena::get_resource() noexcept { return &resource; }
+
+ArenaScope::ArenaScope(Arena& arena) noexcept : previous_resource(current_model_resource) {
+    current_model_resource = arena.get_resource();
+}
+
+ArenaScope::~ArenaScope() { current_model_resource = previous_resource; }
+
+std::pmr::memory_resource* get_model_resource() noexcept {
+    if (current_model_resource == nullptr) {
+        return std::pmr::new_delete_resource();
+    }
+    return current_model_resource;
+}
+
+} // namespace dnd
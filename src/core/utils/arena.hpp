@@ -0,0 +1,149 @@
+#ifndef ARENA_HPP_
+#define ARENA_HPP_
+
+#include <dnd_config.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace dnd {
+
+/**
+ * @brief A monotonic arena that the large buffers and the objects held by an ArenaPtr in the models of a content
+ * allocate from.
+ *
+ * Besides the polymorphic objects, i.e. stat changes, conditions, and spellcasting, the buffers of the formatted texts,
+ * the classes of the spells, and the groups use the arena. The other strings and containers of the models keep using
+ * the default allocator.
+ *
+ * Allocations are only bump-pointer increments into large blocks, deallocations are no-ops and all blocks are freed
+ * at once when the arena is destroyed. The arena is not thread-safe, only one thread may allocate from it at a time.
+ */
+class Arena {
+public:
+    Arena();
+    /**
+     * @brief Creates an arena whose first block has the given size, e.g. a small one for the content of a single file
+     * @param initial_block_size the size of the first block in bytes, later blocks grow geometrically
+     */
+    explicit Arena(size_t initial_block_size);
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+    Arena(Arena&&) = delete;
+    Arena& operator=(Arena&&) = delete;
+
+    std::pmr::memory_resource* get_resource() noexcept;
+private:
+    static constexpr size_t default_initial_block_size = 64 * 1024;
+
+    std::pmr::monotonic_buffer_resource resource;
+};
+
+/**
+ * @brief Makes the objects created with make_arena_ptr and the buffers of the models created by the calling thread
+ * allocate from an arena while the scope exists
+ */
+class ArenaScope {
+public:
+    explicit ArenaScope(Arena& arena) noexcept;
+    ~ArenaScope();
+    ArenaScope(const ArenaScope&) = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
+private:
+    std::pmr::memory_resource* previous_resource;
+};
+
+/**
+ * @brief Returns the memory resource make_arena_ptr and the buffers of new models allocate from on the calling thread
+ * @return the resource of the arena of the innermost ArenaScope, or the default heap resource if there is none
+ */
+std::pmr::memory_resource* get_model_resource() noexcept;
+
+/**
+ * @brief A deleter that destroys an object and returns its memory to the resource it was allocated from
+ * @tparam T the type of the object, possibly a base class of the allocated object
+ */
+template <typename T>
+class ArenaDeleter {
+public:
+    ArenaDeleter() noexcept = default;
+    ArenaDeleter(std::pmr::memory_resource* resource, size_t size, size_t alignment) noexcept;
+    template <typename U>
+    requires std::is_convertible_v<U*, T*>
+    ArenaDeleter(const ArenaDeleter<U>& other) noexcept;
+
+    void operator()(T* ptr) const noexcept;
+private:
+    template <typename U>
+    friend class ArenaDeleter;
+
+    std::pmr::memory_resource* resource = nullptr;
+    // the size and alignment of the allocated object, which might be larger than T
+    size_t size = 0;
+    size_t alignment = 0;
+};
+
+template <typename T>
+using ArenaPtr = std::unique_ptr<T, ArenaDeleter<T>>;
+
+/**
+ * @brief Constructs an object in the memory resource of the calling thread, see get_model_resource
+ * @tparam T the type of the object
+ * @param args the arguments for the constructor of the object
+ * @return an owning pointer to the object
+ */
+template <typename T, typename... Args>
+ArenaPtr<T> make_arena_ptr(Args&&... args);
+
+
+// === IMPLEMENTATION ===
+
+template <typename T>
+ArenaDeleter<T>::ArenaDeleter(std::pmr::memory_resource* resource, size_t size, size_t alignment) noexcept
+    : resource(resource), size(size), alignment(alignment) {}
+
+template <typename T>
+template <typename U>
+requires std::is_convertible_v<U*, T*>
+ArenaDeleter<T>::ArenaDeleter(const ArenaDeleter<U>& other) noexcept
+    : resource(other.resource), size(other.size), alignment(other.alignment) {}
+
+template <typename T>
+void ArenaDeleter<T>::operator()(T* ptr) const noexcept {
+    if (ptr == nullptr) {
+        return;
+    }
+    static_assert(
+        std::has_virtual_destructor_v<T> || std::is_final_v<T>, "objects must be deleted through their real type"
+    );
+    // the allocated object starts at the address of the most derived object
+    void* memory;
+    if constexpr (std::is_polymorphic_v<T>) {
+        memory = dynamic_cast<void*>(ptr);
+    } else {
+        memory = ptr;
+    }
+    ptr->~T();
+    resource->deallocate(memory, size, alignment);
+}
+
+template <typename T, typename... Args>
+ArenaPtr<T> make_arena_ptr(Args&&... args) {
+    std::pmr::memory_resource* resource = get_model_resource();
+    void* memory = resource->allocate(sizeof(T), alignof(T));
+    try {
+        T* object = ::new (memory) T(std::forward<Args>(args)...);
+        return ArenaPtr<T>(object, ArenaDeleter<T>(resource, sizeof(T), alignof(T)));
+    } catch (...) {
+        resource->deallocate(memory, sizeof(T), alignof(T));
+        throw;
+    }
+}
+
+} // namespace dnd
+
+#endif // ARENA_HPP_
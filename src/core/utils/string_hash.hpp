@@ -0,0 +1,47 @@
+#ifndef STRING_HASH_HPP_
+#define STRING_HASH_HPP_
+
+#include <dnd_config.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace dnd {
+
+/**
+ * @brief A transparent string hash that allows looking up std::string keys by std::string_view or const char*
+ * without constructing a temporary std::string
+ */
+struct StringHash {
+    using is_transparent = void;
+
+    size_t operator()(std::string_view str) const noexcept { return std::hash<std::string_view>{}(str); }
+    size_t operator()(const std::string& str) const noexcept { return std::hash<std::string_view>{}(str); }
+    size_t operator()(const char* str) const noexcept { return std::hash<std::string_view>{}(str); }
+};
+
+/**
+ * @brief Computes the 64-bit FNV-1a hash of the given bytes, which unlike std::hash is the same in every run
+ * @param bytes the bytes to hash
+ * @param hash the hash of the preceding bytes if the bytes are hashed in chunks
+ * @return the hash
+ */
+constexpr uint64_t fnv1a_hash(std::string_view bytes, uint64_t hash = 14695981039346656037ull) noexcept {
+    for (char c : bytes) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+// an unordered map with std::string keys that supports heterogeneous lookup
+template <typename T>
+using StringMap = std::unordered_map<std::string, T, StringHash, std::equal_to<>>;
+
+} // namespace dnd
+
+#endif // STRING_HASH_HPP_
@@ -0,0 +1,112 @@
+#include <dnd_config.hpp>
+
+#include "string_interner.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+
+#include <core/utils/string_hash.hpp>
+
+namespace dnd {
+
+InternedString::InternedString() {
+    // the empty string is kept for the whole program, because every default constructed handle refers to it
+    static const InternedString empty_string = StringInterner::get().intern(std::string_view());
+    entry = empty_string.entry;
+    entry->handle_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+StringInterner& StringInterner::get() {
+    static StringInterner instance;
+    return instance;
+}
+
+InternedString StringInterner::intern(std::string_view str) {
+    Shard& shard = shard_of(str);
+    {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = shard.strings.find(str);
+        if (it != shard.strings.end()) {
+            it->handle_count.fetch_add(1, std::memory_order_relaxed);
+            return InternedString(&*it);
+        }
+    }
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    // the elements of an unordered set are never moved, so the handles stay valid when the set grows
+    auto [it, _] = shard.strings.emplace(str);
+    it->handle_count.fetch_add(1, std::memory_order_relaxed);
+    return InternedString(&*it);
+}
+
+std::optional<InternedString> StringInterner::find(std::string_view str) const {
+    const Shard& shard = shard_of(str);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    auto it = shard.strings.find(str);
+    if (it == shard.strings.end()) {
+        return std::nullopt;
+    }
+    it->handle_count.fetch_add(1, std::memory_order_relaxed);
+    return InternedString(&*it);
+}
+
+size_t StringInterner::size() const {
+    size_t total_size = 0;
+    for (const Shard& shard : shards) {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        total_size += shard.strings.size();
+    }
+    return total_size;
+}
+
+void StringInterner::release(const InternedStringEntry* entry) noexcept {
+    size_t handle_count = entry->handle_count.load(std::memory_order_relaxed);
+    while (handle_count > 1) {
+        if (entry->handle_count.compare_exchange_weak(
+                handle_count, handle_count - 1, std::memory_order_release, std::memory_order_relaxed
+            )) {
+            return;
+        }
+    }
+    // The last handle is only released while the shard is locked, so that no other thread can find the entry while it
+    // is removed. Another thread might have found it in the meantime, in which case it is kept.
+    Shard& shard = shard_of(entry->str);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    if (entry->handle_count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        shard.strings.erase(shard.strings.find(std::string_view(entry->str)));
+    }
+}
+
+StringInterner::Shard& StringInterner::shard_of(std::string_view str) noexcept {
+    return shards[StringHash{}(str) % shard_count];
+}
+
+const StringInterner::Shard& StringInterner::shard_of(std::string_view str) const noexcept {
+    return shards[StringHash{}(str) % shard_count];
+}
+
+size_t StringInterner::EntryHash::operator()(std::string_view str) const noexcept { return StringHash{}(str); }
+
+size_t StringInterner::EntryHash::operator()(const InternedStringEntry& entry) const noexcept {
+    return StringHash{}(entry.str);
+}
+
+bool StringInterner::EntryEqual::operator()(
+    const InternedStringEntry& lhs, const InternedStringEntry& rhs
+) const noexcept {
+    return lhs.str == rhs.str;
+}
+
+bool StringInterner::EntryEqual::operator()(std::string_view lhs, const InternedStringEntry& rhs) const noexcept {
+    return lhs == rhs.str;
+}
+
+bool StringInterner::EntryEqual::operator()(const InternedStringEntry& lhs, std::string_view rhs) const noexcept {
+    return lhs.str == rhs;
+}
+
+} // namespace dnd
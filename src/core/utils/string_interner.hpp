@@ -0,0 +1,211 @@
+#ifndef STRING_INTERNER_HPP_
+#define STRING_INTERNER_HPP_
+
+#include <dnd_config.hpp>
+
+#include <array>
+#include <atomic>
+#include <compare>
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include <core/utils/string_hash.hpp>
+
+namespace dnd {
+
+/**
+ * @brief A string in the StringInterner together with the number of handles to it
+ */
+struct InternedStringEntry {
+    explicit InternedStringEntry(std::string_view str);
+
+    std::string str;
+    mutable std::atomic<size_t> handle_count;
+};
+
+/**
+ * @brief A small handle to a string stored in the StringInterner, equal strings always share the same handle.
+ *
+ * Comparing two handles for equality and hashing a handle only look at the pointer. The ordering compares the
+ * strings themselves, so that ordered containers of handles iterate in the same order as ones of strings.
+ * The string is removed from the interner when its last handle is destroyed. Moving a handle does not touch the count,
+ * a moved-from handle may only be assigned to or destroyed.
+ */
+class InternedString {
+public:
+    /**
+     * @brief Constructs a handle to the empty string
+     */
+    InternedString();
+    /**
+     * @brief Interns a string and constructs a handle to it
+     * @param str the string to intern
+     */
+    explicit InternedString(std::string_view str);
+    explicit InternedString(const std::string& str);
+    explicit InternedString(const char* str);
+    InternedString(const InternedString& other) noexcept;
+    InternedString(InternedString&& other) noexcept;
+    InternedString& operator=(const InternedString& other) noexcept;
+    InternedString& operator=(InternedString&& other) noexcept;
+    ~InternedString();
+
+    const std::string& str() const noexcept;
+    operator const std::string&() const noexcept;
+    bool empty() const noexcept;
+    size_t size() const noexcept;
+
+    bool operator==(const InternedString& other) const noexcept;
+    std::strong_ordering operator<=>(const InternedString& other) const noexcept;
+    bool operator==(std::string_view other) const noexcept;
+private:
+    friend class StringInterner;
+    friend struct std::hash<InternedString>;
+
+    // takes over a handle that the interner already counted for the entry
+    explicit InternedString(const InternedStringEntry* entry) noexcept;
+
+    const InternedStringEntry* entry;
+};
+
+/**
+ * @brief A thread-safe pool of the strings shared by the content, e.g. names, group names and attribute names.
+ *
+ * The strings are counted by their handles and freed with the last one, so the strings of a content are freed
+ * together with it, apart from the ones a new content shares.
+ */
+class StringInterner {
+public:
+    static StringInterner& get();
+    /**
+     * @brief Returns the handle to a string, the string is added to the pool if it was not interned before
+     * @param str the string to intern
+     * @return the handle to the string
+     */
+    InternedString intern(std::string_view str);
+    /**
+     * @brief Finds the handle to a string without adding it to the pool
+     * @param str the string to find
+     * @return the handle to the string, or std::nullopt if the string was never interned
+     */
+    std::optional<InternedString> find(std::string_view str) const;
+    size_t size() const;
+private:
+    friend class InternedString;
+
+    StringInterner() = default;
+
+    struct EntryHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view str) const noexcept;
+        size_t operator()(const InternedStringEntry& entry) const noexcept;
+    };
+
+    struct EntryEqual {
+        using is_transparent = void;
+        bool operator()(const InternedStringEntry& lhs, const InternedStringEntry& rhs) const noexcept;
+        bool operator()(std::string_view lhs, const InternedStringEntry& rhs) const noexcept;
+        bool operator()(const InternedStringEntry& lhs, std::string_view rhs) const noexcept;
+    };
+
+    struct Shard {
+        mutable std::shared_mutex mutex;
+        std::unordered_set<InternedStringEntry, EntryHash, EntryEqual> strings;
+    };
+
+    /**
+     * @brief Releases a handle to an entry, the entry is removed when it was the last one
+     */
+    void release(const InternedStringEntry* entry) noexcept;
+    Shard& shard_of(std::string_view str) noexcept;
+    const Shard& shard_of(std::string_view str) const noexcept;
+
+    // the strings are distributed over several shards so that parsing threads rarely wait for each other
+    static constexpr size_t shard_count = 16;
+    std::array<Shard, shard_count> shards;
+};
+
+
+// === IMPLEMENTATION ===
+
+inline InternedStringEntry::InternedStringEntry(std::string_view str) : str(str), handle_count(0) {}
+
+inline InternedString::InternedString(const InternedStringEntry* entry) noexcept : entry(entry) {}
+
+inline InternedString::InternedString(std::string_view str) : InternedString(StringInterner::get().intern(str)) {}
+
+inline InternedString::InternedString(const std::string& str) : InternedString(std::string_view(str)) {}
+
+inline InternedString::InternedString(const char* str) : InternedString(std::string_view(str)) {}
+
+inline InternedString::InternedString(const InternedString& other) noexcept : entry(other.entry) {
+    entry->handle_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+inline InternedString::InternedString(InternedString&& other) noexcept : entry(other.entry) { other.entry = nullptr; }
+
+inline InternedString& InternedString::operator=(const InternedString& other) noexcept {
+    if (entry != other.entry) {
+        other.entry->handle_count.fetch_add(1, std::memory_order_relaxed);
+        if (entry != nullptr) {
+            StringInterner::get().release(entry);
+        }
+        entry = other.entry;
+    }
+    return *this;
+}
+
+inline InternedString& InternedString::operator=(InternedString&& other) noexcept {
+    // the previous entry is released together with the other handle
+    std::swap(entry, other.entry);
+    return *this;
+}
+
+inline InternedString::~InternedString() {
+    if (entry != nullptr) {
+        StringInterner::get().release(entry);
+    }
+}
+
+inline const std::string& InternedString::str() const noexcept { return entry->str; }
+
+inline InternedString::operator const std::string&() const noexcept { return entry->str; }
+
+inline bool InternedString::empty() const noexcept { return entry->str.empty(); }
+
+inline size_t InternedString::size() const noexcept { return entry->str.size(); }
+
+inline bool InternedString::operator==(const InternedString& other) const noexcept { return entry == other.entry; }
+
+inline std::strong_ordering InternedString::operator<=>(const InternedString& other) const noexcept {
+    if (entry == other.entry) {
+        return std::strong_ordering::equal;
+    }
+    return entry->str <=> other.entry->str;
+}
+
+inline bool InternedString::operator==(std::string_view other) const noexcept { return entry->str == other; }
+
+} // namespace dnd
+
+template <>
+struct std::hash<dnd::InternedString> {
+    size_t operator()(const dnd::InternedString& str) const noexcept { return std::hash<const void*>{}(str.entry); }
+};
+
+template <>
+struct fmt::formatter<dnd::InternedString> : fmt::formatter<std::string_view> {
+    auto format(const dnd::InternedString& str, fmt::format_context& ctx) const {
+        return fmt::formatter<std::string_view>::format(str.str(), ctx);
+    }
+};
+
+#endif // STRING_INTERNER_HPP_
@@ -0,0 +1,121 @@
+#include <dnd_config.hpp>
+
+#include "worker_pool.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace dnd {
+
+WorkerPool::WorkerPool() : WorkerPool(std::max(1u, std::thread::hardware_concurrency())) {}
+
+WorkerPool::WorkerPool(size_t worker_count)
+    : job(nullptr), job_count(0), next_job(0), busy_threads(0), batch_generation(0), stopping(false) {
+    const size_t thread_count = std::max(static_cast<size_t>(1), worker_count) - 1;
+    threads.reserve(thread_count);
+    for (size_t i = 0; i < thread_count; ++i) {
+        threads.emplace_back(&WorkerPool::wait_for_batches, this);
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    batch_started.notify_all();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+void WorkerPool::run(size_t new_job_count, const std::function<void(size_t)>& new_job) {
+    if (threads.empty() || new_job_count <= 1) {
+        // like on the workers, the other jobs still run when one of them throws
+        std::exception_ptr exception;
+        for (size_t i = 0; i < new_job_count; ++i) {
+            try {
+                new_job(i);
+            } catch (...) {
+                if (!exception) {
+                    exception = std::current_exception();
+                }
+            }
+        }
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+        return;
+    }
+
+    std::lock_guard<std::mutex> run_lock(run_mutex);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = &new_job;
+        job_count = new_job_count;
+        next_job = 0;
+        busy_threads = threads.size();
+        first_exception = nullptr;
+        ++batch_generation;
+    }
+    batch_started.notify_all();
+    work_on_batch();
+
+    std::exception_ptr exception;
+    {
+        // the batch has to outlive every thread that might still look at it
+        std::unique_lock<std::mutex> lock(mutex);
+        batch_finished.wait(lock, [this]() { return busy_threads == 0; });
+        job = nullptr;
+        exception = std::exchange(first_exception, nullptr);
+    }
+    if (exception) {
+        std::rethrow_exception(exception);
+    }
+}
+
+void WorkerPool::wait_for_batches() {
+    uint64_t seen_generation = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            batch_started.wait(lock, [this, seen_generation]() {
+                return stopping || batch_generation != seen_generation;
+            });
+            if (stopping) {
+                return;
+            }
+            seen_generation = batch_generation;
+        }
+        work_on_batch();
+        bool last_thread;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            last_thread = --busy_threads == 0;
+        }
+        if (last_thread) {
+            batch_finished.notify_one();
+        }
+    }
+}
+
+void WorkerPool::work_on_batch() {
+    for (size_t i = next_job++; i < job_count; i = next_job++) {
+        try {
+            (*job)(i);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!first_exception) {
+                first_exception = std::current_exception();
+            }
+        }
+    }
+}
+
+} // namespace dnd
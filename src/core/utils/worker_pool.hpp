@@ -0,0 +1,73 @@
+#ifndef WORKER_POOL_HPP_
+#define WORKER_POOL_HPP_
+
+#include <dnd_config.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace dnd {
+
+/**
+ * @brief A fixed set of threads that run batches of independent jobs, kept alive between the batches so that
+ * repeated work e.g. re-parsing or recalculating the content does not start new threads every time.
+ *
+ * The thread calling run works on the jobs as well, so a pool with a single worker has no threads of its own.
+ */
+class WorkerPool {
+public:
+    /**
+     * @brief Creates a pool with one worker for every hardware thread
+     */
+    WorkerPool();
+    explicit WorkerPool(size_t worker_count);
+    ~WorkerPool();
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+    WorkerPool(WorkerPool&&) = delete;
+    WorkerPool& operator=(WorkerPool&&) = delete;
+
+    size_t get_worker_count() const noexcept;
+    /**
+     * @brief Runs the job for every index below the job count and waits until all of them are done, the jobs must
+     * not run batches on the same pool themselves
+     * @param job_count the number of jobs
+     * @param job the function running the job with the given index
+     * @throws the first exception thrown by a job, after all other jobs are done
+     */
+    void run(size_t job_count, const std::function<void(size_t)>& job);
+private:
+    void wait_for_batches();
+    void work_on_batch();
+
+    std::vector<std::thread> threads;
+    // only one batch runs at a time, even if several threads share the pool
+    std::mutex run_mutex;
+    std::mutex mutex;
+    std::condition_variable batch_started;
+    std::condition_variable batch_finished;
+    // the current batch, only changed while no thread of the pool works on it
+    const std::function<void(size_t)>* job;
+    size_t job_count;
+    std::atomic<size_t> next_job;
+    size_t busy_threads;
+    uint64_t batch_generation;
+    bool stopping;
+    std::exception_ptr first_exception;
+};
+
+
+// === IMPLEMENTATION ===
+
+inline size_t WorkerPool::get_worker_count() const noexcept { return threads.size() + 1; }
+
+} // namespace dnd
+
+#endif // WORKER_POOL_HPP_
@@ -4,7 +4,6 @@
 
 #include <cassert>
 #include <optional>
-#include <regex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -21,6 +20,7 @@
 #include <core/models/effects/choice/choice_rules.hpp>
 #include <core/utils/char_manipulation.hpp>
 #include <core/validation/effects/stat_change/stat_change_validation.hpp>
+#include <core/validation/string_matchers.hpp>
 #include <core/validation/validation_data.hpp>
 
 namespace dnd {
@@ -232,15 +232,6 @@ static Errors validate_relations_item_choice(const Choice::Data& data, const Con
     return errors;
 }
 
-static constexpr const char* cantrip_filter_regex_cstr = "(([aA]bjuration|[cC]onjuration|[dD]ivination|[eE]nchantment|"
-                                                         "[eE]vocation|[iI]llusion|[nN]ecromancy|[tT]ransmutation) )?"
-                                                         "(([a-zA-Z][a-z|#]*) )?[cC]antrips";
-
-static constexpr const char* spell_filter_regex_cstr = "((1st|2nd|3rd|[4-9]th)-level )?"
-                                                       "(([aA]bjuration|[cC]onjuration|[dD]ivination|[eE]nchantment|"
-                                                       "[eE]vocation|[iI]llusion|[nN]ecromancy|[tT]ransmutation) )?"
-                                                       "(([a-zA-Z][a-z|#]*) )?[sS]pells";
-
 static Errors validate_relations_spell_choice(const Choice::Data& data, const Content& content) {
     Errors errors;
     for (const std::string& explicit_choice : data.explicit_choices) {
@@ -262,10 +253,9 @@ static Errors validate_relations_spell_choice(const Choice::Data& data, const Co
             continue;
         }
         if (data.attribute_name == "cantrips_free") {
-            static const std::regex cantrip_filter_regex(cantrip_filter_regex_cstr);
-            std::smatch match_pieces;
-            if (std::regex_match(group_name, match_pieces, cantrip_filter_regex)) {
-                std::string class_name = match_pieces[4];
+            std::optional<SpellGroupName> group = match_cantrip_group_name(group_name, true);
+            if (group.has_value()) {
+                std::string class_name(group->class_name);
                 if (!class_name.empty() && !content.get_class_library().contains(class_name)) {
                     errors.add_validation_error(
                         ValidationError::Code::RELATION_NOT_FOUND,
@@ -286,10 +276,9 @@ static Errors validate_relations_spell_choice(const Choice::Data& data, const Co
                 );
             }
         } else {
-            static const std::regex spell_filter_regex(spell_filter_regex_cstr);
-            std::smatch match_pieces;
-            if (std::regex_match(group_name, match_pieces, spell_filter_regex)) {
-                std::string class_name = match_pieces[6];
+            std::optional<SpellGroupName> group = match_spell_group_name(group_name, true);
+            if (group.has_value()) {
+                std::string class_name(group->class_name);
                 if (!class_name.empty() && !content.get_class_library().contains(class_name)) {
                     errors.add_validation_error(
                         ValidationError::Code::RELATION_NOT_FOUND,
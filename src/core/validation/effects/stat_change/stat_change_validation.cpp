@@ -2,7 +2,6 @@
 
 #include "stat_change_validation.hpp"
 
-#include <regex>
 #include <string>
 
 #include <fmt/format.h>
@@ -10,19 +9,15 @@
 #include <core/errors/errors.hpp>
 #include <core/errors/validation_error.hpp>
 #include <core/models/effects/stat_change/stat_change.hpp>
+#include <core/validation/string_matchers.hpp>
 #include <core/validation/validation_data.hpp>
 
 namespace dnd {
 
-static constexpr const char*
-    stat_change_regex_cstr = "[A-Z][_A-Z0-9]+ (earliest|early|normal|late|latest) ((add|sub|mult|div|set|max|min) "
-                             "([A-Z][_A-Z0-9]+|-?[1-9]\\d*(\\.[1-9]|\\.\\d[1-9])?)|(set (false|true)))";
-
 Errors validate_stat_change(const StatChange::Data& data) {
     DND_MEASURE_FUNCTION();
     Errors errors;
-    static const std::regex stat_change_regex(stat_change_regex_cstr);
-    if (!std::regex_match(data.stat_change_str, stat_change_regex)) {
+    if (!is_stat_change_string(data.stat_change_str)) {
         std::string msg;
         if (data.stat_change_str.empty()) {
             msg = "Stat change cannot be empty";
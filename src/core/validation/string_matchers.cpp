@@ -0,0 +1,348 @@
+#include <dnd_config.hpp>
+
+#include "string_matchers.hpp"
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <optional>
+#include <string_view>
+
+namespace dnd {
+
+// The matchers replace regular expressions, which are too slow to be used for every condition, stat change and choice.
+// Each of them matches the same strings as the regular expression noted above it in one pass without allocating.
+
+static constexpr bool is_digit(char c) { return c >= '0' && c <= '9'; }
+
+static constexpr bool is_upper(char c) { return c >= 'A' && c <= 'Z'; }
+
+static constexpr bool is_lower(char c) { return c >= 'a' && c <= 'z'; }
+
+/**
+ * @brief A reading position within a string that only ever moves forward
+ */
+class Cursor {
+public:
+    explicit constexpr Cursor(std::string_view str) noexcept : str(str) {}
+
+    constexpr bool at_end() const noexcept { return pos == str.size(); }
+    constexpr bool consume(char c) noexcept {
+        if (pos < str.size() && str[pos] == c) {
+            ++pos;
+            return true;
+        }
+        return false;
+    }
+    constexpr bool consume(std::string_view prefix) noexcept {
+        if (str.substr(pos).starts_with(prefix)) {
+            pos += prefix.size();
+            return true;
+        }
+        return false;
+    }
+    constexpr size_t consume_digits() noexcept {
+        size_t begin = pos;
+        while (pos < str.size() && is_digit(str[pos])) {
+            ++pos;
+        }
+        return pos - begin;
+    }
+    /**
+     * @brief Consumes everything up to the next space or the end, without the space
+     */
+    constexpr std::string_view consume_word() noexcept {
+        size_t begin = pos;
+        while (pos < str.size() && str[pos] != ' ') {
+            ++pos;
+        }
+        return str.substr(begin, pos - begin);
+    }
+    constexpr std::string_view rest() const noexcept { return str.substr(pos); }
+private:
+    std::string_view str;
+    size_t pos = 0;
+};
+
+// [A-Z][_A-Z0-9]+
+static constexpr bool is_identifier(std::string_view str) {
+    if (str.size() < 2 || !is_upper(str[0])) {
+        return false;
+    }
+    for (char c : str.substr(1)) {
+        if (!is_upper(c) && !is_digit(c) && c != '_') {
+            return false;
+        }
+    }
+    return true;
+}
+
+// (4|6|8|10|12|20|100)
+static constexpr bool is_dice_sides(std::string_view str) {
+    constexpr std::array<std::string_view, 7> sides = {"4", "6", "8", "10", "12", "20", "100"};
+    for (std::string_view side : sides) {
+        if (str == side) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// (([1-9]\d*)?[dD](4|6|8|10|12|20|100)\+)*(([1-9]\d*)?[dD](4|6|8|10|12|20|100))([\+\-]\d+)?
+bool is_dice_string(std::string_view str) {
+    size_t pos = 0;
+    while (true) {
+        // a count with a leading zero cannot start a die, and there is nothing else it could be
+        if (pos < str.size() && str[pos] == '0') {
+            return false;
+        }
+        while (pos < str.size() && is_digit(str[pos])) {
+            ++pos;
+        }
+        if (pos == str.size() || (str[pos] != 'd' && str[pos] != 'D')) {
+            return false;
+        }
+        size_t sides_begin = ++pos;
+        while (pos < str.size() && is_digit(str[pos])) {
+            ++pos;
+        }
+        if (!is_dice_sides(str.substr(sides_begin, pos - sides_begin))) {
+            return false;
+        }
+        if (pos == str.size()) {
+            return true;
+        }
+
+        char sign = str[pos++];
+        if (sign != '+' && sign != '-') {
+            return false;
+        }
+        size_t number_begin = pos;
+        while (pos < str.size() && is_digit(str[pos])) {
+            ++pos;
+        }
+        if (pos == str.size()) {
+            // the modifier at the end
+            return pos > number_begin;
+        }
+        if (sign == '-') {
+            return false;
+        }
+        // the next die, whose count is checked again from the start
+        pos = number_begin;
+    }
+}
+
+// -?\d+(\.\d\d?)?
+static constexpr bool is_condition_number(std::string_view str) {
+    Cursor cursor(str);
+    cursor.consume('-');
+    if (cursor.consume_digits() == 0) {
+        return false;
+    }
+    if (cursor.consume('.')) {
+        size_t decimals = cursor.consume_digits();
+        if (decimals != 1 && decimals != 2) {
+            return false;
+        }
+    }
+    return cursor.at_end();
+}
+
+// [A-Z][_A-Z0-9]+ ((==|!=|>=|<=|>|<) ([A-Z][_A-Z0-9]+|-?\d+(\.\d\d?)?|)|== true|== false)
+bool is_condition_string(std::string_view str) {
+    Cursor cursor(str);
+    if (!is_identifier(cursor.consume_word()) || !cursor.consume(' ')) {
+        return false;
+    }
+    constexpr std::array<std::string_view, 6> operators = {"==", "!=", ">=", "<=", ">", "<"};
+    std::string_view op = cursor.consume_word();
+    bool known_operator = false;
+    for (std::string_view known_op : operators) {
+        known_operator = known_operator || op == known_op;
+    }
+    if (!known_operator || !cursor.consume(' ')) {
+        return false;
+    }
+    std::string_view operand = cursor.rest();
+    if (operand.empty() || is_identifier(operand) || is_condition_number(operand)) {
+        return true;
+    }
+    return op == "==" && (operand == "true" || operand == "false");
+}
+
+// -?[1-9]\d*(\.[1-9]|\.\d[1-9])?
+static constexpr bool is_stat_change_number(std::string_view str) {
+    Cursor cursor(str);
+    cursor.consume('-');
+    if (cursor.rest().empty() || cursor.rest()[0] == '0' || cursor.consume_digits() == 0) {
+        return false;
+    }
+    if (cursor.consume('.')) {
+        std::string_view decimals = cursor.rest();
+        if (decimals.size() != 1 && decimals.size() != 2) {
+            return false;
+        }
+        if (!is_digit(decimals[0]) || !is_digit(decimals.back()) || decimals.back() == '0') {
+            return false;
+        }
+        return true;
+    }
+    return cursor.at_end();
+}
+
+// [A-Z][_A-Z0-9]+ (earliest|early|normal|late|latest)
+// ((add|sub|mult|div|set|max|min) ([A-Z][_A-Z0-9]+|-?[1-9]\d*(\.[1-9]|\.\d[1-9])?)|(set (false|true)))
+bool is_stat_change_string(std::string_view str) {
+    Cursor cursor(str);
+    if (!is_identifier(cursor.consume_word()) || !cursor.consume(' ')) {
+        return false;
+    }
+    constexpr std::array<std::string_view, 5> times = {"earliest", "early", "normal", "late", "latest"};
+    std::string_view time = cursor.consume_word();
+    bool known_time = false;
+    for (std::string_view known : times) {
+        known_time = known_time || time == known;
+    }
+    if (!known_time || !cursor.consume(' ')) {
+        return false;
+    }
+    constexpr std::array<std::string_view, 7> operations = {"add", "sub", "mult", "div", "set", "max", "min"};
+    std::string_view operation = cursor.consume_word();
+    bool known_operation = false;
+    for (std::string_view known : operations) {
+        known_operation = known_operation || operation == known;
+    }
+    if (!known_operation || !cursor.consume(' ')) {
+        return false;
+    }
+    std::string_view operand = cursor.rest();
+    if (is_identifier(operand) || is_stat_change_number(operand)) {
+        return true;
+    }
+    return operation == "set" && (operand == "false" || operand == "true");
+}
+
+// CLASS_LEVEL >= [123456789]\d?
+std::optional<int> match_class_level_condition(std::string_view str) {
+    Cursor cursor(str);
+    if (!cursor.consume("CLASS_LEVEL >= ")) {
+        return std::nullopt;
+    }
+    std::string_view level = cursor.rest();
+    if (level.empty() || level.size() > 2 || level[0] == '0' || !is_digit(level[0]) || !is_digit(level.back())) {
+        return std::nullopt;
+    }
+    return level.size() == 1 ? level[0] - '0' : (level[0] - '0') * 10 + (level[1] - '0');
+}
+
+// (1st|2nd|3rd|[4-9]th)-level
+static constexpr bool is_spell_level(std::string_view str) {
+    if (str.size() != 9 || !str.ends_with("-level")) {
+        return false;
+    }
+    std::string_view level = str.substr(0, 3);
+    return level == "1st" || level == "2nd" || level == "3rd"
+           || (level[0] >= '4' && level[0] <= '9' && level.substr(1) == "th");
+}
+
+// ([aA]bjuration|[cC]onjuration|[dD]ivination|[eE]nchantment|[eE]vocation|[iI]llusion|[nN]ecromancy|[tT]ransmutation)
+static constexpr bool is_magic_school(std::string_view str) {
+    constexpr std::array<std::string_view, 8> schools = {
+        "abjuration", "conjuration", "divination", "enchantment",
+        "evocation",  "illusion",    "necromancy", "transmutation",
+    };
+    if (str.empty()) {
+        return false;
+    }
+    for (std::string_view school : schools) {
+        if (str.substr(1) == school.substr(1) && (str[0] == school[0] || str[0] == school[0] - 'a' + 'A')) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// [a-zA-Z][a-z]* or [a-zA-Z][a-z|#]* with class keys
+static constexpr bool is_class_name(std::string_view str, bool allow_class_keys) {
+    if (str.empty() || (!is_lower(str[0]) && !is_upper(str[0]))) {
+        return false;
+    }
+    for (char c : str.substr(1)) {
+        if (!is_lower(c) && !(allow_class_keys && (c == '|' || c == '#'))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Matches a group name of optional words followed by a final word e.g. "spells".
+ * Like the regular expression with optional groups, the earliest optional parts are preferred when a word could be
+ * more than one of them.
+ */
+static std::optional<SpellGroupName> match_group_name(
+    std::string_view str, std::string_view final_word, bool with_level, bool allow_class_keys
+) {
+    // the level, the magic school, the class, and the final word
+    std::array<std::string_view, 4> words;
+    size_t word_count = 0;
+    Cursor cursor(str);
+    while (true) {
+        if (word_count == words.size()) {
+            return std::nullopt;
+        }
+        words[word_count++] = cursor.consume_word();
+        if (cursor.at_end()) {
+            break;
+        }
+        cursor.consume(' ');
+    }
+
+    std::string_view last_word = words[word_count - 1];
+    if (last_word.empty() || last_word.substr(1) != final_word.substr(1)
+        || (last_word[0] != final_word[0] && last_word[0] != final_word[0] - 'a' + 'A')) {
+        return std::nullopt;
+    }
+
+    const size_t optional_word_count = word_count - 1;
+    // the bits are the level, the magic school, and the class, in the order the regular expression would try them
+    for (int parts = 0b111; parts >= 0; --parts) {
+        if ((parts & 0b100) && !with_level) {
+            continue;
+        }
+        if (static_cast<size_t>(std::popcount(static_cast<unsigned>(parts))) != optional_word_count) {
+            continue;
+        }
+        SpellGroupName name;
+        size_t word_index = 0;
+        if (parts & 0b100) {
+            name.level = words[word_index++].substr(0, 3);
+        }
+        if (parts & 0b010) {
+            name.magic_school = words[word_index++];
+        }
+        if (parts & 0b001) {
+            name.class_name = words[word_index++];
+        }
+        bool valid = (!(parts & 0b100) || is_spell_level(words[0]))
+                     && (!(parts & 0b010) || is_magic_school(name.magic_school))
+                     && (!(parts & 0b001) || is_class_name(name.class_name, allow_class_keys));
+        if (valid) {
+            return name;
+        }
+    }
+    return std::nullopt;
+}
+
+// (([aA]bjuration|...|[tT]ransmutation) )?(([a-zA-Z][a-z]*) )?[cC]antrips
+std::optional<SpellGroupName> match_cantrip_group_name(std::string_view str, bool allow_class_keys) {
+    return match_group_name(str, "cantrips", false, allow_class_keys);
+}
+
+// ((1st|2nd|3rd|[4-9]th)-level )?(([aA]bjuration|...|[tT]ransmutation) )?(([a-zA-Z][a-z]*) )?[sS]pells
+std::optional<SpellGroupName> match_spell_group_name(std::string_view str, bool allow_class_keys) {
+    return match_group_name(str, "spells", true, allow_class_keys);
+}
+
+} // namespace dnd
@@ -0,0 +1,60 @@
+#ifndef STRING_MATCHERS_HPP_
+#define STRING_MATCHERS_HPP_
+
+#include <dnd_config.hpp>
+
+#include <optional>
+#include <string_view>
+
+namespace dnd {
+
+/**
+ * @brief Checks whether a string describes dice, e.g. "2d6+1d4+3"
+ */
+bool is_dice_string(std::string_view str);
+
+/**
+ * @brief Checks whether a string is a condition, e.g. "CLASS_LEVEL >= 3" or "HAS_ARMOR == true"
+ */
+bool is_condition_string(std::string_view str);
+
+/**
+ * @brief Checks whether a string is a stat change, e.g. "AC normal add DEX_MOD" or "SPEED late mult 1.5"
+ */
+bool is_stat_change_string(std::string_view str);
+
+/**
+ * @brief Parses the level of a condition of the form "CLASS_LEVEL >= <level>"
+ * @return the level, or std::nullopt if the string is not such a condition
+ */
+std::optional<int> match_class_level_condition(std::string_view str);
+
+/**
+ * @brief The parts of a group name of spells or cantrips such as "3rd-level evocation Wizard spells", the parts that
+ * are not part of the name are empty
+ */
+struct SpellGroupName {
+    std::string_view level;
+    std::string_view magic_school;
+    std::string_view class_name;
+};
+
+/**
+ * @brief Parses a group name such as "evocation Wizard cantrips"
+ * @param str the group name
+ * @param allow_class_keys whether the class can be given by a key that contains '|' or '#'
+ * @return the parts of the name, or std::nullopt if the string is not a group name of cantrips
+ */
+std::optional<SpellGroupName> match_cantrip_group_name(std::string_view str, bool allow_class_keys = false);
+
+/**
+ * @brief Parses a group name such as "3rd-level evocation Wizard spells"
+ * @param str the group name
+ * @param allow_class_keys whether the class can be given by a key that contains '|' or '#'
+ * @return the parts of the name, or std::nullopt if the string is not a group name of spells
+ */
+std::optional<SpellGroupName> match_spell_group_name(std::string_view str, bool allow_class_keys = false);
+
+} // namespace dnd
+
+#endif // STRING_MATCHERS_HPP_
@@ -5,11 +5,13 @@
 
 #include <compare>
 #include <filesystem>
+#include <optional>
 #include <string>
 
 #include <fmt/format.h>
 
-#include <core/text/text.hpp>
+#include <core/text/formatted_text.hpp>
+#include <core/text/text_source.hpp>
 
 namespace dnd {
 
@@ -24,7 +26,9 @@ public:
     virtual std::string get_key() const;
 
     std::string name;
-    Text description;
+    FormattedText description;
+    // if set, the description was not parsed yet and is parsed from this part of the source file when first accessed
+    std::optional<TextSource> description_source;
     std::filesystem::path source_path;
     std::string source_name;
 protected:
@@ -50,6 +50,7 @@ void GuiApp::render() {
     }
     error_messages_window.render();
 
+    session.reparse_changed_content();
     if (session.parsing_result_available()) {
         fuzzy_search_window.render();
         if (show_advanced_search_window) {
@@ -104,7 +105,6 @@ void GuiApp::render_overview_window() {
 
     if (session.get_status() != SessionStatus::PARSING) {
         if (ImGui::Button("Parse content")) {
-            // FIX: re-parsing does not work currently
             session.start_parsing();
         }
     }
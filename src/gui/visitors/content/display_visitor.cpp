@@ -4,6 +4,7 @@
 
 #include <set>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -30,6 +31,7 @@
 #include <core/models/spell/spell.hpp>
 #include <core/models/subclass/subclass.hpp>
 #include <core/models/subspecies/subspecies.hpp>
+#include <core/text/formatted_text.hpp>
 #include <core/visitors/content/content_visitor.hpp>
 #include <gui/gui_fonts.hpp>
 #include <gui/visitors/content/display_visitor.hpp>
@@ -65,7 +67,7 @@ static void source(const ContentPiece& content_piece) {
     ImGui::TableSetColumnIndex(0);
     ImGui::Text("Source:");
     ImGui::TableSetColumnIndex(1);
-    ImGui::TextWrapped("%s", content_piece.get_source_info().name.c_str());
+    ImGui::TextWrapped("%s", content_piece.get_source_info().name.str().c_str());
     ImGui::TableNextRow();
     ImGui::TableSetColumnIndex(0);
     ImGui::Separator();
@@ -94,7 +96,7 @@ constexpr size_t MAX_ITERATIONS = 1000;
 // because we use multiple text calls to support multiple styles,
 // the use of the high-level functions ImGui::Text() and ImGui::SameLine() does not allow for the text wrapping we want
 // thus, we need to implement it ourselves using ImGui's DrawList by writing one line at a time
-static void display_paragraph(const Paragraph& paragraph, const GuiFonts& fonts) {
+static void display_paragraph(FormattedTextNode paragraph, const GuiFonts& fonts) {
     float canvas_width = ImGui::GetContentRegionAvail().x;
     ImVec2 begin_cursor = ImGui::GetCursorScreenPos();
     ImDrawList* draw_list = ImGui::GetWindowDrawList();
@@ -106,43 +108,21 @@ static void display_paragraph(const Paragraph& paragraph, const GuiFonts& fonts)
     float x = x_begin;
     float y = y_begin;
 
-    for (const InlineText& text_obj : paragraph.parts) {
-        ImFont* font = nullptr;
-        bool push_pop_font = false;
-        std::string::const_iterator text_begin;
-        std::string::const_iterator text_end;
-        bool is_link = false;
-
-        switch (text_obj.index()) {
-            case 0: /* SimpleText */ {
-                const SimpleText& simple_text = std::get<0>(text_obj);
-                font = fonts.get(simple_text.bold, simple_text.italic);
-                push_pop_font = ImGui::GetFont() != font;
-                text_begin = simple_text.str.cbegin();
-                text_end = simple_text.str.cend();
-                break;
-            }
-            case 1: /* Link */ {
-                const Link& link = std::get<1>(text_obj);
-                font = fonts.get(link.text.bold, link.text.italic);
-                push_pop_font = ImGui::GetFont() != font;
-                text_begin = link.text.str.cbegin();
-                text_end = link.text.str.cend();
-                is_link = true;
-                break;
-            }
-            default: {
-                std::unreachable();
-            }
-        }
+    for (FormattedTextNode text_node : paragraph.get_children()) {
+        ImFont* font = fonts.get(text_node.is_bold(), text_node.is_italic());
+        bool push_pop_font = ImGui::GetFont() != font;
+        std::string_view text = text_node.get_text();
+        const char* text_begin = text.data();
+        const char* text_end = text.data() + text.size();
+        bool is_link = text_node.get_type() == FormattedTextNodeType::LINK;
 
         if (push_pop_font) {
             ImGui::PushFont(font);
         }
 
-        std::string::const_iterator subtext_begin = text_begin;
-        std::string::const_iterator current_end = text_begin;
-        std::string::const_iterator last_fitting_end;
+        const char* subtext_begin = text_begin;
+        const char* current_end = text_begin;
+        const char* last_fitting_end = text_begin;
 
         size_t outer_iterations = 0;
         bool empty_last_line = false;
@@ -161,15 +141,14 @@ static void display_paragraph(const Paragraph& paragraph, const GuiFonts& fonts)
                 while (current_end != text_end && *current_end != ' ') {
                     ++current_end;
                 }
-                subtext_size = ImGui::CalcTextSize(&*subtext_begin, &*current_end);
+                subtext_size = ImGui::CalcTextSize(subtext_begin, current_end);
             } while (x + subtext_size.x <= x_end);
 
             if (inner_iterations++ >= MAX_ITERATIONS) {
                 break;
             }
 
-            std::string line_text(subtext_begin, last_fitting_end);
-            if (line_text.empty()) {
+            if (subtext_begin == last_fitting_end) {
                 if (empty_last_line) {
                     // finding two empty lines in a row is a sign of too little space; aborting...
                     break;
@@ -178,7 +157,7 @@ static void display_paragraph(const Paragraph& paragraph, const GuiFonts& fonts)
             }
 
             const ImVec4& color = (is_link) ? link_color : default_text_color;
-            draw_list->AddText(ImVec2(x, y), ImColor(color), line_text.c_str());
+            draw_list->AddText(ImVec2(x, y), ImColor(color), subtext_begin, last_fitting_end);
 
             if (last_fitting_end == text_end) {
                 // not reached end of line
@@ -212,63 +191,81 @@ static void display_paragraph(const Paragraph& paragraph, const GuiFonts& fonts)
     ImGui::Dummy(space_used);
 }
 
-static void display_table(const Table& table, const GuiFonts& fonts) {
+static void display_table(FormattedTextNode table, const GuiFonts& fonts) {
     const char* id = "unnamed";
-    if (table.caption.has_value()) {
+    if (!table.get_text().empty()) {
+        id = table.get_c_str();
         ImGui::PushFont(fonts.bold);
-        ImGui::TextWrapped("%s", table.caption.value().str.c_str());
+        ImGui::TextWrapped("%s", id);
         ImGui::PopFont();
-        id = table.caption.value().str.c_str();
     }
-    if (ImGui::BeginTable(id, static_cast<int>(table.columns), table_flags)) {
-        for (size_t col = 0; col < table.columns; ++col) {
-            float col_weight = 0;
-            if (table.column_widths.has_value()) {
-                col_weight = static_cast<float>(table.column_widths->at(col).value_or(0));
-            }
-            ImGui::TableSetupColumn(table.header.at(col).str.c_str(), ImGuiTableColumnFlags_WidthStretch, col_weight);
-        }
-        ImGui::TableHeadersRow();
-        for (size_t row = 0; row < table.rows.size(); ++row) {
-            ImGui::TableNextRow();
-            for (size_t col = 0; col < table.columns; ++col) {
-                ImGui::TableSetColumnIndex(static_cast<int>(col));
-                if (col >= table.rows[row].size()) {
+    size_t columns = table.get_column_count();
+    if (ImGui::BeginTable(id, static_cast<int>(columns), table_flags)) {
+        // the columns are stored before the rows
+        bool headers_row_done = false;
+        for (FormattedTextNode table_part : table.get_children()) {
+            switch (table_part.get_type()) {
+                case FormattedTextNodeType::TABLE_COLUMN: {
+                    float col_weight = static_cast<float>(table_part.get_column_width().value_or(0));
+                    ImGui::TableSetupColumn(
+                        table_part.get_c_str(), ImGuiTableColumnFlags_WidthStretch, col_weight
+                    );
+                    break;
+                }
+                case FormattedTextNodeType::TABLE_ROW: {
+                    if (!headers_row_done) {
+                        ImGui::TableHeadersRow();
+                        headers_row_done = true;
+                    }
+                    ImGui::TableNextRow();
+                    size_t col = 0;
+                    for (FormattedTextNode cell : table_part.get_children()) {
+                        if (col >= columns) {
+                            break;
+                        }
+                        ImGui::TableSetColumnIndex(static_cast<int>(col++));
+                        display_paragraph(cell, fonts);
+                    }
                     break;
                 }
-                display_paragraph(table.rows[row][col], fonts);
+                default: {
+                    std::unreachable();
+                }
             }
         }
+        if (!headers_row_done) {
+            ImGui::TableHeadersRow();
+        }
 
         ImGui::EndTable();
     }
 }
 
-void display_formatted_text(const Text& formatted_text, const GuiFonts& fonts) {
+void display_formatted_text(const FormattedText& formatted_text, const GuiFonts& fonts) {
     DND_UNUSED(table_flags);
     ImGui::PushTextWrapPos(0.0f);
-    for (const TextObject& text_obj : formatted_text.parts) {
-        switch (text_obj.index()) {
-            case 0: /* Paragraph */ {
-                const Paragraph& paragraph = std::get<0>(text_obj);
-                display_paragraph(paragraph, fonts);
+    for (FormattedTextNode text_node : formatted_text.get_parts()) {
+        switch (text_node.get_type()) {
+            case FormattedTextNodeType::PARAGRAPH: {
+                display_paragraph(text_node, fonts);
                 break;
             }
-            case 1: /* List */ {
-                const List& list = std::get<1>(text_obj);
-                if (list.text_above.has_value()) {
-                    display_paragraph(list.text_above.value(), fonts);
-                }
-                for (const ListItem& list_item : list.parts) {
+            case FormattedTextNodeType::LIST: {
+                for (FormattedTextNode list_part : text_node.get_children()) {
+                    if (list_part.get_type() == FormattedTextNodeType::PARAGRAPH) {
+                        // the text above or below the list items
+                        display_paragraph(list_part, fonts);
+                        continue;
+                    }
                     ImGui::Bullet();
                     ImGui::BeginGroup();
-                    for (const std::variant<Paragraph, Table>& part : list_item.parts) {
-                        switch (part.index()) {
-                            case 0: /* Paragraph */
-                                display_paragraph(std::get<0>(part), fonts);
+                    for (FormattedTextNode item_part : list_part.get_children()) {
+                        switch (item_part.get_type()) {
+                            case FormattedTextNodeType::PARAGRAPH:
+                                display_paragraph(item_part, fonts);
                                 break;
-                            case 1: /* Table */
-                                display_table(std::get<1>(part), fonts);
+                            case FormattedTextNodeType::TABLE:
+                                display_table(item_part, fonts);
                                 break;
                             default:
                                 std::unreachable();
@@ -278,9 +275,8 @@ void display_formatted_text(const Text& formatted_text, const GuiFonts& fonts) {
                 }
                 break;
             }
-            case 2: /* Table */ {
-                const Table& table = std::get<2>(text_obj);
-                display_table(table, fonts);
+            case FormattedTextNodeType::TABLE: {
+                display_table(text_node, fonts);
                 break;
             }
             default: {
@@ -8,7 +8,7 @@
 namespace dnd {
 
 class Content;
-struct Text;
+class FormattedText;
 struct GuiFonts;
 
 class DisplayVisitor : public ContentVisitor {
@@ -22,7 +22,7 @@ private:
     const GuiFonts& fonts;
 };
 
-void display_formatted_text(const Text& formatted_text, const GuiFonts& fonts);
+void display_formatted_text(const FormattedText& formatted_text, const GuiFonts& fonts);
 
 } // namespace dnd
 
@@ -65,7 +65,7 @@ static ContentFilterVariant get_filter_from_filter_index(const Content& content,
     std::unreachable();
 }
 
-AdvancedSearchWindow::AdvancedSearchWindow(Session& session) : session(session), result_list() {}
+AdvancedSearchWindow::AdvancedSearchWindow(Session& session) : session(session) {}
 
 void AdvancedSearchWindow::render() {
     DND_MEASURE_FUNCTION();
@@ -123,18 +123,22 @@ void AdvancedSearchWindow::render() {
     if (ImGui::Button("Search", ImVec2(first_column_button_width, 0))) {
         session.start_advanced_search();
     }
-    if (session.advanced_search_results_available()) {
-        result_list = session.get_advanced_search_result_strings();
-    }
+    // the results of a finished search are stored, while searching the previous results are shown
+    session.advanced_search_results_available();
     ImGui::Spacing();
     ImGui::Separator();
 
-    size_t i = 0;
-    for (const std::string& result : result_list) {
-        if (ImGui::Selectable(result.c_str(), false)) {
-            session.open_advanced_search_result(i);
+    const std::vector<std::string>& result_list = session.get_advanced_search_result_strings();
+    // only the visible results are submitted to ImGui
+    ImGuiListClipper clipper;
+    clipper.Begin(static_cast<int>(result_list.size()));
+    while (clipper.Step()) {
+        for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i) {
+            size_t index = static_cast<size_t>(i);
+            if (ImGui::Selectable(result_list[index].c_str(), false)) {
+                session.open_advanced_search_result(index);
+            }
         }
-        ++i;
     }
 
     ImGui::End();
@@ -3,9 +3,6 @@
 
 #include <dnd_config.hpp>
 
-#include <string>
-#include <vector>
-
 #include <core/session.hpp>
 #include <gui/visitors/filters/filter_setting_visitor.hpp>
 
@@ -18,8 +15,6 @@ public:
 private:
     Session& session;
     FilterSettingVisitor filter_setting_visitor;
-
-    std::vector<std::string> result_list;
 };
 
 } // namespace dnd
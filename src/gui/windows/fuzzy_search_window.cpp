@@ -3,6 +3,7 @@
 #include "fuzzy_search_window.hpp"
 
 #include <string>
+#include <vector>
 
 #include <fmt/format.h>
 #include <imgui/imgui.h>
@@ -125,10 +126,16 @@ void FuzzySearchWindow::render() {
     }
 
     if (ImGui::BeginChild("Search Results", ImVec2(-FLT_MIN, -FLT_MIN))) {
-        std::vector<std::string> search_result_strings = session.get_fuzzy_search_result_strings();
-        for (size_t i = 0; i < search_result_count; ++i) {
-            if (ImGui::Selectable(search_result_strings[i].c_str(), false)) {
-                session.open_fuzzy_search_result(i);
+        const std::vector<std::string>& search_result_strings = session.get_fuzzy_search_result_strings();
+        // only the visible results are submitted to ImGui
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(search_result_strings.size()));
+        while (clipper.Step()) {
+            for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i) {
+                size_t index = static_cast<size_t>(i);
+                if (ImGui::Selectable(search_result_strings[index].c_str(), false)) {
+                    session.open_fuzzy_search_result(index);
+                }
             }
         }
     }
@@ -0,0 +1,79 @@
+#include <dnd_config.hpp>
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#include <runtime_measurement/measurer.hpp>
+
+// replaces the global allocation functions to track the allocations, only compiled if DND_MEASURE_ALLOCATIONS is set
+
+namespace {
+
+// the size of each allocation is stored in front of it, so that the deallocated bytes are known as well
+constexpr size_t header_size = alignof(std::max_align_t);
+
+struct AllocationTrackingRegistration {
+    AllocationTrackingRegistration() { ::dnd::Measurer::enableAllocationTracking(); }
+};
+
+const AllocationTrackingRegistration registration;
+
+void* allocate(size_t size) noexcept {
+    while (true) {
+        void* block = std::malloc(size + header_size);
+        if (block != nullptr) {
+            *static_cast<size_t*>(block) = size;
+            ::dnd::Measurer::recordAllocation(size);
+            return static_cast<std::byte*>(block) + header_size;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if (handler == nullptr) {
+            return nullptr;
+        }
+        try {
+            handler();
+        } catch (...) {
+            return nullptr;
+        }
+    }
+}
+
+void* allocate_or_throw(size_t size) {
+    void* ptr = allocate(size);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void deallocate(void* ptr) noexcept {
+    if (ptr == nullptr) {
+        return;
+    }
+    void* block = static_cast<std::byte*>(ptr) - header_size;
+    ::dnd::Measurer::recordDeallocation(*static_cast<size_t*>(block));
+    std::free(block);
+}
+
+} // namespace
+
+void* operator new(size_t size) { return allocate_or_throw(size); }
+
+void* operator new[](size_t size) { return allocate_or_throw(size); }
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return allocate(size); }
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return allocate(size); }
+
+void operator delete(void* ptr) noexcept { deallocate(ptr); }
+
+void operator delete[](void* ptr) noexcept { deallocate(ptr); }
+
+void operator delete(void* ptr, size_t) noexcept { deallocate(ptr); }
+
+void operator delete[](void* ptr, size_t) noexcept { deallocate(ptr); }
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { deallocate(ptr); }
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { deallocate(ptr); }
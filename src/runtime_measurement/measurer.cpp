@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <chrono>
 #include <cstring>
 #include <filesystem>
@@ -9,7 +10,9 @@
 #include <iomanip>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <thread>
 #include <vector>
 
@@ -32,32 +35,106 @@ static constexpr std::array<const char*, 12> values_for_human_readable = {
     "Main execution scope without parsing",
 };
 
+// how often the events are collected from the thread buffers while a session is running
+static constexpr std::chrono::milliseconds collect_interval(10);
+
+/**
+ * @brief Owns the buffer of a thread for the lifetime of the thread and releases it for reuse when the thread exits
+ */
+class ThreadTraceBufferHandle {
+public:
+    ~ThreadTraceBufferHandle() {
+        if (buffer != nullptr) {
+            buffer->retire();
+        }
+    }
+    ThreadTraceBuffer* buffer = nullptr;
+};
+
+static thread_local ThreadTraceBufferHandle thread_buffer_handle;
+
+ThreadTraceBuffer::ThreadTraceBuffer(uint32_t thread_index)
+    : thread_index(thread_index), events(std::make_unique<std::array<TraceEvent, capacity>>()), head(0), tail(0),
+      dropped_count(0), retired(false) {}
+
+void ThreadTraceBuffer::drain(std::vector<TraceEvent>& drained_events) {
+    size_t current_tail = tail.load(std::memory_order_relaxed);
+    size_t current_head = head.load(std::memory_order_acquire);
+    for (; current_tail != current_head; ++current_tail) {
+        drained_events.push_back((*events)[current_tail % capacity]);
+    }
+    tail.store(current_tail, std::memory_order_release);
+}
+
+bool ThreadTraceBuffer::empty() const {
+    return head.load(std::memory_order_acquire) == tail.load(std::memory_order_relaxed);
+}
+
+size_t ThreadTraceBuffer::take_dropped_count() { return dropped_count.exchange(0, std::memory_order_relaxed); }
+
+void ThreadTraceBuffer::retire() { retired.store(true, std::memory_order_release); }
+
+bool ThreadTraceBuffer::try_reuse() {
+    if (!retired.load(std::memory_order_acquire) || !empty()) {
+        return false;
+    }
+    retired.store(false, std::memory_order_relaxed);
+    return true;
+}
+
+Measurer::Measurer() : recording(false), session(nullptr), stop_collector(false) {
+    heap_bytes_name_id = internScopeName("Heap memory");
+    allocation_total_name_id = internScopeName("Allocations");
+}
+
+Measurer::~Measurer() { stopCollector(); }
+
 void Measurer::beginSession(const std::string& name, const std::string& filepath = "results.json") {
-    session_start_time = std::chrono::system_clock::now();
-    session = std::unique_ptr<MeasuringSession>(
-        new MeasuringSession{.name = name, .filepath = filepath, .json = {{"tspeciesEvents", nlohmann::json::array()}}}
-    );
+    if (session != nullptr) {
+        endSession();
+    }
+    {
+        std::lock_guard<std::mutex> lock(buffers_mutex);
+        // discard events that were recorded while the last session was ending
+        std::vector<TraceEvent> stale_events;
+        for (const std::unique_ptr<ThreadTraceBuffer>& buffer : thread_buffers) {
+            buffer->drain(stale_events);
+            buffer->take_dropped_count();
+        }
+        session = std::make_unique<MeasuringSession>(MeasuringSession{
+            .name = name,
+            .filepath = filepath,
+            .start_time = std::chrono::system_clock::now(),
+            .steady_start = now(),
+            .events = {},
+            .dropped_count = 0,
+        });
+    }
+    stop_collector = false;
+    collector = std::thread(&Measurer::runCollector, this);
+    recording.store(true, std::memory_order_relaxed);
 }
 
 void Measurer::endSession() {
+    if (session == nullptr) {
+        return;
+    }
+    recording.store(false, std::memory_order_relaxed);
+    stopCollector();
+    collectEvents();
     std::chrono::time_point session_end_time = std::chrono::system_clock::now();
 
-    // convert thread ids to consecutive integers
-    std::vector<size_t> thread_ids;
-    int next_id = 0;
-    for (auto& measurement : session->json.at("tspeciesEvents")) {
-        auto it = find(thread_ids.begin(), thread_ids.end(), measurement.at("tid"));
-        if (it != thread_ids.end()) {
-            long idx = it - thread_ids.begin();
-            measurement.at("tid") = idx;
-        } else {
-            thread_ids.push_back(measurement.at("tid"));
-            measurement.at("tid") = next_id++;
+    std::vector<std::string> escaped_names;
+    {
+        std::lock_guard<std::mutex> lock(scope_names_mutex);
+        escaped_names.reserve(scope_names.size());
+        for (const std::string& name : scope_names) {
+            escaped_names.push_back(nlohmann::json(name).dump(-1, ' ', false, nlohmann::json::error_handler_t::replace));
         }
     }
 
     std::filesystem::path parent_dir = std::filesystem::path(session->filepath).parent_path();
-    if (!std::filesystem::exists(parent_dir)) {
+    if (!parent_dir.empty() && !std::filesystem::exists(parent_dir)) {
         std::filesystem::create_directory(parent_dir);
     }
 
@@ -70,19 +147,33 @@ void Measurer::endSession() {
     }
     max_str_len += 4;
 
-    std::time_t start = std::chrono::system_clock::to_time_t(session_start_time);
+    std::time_t start = std::chrono::system_clock::to_time_t(session->start_time);
     output_stream << "Session started at: " << std::put_time(std::localtime(&start), "%F %T\n");
     std::time_t end = std::chrono::system_clock::to_time_t(session_end_time);
     output_stream << "Session stopped at: " << std::put_time(std::localtime(&end), "%F %T\n\n");
+    if (session->dropped_count > 0) {
+        output_stream << "Events dropped because a thread buffer was full: " << session->dropped_count << "\n\n";
+    }
 
     for (const char* human_readable_value : values_for_human_readable) {
-        for (auto& measurement : session->json.at("tspeciesEvents")) {
-            if (measurement.at("name") == human_readable_value) {
+        std::optional<uint32_t> name_id;
+        {
+            std::lock_guard<std::mutex> lock(scope_names_mutex);
+            auto it = scope_name_ids.find(human_readable_value);
+            if (it != scope_name_ids.end()) {
+                name_id = it->second;
+            }
+        }
+        if (!name_id.has_value()) {
+            continue;
+        }
+        for (const TraceEvent& event : session->events) {
+            if (event.type == TraceEventType::SLICE && event.name_id == name_id.value()) {
                 output_stream << human_readable_value;
                 for (size_t i = 0; i < max_str_len - strlen(human_readable_value); ++i) {
                     output_stream << ' ';
                 }
-                output_stream << measurement.at("dur").get<int>() / 1000.0f << " ms\n";
+                output_stream << static_cast<double>(event.end - event.start) / 1'000'000.0 << " ms\n";
                 break;
             }
         }
@@ -90,39 +181,141 @@ void Measurer::endSession() {
     output_stream.flush();
     output_stream.close();
 
+    // counter increments are recorded by many threads, so they are summed up in the order they happened
+    std::stable_sort(session->events.begin(), session->events.end(), [](const TraceEvent& a, const TraceEvent& b) {
+        return a.start < b.start;
+    });
+    std::vector<int64_t> counter_values(escaped_names.size(), 0);
+    bool tracking_allocations = isTrackingAllocations();
+
+    // write the events in the Chrome trace format, times are given in microseconds
     output_stream.open(session->filepath);
-    output_stream << std::setw(4) << session->json << std::flush;
+    output_stream << std::fixed << std::setprecision(3) << "{\"traceEvents\":[";
+    bool first = true;
+    for (const TraceEvent& event : session->events) {
+        output_stream << (first ? "\n" : ",\n");
+        first = false;
+        double timestamp = static_cast<double>(event.start - session->steady_start) / 1000.0;
+        if (event.type == TraceEventType::SLICE) {
+            output_stream << "{\"cat\":\"function\",\"dur\":" << static_cast<double>(event.end - event.start) / 1000.0
+                          << ",\"name\":" << escaped_names[event.name_id] << ",\"ph\":\"X\",\"pid\":0,\"tid\":"
+                          << event.thread_index << ",\"ts\":" << timestamp;
+            if (tracking_allocations) {
+                output_stream << ",\"args\":{\"allocations\":" << event.allocation_count
+                              << ",\"allocated_bytes\":" << event.value << '}';
+            }
+            output_stream << '}';
+            continue;
+        }
+        int64_t& counter_value = counter_values[event.name_id];
+        if (event.type == TraceEventType::COUNTER_INCREMENT) {
+            counter_value += event.value;
+        } else {
+            counter_value = event.value;
+        }
+        output_stream << "{\"cat\":\"counter\",\"name\":" << escaped_names[event.name_id]
+                      << ",\"ph\":\"C\",\"pid\":0,\"ts\":" << timestamp << ",\"args\":{\"value\":" << counter_value
+                      << "}}";
+    }
+    output_stream << "\n],\"otherData\":{\"droppedEvents\":" << session->dropped_count << "}}\n" << std::flush;
     output_stream.close();
     session = nullptr;
 }
 
-void Measurer::writeProfile(const TimerResult& result) {
-    if (session == nullptr) {
-        return;
+uint32_t Measurer::internScopeName(std::string_view name) {
+    std::lock_guard<std::mutex> lock(scope_names_mutex);
+    std::string name_str(name);
+    auto it = scope_name_ids.find(name_str);
+    if (it != scope_name_ids.end()) {
+        return it->second;
     }
-    std::string name = result.name;
-    std::replace(name.begin(), name.end(), '"', '\'');
+    uint32_t name_id = static_cast<uint32_t>(scope_names.size());
+    scope_names.push_back(name_str);
+    scope_name_ids.emplace(std::move(name_str), name_id);
+    return name_id;
+}
 
-    nlohmann::json result_json = {
-        {"cat", "function"}, {"dur", result.end - result.start}, {"name", name},       {"ph", "X"},
-        {"pid", 0},          {"tid", result.thread_id},          {"ts", result.start},
-    };
+void Measurer::writeProfile(TraceEvent event) {
+    if (!isRecording()) {
+        return;
+    }
+    if (thread_buffer_handle.buffer == nullptr) {
+        thread_buffer_handle.buffer = acquireThreadBuffer();
+    }
+    event.thread_index = thread_buffer_handle.buffer->get_thread_index();
+    thread_buffer_handle.buffer->push(event);
+}
 
-    std::lock_guard<std::mutex> lock(write_profile_mutex);
-    session->json.at("tspeciesEvents").push_back(result_json);
+ThreadTraceBuffer* Measurer::acquireThreadBuffer() {
+    std::lock_guard<std::mutex> lock(buffers_mutex);
+    for (const std::unique_ptr<ThreadTraceBuffer>& buffer : thread_buffers) {
+        if (buffer->try_reuse()) {
+            return buffer.get();
+        }
+    }
+    uint32_t thread_index = static_cast<uint32_t>(thread_buffers.size());
+    return thread_buffers.emplace_back(std::make_unique<ThreadTraceBuffer>(thread_index)).get();
 }
 
-void Timer::stop() {
-    std::chrono::system_clock::time_point end_time = std::chrono::system_clock::now();
+void Measurer::collectEvents() {
+    std::lock_guard<std::mutex> lock(buffers_mutex);
+    if (session == nullptr) {
+        return;
+    }
+    for (const std::unique_ptr<ThreadTraceBuffer>& buffer : thread_buffers) {
+        buffer->drain(session->events);
+        session->dropped_count += buffer->take_dropped_count();
+    }
+}
 
-    int64_t start = std::chrono::time_point_cast<std::chrono::microseconds>(start_time).time_since_epoch().count();
-    int64_t end = std::chrono::time_point_cast<std::chrono::microseconds>(end_time).time_since_epoch().count();
+void Measurer::runCollector() {
+    std::unique_lock<std::mutex> lock(collector_mutex);
+    sampleAllocationCounters();
+    while (!collector_condition.wait_for(lock, collect_interval, [this]() { return stop_collector; })) {
+        sampleAllocationCounters();
+        collectEvents();
+    }
+    sampleAllocationCounters();
+}
 
-    size_t thread_id = std::hash<std::thread::id>{}(std::this_thread::get_id());
+void Measurer::sampleAllocationCounters() {
+    if (!isTrackingAllocations()) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(buffers_mutex);
+    if (session == nullptr) {
+        return;
+    }
+    int64_t timestamp = now();
+    session->events.push_back(TraceEvent{
+        .start = timestamp,
+        .value = heap_bytes.load(std::memory_order_relaxed),
+        .name_id = heap_bytes_name_id,
+        .type = TraceEventType::COUNTER_VALUE,
+    });
+    session->events.push_back(TraceEvent{
+        .start = timestamp,
+        .value = allocation_total.load(std::memory_order_relaxed),
+        .name_id = allocation_total_name_id,
+        .type = TraceEventType::COUNTER_VALUE,
+    });
+}
 
-    Measurer::get().writeProfile(TimerResult{name, start, end, thread_id});
+void Measurer::stopCollector() {
+    if (!collector.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(collector_mutex);
+        stop_collector = true;
+    }
+    collector_condition.notify_one();
+    collector.join();
+}
 
-    stopped = true;
+void Timer::make_innermost() {
+    outer_timer = innermost_timer;
+    innermost_timer = this;
 }
 
 } // namespace dnd
@@ -1,29 +1,96 @@
 #ifndef MEASURER_HPP_
 #define MEASURER_HPP_
 
+#include <array>
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
 #include <memory>
 #include <mutex>
 #include <string>
-
-#include <nlohmann/json.hpp>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 // inspired by TheCherno
 
 namespace dnd {
 
+enum class TraceEventType : uint8_t {
+    // a measured duration of a scope
+    SLICE,
+    // an increment of a counter
+    COUNTER_INCREMENT,
+    // a new absolute value of a counter
+    COUNTER_VALUE,
+};
+
 /**
- * @brief A struct representing a result of one timer
+ * @brief A struct representing a result of one timer or a change of a counter, it has a fixed size so that it can be
+ * recorded cheaply
  */
-struct TimerResult {
-    // the name of the timer
-    std::string name;
-    // the start time id
+struct TraceEvent {
+    // the start time (or for counters the time of the change) in nanoseconds of a steady clock
     int64_t start;
-    // the end time id
-    int64_t end;
-    // the thread id
-    size_t thread_id;
+    // the end time in nanoseconds of a steady clock, unused for counters
+    int64_t end = 0;
+    // the allocated bytes for slices, the increment or the new value for counters
+    int64_t value = 0;
+    // the id of the interned scope or counter name
+    uint32_t name_id;
+    // the consecutive index of the thread that recorded the event, set when the event is recorded
+    uint32_t thread_index = 0;
+    // the number of allocations during the slice, unused for counters
+    uint32_t allocation_count = 0;
+    TraceEventType type = TraceEventType::SLICE;
+};
+
+/**
+ * @brief A ring buffer of trace events with one producing thread and one consuming thread that does not lock
+ */
+class ThreadTraceBuffer {
+public:
+    static constexpr size_t capacity = 1 << 16;
+
+    explicit ThreadTraceBuffer(uint32_t thread_index);
+    uint32_t get_thread_index() const;
+    /**
+     * @brief Records an event, if the buffer is full the event is dropped, must only be called by the owning thread
+     * @param event the event to record
+     */
+    void push(const TraceEvent& event);
+    /**
+     * @brief Moves all recorded events out of the buffer, must not be called by two threads at once
+     * @param events the vector to append the events to
+     */
+    void drain(std::vector<TraceEvent>& events);
+    bool empty() const;
+    /**
+     * @brief Returns and resets the number of events that were dropped because the buffer was full
+     * @return the number of dropped events
+     */
+    size_t take_dropped_count();
+    /**
+     * @brief Marks the buffer as reusable by a new thread once it is drained, called when the owning thread exits
+     */
+    void retire();
+    /**
+     * @brief Takes over a drained buffer of an exited thread
+     * @return "true" if the buffer was free and is now owned by the calling thread, "false" otherwise
+     */
+    bool try_reuse();
+private:
+    const uint32_t thread_index;
+    std::unique_ptr<std::array<TraceEvent, capacity>> events;
+    // the producer and consumer positions are on separate cache lines to avoid false sharing
+    alignas(64) std::atomic<size_t> head;
+    alignas(64) std::atomic<size_t> tail;
+    std::atomic<size_t> dropped_count;
+    // "true" if the owning thread exited
+    std::atomic<bool> retired;
 };
 
 /**
@@ -34,12 +101,21 @@ struct MeasuringSession {
     std::string name;
     // the file path where to store the results
     std::string filepath;
-    // the json where the results are stored before they are written into the file
-    nlohmann::json json;
+    // the start of the session
+    std::chrono::system_clock::time_point start_time;
+    // the start of the session in nanoseconds of the steady clock the events are recorded with
+    int64_t steady_start;
+    // the events moved out of the thread buffers before they are written into the file
+    std::vector<TraceEvent> events;
+    // the number of events that were dropped because a thread buffer was full
+    size_t dropped_count;
 };
 
 /**
- * @brief A dirty way of saving threading information into json files that you can view with https://ui.perfetto.dev/
+ * @brief A way of saving threading information into json files that you can view with https://ui.perfetto.dev/
+ *
+ * Each thread records its events into its own ring buffer without locking, a background thread collects them
+ * while the session is running and they are written in the Chrome trace format when the session ends.
  */
 class Measurer {
 public:
@@ -47,6 +123,7 @@ public:
      * @brief Constructs a Measurer
      */
     Measurer();
+    ~Measurer();
     /**
      * @brief Starts a measuring session with a certain name
      * @param name a name for the measuring session
@@ -58,62 +135,217 @@ public:
      */
     void endSession();
     /**
-     * @brief Save the profile of one timing result
-     * @param result the result of one timer
+     * @brief Returns whether a session is running, i.e. whether events are recorded
+     * @return "true" if a session is running, "false" otherwise
+     */
+    bool isRecording() const;
+    /**
+     * @brief Returns the id of a scope name, the same name always receives the same id
+     * @param name the name of a measured scope
+     * @return the id of the scope name
+     */
+    uint32_t internScopeName(std::string_view name);
+    /**
+     * @brief Save the profile of one timing result into the buffer of the calling thread
+     * @param event the result of one timer
+     */
+    void writeProfile(TraceEvent event);
+    /**
+     * @brief Adds to a counter that is shown as a counter track next to the slices
+     * @param name_id the id of the interned counter name
+     * @param increment the value to add to the counter
+     */
+    void addToCounter(uint32_t name_id, int64_t increment);
+    /**
+     * @brief Enables the allocation counts and bytes of the slices and the heap memory counter tracks, called by the
+     * allocation hooks when they are linked into the program
+     */
+    static void enableAllocationTracking();
+    static bool isTrackingAllocations();
+    /**
+     * @brief Attributes an allocation to the innermost running timer of the calling thread, called by the allocation
+     * hooks and therefore must neither allocate nor lock
+     * @param size the size of the allocation in bytes
+     */
+    static void recordAllocation(size_t size);
+    /**
+     * @brief Records a deallocation, called by the allocation hooks and therefore must neither allocate nor lock
+     * @param size the size of the deallocated memory in bytes
      */
-    void writeProfile(const TimerResult& result);
+    static void recordDeallocation(size_t size);
+    /**
+     * @brief Returns the current time of the clock the events are recorded with
+     * @return the current time in nanoseconds
+     */
+    static int64_t now();
     static Measurer& get();
 private:
-    // a mutex to control writing access to the results json
-    static std::mutex write_profile_mutex;
+    ThreadTraceBuffer* acquireThreadBuffer();
+    void collectEvents();
+    void runCollector();
+    void stopCollector();
+    void sampleAllocationCounters();
+
+    // "true" if the allocation hooks are linked into the program
+    static inline std::atomic<bool> allocation_tracking = false;
+    // the currently allocated bytes on the heap
+    static inline std::atomic<int64_t> heap_bytes = 0;
+    // the number of allocations since the program started
+    static inline std::atomic<int64_t> allocation_total = 0;
+
+    // "true" while a session is running
+    std::atomic<bool> recording;
     // the current measuring session, nullptr if there is none
     std::unique_ptr<MeasuringSession> session;
-    // the start of the current session
-    std::chrono::system_clock::time_point session_start_time;
+    // a mutex to control access to the thread buffers and to the events of the session
+    std::mutex buffers_mutex;
+    // the buffers of all threads that recorded events, they are reused after their thread exited
+    std::vector<std::unique_ptr<ThreadTraceBuffer>> thread_buffers;
+    // a mutex to control access to the interned scope names
+    std::mutex scope_names_mutex;
+    std::deque<std::string> scope_names;
+    std::unordered_map<std::string, uint32_t> scope_name_ids;
+    // the thread collecting the events from the thread buffers while a session is running
+    std::thread collector;
+    std::mutex collector_mutex;
+    std::condition_variable collector_condition;
+    bool stop_collector;
+    // the ids of the counter names sampled by the collector if allocations are tracked
+    uint32_t heap_bytes_name_id;
+    uint32_t allocation_total_name_id;
 };
 
 /**
- * @brief A quick and dirty instrumenation scope timer
+ * @brief A quick instrumentation scope timer, allocations while it is the innermost running timer of its thread are
+ * attributed to it, therefore timers should be stopped in the reverse order they were started
  */
 class Timer {
 public:
     /**
-     * @brief Constructs or rather starts a new timer with the given name
+     * @brief Constructs or rather starts a new timer with the name of the given id
+     * @param name_id the id of an interned scope name
+     */
+    explicit Timer(uint32_t name_id);
+    /**
+     * @brief Constructs or rather starts a new timer with the given name, the name is interned on every call
      * @param name a name for the timer
      */
-    Timer(const char* name);
+    explicit Timer(std::string_view name);
     /**
      * @brief Destructs the object and stops the timer if not already stopped
      */
-    virtual ~Timer();
+    ~Timer();
     /**
      * @brief Stops the timer
      */
     void stop();
 private:
-    // the name of the timer
-    const std::string name;
-    // "true" if timer was stopped, "false" otherwise
+    friend class Measurer;
+
+    /**
+     * @brief Makes the timer the innermost running timer of the thread, defined in the source file because compilers
+     * warn about storing the address of a local timer in a thread-local variable when it is inlined
+     */
+    void make_innermost();
+
+    // the innermost running timer of the thread
+    static inline thread_local Timer* innermost_timer = nullptr;
+
+    // the timer that was the innermost running timer when this timer was started
+    Timer* outer_timer;
+    // the id of the name of the timer
+    uint32_t name_id;
+    // "true" if timer was stopped or no session is running, "false" otherwise
     bool stopped;
     // the time the timer was started at
-    std::chrono::system_clock::time_point start_time;
+    int64_t start_time;
+    // the number of allocations while the timer was the innermost running timer
+    uint32_t allocation_count;
+    // the allocated bytes while the timer was the innermost running timer
+    int64_t allocated_bytes;
 };
 
-inline std::mutex Measurer::write_profile_mutex;
+inline uint32_t ThreadTraceBuffer::get_thread_index() const { return thread_index; }
+
+inline void ThreadTraceBuffer::push(const TraceEvent& event) {
+    size_t current_head = head.load(std::memory_order_relaxed);
+    if (current_head - tail.load(std::memory_order_acquire) == capacity) {
+        dropped_count.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    (*events)[current_head % capacity] = event;
+    head.store(current_head + 1, std::memory_order_release);
+}
+
+inline bool Measurer::isRecording() const { return recording.load(std::memory_order_relaxed); }
+
+inline void Measurer::addToCounter(uint32_t name_id, int64_t increment) {
+    if (!isRecording()) {
+        return;
+    }
+    writeProfile(TraceEvent{
+        .start = now(), .value = increment, .name_id = name_id, .type = TraceEventType::COUNTER_INCREMENT
+    });
+}
+
+inline void Measurer::enableAllocationTracking() { allocation_tracking.store(true, std::memory_order_relaxed); }
 
-inline Measurer::Measurer() : session(nullptr) {}
+inline bool Measurer::isTrackingAllocations() { return allocation_tracking.load(std::memory_order_relaxed); }
+
+inline void Measurer::recordAllocation(size_t size) {
+    int64_t bytes = static_cast<int64_t>(size);
+    heap_bytes.fetch_add(bytes, std::memory_order_relaxed);
+    allocation_total.fetch_add(1, std::memory_order_relaxed);
+    Timer* timer = Timer::innermost_timer;
+    if (timer != nullptr) {
+        ++timer->allocation_count;
+        timer->allocated_bytes += bytes;
+    }
+}
+
+inline void Measurer::recordDeallocation(size_t size) {
+    heap_bytes.fetch_sub(static_cast<int64_t>(size), std::memory_order_relaxed);
+}
+
+inline int64_t Measurer::now() {
+    std::chrono::steady_clock::duration time = std::chrono::steady_clock::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(time).count();
+}
 
 inline Measurer& Measurer::get() {
     static Measurer instance;
     return instance;
 }
 
-inline Timer::Timer(const char* name) : name(name), stopped(false) { start_time = std::chrono::system_clock::now(); }
-
-inline Timer::~Timer() {
+inline Timer::Timer(uint32_t name_id)
+    : outer_timer(nullptr), name_id(name_id), stopped(!Measurer::get().isRecording()),
+      start_time(stopped ? 0 : Measurer::now()), allocation_count(0), allocated_bytes(0) {
     if (!stopped) {
-        stop();
+        make_innermost();
+    }
+}
+
+inline Timer::Timer(std::string_view name)
+    : Timer(Measurer::get().isRecording() ? Measurer::get().internScopeName(name) : 0) {}
+
+inline Timer::~Timer() { stop(); }
+
+inline void Timer::stop() {
+    if (stopped) {
+        return;
+    }
+    int64_t end_time = Measurer::now();
+    if (innermost_timer == this) {
+        innermost_timer = outer_timer;
     }
+    stopped = true;
+    Measurer::get().writeProfile(TraceEvent{
+        .start = start_time,
+        .end = end_time,
+        .value = allocated_bytes,
+        .name_id = name_id,
+        .allocation_count = allocation_count,
+    });
 }
 
 } // namespace dnd
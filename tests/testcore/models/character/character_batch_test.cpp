@@ -0,0 +1,147 @@
+#include <dnd_config.hpp>
+
+#include <core/models/character/character_batch.hpp>
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <core/basic_mechanics/character_progression.hpp>
+#include <core/content.hpp>
+#include <core/errors/errors.hpp>
+#include <core/models/character/character.hpp>
+#include <core/models/character/stat_attribute.hpp>
+#include <core/models/character/stats.hpp>
+#include <core/models/effects_provider/feature.hpp>
+#include <core/utils/worker_pool.hpp>
+#include <testcore/minimal_testing_content.hpp>
+#include <testcore/validation/validation_data_mock.hpp>
+
+namespace dnd::test {
+
+static constexpr const char* tags = "[core][models][character]";
+
+static Character::Data batch_character_data(const std::string& name, int level) {
+    Character::Data data;
+    set_valid_mock_values(data, name.c_str());
+    Feature::Data& feature_data = data.features_data.emplace_back();
+    set_valid_mock_values(feature_data, (name + " Feature").c_str());
+    data.base_ability_scores_data.strength = 10;
+    data.base_ability_scores_data.dexterity = 8;
+    data.base_ability_scores_data.constitution = 12;
+    data.base_ability_scores_data.intelligence = 15;
+    data.base_ability_scores_data.wisdom = 12;
+    data.base_ability_scores_data.charisma = 14;
+    data.feature_providers_data.species_key = "Dwarf##dummy";
+    data.feature_providers_data.subspecies_key = "Hill Dwarf##dummy";
+    data.feature_providers_data.class_key = "Wizard##dummy";
+    data.feature_providers_data.subclass_key = "Abjuration##dummy|Wizard";
+    data.progression_data.level = level;
+    data.progression_data.xp = xp_for_level(level).value();
+    data.progression_data.hit_dice_rolls = std::vector<int>(level, 3);
+    return data;
+}
+
+static void require_same_characters(const Content& content, const Content& expected_content) {
+    const std::vector<Character>& characters = content.get_all_characters();
+    const std::vector<Character>& expected_characters = expected_content.get_all_characters();
+    REQUIRE(characters.size() == expected_characters.size());
+    for (size_t i = 0; i < characters.size(); ++i) {
+        REQUIRE(characters[i].get_key() == expected_characters[i].get_key());
+        for (size_t slot = 0; slot < stat_slot_count; ++slot) {
+            const StatSlot stat_slot = static_cast<StatSlot>(slot);
+            const Stats& expected_stats = expected_characters[i].get_stats();
+            REQUIRE(characters[i].get_stats().get_raw(stat_slot) == expected_stats.get_raw(stat_slot));
+        }
+    }
+    REQUIRE(
+        content.get_character_library().get_drafts().size()
+        == expected_content.get_character_library().get_drafts().size()
+    );
+}
+
+TEST_CASE("CharacterBatch::create_all_for", tags) {
+    Content content = minimal_testing_content();
+    Content expected_content = minimal_testing_content();
+    WorkerPool worker_pool(4);
+    CharacterBatch batch;
+
+    SECTION("the characters are added in the order of their keys, like creating them one by one in that order") {
+        const std::vector<std::pair<std::string, int>> characters = {
+            {"Character C", 3}, {"Character A", 1}, {"Character E", 7}, {"Character B", 12}, {"Character D", 5},
+        };
+        for (const auto& [name, level] : characters) {
+            batch.add(batch_character_data(name, level));
+        }
+        for (const char* name : {"Character A", "Character B", "Character C", "Character D", "Character E"}) {
+            for (const auto& [character_name, level] : characters) {
+                if (character_name == name) {
+                    Character::Data data = batch_character_data(name, level);
+                    expected_content.add_character_result(Character::create_for(std::move(data), expected_content));
+                }
+            }
+        }
+        REQUIRE_FALSE(batch.empty());
+        batch.create_all_for(content, worker_pool);
+        REQUIRE(batch.empty());
+        REQUIRE(content.get_all_characters().size() == 6);
+        require_same_characters(content, expected_content);
+    }
+
+    SECTION("characters depending on each other are validated against the characters added before them") {
+        // the same key twice, a feature shadowing another character's feature, and a key already in the content
+        batch.add(batch_character_data("Character B", 2));
+        batch.add(batch_character_data("Character A", 4));
+        batch.add(batch_character_data("Character B", 6));
+        Character::Data shadowing_data = batch_character_data("Character C", 3);
+        shadowing_data.features_data[0].name = "Character A Feature";
+        batch.add(std::move(shadowing_data));
+        batch.add(batch_character_data("Example Character", 4));
+
+        for (Character::Data& data : std::vector<Character::Data>{
+                 batch_character_data("Character A", 4), batch_character_data("Character B", 2),
+                 batch_character_data("Character B", 6), batch_character_data("Character C", 3),
+                 batch_character_data("Example Character", 4),
+             }) {
+            if (data.name == "Character C") {
+                data.features_data[0].name = "Character A Feature";
+            }
+            expected_content.add_character_result(Character::create_for(std::move(data), expected_content));
+        }
+        batch.create_all_for(content, worker_pool);
+        REQUIRE(content.get_all_characters().size() == 3);
+        REQUIRE(content.get_character_library().get_drafts().size() == 3);
+        require_same_characters(content, expected_content);
+    }
+}
+
+TEST_CASE("Content::recalculate_all_characters", tags) {
+    Content content = minimal_testing_content();
+    Content expected_content = minimal_testing_content();
+    WorkerPool worker_pool(4);
+    CharacterBatch batch;
+    for (int level = 1; level <= 20; ++level) {
+        std::string name = "Character " + std::to_string(level);
+        batch.add(batch_character_data(name, level));
+        expected_content.add_character_result(
+            Character::create_for(batch_character_data(name, level), expected_content)
+        );
+    }
+    batch.create_all_for(content, worker_pool);
+
+    Errors errors = content.recalculate_all_characters(worker_pool);
+    REQUIRE(errors.ok());
+    REQUIRE(content.get_all_characters().size() == expected_content.get_all_characters().size());
+    for (const Character& expected_character : expected_content.get_all_characters()) {
+        const Character& character = content.get_character_library().get(expected_character.get_key()).value();
+        for (size_t slot = 0; slot < stat_slot_count; ++slot) {
+            const StatSlot stat_slot = static_cast<StatSlot>(slot);
+            REQUIRE(character.get_stats().get_raw(stat_slot) == expected_character.get_stats().get_raw(stat_slot));
+        }
+    }
+}
+
+} // namespace dnd::test
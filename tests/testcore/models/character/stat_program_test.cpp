@@ -0,0 +1,110 @@
+#include <dnd_config.hpp>
+
+#include <core/models/character/stat_program.hpp>
+
+#include <cstddef>
+#include <expected>
+#include <string_view>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <core/errors/errors.hpp>
+#include <core/models/character/stat_attribute.hpp>
+#include <core/models/character/stats.hpp>
+#include <core/models/effects/stat_change/identifier_stat_change.hpp>
+#include <core/models/effects/stat_change/literal_stat_change.hpp>
+#include <core/models/effects/stat_change/stat_change.hpp>
+
+namespace dnd::test {
+
+using namespace std::string_view_literals;
+
+static constexpr const char* tags = "[core][models][stats]";
+
+static void require_same_stats(
+    const Stats& stats, const Stats& expected, const std::vector<const char*>& custom_names
+) {
+    for (size_t i = 0; i < stat_slot_count; ++i) {
+        REQUIRE(stats.get_raw(static_cast<StatSlot>(i)) == expected.get_raw(static_cast<StatSlot>(i)));
+    }
+    for (const char* custom_name : custom_names) {
+        REQUIRE(stats.get_raw(custom_name) == expected.get_raw(custom_name));
+    }
+}
+
+TEST_CASE("StatProgram", tags) {
+    // a custom value that is read before it is written and one that is calculated from the dexterity modifier
+    LiteralStatChange early_bonus("BONUS"sv, StatChangeTime::EARLY, StatChangeOperation::SET, 1);
+    IdentifierStatChange armor_class("AC"sv, StatChangeTime::NORMAL, StatChangeOperation::ADD, "BONUS"sv);
+    LiteralStatChange late_bonus("BONUS"sv, StatChangeTime::LATE, StatChangeOperation::ADD, 2);
+    IdentifierStatChange dexterity_value("DEX_VALUE"sv, StatChangeTime::NORMAL, StatChangeOperation::SET, "dex_MOD"sv);
+    IdentifierStatChange doubled("DEX_VALUE"sv, StatChangeTime::LATE, StatChangeOperation::ADD, "DEX_VALUE"sv);
+    IdentifierStatChange athletics("ATHLETICS"sv, StatChangeTime::NORMAL, StatChangeOperation::ADD, "PB"sv);
+    LiteralStatChange strength("str"sv, StatChangeTime::NORMAL, StatChangeOperation::ADD, 2);
+    const std::vector<const char*> custom_names = {"BONUS", "DEX_VALUE"};
+
+    StatProgram program({
+        early_bonus.get_instruction(), armor_class.get_instruction(), late_bonus.get_instruction(),
+        dexterity_value.get_instruction(), doubled.get_instruction(), athletics.get_instruction(),
+        strength.get_instruction(),
+    });
+    StatInputs inputs{
+        .ability_scores = {10, 14, 13, 16, 12, 8},
+        .proficiency_bonus = 2,
+        .hit_dice_maximum = 8,
+        .hit_dice_rolls = {5, 6},
+    };
+    std::expected<Stats, Errors> result = program.evaluate(inputs);
+    REQUIRE(result.has_value());
+    Stats stats = result.value();
+    REQUIRE(stats.get_ability_score(Ability::STRENGTH) == 12);
+    REQUIRE(stats.get_armor_class() == 13);
+    REQUIRE(stats.get_int("BONUS") == 3);
+    REQUIRE(stats.get_int("DEX_VALUE") == 4);
+    REQUIRE(stats.get_skill_modifier(Skill::ATHLETICS) == 3);
+
+    StatInputs new_inputs = inputs;
+    SECTION("the same inputs do not run any steps") {
+        REQUIRE(program.count_update_steps(inputs, new_inputs) == 0);
+    }
+    SECTION("changing an ability score") {
+        new_inputs.ability_scores[static_cast<size_t>(Ability::DEXTERITY)] = 18;
+        REQUIRE(program.count_update_steps(inputs, new_inputs) < program.step_count());
+        REQUIRE(program.update(stats, inputs, new_inputs).ok());
+        require_same_stats(stats, program.evaluate(new_inputs).value(), custom_names);
+        REQUIRE(stats.get_armor_class() == 15);
+        REQUIRE(stats.get_int("DEX_VALUE") == 8);
+    }
+    SECTION("changing an ability score above its maximum") {
+        new_inputs.ability_scores[static_cast<size_t>(Ability::STRENGTH)] = 19;
+        REQUIRE(program.update(stats, inputs, new_inputs).ok());
+        require_same_stats(stats, program.evaluate(new_inputs).value(), custom_names);
+        REQUIRE(stats.get_ability_score(Ability::STRENGTH) == 20);
+    }
+    SECTION("changing the proficiency bonus") {
+        new_inputs.proficiency_bonus = 4;
+        REQUIRE(program.update(stats, inputs, new_inputs).ok());
+        require_same_stats(stats, program.evaluate(new_inputs).value(), custom_names);
+        REQUIRE(stats.get_skill_modifier(Skill::ATHLETICS) == 5);
+    }
+    SECTION("changing the hit dice rolls") {
+        new_inputs.hit_dice_rolls = {8, 8, 8};
+        REQUIRE(program.count_update_steps(inputs, new_inputs) == 1);
+        REQUIRE(program.update(stats, inputs, new_inputs).ok());
+        require_same_stats(stats, program.evaluate(new_inputs).value(), custom_names);
+        REQUIRE(stats.get_maximum_hp() == 8 + 3 * (8 + 1));
+    }
+    SECTION("changing everything") {
+        new_inputs = StatInputs{
+            .ability_scores = {8, 9, 10, 11, 12, 13},
+            .proficiency_bonus = 6,
+            .hit_dice_maximum = 12,
+            .hit_dice_rolls = {1},
+        };
+        REQUIRE(program.update(stats, inputs, new_inputs).ok());
+        require_same_stats(stats, program.evaluate(new_inputs).value(), custom_names);
+    }
+}
+
+} // namespace dnd::test
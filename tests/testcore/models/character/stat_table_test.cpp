@@ -0,0 +1,131 @@
+#include <dnd_config.hpp>
+
+#include <core/models/character/stat_table.hpp>
+
+#include <cstddef>
+#include <expected>
+#include <utility>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <core/basic_mechanics/abilities.hpp>
+#include <core/basic_mechanics/skills.hpp>
+#include <core/content.hpp>
+#include <core/errors/errors.hpp>
+#include <core/models/character/character.hpp>
+#include <core/models/character/progression.hpp>
+#include <core/models/character/stat_attribute.hpp>
+#include <core/models/class/class.hpp>
+#include <core/models/effects_provider/class_feature.hpp>
+#include <testcore/minimal_testing_content.hpp>
+#include <testcore/validation/validation_data_mock.hpp>
+
+namespace dnd::test {
+
+static constexpr const char* tags = "[core][models][stats]";
+
+TEST_CASE("Character::calculate_stat_table", tags) {
+    Content content = minimal_testing_content();
+
+    SECTION("the row of the current level matches the stats") {
+        const Character& character = content.get_character_library().get(0).value();
+        std::expected<StatTable, Errors> result = character.calculate_stat_table(content);
+        REQUIRE(result.has_value());
+        const StatTable& table = result.value();
+        REQUIRE(table.get_attributes().size() >= stat_slot_count);
+        const int level = character.get_progression().get_level();
+        for (size_t i = 0; i < stat_slot_count; ++i) {
+            StatSlot slot = static_cast<StatSlot>(i);
+            REQUIRE(table.get_raw(level, slot) == character.get_stats().get_raw(slot));
+        }
+        REQUIRE_FALSE(table.get_raw(0, StatSlot::ARMOR_CLASS).has_value());
+        REQUIRE_FALSE(table.get_raw(21, StatSlot::ARMOR_CLASS).has_value());
+    }
+
+    SECTION("the proficiency bonus and hit points grow with the level") {
+        const Character& character = content.get_character_library().get(0).value();
+        const StatTable table = character.calculate_stat_table(content).value();
+        REQUIRE(table.get_int(1, StatSlot::PROFICIENCY_BONUS) == 2);
+        REQUIRE(table.get_int(5, StatSlot::PROFICIENCY_BONUS) == 3);
+        REQUIRE(table.get_int(20, StatSlot::PROFICIENCY_BONUS) == 6);
+        REQUIRE(table.get_int(5, skill_slot(Skill::ARCANA)) == 2);
+        // the wizard has a d6 hit die, rolled 6, 4, 2, and 5 with a constitution modifier of 1
+        REQUIRE(table.get_int(1, StatSlot::MAXIMUM_HP) == 6 + 6 + 1);
+        REQUIRE(table.get_int(4, StatSlot::MAXIMUM_HP) == 6 + 6 + 4 + 2 + 5 + 4 * 1);
+        // the levels that were not rolled yet use the average of 4
+        REQUIRE(table.get_int(6, StatSlot::MAXIMUM_HP) == 6 + 6 + 4 + 2 + 5 + 4 + 4 + 6 * 1);
+    }
+
+    SECTION("higher level effects apply from their level on") {
+        Class::Data class_data{};
+        set_valid_mock_values(class_data, "Fighter");
+        class_data.spellcasting_data.is_spellcaster = false;
+        ClassFeature::Data& feature_data = class_data.features_data.emplace_back();
+        set_valid_mock_values(feature_data, "Fighting Style");
+        feature_data.class_name = "Fighter";
+        feature_data.class_source_name = "dummy";
+        feature_data.level = 1;
+        feature_data.main_effects_data.stat_changes_data.push_back({.stat_change_str = "AC normal add 1"});
+        feature_data.higher_level_effects_data[5].stat_changes_data.push_back({.stat_change_str = "AC normal add 1"});
+        feature_data.higher_level_effects_data[11].stat_changes_data.push_back({
+            .stat_change_str = "STYLE earliest set 2",
+        });
+        ClassFeature::Data& subclass_feature_data = class_data.features_data.emplace_back();
+        set_valid_mock_values(subclass_feature_data, "Martial Archetype");
+        subclass_feature_data.class_name = "Fighter";
+        subclass_feature_data.class_source_name = "dummy";
+        subclass_feature_data.level = 3;
+        subclass_feature_data.main_effects_data.activation_conditions_data.push_back({
+            .condition_str = "CLASS_LEVEL >= 3",
+        });
+        class_data.subclass_feature_name = "Martial Archetype";
+        class_data.hit_dice_str = "d10";
+        class_data.important_levels_data.feat_levels = {4, 6, 8, 12, 14, 16, 19};
+        content.add_class(Class::create_for(std::move(class_data), content).value());
+
+        Character::Data character_data;
+        set_valid_mock_values(character_data, "Fighter Character");
+        character_data.base_ability_scores_data.strength = 15;
+        character_data.base_ability_scores_data.dexterity = 14;
+        character_data.base_ability_scores_data.constitution = 14;
+        character_data.base_ability_scores_data.intelligence = 8;
+        character_data.base_ability_scores_data.wisdom = 12;
+        character_data.base_ability_scores_data.charisma = 10;
+        character_data.feature_providers_data.species_key = "Human##dummy";
+        character_data.feature_providers_data.class_key = "Fighter##dummy";
+        character_data.progression_data.level = 2;
+        character_data.progression_data.xp = 300;
+        character_data.progression_data.hit_dice_rolls = {10, 7};
+        CreateResult<Character> character_result = Character::create_for(std::move(character_data), content);
+        REQUIRE(character_result.is_valid());
+        Character character = character_result.value();
+
+        const StatTable table = character.calculate_stat_table(content).value();
+        REQUIRE(table.get_int(2, StatSlot::ARMOR_CLASS) == character.get_stats().get_armor_class());
+        REQUIRE(table.get_int(1, StatSlot::ARMOR_CLASS) == 13);
+        REQUIRE(table.get_int(4, StatSlot::ARMOR_CLASS) == 13);
+        REQUIRE(table.get_int(5, StatSlot::ARMOR_CLASS) == 14);
+        REQUIRE(table.get_int(20, StatSlot::ARMOR_CLASS) == 14);
+        // the level 3 roll is the average of 6 and the constitution modifier is 2
+        REQUIRE(table.get_int(3, StatSlot::MAXIMUM_HP) == 10 + 10 + 7 + 6 + 3 * 2);
+        const StatAttribute style("STYLE");
+        REQUIRE(table.get_attributes().back() == style);
+        REQUIRE_FALSE(table.get_int(10, style).has_value());
+        REQUIRE(table.get_int(11, style) == 2);
+        REQUIRE(table.get_int(20, style) == 2);
+
+        // changing the level selects the effects of the new level from the ones collected when creating the character
+        const size_t level_2_effect_count = character.get_active_effects().size();
+        Progression::Data progression_data{.level = 5, .xp = 6500, .hit_dice_rolls = {10, 7, 6, 6, 6}};
+        REQUIRE(character.set_progression(Progression::create(std::move(progression_data)).value(), content).ok());
+        REQUIRE(character.get_active_effects().size() == level_2_effect_count + 1);
+        REQUIRE(character.get_stats().get_armor_class() == table.get_int(5, StatSlot::ARMOR_CLASS));
+        REQUIRE(character.get_stats().get_raw(StatSlot::MAXIMUM_HP) == table.get_raw(5, StatSlot::MAXIMUM_HP));
+
+        REQUIRE(character.recalculate_stats(content).ok());
+        REQUIRE(character.get_active_effects().size() == level_2_effect_count + 1);
+        REQUIRE(character.get_stats().get_armor_class() == table.get_int(5, StatSlot::ARMOR_CLASS));
+    }
+}
+
+} // namespace dnd::test
@@ -0,0 +1,115 @@
+#include <dnd_config.hpp>
+
+#include <core/models/character/stats.hpp>
+
+#include <cstddef>
+#include <expected>
+#include <string_view>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <core/basic_mechanics/abilities.hpp>
+#include <core/basic_mechanics/dice.hpp>
+#include <core/basic_mechanics/skills.hpp>
+#include <core/errors/errors.hpp>
+#include <core/models/character/ability_scores.hpp>
+#include <core/models/character/stat_attribute.hpp>
+#include <core/models/effects/stat_change/identifier_stat_change.hpp>
+#include <core/models/effects/stat_change/literal_stat_change.hpp>
+#include <core/models/effects/stat_change/stat_change.hpp>
+#include <core/utils/string_interner.hpp>
+
+namespace dnd::test {
+
+using namespace std::string_view_literals;
+
+static constexpr const char* tags = "[core][models][stats]";
+
+TEST_CASE("StatAttribute", tags) {
+    SECTION("built-in attributes are resolved to their slots") {
+        REQUIRE(StatAttribute("AC").get_slot() == StatSlot::ARMOR_CLASS);
+        REQUIRE(StatAttribute("PB").get_slot() == StatSlot::PROFICIENCY_BONUS);
+        REQUIRE(StatAttribute("con").get_slot() == ability_slot(Ability::CONSTITUTION));
+        REQUIRE(StatAttribute("str_MAX").get_slot() == ability_maximum_slot(Ability::STRENGTH));
+        REQUIRE(StatAttribute("dex_MOD").get_slot() == ability_modifier_slot(Ability::DEXTERITY));
+        REQUIRE(StatAttribute("wis_SAVE").get_slot() == ability_save_slot(Ability::WISDOM));
+        REQUIRE(StatAttribute("STEALTH").get_slot() == skill_slot(Skill::STEALTH));
+        REQUIRE_FALSE(StatAttribute("SURVIVAL").is_custom());
+    }
+    SECTION("other attributes are custom") {
+        REQUIRE(StatAttribute("MY_VALUE").is_custom());
+        REQUIRE(StatAttribute("DEX_MOD").is_custom());
+        REQUIRE(StatAttribute("MY_VALUE").get_name() == "MY_VALUE");
+    }
+    SECTION("every slot has a distinct name") {
+        for (size_t i = 0; i < stat_slot_count; ++i) {
+            StatSlot slot = static_cast<StatSlot>(i);
+            REQUIRE(stat_slot_from_name(stat_slot_name(slot).str()) == slot);
+            REQUIRE(StatAttribute(slot) == StatAttribute(stat_slot_name(slot).str()));
+        }
+    }
+}
+
+TEST_CASE("Stats::create", tags) {
+    AbilityScores ability_scores = AbilityScores::create(AbilityScores::Data{
+        .strength = 10, .dexterity = 14, .constitution = 13, .intelligence = 16, .wisdom = 12, .charisma = 8
+    }).value();
+    Dice hit_dice = Dice::single_from_int(8).value();
+    std::vector<int> hit_dice_rolls = {5, 6};
+
+    SECTION("without stat changes") {
+        std::expected<Stats, Errors> result = Stats::create(ability_scores, 2, {}, hit_dice, hit_dice_rolls);
+        REQUIRE(result.has_value());
+        const Stats& stats = result.value();
+        REQUIRE(stats.is_complete());
+        REQUIRE(stats.get_ability_score(Ability::DEXTERITY) == 14);
+        REQUIRE(stats.get_ability_modifier(Ability::DEXTERITY) == 2);
+        REQUIRE(stats.get_ability_modifier(Ability::CHARISMA) == -1);
+        REQUIRE(stats.get_ability_max_score(Ability::STRENGTH) == 20);
+        REQUIRE(stats.get_ability_save_modifier(Ability::INTELLIGENCE) == 3);
+        REQUIRE(stats.get_skill_modifier(Skill::ARCANA) == 3);
+        REQUIRE(stats.get_armor_class() == 12);
+        REQUIRE(stats.get_initiative() == 2);
+        REQUIRE(stats.get_maximum_hp() == 8 + 5 + 1 + 6 + 1);
+        REQUIRE(stats.get_speed() == 0);
+        REQUIRE(stats.get_int("PB") == 2);
+        REQUIRE(stats.get_int("int_MOD") == 3);
+        REQUIRE_FALSE(stats.get_int("SPEED").has_value());
+        REQUIRE_FALSE(stats.get_int("NEVER_USED_ATTRIBUTE").has_value());
+
+        Stats mutable_stats = stats;
+        REQUIRE(mutable_stats.get_raw_mut("int_MOD").has_value());
+        REQUIRE_FALSE(mutable_stats.get_raw_mut("NEVER_WRITTEN_ATTRIBUTE").has_value());
+        // looking up a name must not add it to the interner
+        REQUIRE_FALSE(StringInterner::get().find("NEVER_WRITTEN_ATTRIBUTE").has_value());
+    }
+    SECTION("with stat changes") {
+        LiteralStatChange strength_bonus("str"sv, StatChangeTime::NORMAL, StatChangeOperation::ADD, 12);
+        LiteralStatChange speed("SPEED"sv, StatChangeTime::EARLIEST, StatChangeOperation::SET, 30);
+        LiteralStatChange custom_value("MY_VALUE"sv, StatChangeTime::EARLIEST, StatChangeOperation::SET, 1.5f);
+        IdentifierStatChange armor_class("AC"sv, StatChangeTime::NORMAL, StatChangeOperation::ADD, "str_MOD"sv);
+        IdentifierStatChange multiplied_speed("SPEED"sv, StatChangeTime::LATE, StatChangeOperation::MULT, "MY_VALUE"sv);
+        std::vector<StatChangeInstruction> program = {
+            strength_bonus.get_instruction(), speed.get_instruction(), custom_value.get_instruction(),
+            armor_class.get_instruction(), multiplied_speed.get_instruction(),
+        };
+
+        std::expected<Stats, Errors> result = Stats::create(ability_scores, 2, program, hit_dice, hit_dice_rolls);
+        REQUIRE(result.has_value());
+        const Stats& stats = result.value();
+        REQUIRE(stats.get_ability_score(Ability::STRENGTH) == 20);
+        REQUIRE(stats.get_ability_modifier(Ability::STRENGTH) == 5);
+        REQUIRE(stats.get_skill_modifier(Skill::ATHLETICS) == 5);
+        REQUIRE(stats.get_armor_class() == 17);
+        REQUIRE(stats.get_float("MY_VALUE") == 1.5f);
+        REQUIRE(stats.get_speed() == 45);
+    }
+    SECTION("with a stat change reading an unknown attribute") {
+        IdentifierStatChange unknown("AC"sv, StatChangeTime::NORMAL, StatChangeOperation::ADD, "UNKNOWN_VALUE"sv);
+        std::vector<StatChangeInstruction> program = {unknown.get_instruction()};
+        REQUIRE_FALSE(Stats::create(ability_scores, 2, program, hit_dice, hit_dice_rolls).has_value());
+    }
+}
+
+} // namespace dnd::test
@@ -16,4 +16,11 @@ TEST_CASE("parse_content // providing invalid directory to parsing function", ta
     REQUIRE_FALSE(result.errors.ok());
 }
 
+TEST_CASE("parse_content // parallel parsing of an invalid directory", tags) {
+    std::set<std::filesystem::path> content_paths = {"/this/directory/doesnt/exist"};
+    ParsingResult result = parse_content(content_paths, ParsingMode::PARALLEL);
+    REQUIRE_FALSE(result.errors.ok());
+    REQUIRE(result.content.empty());
+}
+
 } // namespace dnd::test
@@ -0,0 +1,229 @@
+#include <dnd_config.hpp>
+
+#include <core/parsing/content_snapshot.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include <catch2/catch_test_macros.hpp>
+#include <nlohmann/json.hpp>
+
+#include <core/errors/errors.hpp>
+#include <core/errors/validation_error.hpp>
+#include <core/models/spell/spell.hpp>
+#include <core/parsing/parser.hpp>
+#include <core/parsing/snapshot_serialization.hpp>
+#include <core/text/formatted_text.hpp>
+
+namespace dnd::test {
+
+static constexpr const char* tags = "[core][parsing]";
+
+static Spell::Data example_spell_data() {
+    Spell::Data data;
+    data.name = "Fire Bolt";
+    data.description = FormattedText::simple("You hurl a mote of fire at a creature or object within range.");
+    data.source_path = "/path/to/spells.json";
+    data.source_name = "PHB";
+    data.components_data = {.verbal = true, .somatic = true, .material_components = ""};
+    data.type_data = {.level = 0, .magic_school_char = 'V', .ritual = false};
+    data.concentration = false;
+    data.casting_time = "1 action";
+    data.range = "120 feet";
+    data.duration = "Instantaneous";
+    data.classes = {"Sorcerer|PHB", "Wizard|PHB"};
+    return data;
+}
+
+TEST_CASE("snapshot_serialization // round trip", tags) {
+    SnapshotWriter writer;
+    const Spell::Data spell_data = example_spell_data();
+    serialize(writer, spell_data);
+    Errors errors;
+    errors.add_parsing_error(ParsingError::Code::INVALID_FILE_FORMAT, "/path/to/file.json", "error message");
+    serialize(writer, errors);
+
+    SnapshotReader reader(writer.get_buffer());
+    Spell::Data read_spell_data;
+    Errors read_errors;
+    deserialize(reader, read_spell_data);
+    deserialize(reader, read_errors);
+    REQUIRE(reader.ok());
+    REQUIRE(reader.at_end());
+    REQUIRE(read_spell_data == spell_data);
+    REQUIRE(read_errors.get_errors().size() == 1);
+    REQUIRE(std::get<ParsingError>(read_errors.get_errors()[0]).get_error_message() == "error message");
+}
+
+TEST_CASE("snapshot_serialization // formatted text round trip", tags) {
+    nlohmann::json json = R"({"entries": [
+        "Cast {@spell Fireball|PHB|page=241} {@b now}:",
+        {"type": "list", "items": ["first", {"type": "item", "name": "Second", "entry": "{@i second}"}]},
+        {"type": "table", "caption": "Damage", "colLabels": ["Level", "Dice"], "colStyles": ["col-2", "col-10"],
+         "rows": [["1", "{@dice 1d6}"], [5, "2d6"]]}
+    ]})"_json;
+    FormattedText text;
+    REQUIRE_FALSE(write_formatted_text_into(json, text, "test.json").has_value());
+
+    SnapshotWriter writer;
+    serialize(writer, text);
+    SnapshotReader reader(writer.get_buffer());
+    FormattedText read_text;
+    deserialize(reader, read_text);
+    REQUIRE(reader.ok());
+    REQUIRE(reader.at_end());
+    REQUIRE(read_text == text);
+}
+
+TEST_CASE("snapshot_serialization // truncated buffer", tags) {
+    SnapshotWriter writer;
+    serialize(writer, example_spell_data());
+    const std::string truncated_buffer = writer.get_buffer().substr(0, writer.get_buffer().size() / 2);
+
+    SnapshotReader reader(truncated_buffer);
+    Spell::Data read_spell_data;
+    deserialize(reader, read_spell_data);
+    REQUIRE_FALSE(reader.ok());
+}
+
+TEST_CASE("snapshot_serialization // corrupted sizes", tags) {
+    SECTION("a string longer than the buffer is rejected before it is allocated") {
+        SnapshotWriter writer;
+        serialize<uint64_t>(writer, static_cast<uint64_t>(-1));
+        writer.write_bytes("abc", 3);
+        SnapshotReader reader(writer.get_buffer());
+        std::string str = "unchanged";
+        deserialize(reader, str);
+        REQUIRE_FALSE(reader.ok());
+        REQUIRE(str == "unchanged");
+    }
+    SECTION("a map with more elements than the buffer holds is rejected") {
+        SnapshotWriter writer;
+        serialize<uint64_t>(writer, static_cast<uint64_t>(-1));
+        serialize(writer, std::string("key"));
+        serialize(writer, 1);
+        SnapshotReader reader(writer.get_buffer());
+        std::unordered_map<std::string, int> map;
+        deserialize(reader, map);
+        REQUIRE_FALSE(reader.ok());
+    }
+    SECTION("a bool that is neither 0 nor 1 is rejected") {
+        SnapshotWriter writer;
+        serialize<uint8_t>(writer, 2);
+        SnapshotReader reader(writer.get_buffer());
+        bool value = false;
+        deserialize(reader, value);
+        REQUIRE_FALSE(reader.ok());
+        REQUIRE_FALSE(value);
+    }
+    SECTION("an enum value out of the range of the enum is rejected") {
+        SnapshotWriter writer;
+        serialize<uint8_t>(writer, static_cast<uint8_t>(FormattedTextNodeType::LINK) + 1);
+        serialize<int>(writer, -1);
+        SnapshotReader reader(writer.get_buffer());
+        FormattedTextNodeType type = FormattedTextNodeType::PARAGRAPH;
+        deserialize(reader, type);
+        REQUIRE_FALSE(reader.ok());
+        REQUIRE(type == FormattedTextNodeType::PARAGRAPH);
+
+        SnapshotReader signed_reader(std::string_view(writer.get_buffer()).substr(sizeof(uint8_t)));
+        ValidationError::Code code = ValidationError::Code::MISSING_ATTRIBUTE;
+        deserialize(signed_reader, code);
+        REQUIRE_FALSE(signed_reader.ok());
+    }
+}
+
+TEST_CASE("ContentSnapshot // save, load, and find files", tags) {
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "dnd_content_snapshot_test";
+    std::filesystem::create_directories(directory);
+    const std::filesystem::path content_file = directory / "content.json";
+    const std::filesystem::path snapshot_file = directory / "content_snapshot.bin";
+    {
+        std::ofstream file(content_file);
+        file << "{}";
+    }
+
+    std::optional<FileFingerprint> fingerprint = fingerprint_file(content_file);
+    REQUIRE(fingerprint.has_value());
+    REQUIRE(fingerprint->size == 2);
+    REQUIRE_FALSE(fingerprint_file(directory / "missing.json").has_value());
+
+    ContentSnapshot snapshot;
+    snapshot.add(
+        content_file,
+        FileSnapshot{
+            .fingerprint = fingerprint.value(),
+            .dependency_hash = 0,
+            .ready_to_save = true,
+            .errors = {},
+            .parsed_data = "parsed data",
+        }
+    );
+    REQUIRE(snapshot.save(snapshot_file));
+
+    SECTION("loading restores the files") {
+        std::optional<ContentSnapshot> loaded_snapshot = ContentSnapshot::load(snapshot_file);
+        REQUIRE(loaded_snapshot.has_value());
+        REQUIRE(loaded_snapshot->size() == 1);
+        const FileSnapshot* file_snapshot = loaded_snapshot->find(content_file, fingerprint.value(), 0);
+        REQUIRE(file_snapshot != nullptr);
+        REQUIRE(file_snapshot->parsed_data == "parsed data");
+    }
+    SECTION("outdated files are not found") {
+        FileFingerprint changed_fingerprint = fingerprint.value();
+        changed_fingerprint.content_hash += 1;
+        REQUIRE(snapshot.find(content_file, changed_fingerprint, 0) == nullptr);
+        REQUIRE(snapshot.find(content_file, fingerprint.value(), 1) == nullptr);
+        REQUIRE(snapshot.find(directory / "other.json", fingerprint.value(), 0) == nullptr);
+    }
+    SECTION("files reported as unchanged keep their fingerprint") {
+        REQUIRE_FALSE(snapshot.get_unchanged_fingerprint(content_file).has_value());
+        snapshot.set_unchanged_except({directory / "other.json"});
+        REQUIRE(snapshot.get_unchanged_fingerprint(content_file) == fingerprint);
+        snapshot.set_unchanged_except({content_file});
+        REQUIRE_FALSE(snapshot.get_unchanged_fingerprint(content_file).has_value());
+    }
+    SECTION("files are only hashed if their modification time or size changed") {
+        FileFingerprint previous_fingerprint = fingerprint.value();
+        previous_fingerprint.content_hash += 1;
+        REQUIRE(fingerprint_file(content_file, &previous_fingerprint) == previous_fingerprint);
+        previous_fingerprint.size += 1;
+        REQUIRE(fingerprint_file(content_file, &previous_fingerprint) == fingerprint);
+        REQUIRE(snapshot.find_fingerprint(content_file) != nullptr);
+        REQUIRE(*snapshot.find_fingerprint(content_file) == fingerprint);
+        REQUIRE(snapshot.find_fingerprint(directory / "other.json") == nullptr);
+    }
+    SECTION("corrupted snapshots are not loaded") {
+        {
+            std::ofstream file(snapshot_file, std::ios::binary | std::ios::trunc);
+            file << "not a snapshot";
+        }
+        REQUIRE_FALSE(ContentSnapshot::load(snapshot_file).has_value());
+    }
+    SECTION("snapshots with corrupted sizes are not loaded") {
+        std::string buffer;
+        {
+            std::ifstream file(snapshot_file, std::ios::binary);
+            buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        }
+        // the last bytes are the parsed data, preceded by its size
+        const size_t size_position = buffer.size() - std::string("parsed data").size() - sizeof(uint64_t);
+        buffer.replace(size_position, sizeof(uint64_t), sizeof(uint64_t), '\xff');
+        {
+            std::ofstream file(snapshot_file, std::ios::binary | std::ios::trunc);
+            file << buffer;
+        }
+        REQUIRE_FALSE(ContentSnapshot::load(snapshot_file).has_value());
+    }
+
+    std::filesystem::remove_all(directory);
+}
+
+} // namespace dnd::test
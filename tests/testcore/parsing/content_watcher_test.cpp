@@ -0,0 +1,45 @@
+#include <dnd_config.hpp>
+
+#include <core/parsing/content_watcher.hpp>
+
+#include <filesystem>
+#include <fstream>
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace dnd::test {
+
+static constexpr const char* tags = "[core][parsing]";
+
+TEST_CASE("ContentWatcher // reports changed content files", tags) {
+    if (!ContentWatcher::is_supported()) {
+        return;
+    }
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "dnd_content_watcher_test";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory / "spells");
+
+    ContentWatcher watcher;
+    watcher.watch({directory});
+    REQUIRE(watcher.poll_changes().empty());
+
+    {
+        std::ofstream file(directory / "spells" / "spells-homebrew.json");
+        file << "{}";
+        std::ofstream other_file(directory / "notes.txt");
+        other_file << "not content";
+    }
+    ContentChanges changes = watcher.poll_changes();
+    REQUIRE_FALSE(changes.incomplete);
+    REQUIRE(changes.files.size() == 1);
+    REQUIRE(changes.files.contains(directory / "spells" / "spells-homebrew.json"));
+    REQUIRE(watcher.poll_changes().empty());
+
+    std::filesystem::create_directory(directory / "characters");
+    REQUIRE(watcher.poll_changes().incomplete);
+
+    watcher.stop();
+    std::filesystem::remove_all(directory);
+}
+
+} // namespace dnd::test
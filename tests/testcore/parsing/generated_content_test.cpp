@@ -0,0 +1,351 @@
+#include <dnd_config.hpp>
+
+#include <core/parsing/content_parsing.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <nlohmann/json.hpp>
+
+#include <core/basic_mechanics/abilities.hpp>
+#include <core/content.hpp>
+#include <core/errors/errors.hpp>
+#include <core/groups.hpp>
+#include <core/models/character/character.hpp>
+#include <core/models/effects_provider/class_feature.hpp>
+#include <core/models/spell/spell.hpp>
+#include <core/parsing/content_serialization.hpp>
+#include <core/parsing/content_snapshot.hpp>
+#include <core/parsing/lazy_text_parsing.hpp>
+#include <core/parsing/snapshot_serialization.hpp>
+#include <core/storage_content_library.hpp>
+#include <core/text/formatted_text.hpp>
+#include <core/types.hpp>
+#include <core/utils/worker_pool.hpp>
+#include <corpus/content_generator.hpp>
+#include <x/content_pieces.hpp>
+
+namespace dnd::test {
+
+static constexpr const char* tags = "[core][parsing][generated]";
+
+static std::string read_file(const std::filesystem::path& filepath) {
+    std::ifstream file(filepath);
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    return buffer.str();
+}
+
+static nlohmann::ordered_json read_json(const std::filesystem::path& filepath) {
+    std::ifstream file(filepath);
+    return nlohmann::ordered_json::parse(file);
+}
+
+static void write_json(const std::filesystem::path& filepath, const nlohmann::ordered_json& json) {
+    std::ofstream file(filepath, std::ios::trunc);
+    file << json.dump(4);
+}
+
+static std::vector<std::string> node_texts(const FormattedText& text) {
+    std::vector<std::string> texts;
+    for (FormattedTextNode node : text.get_all_nodes()) {
+        texts.emplace_back(node.get_text());
+    }
+    return texts;
+}
+
+// the IDs of the content pieces are their positions, so equal keys in the same order mean equal IDs
+template <typename T>
+static std::vector<std::string> keys_in_id_order(const std::vector<T>& content_pieces) {
+    std::vector<std::string> keys;
+    for (const T& content_piece : content_pieces) {
+        keys.push_back(content_piece.get_key());
+    }
+    return keys;
+}
+
+template <typename T>
+static std::vector<std::string> keys_in_id_order(const std::vector<CRef<T>>& content_pieces) {
+    std::vector<std::string> keys;
+    for (const T& content_piece : content_pieces) {
+        keys.push_back(content_piece.get_key());
+    }
+    return keys;
+}
+
+template <typename T>
+static std::vector<typename T::Data> draft_data(const StorageContentLibrary<T>& library) {
+    std::vector<typename T::Data> data;
+    for (const auto& [draft_data, draft_errors] : library.get_drafts()) {
+        data.push_back(draft_data);
+    }
+    return data;
+}
+
+static std::vector<std::string> error_messages(const Errors& errors) {
+    std::vector<std::string> messages;
+    for (const Error& error : errors.get_errors()) {
+        std::visit(
+            [&messages](const auto& specific_error) { messages.push_back(specific_error.get_error_message()); },
+            error
+        );
+    }
+    return messages;
+}
+
+TEST_CASE("generate_content // same seed generates the same content", tags) {
+    const std::filesystem::path first_directory = std::filesystem::temp_directory_path() / "dnd_generated_first";
+    const std::filesystem::path second_directory = std::filesystem::temp_directory_path() / "dnd_generated_second";
+    bench::ContentGeneratorOptions options{.seed = 42, .error_rate = 0.1};
+    bench::generate_content(first_directory, options);
+    bench::generate_content(second_directory, options);
+
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(first_directory)) {
+        if (!entry.is_regular_file()) {
+            continue;
+        }
+        std::filesystem::path relative_path = std::filesystem::relative(entry.path(), first_directory);
+        REQUIRE(std::filesystem::exists(second_directory / relative_path));
+        REQUIRE(read_file(entry.path()) == read_file(second_directory / relative_path));
+    }
+
+    std::filesystem::remove_all(first_directory);
+    std::filesystem::remove_all(second_directory);
+}
+
+TEST_CASE("parse_content // generated content without errors", tags) {
+    const std::filesystem::path content_directory = std::filesystem::temp_directory_path() / "dnd_generated_valid";
+    bench::ContentGeneratorOptions options{.seed = 7};
+    bench::generate_content(content_directory, options);
+
+    ParsingResult result = parse_content({content_directory}, ParsingMode::PARALLEL);
+    REQUIRE(result.errors.ok());
+    const Content& content = result.content;
+    REQUIRE(content.get_spell_library().size() == options.spell_count);
+    REQUIRE(content.get_class_library().size() == options.class_count);
+    REQUIRE(content.get_subclass_library().size() == options.class_count * options.subclass_count);
+    REQUIRE(content.get_species_library().size() == options.species_count);
+    REQUIRE(content.get_subspecies_library().size() == options.species_count * options.subspecies_count);
+    REQUIRE(content.get_choosable_library().size() == options.feat_count);
+    REQUIRE(content.get_character_library().size() == options.character_count);
+
+    std::filesystem::remove_all(content_directory);
+}
+
+TEST_CASE("parse_content // generated content with errors", tags) {
+    const std::filesystem::path content_directory = std::filesystem::temp_directory_path() / "dnd_generated_invalid";
+    bench::ContentGeneratorOptions options{.seed = 7, .error_rate = 0.5};
+    bench::generate_content(content_directory, options);
+
+    ParsingResult result = parse_content({content_directory}, ParsingMode::PARALLEL);
+    REQUIRE_FALSE(result.errors.ok());
+
+    std::filesystem::remove_all(content_directory);
+}
+
+TEST_CASE("parse_content // sequential and parallel parsing of generated content give the same result", tags) {
+    const std::filesystem::path content_directory = std::filesystem::temp_directory_path() / "dnd_generated_modes";
+    bench::ContentGeneratorOptions options{.seed = 13, .error_rate = 0.2};
+    bench::generate_content(content_directory, options);
+
+    ParsingResult sequential_result = parse_content({content_directory}, ParsingMode::SEQUENTIAL);
+    ParsingResult parallel_result = parse_content({content_directory}, ParsingMode::PARALLEL);
+    REQUIRE_FALSE(sequential_result.errors.ok());
+    REQUIRE(error_messages(parallel_result.errors) == error_messages(sequential_result.errors));
+    const Content& sequential_content = sequential_result.content;
+    const Content& parallel_content = parallel_result.content;
+
+#define X(C, U, j, a, p, P)                                                                                            \
+    REQUIRE(keys_in_id_order(parallel_content.get_all_##p()) == keys_in_id_order(sequential_content.get_all_##p()));
+    X_CONTENT_PIECES
+#undef X
+#define X(C, U, j, a, p, P)                                                                                            \
+    REQUIRE(                                                                                                           \
+        parallel_content.get_##j##_library().get_drafts().size()                                                       \
+        == sequential_content.get_##j##_library().get_drafts().size()                                                  \
+    );
+    X_OWNED_CONTENT_PIECES
+#undef X
+    REQUIRE(parallel_result.content_paths == sequential_result.content_paths);
+
+    std::filesystem::remove_all(content_directory);
+}
+
+TEST_CASE("parse_content // lazily parsed descriptions equal the eagerly parsed ones", tags) {
+    const std::filesystem::path content_directory = std::filesystem::temp_directory_path() / "dnd_generated_lazy";
+    bench::ContentGeneratorOptions options{.seed = 11};
+    bench::generate_content(content_directory, options);
+
+    ParsingResult eager_result = parse_content({content_directory}, ParsingMode::PARALLEL);
+    ParsingResult lazy_result = parse_content(
+        {content_directory}, ParsingMode::PARALLEL, nullptr, DescriptionParsing::LAZY
+    );
+    REQUIRE(lazy_result.errors.ok());
+    const Content& eager_content = eager_result.content;
+    const Content& lazy_content = lazy_result.content;
+
+    REQUIRE(lazy_content.get_all_spells().size() == eager_content.get_all_spells().size());
+    for (size_t i = 0; i < eager_content.get_all_spells().size(); ++i) {
+        REQUIRE(
+            node_texts(lazy_content.get_all_spells()[i].get_description())
+            == node_texts(eager_content.get_all_spells()[i].get_description())
+        );
+    }
+    REQUIRE(lazy_content.get_all_class_features().size() == eager_content.get_all_class_features().size());
+    for (size_t i = 0; i < eager_content.get_all_class_features().size(); ++i) {
+        REQUIRE(
+            node_texts(lazy_content.get_all_class_features()[i].get().get_description())
+            == node_texts(eager_content.get_all_class_features()[i].get().get_description())
+        );
+    }
+
+    std::filesystem::remove_all(content_directory);
+}
+
+TEST_CASE("parse_content // the built content is restored from the snapshot while no file changed", tags) {
+    const std::filesystem::path content_directory = std::filesystem::temp_directory_path() / "dnd_generated_built";
+    bench::ContentGeneratorOptions options{.seed = 19, .error_rate = 0.2};
+    bench::generate_content(content_directory, options);
+    const std::filesystem::path spells_filepath = content_directory / "spells" / "spells-0.json";
+
+    ContentSnapshot snapshot;
+    ParsingResult parsed_result = parse_content(
+        {content_directory}, ParsingMode::PARALLEL, &snapshot, DescriptionParsing::LAZY
+    );
+    REQUIRE(snapshot.get_built_content() != nullptr);
+
+    SECTION("the restored content equals the parsed content") {
+        ParsingResult restored_result = parse_content(
+            {content_directory}, ParsingMode::PARALLEL, &snapshot, DescriptionParsing::LAZY
+        );
+        REQUIRE(snapshot.get_built_content() != nullptr);
+        REQUIRE(error_messages(restored_result.errors) == error_messages(parsed_result.errors));
+        const Content& parsed_content = parsed_result.content;
+        const Content& restored_content = restored_result.content;
+#define X(C, U, j, a, p, P)                                                                                            \
+    REQUIRE(keys_in_id_order(restored_content.get_all_##p()) == keys_in_id_order(parsed_content.get_all_##p()));
+        X_CONTENT_PIECES
+#undef X
+#define X(C, U, j, a, p, P)                                                                                            \
+    REQUIRE(                                                                                                           \
+        draft_data(restored_content.get_##j##_library()) == draft_data(parsed_content.get_##j##_library())             \
+    );
+        X_OWNED_CONTENT_PIECES
+#undef X
+        const Groups& groups = restored_content.get_groups();
+        REQUIRE(groups.get_all_group_names() == parsed_content.get_groups().get_all_group_names());
+        for (const std::string& group_name : groups.get_all_group_names()) {
+            REQUIRE(groups.get_group(group_name) == parsed_content.get_groups().get_group(group_name));
+        }
+        for (size_t i = 0; i < parsed_content.get_all_spells().size(); ++i) {
+            REQUIRE(
+                node_texts(restored_content.get_all_spells()[i].get_description())
+                == node_texts(parsed_content.get_all_spells()[i].get_description())
+            );
+        }
+        for (size_t i = 0; i < parsed_content.get_all_characters().size(); ++i) {
+            const Stats& stats = restored_content.get_all_characters()[i].get_stats();
+            const Stats& parsed_stats = parsed_content.get_all_characters()[i].get_stats();
+            REQUIRE(stats.get_maximum_hp() == parsed_stats.get_maximum_hp());
+            REQUIRE(stats.get_armor_class() == parsed_stats.get_armor_class());
+            for (Ability ability : {Ability::STRENGTH, Ability::DEXTERITY, Ability::CHARISMA}) {
+                REQUIRE(stats.get_ability_score(ability) == parsed_stats.get_ability_score(ability));
+            }
+        }
+    }
+    SECTION("the content is taken from the snapshot instead of the files") {
+        BuiltContentSnapshot built_content = *snapshot.get_built_content();
+        SnapshotWriter writer;
+        ContentSerializer::write(writer, Content());
+        built_content.content_data = writer.take_buffer();
+        snapshot.set_built_content(std::move(built_content));
+        ParsingResult restored_result = parse_content(
+            {content_directory}, ParsingMode::PARALLEL, &snapshot, DescriptionParsing::LAZY
+        );
+        REQUIRE(restored_result.content.empty());
+    }
+    SECTION("the content is parsed if a file changed") {
+        nlohmann::ordered_json spells_json = read_json(spells_filepath);
+        spells_json["spell"].erase(0);
+        write_json(spells_filepath, spells_json);
+        ParsingResult reparsed_result = parse_content(
+            {content_directory}, ParsingMode::PARALLEL, &snapshot, DescriptionParsing::LAZY
+        );
+        REQUIRE(reparsed_result.content.get_all_spells().size() + 1 == parsed_result.content.get_all_spells().size());
+        REQUIRE(snapshot.get_built_content() != nullptr);
+    }
+    SECTION("the content is parsed if the descriptions are parsed differently") {
+        ParsingResult eager_result = parse_content({content_directory}, ParsingMode::PARALLEL, &snapshot);
+        REQUIRE(snapshot.get_built_content()->description_parsing == DescriptionParsing::EAGER);
+        REQUIRE(
+            keys_in_id_order(eager_result.content.get_all_spells())
+            == keys_in_id_order(parsed_result.content.get_all_spells())
+        );
+    }
+
+    std::filesystem::remove_all(content_directory);
+}
+
+TEST_CASE("reparse_changed_files // generated content", tags) {
+    const std::filesystem::path content_directory = std::filesystem::temp_directory_path() / "dnd_generated_reparse";
+    bench::ContentGeneratorOptions options{.seed = 17};
+    bench::generate_content(content_directory, options);
+    const std::filesystem::path spells_filepath = content_directory / "spells" / "spells-0.json";
+    WorkerPool worker_pool(2);
+
+    ParsingResult result = parse_content({content_directory}, ParsingMode::PARALLEL);
+    REQUIRE(result.errors.ok());
+    Content& content = result.content;
+    nlohmann::ordered_json spells_json = read_json(spells_filepath);
+    nlohmann::ordered_json& changed_spell = spells_json["spell"][0];
+
+    SECTION("a changed spell is replaced in place") {
+        changed_spell["level"] = (changed_spell["level"].get<int>() + 1) % 10;
+        write_json(spells_filepath, spells_json);
+        REQUIRE(reparse_changed_files(
+            content, result.errors, {content_directory}, {spells_filepath}, nullptr, DescriptionParsing::EAGER,
+            worker_pool
+        ));
+        REQUIRE(result.errors.ok());
+
+        ParsingResult fresh_result = parse_content({content_directory}, ParsingMode::PARALLEL);
+        const Content& fresh_content = fresh_result.content;
+#define X(C, U, j, a, p, P)                                                                                            \
+    REQUIRE(keys_in_id_order(content.get_all_##p()) == keys_in_id_order(fresh_content.get_all_##p()));
+        X_CONTENT_PIECES
+#undef X
+        for (size_t i = 0; i < fresh_content.get_all_spells().size(); ++i) {
+            const Spell& spell = content.get_all_spells()[i];
+            const Spell& fresh_spell = fresh_content.get_all_spells()[i];
+            REQUIRE(spell.get_type().get_spell_level() == fresh_spell.get_type().get_spell_level());
+            REQUIRE(spell.get_classes() == fresh_spell.get_classes());
+            REQUIRE(node_texts(spell.get_description()) == node_texts(fresh_spell.get_description()));
+        }
+    }
+    SECTION("a spell that became invalid requires parsing all content") {
+        changed_spell.erase("school");
+        write_json(spells_filepath, spells_json);
+        REQUIRE_FALSE(reparse_changed_files(
+            content, result.errors, {content_directory}, {spells_filepath}, nullptr, DescriptionParsing::EAGER,
+            worker_pool
+        ));
+    }
+    SECTION("a removed spell requires parsing all content") {
+        spells_json["spell"].erase(0);
+        write_json(spells_filepath, spells_json);
+        REQUIRE_FALSE(reparse_changed_files(
+            content, result.errors, {content_directory}, {spells_filepath}, nullptr, DescriptionParsing::EAGER,
+            worker_pool
+        ));
+    }
+
+    std::filesystem::remove_all(content_directory);
+}
+
+} // namespace dnd::test
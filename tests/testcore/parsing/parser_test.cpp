@@ -0,0 +1,143 @@
+#include <dnd_config.hpp>
+
+#include <core/parsing/parser.hpp>
+
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <nlohmann/json.hpp>
+
+#include <core/errors/errors.hpp>
+#include <core/text/formatted_text.hpp>
+#include <core/text/formatted_text_writer.hpp>
+
+namespace dnd::test {
+
+static constexpr const char* tags = "[core][parsing]";
+
+static std::vector<FormattedTextNode> collect(FormattedTextNode::Range range) {
+    std::vector<FormattedTextNode> nodes;
+    for (FormattedTextNode node : range) {
+        nodes.push_back(node);
+    }
+    return nodes;
+}
+
+/**
+ * @brief Parses a paragraph into a new text and returns the error, the paragraph is the only part of the text
+ */
+static std::optional<Error> parse_single_paragraph(std::string_view str, FormattedText& text) {
+    FormattedTextWriter writer(text);
+    uint32_t paragraph_index = writer.begin_node(FormattedTextNodeType::PARAGRAPH);
+    std::optional<Error> error = parse_paragraph(str, writer, "test.json");
+    writer.end_node(paragraph_index);
+    return error;
+}
+
+TEST_CASE("parse_paragraph // formatting and links", tags) {
+    FormattedText text;
+    std::optional<Error> error = parse_single_paragraph(
+        "Cast {@spell Fireball|PHB} {@b for {@i big} damage} now", text
+    );
+    REQUIRE_FALSE(error.has_value());
+    std::vector<FormattedTextNode> parts = collect((*text.get_parts().begin()).get_children());
+    REQUIRE(parts.size() == 7);
+
+    REQUIRE(parts[0].get_text() == "Cast ");
+    REQUIRE(parts[1].get_type() == FormattedTextNodeType::LINK);
+    REQUIRE(parts[1].get_text() == "Fireball");
+    std::vector<FormattedTextAttribute> attributes;
+    for (FormattedTextAttribute attribute : parts[1].get_attributes()) {
+        attributes.push_back(attribute);
+    }
+    REQUIRE(attributes.size() == 1);
+    REQUIRE(attributes[0].value == "PHB");
+    REQUIRE(parts[2].get_text() == " ");
+
+    REQUIRE(parts[3].get_text() == "for ");
+    REQUIRE((parts[3].is_bold() && !parts[3].is_italic()));
+    REQUIRE(parts[4].get_text() == "big");
+    REQUIRE((parts[4].is_bold() && parts[4].is_italic()));
+    REQUIRE(parts[5].get_text() == " damage");
+    REQUIRE(parts[6].get_text() == " now");
+    REQUIRE((!parts[6].is_bold() && !parts[6].is_italic()));
+}
+
+TEST_CASE("parse_paragraph // scaled dice swap the text with the last attribute", tags) {
+    FormattedText text;
+    REQUIRE_FALSE(parse_single_paragraph("{@scaledamage 2d6|3-9|1d6}", text).has_value());
+    std::vector<FormattedTextNode> parts = collect((*text.get_parts().begin()).get_children());
+    REQUIRE(parts.size() == 1);
+    REQUIRE(parts[0].get_text() == "1d6");
+    std::optional<std::string_view> last_value;
+    for (FormattedTextAttribute attribute : parts[0].get_attributes()) {
+        last_value = attribute.value;
+    }
+    REQUIRE(last_value == "2d6");
+}
+
+TEST_CASE("parse_paragraph // incomplete tags are kept as text", tags) {
+    FormattedText text;
+    REQUIRE_FALSE(parse_single_paragraph("a {b} {@spell unterminated", text).has_value());
+    std::vector<FormattedTextNode> parts = collect((*text.get_parts().begin()).get_children());
+    REQUIRE(parts.size() == 1);
+    REQUIRE(parts[0].get_text() == "a {b} {@spell unterminated");
+}
+
+TEST_CASE("parse_paragraph // formatting tags cannot have attributes", tags) {
+    FormattedText text;
+    REQUIRE(parse_single_paragraph("{@b bold|attribute}", text).has_value());
+}
+
+TEST_CASE("write_formatted_text_into // lists", tags) {
+    FormattedText text;
+
+    SECTION("a list takes the paragraph that introduces it") {
+        nlohmann::json json = R"({"entries": [
+            "Choose one of the following:",
+            {"type": "list", "items": ["{@b first}", "second", ""]}
+        ]})"_json;
+        REQUIRE_FALSE(write_formatted_text_into(json, text, "test.json").has_value());
+        std::vector<FormattedTextNode> parts = collect(text.get_parts());
+        REQUIRE(parts.size() == 1);
+        REQUIRE(parts[0].get_type() == FormattedTextNodeType::LIST);
+        std::vector<FormattedTextNode> list_parts = collect(parts[0].get_children());
+        REQUIRE(list_parts.size() == 3);
+        REQUIRE(list_parts[0].get_type() == FormattedTextNodeType::PARAGRAPH);
+        REQUIRE(list_parts[1].get_type() == FormattedTextNodeType::LIST_ITEM);
+        REQUIRE(list_parts[2].get_type() == FormattedTextNodeType::LIST_ITEM);
+        REQUIRE(text.node_count() == 9);
+    }
+    SECTION("a single item is not a list") {
+        nlohmann::json json = R"({"entries": [
+            "before",
+            "Choose one of the following:",
+            {"type": "list", "items": ["{@spell only}"]},
+            "after"
+        ]})"_json;
+        REQUIRE_FALSE(write_formatted_text_into(json, text, "test.json").has_value());
+
+        FormattedText expected;
+        FormattedTextWriter writer(expected);
+        for (std::string_view str : {"before", "{@spell only}", "after"}) {
+            uint32_t paragraph_index = writer.begin_node(FormattedTextNodeType::PARAGRAPH);
+            REQUIRE_FALSE(parse_paragraph(str, writer, "test.json").has_value());
+            writer.end_node(paragraph_index);
+        }
+        REQUIRE(text == expected);
+    }
+    SECTION("a list with an error is dropped with its introduction") {
+        nlohmann::json json = R"({"entries": [
+            "before",
+            "Choose one of the following:",
+            {"type": "list", "items": ["first", 42]}
+        ]})"_json;
+        REQUIRE(write_formatted_text_into(json, text, "test.json").has_value());
+        REQUIRE(text == FormattedText::simple("before"));
+    }
+}
+
+} // namespace dnd::test
@@ -0,0 +1,211 @@
+#include <dnd_config.hpp>
+
+#include <core/parsing/streaming_file_parser.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <core/content.hpp>
+#include <core/errors/errors.hpp>
+#include <core/models/spell/spell.hpp>
+#include <core/parsing/spell_file_parser.hpp>
+#include <core/parsing/lazy_text_parsing.hpp>
+#include <core/parsing/spell_sources_file_parser.hpp>
+#include <core/text/formatted_text.hpp>
+#include <core/utils/string_interner.hpp>
+
+namespace dnd::test {
+
+static constexpr const char* tags = "[core][parsing]";
+
+static const char* example_spells_json = R"({
+    "monster": [{"name": "Goblin", "trait": [{"entries": [["nested"], {"deeply": [1, 2.5, null, true]}]}]}],
+    "spell": [
+        {
+            "name": "Fire Bolt", "source": "PHB", "page": 1, "level": 0, "school": "V",
+            "time": [{"number": 1, "unit": "action"}],
+            "range": {"type": "point", "distance": {"type": "feet", "amount": 120}},
+            "components": {"v": true, "s": true}, "duration": [{"type": "instant"}],
+            "entries": ["You hurl a mote of fire."]
+        }
+    ],
+    "_meta": {"sources": [{"json": "PHB"}]}
+})";
+
+static void write_file(const std::filesystem::path& filepath, const std::string& text) {
+    std::ofstream file(filepath, std::ios::trunc);
+    file << text;
+}
+
+static std::vector<std::string> node_texts(const FormattedText& text) {
+    std::vector<std::string> texts;
+    for (FormattedTextNode node : text.get_all_nodes()) {
+        texts.emplace_back(node.get_text());
+    }
+    return texts;
+}
+
+TEST_CASE("StreamingFileParser // parses the elements of supported categories", tags) {
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "dnd_streaming_file_parser_test";
+    std::filesystem::create_directories(directory);
+    const std::filesystem::path spells_file = directory / "spells.json";
+    const SpellSources spell_sources = {{"PHB", {{"Fire Bolt", {"Wizard|PHB"}}}}};
+
+    SECTION("unsupported categories are skipped") {
+        write_file(spells_file, example_spells_json);
+        SpellFileParser parser(spells_file, spell_sources);
+        REQUIRE(parser.open_json().ok());
+        REQUIRE(parser.parse().ok());
+
+        Content content;
+        parser.save_result(content);
+        REQUIRE(content.get_all_spells().size() == 1);
+        const Spell& spell = content.get_all_spells()[0];
+        REQUIRE(spell.get_name() == "Fire Bolt");
+        REQUIRE(spell.get_classes() == std::pmr::set<InternedString>{InternedString("Wizard|PHB")});
+    }
+    SECTION("descriptions can be parsed lazily from the element's location in the file") {
+        write_file(spells_file, example_spells_json);
+        SpellFileParser eager_parser(spells_file, spell_sources);
+        REQUIRE(eager_parser.open_json().ok());
+        REQUIRE(eager_parser.parse().ok());
+        SpellFileParser lazy_parser(spells_file, spell_sources, DescriptionParsing::LAZY);
+        REQUIRE(lazy_parser.open_json().ok());
+        REQUIRE(lazy_parser.parse().ok());
+
+        Content eager_content;
+        eager_parser.save_result(eager_content);
+        Content lazy_content;
+        lazy_parser.save_result(lazy_content);
+        REQUIRE(lazy_content.get_all_spells().size() == 1);
+        const FormattedText& lazy_description = lazy_content.get_all_spells()[0].get_description();
+        REQUIRE(node_texts(lazy_description) == node_texts(eager_content.get_all_spells()[0].get_description()));
+        REQUIRE(node_texts(lazy_description).back() == "You hurl a mote of fire.");
+    }
+    SECTION("lazily parsed descriptions are not built while streaming") {
+        const std::string text = example_spells_json;
+        const std::string entries = R"("entries": ["You hurl a mote of fire."])";
+        const std::string nested_entries = R"("entries": [
+            "You hurl a mote of fire:", {"type": "list", "items": ["{@b first}", "second"]}
+        ],
+        "entriesHigherLevel": [{"type": "entries", "name": "At Higher Levels", "entries": ["More fire."]}])";
+        write_file(spells_file, std::string(text).replace(text.find(entries), entries.size(), nested_entries));
+        SpellFileParser eager_parser(spells_file, spell_sources);
+        REQUIRE(eager_parser.open_json().ok());
+        REQUIRE(eager_parser.parse().ok());
+        SpellFileParser lazy_parser(spells_file, spell_sources, DescriptionParsing::LAZY);
+        REQUIRE(lazy_parser.open_json().ok());
+        REQUIRE(lazy_parser.parse().ok());
+
+        Content eager_content;
+        eager_parser.save_result(eager_content);
+        Content lazy_content;
+        lazy_parser.save_result(lazy_content);
+        REQUIRE(lazy_content.get_all_spells().size() == 1);
+        const FormattedText& lazy_description = lazy_content.get_all_spells()[0].get_description();
+        REQUIRE(node_texts(lazy_description) == node_texts(eager_content.get_all_spells()[0].get_description()));
+        REQUIRE(node_texts(lazy_description).back() == "More fire.");
+    }
+    SECTION("elements spanning several chunks of the file are located for lazily parsed descriptions") {
+        const std::string text = example_spells_json;
+        const std::string entry = "You hurl a mote of fire.";
+        const std::string long_entry = std::string(200 * 1024, 'f');
+        write_file(spells_file, std::string(text).replace(text.find(entry), entry.size(), long_entry));
+        SpellFileParser lazy_parser(spells_file, spell_sources, DescriptionParsing::LAZY);
+        REQUIRE(lazy_parser.open_json().ok());
+        REQUIRE(lazy_parser.parse().ok());
+
+        Content lazy_content;
+        lazy_parser.save_result(lazy_content);
+        REQUIRE(lazy_content.get_all_spells().size() == 1);
+        REQUIRE(node_texts(lazy_content.get_all_spells()[0].get_description()).back() == long_entry);
+    }
+    SECTION("lazily parsed descriptions report missing and empty entries like eagerly parsed ones") {
+        const std::string text = example_spells_json;
+        const std::string entries = R"("entries": ["You hurl a mote of fire."])";
+        for (const std::string& replacement : {std::string(R"("page": 1)"), std::string(R"("entries": [])")}) {
+            write_file(spells_file, std::string(text).replace(text.find(entries), entries.size(), replacement));
+            SpellFileParser eager_parser(spells_file, spell_sources);
+            REQUIRE(eager_parser.open_json().ok());
+            const Errors eager_errors = eager_parser.parse();
+            SpellFileParser lazy_parser(spells_file, spell_sources, DescriptionParsing::LAZY);
+            REQUIRE(lazy_parser.open_json().ok());
+            const Errors lazy_errors = lazy_parser.parse();
+            REQUIRE(lazy_errors.get_errors().size() == eager_errors.get_errors().size());
+
+            Content eager_content;
+            eager_parser.save_result(eager_content);
+            Content lazy_content;
+            lazy_parser.save_result(lazy_content);
+            REQUIRE(lazy_content.get_all_spells().empty());
+            REQUIRE(eager_content.get_all_spells().empty());
+            REQUIRE(
+                lazy_content.get_spell_library().get_drafts().size()
+                == eager_content.get_spell_library().get_drafts().size()
+            );
+        }
+    }
+    SECTION("errors in a lazily parsed description are shown in the description") {
+        const std::string text = example_spells_json;
+        const std::string entries = R"(["You hurl a mote of fire."])";
+        write_file(spells_file, std::string(text).replace(text.find(entries), entries.size(), R"(["Fire.", 5])"));
+        SpellFileParser lazy_parser(spells_file, spell_sources, DescriptionParsing::LAZY);
+        REQUIRE(lazy_parser.open_json().ok());
+        REQUIRE(lazy_parser.parse().ok());
+        Content lazy_content;
+        lazy_parser.save_result(lazy_content);
+        REQUIRE(lazy_content.get_all_spells().size() == 1);
+        const std::vector<std::string> texts = node_texts(lazy_content.get_all_spells()[0].get_description());
+        REQUIRE(std::find(texts.begin(), texts.end(), "Fire.") != texts.end());
+        REQUIRE(texts.back().starts_with("Error in the description: "));
+    }
+    SECTION("descriptions that changed in the file are not parsed from their old location") {
+        write_file(spells_file, example_spells_json);
+        SpellFileParser lazy_parser(spells_file, spell_sources, DescriptionParsing::LAZY);
+        REQUIRE(lazy_parser.open_json().ok());
+        REQUIRE(lazy_parser.parse().ok());
+        Content lazy_content;
+        lazy_parser.save_result(lazy_content);
+
+        // the same length, so that the old location still contains a valid object
+        const std::string text = example_spells_json;
+        const std::string description = "You hurl a mote of fire.";
+        const std::string changed_description = "You hurl a mote of ice!!";
+        write_file(
+            spells_file, std::string(text).replace(text.find(description), description.size(), changed_description)
+        );
+        const std::vector<std::string> texts = node_texts(lazy_content.get_all_spells()[0].get_description());
+        REQUIRE(texts.back().find("was changed") != std::string::npos);
+        REQUIRE(std::find(texts.begin(), texts.end(), changed_description) == texts.end());
+    }
+    SECTION("elements that are not objects are reported") {
+        write_file(spells_file, R"({"spell": [1, ["not an object"]]})");
+        SpellFileParser parser(spells_file, spell_sources);
+        REQUIRE(parser.open_json().ok());
+        REQUIRE(parser.parse().get_errors().size() == 2);
+        REQUIRE(parser.continue_after_errors());
+    }
+    SECTION("invalid JSON results in a single error and nothing is parsed") {
+        const std::string text = example_spells_json;
+        write_file(spells_file, text.substr(0, text.find("\"_meta\"")) + "{");
+        SpellFileParser parser(spells_file, spell_sources);
+        REQUIRE(parser.open_json().ok());
+        Errors errors = parser.parse();
+        REQUIRE(errors.get_errors().size() == 1);
+        REQUIRE_FALSE(parser.continue_after_errors());
+
+        Content content;
+        parser.save_result(content);
+        REQUIRE(content.get_all_spells().empty());
+    }
+
+    std::filesystem::remove_all(directory);
+}
+
+} // namespace dnd::test
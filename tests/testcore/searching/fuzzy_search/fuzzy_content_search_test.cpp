@@ -0,0 +1,125 @@
+#include <dnd_config.hpp>
+
+#include <core/searching/fuzzy_search/fuzzy_content_search.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <core/content.hpp>
+#include <core/searching/fuzzy_search/fuzzy_search_index.hpp>
+#include <core/searching/fuzzy_search/fuzzy_string_search.hpp>
+#include <core/searching/search_result.hpp>
+#include <core/types.hpp>
+#include <core/utils/worker_pool.hpp>
+#include <testcore/minimal_testing_content.hpp>
+#include <x/content_pieces.hpp>
+
+namespace dnd::test {
+
+static constexpr const char* tags = "[core][searching][fuzzy_search]";
+
+static void require_same_results(const std::vector<SearchResult>& a, const std::vector<SearchResult>& b) {
+    REQUIRE(a.size() == b.size());
+    for (size_t i = 0; i < a.size(); ++i) {
+        REQUIRE(a[i].content_piece_id == b[i].content_piece_id);
+        REQUIRE(a[i].significance == b[i].significance);
+    }
+}
+
+// scores every content piece by its name without the index, which the searches need to agree with
+static std::vector<SearchResult> fuzzy_search_all(const Content& content, const std::string& search_query) {
+    std::vector<SearchResult> results;
+    auto add_result = [&](const std::string& name, Id id) {
+        int64_t match_score = fuzzy_match_string(search_query, name);
+        if (match_score > 0) {
+            results.emplace_back(id, match_score);
+        }
+    };
+#define X(C, U, j, a, p, P)                                                                                            \
+    for (size_t i = 0; i < content.get_all_##p().size(); ++i) {                                                        \
+        add_result(content.get_##j(i).get_name(), Id{.index = i, .type = Type::C});                                    \
+    }
+    X_CONTENT_PIECES
+#undef X
+    return results;
+}
+
+TEST_CASE("fuzzy_search_content_top_k // keeps the best results of a full search", tags) {
+    Content content = minimal_testing_content();
+    FuzzySearchIndex index(content);
+    WorkerPool worker_pool(2);
+    FuzzySearchOptions options;
+    options.set_all(true);
+
+    for (const char* query : {"a", "e", "fire", "wizard", "xyz"}) {
+        std::vector<SearchResult> all_results = fuzzy_search_all(content, query);
+        std::sort(all_results.begin(), all_results.end(), search_result_ranks_higher);
+
+        TopFuzzySearchResults top_results =
+            fuzzy_search_content_top_k(index, query, options, all_results.size(), worker_pool);
+        REQUIRE(top_results.match_count == all_results.size());
+        require_same_results(top_results.results, all_results);
+
+        top_results = fuzzy_search_content_top_k(index, query, options, 2, worker_pool);
+        REQUIRE(top_results.match_count == all_results.size());
+        all_results.resize(std::min(all_results.size(), static_cast<size_t>(2)));
+        require_same_results(top_results.results, all_results);
+    }
+}
+
+TEST_CASE("fuzzy_search_content_top_k // only searches the selected types", tags) {
+    Content content = minimal_testing_content();
+    FuzzySearchIndex index(content);
+    WorkerPool worker_pool(2);
+    FuzzySearchOptions options;
+    options.set_all(false);
+    options.search_spells = true;
+
+    TopFuzzySearchResults top_results = fuzzy_search_content_top_k(index, "fire", options, 10, worker_pool);
+    REQUIRE(top_results.match_count == top_results.results.size());
+    for (const SearchResult& result : top_results.results) {
+        REQUIRE(result.content_piece_id.type == Type::Spell);
+    }
+}
+
+TEST_CASE("refine_fuzzy_search_top_k // finds the same results as a full search for extended queries", tags) {
+    Content content = minimal_testing_content();
+    FuzzySearchIndex index(content);
+    WorkerPool worker_pool(2);
+    FuzzySearchOptions options;
+    options.set_all(true);
+
+    TopFuzzySearchResults previous_results = fuzzy_search_content_top_k(index, "e", options, 100, worker_pool);
+    for (const char* query : {"ex", "exa", "exAmple", "example c", "example cz"}) {
+        TopFuzzySearchResults full_results = fuzzy_search_content_top_k(index, query, options, 100, worker_pool);
+        TopFuzzySearchResults refined_results =
+            refine_fuzzy_search_top_k(index, query, previous_results.candidates, 100, worker_pool);
+        REQUIRE(refined_results.match_count == full_results.match_count);
+        REQUIRE(refined_results.candidates.size() == full_results.candidates.size());
+        require_same_results(refined_results.results, full_results.results);
+        REQUIRE(refined_results.candidates.size() <= previous_results.candidates.size());
+        previous_results = std::move(refined_results);
+    }
+}
+
+TEST_CASE("FuzzySearchIndex // prepares the names of all content pieces", tags) {
+    Content content = minimal_testing_content();
+    FuzzySearchIndex index(content);
+
+    REQUIRE(index.size(Type::Spell) == content.get_all_spells().size());
+    for (size_t i = 0; i < index.size(Type::Spell); ++i) {
+        FuzzyMatchTarget target = index.get(Type::Spell, i);
+        const std::string& name = content.get_all_spells()[i].get_name();
+        REQUIRE(target.lowercase.size() == name.size());
+        REQUIRE((target.char_mask & fuzzy_char_mask(target.lowercase)) == target.char_mask);
+        REQUIRE(fuzzy_match_prepared("xyz", fuzzy_char_mask("xyz"), target) == fuzzy_match_string("xyz", name));
+        REQUIRE(fuzzy_match_prepared("ire", fuzzy_char_mask("ire"), target) == fuzzy_match_string("Ire", name));
+    }
+}
+
+} // namespace dnd::test
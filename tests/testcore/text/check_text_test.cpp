@@ -0,0 +1,46 @@
+#include <dnd_config.hpp>
+
+#include <core/text/check_text.hpp>
+
+#include <cstddef>
+#include <string>
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace dnd::test {
+
+static constexpr const char* tags = "[core][utils]";
+
+TEST_CASE("checked_string // printable ASCII stays unchanged", tags) {
+    REQUIRE(checked_string(std::string()).empty());
+    REQUIRE(checked_string(std::string("short")) == "short");
+    const std::string long_text = "You hurl a mote of fire at a creature or object within range. Make a ranged spell "
+                                  "attack against the target. On a hit, the target takes 1d10 fire damage.";
+    REQUIRE(checked_string(std::string(long_text)) == long_text);
+}
+
+TEST_CASE("checked_string // code points are substituted", tags) {
+    REQUIRE(checked_string(std::string("3×4")) == "3x4");
+    REQUIRE(checked_string(std::string("a – b — c − d")) == "a - b - c - d");
+    REQUIRE(checked_string(std::string("½")) == "1/2");
+    REQUIRE(checked_string(std::string("1½")) == "1 1/2");
+    REQUIRE(checked_string(std::string("Über")) == "Über");
+}
+
+TEST_CASE("checked_string // code points at the borders of blocks", tags) {
+    for (size_t prefix_length : {0, 1, 15, 16, 17, 31, 32, 33, 63}) {
+        const std::string prefix(prefix_length, 'a');
+        const std::string suffix(40, 'b');
+        REQUIRE(checked_string(prefix + "—" + suffix) == prefix + "-" + suffix);
+        REQUIRE(checked_string(prefix + "ä" + suffix) == prefix + "ä" + suffix);
+        REQUIRE(checked_string(prefix + "2½" + suffix) == prefix + "2 1/2" + suffix);
+    }
+}
+
+TEST_CASE("checked_string // unprintable characters and invalid bytes are kept", tags) {
+    REQUIRE(checked_string(std::string("line\nbreak")) == "line\nbreak");
+    REQUIRE(checked_string(std::string("invalid \xff byte")) == "invalid \xff byte");
+    REQUIRE(checked_string(std::string("truncated \xe2\x80")) == "truncated \xe2\x80");
+}
+
+} // namespace dnd::test
@@ -0,0 +1,196 @@
+#include <dnd_config.hpp>
+
+#include <core/text/formatted_text.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <core/text/formatted_text_writer.hpp>
+
+namespace dnd::test {
+
+static constexpr const char* tags = "[core][utils]";
+
+static std::vector<FormattedTextNode> collect(FormattedTextNode::Range range) {
+    std::vector<FormattedTextNode> nodes;
+    for (FormattedTextNode node : range) {
+        nodes.push_back(node);
+    }
+    return nodes;
+}
+
+TEST_CASE("FormattedText::simple", tags) {
+    FormattedText text = FormattedText::simple("Hello world");
+    REQUIRE_FALSE(text.empty());
+    std::vector<FormattedTextNode> parts = collect(text.get_parts());
+    REQUIRE(parts.size() == 1);
+    REQUIRE(parts[0].get_type() == FormattedTextNodeType::PARAGRAPH);
+    std::vector<FormattedTextNode> inline_parts = collect(parts[0].get_children());
+    REQUIRE(inline_parts.size() == 1);
+    REQUIRE(inline_parts[0].get_type() == FormattedTextNodeType::SIMPLE_TEXT);
+    REQUIRE(inline_parts[0].get_text() == "Hello world");
+    REQUIRE(std::string_view(inline_parts[0].get_c_str()) == "Hello world");
+    REQUIRE_FALSE(inline_parts[0].is_bold());
+    REQUIRE_FALSE(inline_parts[0].is_italic());
+}
+
+TEST_CASE("FormattedText: empty text", tags) {
+    FormattedText text;
+    REQUIRE(text.empty());
+    REQUIRE(text.get_parts().empty());
+    REQUIRE(text.get_all_nodes().empty());
+}
+
+namespace {
+
+// counts the allocations it forwards to the heap
+class CountingResource : public std::pmr::memory_resource {
+public:
+    size_t allocation_count = 0;
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        ++allocation_count;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void* ptr, size_t bytes, size_t alignment) override {
+        std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+} // namespace
+
+TEST_CASE("FormattedText: allocates its buffers from its memory resource", tags) {
+    CountingResource resource;
+    FormattedText text(&resource);
+    FormattedTextWriter writer(text);
+    uint32_t paragraph_index = writer.begin_node(FormattedTextNodeType::PARAGRAPH);
+    writer.add_simple_text("Hello world", false, false);
+    writer.end_node(paragraph_index);
+    size_t allocation_count = resource.allocation_count;
+    REQUIRE(allocation_count > 0);
+
+    SECTION("a copy allocates from the default resource") {
+        FormattedText copy = text;
+        REQUIRE(resource.allocation_count == allocation_count);
+        REQUIRE(copy == text);
+    }
+    SECTION("a moved text keeps its resource") {
+        FormattedText moved = std::move(text);
+        FormattedTextWriter moved_writer(moved);
+        moved_writer.end_node(moved_writer.begin_node(FormattedTextNodeType::PARAGRAPH, "A longer second paragraph"));
+        REQUIRE(resource.allocation_count > allocation_count);
+    }
+}
+
+static void add_simple_paragraph(FormattedTextWriter& writer, std::string_view str) {
+    uint32_t paragraph_index = writer.begin_node(FormattedTextNodeType::PARAGRAPH);
+    writer.add_simple_text(str, false, false);
+    writer.end_node(paragraph_index);
+}
+
+TEST_CASE("FormattedText: nested nodes", tags) {
+    FormattedText text;
+    FormattedTextWriter writer(text);
+
+    uint32_t paragraph_index = writer.begin_node(FormattedTextNodeType::PARAGRAPH);
+    writer.add_simple_text("Cast ", false, false);
+    writer.add_link("Fireball", true, false, {{.key = std::nullopt, .value = "PHB"}, {.key = "page", .value = "241"}});
+    writer.add_simple_text(" now.", false, true);
+    writer.end_node(paragraph_index);
+
+    uint32_t list_index = writer.begin_node(FormattedTextNodeType::LIST);
+    add_simple_paragraph(writer, "above");
+    uint32_t first_item_index = writer.begin_node(FormattedTextNodeType::LIST_ITEM);
+    add_simple_paragraph(writer, "first");
+    writer.end_node(first_item_index);
+    uint32_t second_item_index = writer.begin_node(FormattedTextNodeType::LIST_ITEM);
+    uint32_t table_index = writer.begin_node(FormattedTextNodeType::TABLE, "Damage");
+    writer.set_column_count(table_index, 2);
+    uint32_t level_column_index = writer.begin_node(FormattedTextNodeType::TABLE_COLUMN, "Level");
+    writer.set_column_width(level_column_index, 2);
+    writer.end_node(level_column_index);
+    uint32_t dice_column_index = writer.begin_node(FormattedTextNodeType::TABLE_COLUMN, "Dice");
+    writer.set_column_width(dice_column_index, std::nullopt);
+    writer.end_node(dice_column_index);
+    for (std::string_view level_and_dice : {"1 1d6", "5 2d6"}) {
+        uint32_t row_index = writer.begin_node(FormattedTextNodeType::TABLE_ROW);
+        add_simple_paragraph(writer, level_and_dice.substr(0, 1));
+        add_simple_paragraph(writer, level_and_dice.substr(2));
+        writer.end_node(row_index);
+    }
+    writer.end_node(table_index);
+    writer.end_node(second_item_index);
+    writer.end_node(list_index);
+
+    std::vector<FormattedTextNode> parts = collect(text.get_parts());
+    REQUIRE(parts.size() == 2);
+
+    SECTION("paragraph with a link") {
+        REQUIRE(parts[0].get_type() == FormattedTextNodeType::PARAGRAPH);
+        std::vector<FormattedTextNode> inline_parts = collect(parts[0].get_children());
+        REQUIRE(inline_parts.size() == 3);
+        REQUIRE(inline_parts[0].get_text() == "Cast ");
+        REQUIRE(inline_parts[1].get_type() == FormattedTextNodeType::LINK);
+        REQUIRE(inline_parts[1].get_text() == "Fireball");
+        REQUIRE(inline_parts[1].is_bold());
+        std::vector<FormattedTextAttribute> attributes;
+        for (FormattedTextAttribute attribute : inline_parts[1].get_attributes()) {
+            attributes.push_back(attribute);
+        }
+        REQUIRE(attributes.size() == 2);
+        REQUIRE_FALSE(attributes[0].key.has_value());
+        REQUIRE(attributes[0].value == "PHB");
+        REQUIRE(attributes[1].key == "page");
+        REQUIRE(attributes[1].value == "241");
+        REQUIRE(inline_parts[2].get_text() == " now.");
+        REQUIRE(inline_parts[2].is_italic());
+        REQUIRE(inline_parts[2].get_attributes().empty());
+    }
+    SECTION("list with a table") {
+        REQUIRE(parts[1].get_type() == FormattedTextNodeType::LIST);
+        std::vector<FormattedTextNode> list_parts = collect(parts[1].get_children());
+        REQUIRE(list_parts.size() == 3);
+        REQUIRE(list_parts[0].get_type() == FormattedTextNodeType::PARAGRAPH);
+        REQUIRE(list_parts[1].get_type() == FormattedTextNodeType::LIST_ITEM);
+        REQUIRE(list_parts[2].get_type() == FormattedTextNodeType::LIST_ITEM);
+
+        std::vector<FormattedTextNode> item_parts = collect(list_parts[2].get_children());
+        REQUIRE(item_parts.size() == 1);
+        FormattedTextNode table_node = item_parts[0];
+        REQUIRE(table_node.get_type() == FormattedTextNodeType::TABLE);
+        REQUIRE(table_node.get_text() == "Damage");
+        REQUIRE(table_node.get_column_count() == 2);
+
+        std::vector<FormattedTextNode> table_parts = collect(table_node.get_children());
+        REQUIRE(table_parts.size() == 4);
+        REQUIRE(table_parts[0].get_type() == FormattedTextNodeType::TABLE_COLUMN);
+        REQUIRE(table_parts[0].get_text() == "Level");
+        REQUIRE(table_parts[0].get_column_width() == 2);
+        REQUIRE(table_parts[1].get_text() == "Dice");
+        REQUIRE_FALSE(table_parts[1].get_column_width().has_value());
+        REQUIRE(table_parts[3].get_type() == FormattedTextNodeType::TABLE_ROW);
+        std::vector<FormattedTextNode> cells = collect(table_parts[3].get_children());
+        REQUIRE(cells.size() == 2);
+        REQUIRE(collect(cells[1].get_children())[0].get_text() == "2d6");
+    }
+    SECTION("all nodes in document order") {
+        std::vector<FormattedTextNode> all_nodes = collect(text.get_all_nodes());
+        REQUIRE(all_nodes.size() == text.node_count());
+        REQUIRE(all_nodes[0].get_type() == FormattedTextNodeType::PARAGRAPH);
+        REQUIRE(all_nodes[1].get_text() == "Cast ");
+        REQUIRE(all_nodes[2].get_text() == "Fireball");
+        REQUIRE(all_nodes[3].get_text() == " now.");
+        REQUIRE(all_nodes[4].get_type() == FormattedTextNodeType::LIST);
+        REQUIRE(all_nodes.back().get_text() == "2d6");
+    }
+}
+
+} // namespace dnd::test
@@ -0,0 +1,109 @@
+#include <dnd_config.hpp>
+
+#include <core/text/formatted_text_writer.hpp>
+
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <core/text/formatted_text.hpp>
+
+namespace dnd::test {
+
+static constexpr const char* tags = "[core][utils]";
+
+static void add_paragraph(FormattedTextWriter& writer, std::string_view str) {
+    uint32_t paragraph_index = writer.begin_node(FormattedTextNodeType::PARAGRAPH);
+    writer.add_simple_text(str, false, false);
+    writer.end_node(paragraph_index);
+}
+
+static void add_paragraph_with_link(FormattedTextWriter& writer, std::string_view str) {
+    uint32_t paragraph_index = writer.begin_node(FormattedTextNodeType::PARAGRAPH);
+    writer.add_simple_text(str, false, false);
+    writer.add_link("Fireball", false, false, {{.key = std::nullopt, .value = "PHB"}});
+    writer.end_node(paragraph_index);
+}
+
+static void add_item(FormattedTextWriter& writer, std::string_view str) {
+    uint32_t item_index = writer.begin_node(FormattedTextNodeType::LIST_ITEM);
+    add_paragraph_with_link(writer, str);
+    writer.end_node(item_index);
+}
+
+TEST_CASE("FormattedTextWriter: checked strings", tags) {
+    FormattedText text;
+    FormattedTextWriter writer(text);
+    uint32_t paragraph_index = writer.begin_node(FormattedTextNodeType::PARAGRAPH);
+    writer.add_simple_text("Wisdom \xe2\x80\x94 Insight", true, false, ". ");
+    writer.end_node(paragraph_index);
+
+    FormattedTextNode paragraph = *text.get_parts().begin();
+    FormattedTextNode simple_text = *paragraph.get_children().begin();
+    REQUIRE(simple_text.get_text() == "Wisdom - Insight. ");
+    REQUIRE(simple_text.is_bold());
+}
+
+TEST_CASE("FormattedTextWriter: resetting to a mark", tags) {
+    FormattedText text;
+    FormattedTextWriter writer(text);
+    add_paragraph(writer, "kept");
+    FormattedText before = text;
+
+    SECTION("at the end") {
+        FormattedTextWriter::Mark mark = writer.mark();
+        add_paragraph_with_link(writer, "discarded ");
+        writer.reset_to(mark);
+        REQUIRE(text == before);
+    }
+    SECTION("before a node") {
+        add_paragraph_with_link(writer, "discarded ");
+        writer.reset_to(writer.mark_before(2));
+        REQUIRE(text == before);
+    }
+}
+
+TEST_CASE("FormattedTextWriter: wrapping nodes into a list", tags) {
+    FormattedText text;
+    FormattedTextWriter writer(text);
+    add_paragraph_with_link(writer, "before ");
+    add_paragraph(writer, "above:");
+    add_item(writer, "first ");
+    add_item(writer, "second ");
+    writer.wrap_nodes_from(3, FormattedTextNodeType::LIST);
+
+    FormattedText expected;
+    FormattedTextWriter expected_writer(expected);
+    add_paragraph_with_link(expected_writer, "before ");
+    uint32_t list_index = expected_writer.begin_node(FormattedTextNodeType::LIST);
+    add_paragraph(expected_writer, "above:");
+    add_item(expected_writer, "first ");
+    add_item(expected_writer, "second ");
+    expected_writer.end_node(list_index);
+
+    REQUIRE(text == expected);
+}
+
+TEST_CASE("FormattedTextWriter: erasing nodes", tags) {
+    FormattedText text;
+    FormattedTextWriter writer(text);
+    add_paragraph_with_link(writer, "before ");
+    add_paragraph_with_link(writer, "above:");
+    add_item(writer, "only ");
+    add_paragraph_with_link(writer, "after ");
+    // the paragraph above the item and the item node itself, the parts of the item remain
+    writer.erase_nodes(3, 7);
+
+    FormattedText expected;
+    FormattedTextWriter expected_writer(expected);
+    add_paragraph_with_link(expected_writer, "before ");
+    add_paragraph_with_link(expected_writer, "only ");
+    add_paragraph_with_link(expected_writer, "after ");
+
+    REQUIRE(text == expected);
+    REQUIRE(writer.get_last_part() == 6);
+}
+
+} // namespace dnd::test
@@ -2,6 +2,10 @@
 
 #include <core/text/rich_text.hpp>
 
+#include <optional>
+#include <string>
+#include <vector>
+
 #include <catch2/catch_test_macros.hpp>
 
 namespace dnd::test {
@@ -61,4 +65,26 @@ TEST_CASE("parse_rich_text", tags) {
     }
 }
 
+TEST_CASE("parse_rich_text_view", tags) {
+    const std::string s = "{@filter Charms|rewards|source=IDRotF} suffix";
+    std::optional<RichTextView> parse_result = parse_rich_text_view(s);
+    REQUIRE(parse_result.has_value());
+    REQUIRE(parse_result->rich_type == "filter");
+    REQUIRE(parse_result->text == "Charms");
+    REQUIRE(parse_result->attributes == "rewards|source=IDRotF");
+    REQUIRE(parse_result->length == s.length() - 7);
+    // the views point into the parsed string
+    REQUIRE(parse_result->text.data() == s.data() + 9);
+
+    std::vector<RichAttribute> attributes;
+    parse_rich_attributes_into(parse_result->attributes, attributes);
+    const std::vector<RichAttribute> expected_attributes = {
+        {.key = std::nullopt, .value = "rewards"}, {.key = "source", .value = "IDRotF"}
+    };
+    REQUIRE(attributes == expected_attributes);
+
+    REQUIRE_FALSE(parse_rich_text_view("{@spell Fireball|PHB").has_value());
+    REQUIRE_FALSE(parse_rich_text_view("{spell Fireball}").has_value());
+}
+
 } // namespace dnd::test
@@ -0,0 +1,60 @@
+#include <dnd_config.hpp>
+
+#include <core/utils/arena.hpp>
+
+#include <memory_resource>
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace dnd::test {
+
+static constexpr const char* tags = "[core][utils]";
+
+namespace {
+
+struct Base {
+    virtual ~Base() = default;
+    virtual int value() const = 0;
+};
+
+struct Derived : public Base {
+    Derived(int& destroyed_count, int value) : destroyed_count(destroyed_count), stored_value(value) {}
+    ~Derived() override { ++destroyed_count; }
+    int value() const override { return stored_value; }
+
+    int& destroyed_count;
+    int stored_value;
+};
+
+} // namespace
+
+TEST_CASE("make_arena_ptr // allocates from the heap without an arena scope", tags) {
+    REQUIRE(get_model_resource() == std::pmr::new_delete_resource());
+    int destroyed_count = 0;
+    {
+        ArenaPtr<Base> ptr = make_arena_ptr<Derived>(destroyed_count, 3);
+        REQUIRE(ptr->value() == 3);
+    }
+    REQUIRE(destroyed_count == 1);
+}
+
+TEST_CASE("make_arena_ptr // allocates from the arena of the innermost scope", tags) {
+    Arena outer_arena;
+    Arena inner_arena;
+    int destroyed_count = 0;
+    {
+        ArenaScope outer_scope(outer_arena);
+        REQUIRE(get_model_resource() == outer_arena.get_resource());
+        {
+            ArenaScope inner_scope(inner_arena);
+            REQUIRE(get_model_resource() == inner_arena.get_resource());
+            ArenaPtr<Base> ptr = make_arena_ptr<Derived>(destroyed_count, 5);
+            REQUIRE(ptr->value() == 5);
+        }
+        REQUIRE(get_model_resource() == outer_arena.get_resource());
+    }
+    REQUIRE(get_model_resource() == std::pmr::new_delete_resource());
+    REQUIRE(destroyed_count == 1);
+}
+
+} // namespace dnd::test
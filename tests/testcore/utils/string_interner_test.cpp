@@ -0,0 +1,90 @@
+#include <dnd_config.hpp>
+
+#include <core/utils/string_interner.hpp>
+
+#include <algorithm>
+#include <optional>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace dnd::test {
+
+static constexpr const char* tags = "[core][utils]";
+
+TEST_CASE("InternedString // equal strings share the same handle", tags) {
+    InternedString a("Wizard");
+    InternedString b(std::string("Wiz") + "ard");
+    InternedString c("Evocation");
+    REQUIRE(a == b);
+    REQUIRE(&a.str() == &b.str());
+    REQUIRE(a != c);
+    REQUIRE(a.str() == "Wizard");
+    REQUIRE(a == "Wizard");
+}
+
+TEST_CASE("InternedString // default constructed handle is the empty string", tags) {
+    InternedString empty;
+    REQUIRE(empty.empty());
+    REQUIRE(empty == InternedString(""));
+}
+
+TEST_CASE("InternedString // ordering compares the strings", tags) {
+    std::set<InternedString> strings = {InternedString("wis"), InternedString("cha"), InternedString("int")};
+    std::set<std::string> expected = {"cha", "int", "wis"};
+    REQUIRE(std::set<std::string>(strings.begin(), strings.end()) == expected);
+}
+
+TEST_CASE("StringInterner // find does not intern", tags) {
+    StringInterner& interner = StringInterner::get();
+    REQUIRE_FALSE(interner.find("a string that is never interned by any test").has_value());
+    InternedString interned = interner.intern("a string that is interned by this test");
+    std::optional<InternedString> found = interner.find("a string that is interned by this test");
+    REQUIRE(found.has_value());
+    REQUIRE(found.value() == interned);
+}
+
+TEST_CASE("StringInterner // a string is removed with its last handle", tags) {
+    StringInterner& interner = StringInterner::get();
+    const char* str = "a string that only this test interns and releases";
+    {
+        InternedString first(str);
+        InternedString second = first;
+        InternedString third("another string of this test");
+        third = second;
+        first = InternedString();
+        REQUIRE(interner.find(str).has_value());
+        REQUIRE(third == second);
+        REQUIRE_FALSE(interner.find("another string of this test").has_value());
+    }
+    REQUIRE_FALSE(interner.find(str).has_value());
+    REQUIRE(InternedString(str).str() == str);
+}
+
+TEST_CASE("InternedString // moving a handle keeps the string interned", tags) {
+    StringInterner& interner = StringInterner::get();
+    const char* str = "a string that only this test moves around";
+    {
+        InternedString first(str);
+        InternedString second(std::move(first));
+        REQUIRE(second == str);
+        std::vector<InternedString> strings;
+        strings.push_back(std::move(second));
+        strings.emplace_back("another string of the moving test");
+        strings.emplace_back("a third string of the moving test");
+        std::sort(strings.begin(), strings.end());
+        REQUIRE(strings.front() == str);
+        first = std::move(strings.front());
+        REQUIRE(first == str);
+        first = InternedString(str);
+        REQUIRE(interner.find(str).has_value());
+        strings.clear();
+    }
+    REQUIRE_FALSE(interner.find(str).has_value());
+    REQUIRE_FALSE(interner.find("another string of the moving test").has_value());
+}
+
+} // namespace dnd::test
@@ -0,0 +1,97 @@
+#include <dnd_config.hpp>
+
+#include <core/utils/worker_pool.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace dnd::test {
+
+static constexpr const char* tags = "[core][utils]";
+
+TEST_CASE("WorkerPool // runs every job exactly once", tags) {
+    WorkerPool worker_pool(4);
+    REQUIRE(worker_pool.get_worker_count() == 4);
+    std::vector<std::atomic<int>> runs(1000);
+    worker_pool.run(runs.size(), [&runs](size_t i) { ++runs[i]; });
+    for (const std::atomic<int>& run_count : runs) {
+        REQUIRE(run_count == 1);
+    }
+}
+
+TEST_CASE("WorkerPool // can be reused for several batches", tags) {
+    WorkerPool worker_pool(3);
+    std::atomic<size_t> sum = 0;
+    for (size_t batch = 0; batch < 50; ++batch) {
+        worker_pool.run(batch, [&sum](size_t i) { sum += i + 1; });
+    }
+    // every batch of n jobs adds 1 + 2 + ... + n
+    size_t expected_sum = 0;
+    for (size_t batch = 0; batch < 50; ++batch) {
+        expected_sum += batch * (batch + 1) / 2;
+    }
+    REQUIRE(sum == expected_sum);
+}
+
+TEST_CASE("WorkerPool // a single worker runs the jobs in order on the calling thread", tags) {
+    WorkerPool worker_pool(1);
+    REQUIRE(worker_pool.get_worker_count() == 1);
+    const std::thread::id caller = std::this_thread::get_id();
+    std::vector<size_t> order;
+    worker_pool.run(5, [&order, caller](size_t i) {
+        REQUIRE(std::this_thread::get_id() == caller);
+        order.push_back(i);
+    });
+    REQUIRE(order == std::vector<size_t>{0, 1, 2, 3, 4});
+}
+
+TEST_CASE("WorkerPool // a single worker rethrows the first exception after the other jobs are done", tags) {
+    WorkerPool worker_pool(1);
+    std::vector<size_t> finished;
+    REQUIRE_THROWS_AS(
+        worker_pool.run(
+            5,
+            [&finished](size_t i) {
+                if (i == 1) {
+                    throw std::runtime_error("job failed");
+                }
+                if (i == 3) {
+                    throw std::logic_error("later job failed");
+                }
+                finished.push_back(i);
+            }
+        ),
+        std::runtime_error
+    );
+    REQUIRE(finished == std::vector<size_t>{0, 2, 4});
+}
+
+TEST_CASE("WorkerPool // rethrows an exception of a job after the other jobs are done", tags) {
+    WorkerPool worker_pool(4);
+    std::atomic<int> finished = 0;
+    REQUIRE_THROWS_AS(
+        worker_pool.run(
+            100,
+            [&finished](size_t i) {
+                if (i == 42) {
+                    throw std::runtime_error("job failed");
+                }
+                ++finished;
+            }
+        ),
+        std::runtime_error
+    );
+    REQUIRE(finished == 99);
+
+    // the pool stays usable after a failed batch
+    std::atomic<int> runs = 0;
+    worker_pool.run(10, [&runs](size_t) { ++runs; });
+    REQUIRE(runs == 10);
+}
+
+} // namespace dnd::test
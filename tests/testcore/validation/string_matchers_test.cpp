@@ -0,0 +1,103 @@
+#include <dnd_config.hpp>
+
+#include <core/validation/string_matchers.hpp>
+
+#include <optional>
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace dnd::test {
+
+static constexpr const char* tags = "[core][validation]";
+
+TEST_CASE("is_dice_string", tags) {
+    REQUIRE(is_dice_string("d20"));
+    REQUIRE(is_dice_string("2d6"));
+    REQUIRE(is_dice_string("1d8+2d6+D4"));
+    REQUIRE(is_dice_string("1d100-5"));
+    REQUIRE(is_dice_string("3d12+05"));
+    REQUIRE_FALSE(is_dice_string(""));
+    REQUIRE_FALSE(is_dice_string("0d6"));
+    REQUIRE_FALSE(is_dice_string("1d7"));
+    REQUIRE_FALSE(is_dice_string("1d6+"));
+    REQUIRE_FALSE(is_dice_string("1d6-2d6"));
+    REQUIRE_FALSE(is_dice_string("1d6+0d6"));
+    REQUIRE_FALSE(is_dice_string("1d6 + 2"));
+}
+
+TEST_CASE("is_condition_string", tags) {
+    REQUIRE(is_condition_string("HAS_ARMOR == true"));
+    REQUIRE(is_condition_string("CLASS_LEVEL >= 3"));
+    REQUIRE(is_condition_string("MY_VALUE_1 > -2.35"));
+    REQUIRE(is_condition_string("AC != DEX_MOD"));
+    REQUIRE(is_condition_string("AC == "));
+    REQUIRE_FALSE(is_condition_string("A == 1"));
+    REQUIRE_FALSE(is_condition_string("AC != true"));
+    REQUIRE_FALSE(is_condition_string("AC = 3"));
+    REQUIRE_FALSE(is_condition_string("AC >= 1.234"));
+    REQUIRE_FALSE(is_condition_string("AC >= 1."));
+}
+
+TEST_CASE("is_stat_change_string", tags) {
+    REQUIRE(is_stat_change_string("AC normal add DEX_MOD"));
+    REQUIRE(is_stat_change_string("SPEED latest mult 1.5"));
+    REQUIRE(is_stat_change_string("MAXHP early sub -2.05"));
+    REQUIRE(is_stat_change_string("HAS_ARMOR earliest set true"));
+    REQUIRE_FALSE(is_stat_change_string(""));
+    REQUIRE_FALSE(is_stat_change_string("AC normal add 0"));
+    REQUIRE_FALSE(is_stat_change_string("AC normal mult 1.50"));
+    REQUIRE_FALSE(is_stat_change_string("AC normal add true"));
+    REQUIRE_FALSE(is_stat_change_string("AC sometime add 1"));
+}
+
+TEST_CASE("match_class_level_condition", tags) {
+    REQUIRE(match_class_level_condition("CLASS_LEVEL >= 3") == 3);
+    REQUIRE(match_class_level_condition("CLASS_LEVEL >= 17") == 17);
+    REQUIRE_FALSE(match_class_level_condition("CLASS_LEVEL >= 0").has_value());
+    REQUIRE_FALSE(match_class_level_condition("CLASS_LEVEL >= 100").has_value());
+    REQUIRE_FALSE(match_class_level_condition("CLASS_LEVEL == 3").has_value());
+}
+
+TEST_CASE("match_cantrip_group_name", tags) {
+    std::optional<SpellGroupName> group = match_cantrip_group_name("Evocation Wizard cantrips");
+    REQUIRE(group.has_value());
+    REQUIRE(group->magic_school == "Evocation");
+    REQUIRE(group->class_name == "Wizard");
+
+    // like with the optional groups of a regular expression, the magic school is preferred over the class
+    group = match_cantrip_group_name("illusion Cantrips");
+    REQUIRE(group.has_value());
+    REQUIRE(group->magic_school == "illusion");
+    REQUIRE(group->class_name.empty());
+
+    group = match_cantrip_group_name("Bard cantrips");
+    REQUIRE(group.has_value());
+    REQUIRE(group->magic_school.empty());
+    REQUIRE(group->class_name == "Bard");
+
+    REQUIRE(match_cantrip_group_name("cantrips").has_value());
+    REQUIRE_FALSE(match_cantrip_group_name("Bard Wizard cantrips").has_value());
+    REQUIRE_FALSE(match_cantrip_group_name("wizard|phb cantrips").has_value());
+    REQUIRE(match_cantrip_group_name("wizard|phb cantrips", true).has_value());
+}
+
+TEST_CASE("match_spell_group_name", tags) {
+    std::optional<SpellGroupName> group = match_spell_group_name("3rd-level abjuration Cleric spells");
+    REQUIRE(group.has_value());
+    REQUIRE(group->level == "3rd");
+    REQUIRE(group->magic_school == "abjuration");
+    REQUIRE(group->class_name == "Cleric");
+
+    group = match_spell_group_name("7th-level Spells");
+    REQUIRE(group.has_value());
+    REQUIRE(group->level == "7th");
+    REQUIRE(group->magic_school.empty());
+
+    REQUIRE(match_spell_group_name("Warlock spells").has_value());
+    REQUIRE_FALSE(match_spell_group_name("0th-level spells").has_value());
+    REQUIRE_FALSE(match_spell_group_name("Warlock 1st-level spells").has_value());
+    REQUIRE_FALSE(match_spell_group_name("Wizard  spells").has_value());
+    REQUIRE_FALSE(match_spell_group_name("Wizard spells ").has_value());
+}
+
+} // namespace dnd::test
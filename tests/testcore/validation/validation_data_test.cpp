@@ -8,7 +8,7 @@
 #include <catch2/catch_test_macros.hpp>
 
 #include <core/errors/errors.hpp>
-#include <core/text/text.hpp>
+#include <core/text/formatted_text.hpp>
 #include <testcore/validation/validation_data_mock.hpp>
 
 namespace dnd::test {
@@ -22,7 +22,7 @@ TEST_CASE("validate_name_description_and_source", tags) {
     Errors errors;
     SECTION("Valid Data") {
         data.name = "Name";
-        data.description = Text::simple("Description");
+        data.description = FormattedText::simple("Description");
         data.source_path = dummy_path;
         REQUIRE_NOTHROW(errors = validate_name_description_and_source(data));
         REQUIRE(errors.ok());
@@ -30,7 +30,7 @@ TEST_CASE("validate_name_description_and_source", tags) {
 
     SECTION("Empty name") {
         data.name = "";
-        data.description = Text::simple("Description");
+        data.description = FormattedText::simple("Description");
         data.source_path = dummy_path;
         REQUIRE_NOTHROW(errors = validate_name_description_and_source(data));
         REQUIRE_FALSE(errors.ok());
@@ -38,7 +38,7 @@ TEST_CASE("validate_name_description_and_source", tags) {
 
     SECTION("Empty description") {
         data.name = "Name";
-        data.description = Text{};
+        data.description = FormattedText{};
         data.source_path = dummy_path;
         REQUIRE_NOTHROW(errors = validate_name_description_and_source(data));
         REQUIRE_FALSE(errors.ok());
@@ -46,7 +46,7 @@ TEST_CASE("validate_name_description_and_source", tags) {
 
     SECTION("Empty source path") {
         data.name = "Name";
-        data.description = Text{};
+        data.description = FormattedText{};
         data.source_path = std::filesystem::path("");
         REQUIRE_NOTHROW(errors = validate_name_description_and_source(data));
         REQUIRE_FALSE(errors.ok());
@@ -54,7 +54,7 @@ TEST_CASE("validate_name_description_and_source", tags) {
 
     SECTION("Completely empty") {
         data.name = "";
-        data.description = Text{};
+        data.description = FormattedText{};
         data.source_path = std::filesystem::path("");
         REQUIRE_NOTHROW(errors = validate_name_description_and_source(data));
         REQUIRE_FALSE(errors.ok());